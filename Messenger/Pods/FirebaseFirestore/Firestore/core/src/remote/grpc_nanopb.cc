@@ -16,6 +16,8 @@
 
 #include "Firestore/core/src/remote/grpc_nanopb.h"
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 #include "Firestore/core/include/firebase/firestore/firestore_errors.h"
@@ -28,13 +30,19 @@ namespace firebase {
 namespace firestore {
 namespace remote {
 
-using nanopb::ByteString;
-using nanopb::ByteStringWriter;
 using util::Status;
 
+namespace {
+
+// Slices are allocated in growing blocks, so that small messages take little
+// memory and large ones few slices.
+constexpr size_t kMinSliceSize = 1024;
+constexpr size_t kMaxSliceSize = 64 * 1024;
+
+}  // namespace
+
 ByteBufferReader::ByteBufferReader(const grpc::ByteBuffer& buffer) {
-  std::vector<grpc::Slice> slices;
-  grpc::Status status = buffer.Dump(&slices);
+  grpc::Status status = buffer.Dump(&slices_);
   // Conversion may fail if compression is used and gRPC tries to decompress an
   // ill-formed buffer.
   if (!status.ok()) {
@@ -45,14 +53,39 @@ ByteBufferReader::ByteBufferReader(const grpc::ByteBuffer& buffer) {
     return;
   }
 
-  ByteStringWriter writer;
-  writer.Reserve(buffer.Length());
-  for (const auto& slice : slices) {
-    writer.Append(slice.begin(), slice.size());
+  // A single slice can be decoded in place; only messages that span slices
+  // need the slower callback stream.
+  if (slices_.size() == 1) {
+    stream_ = pb_istream_from_buffer(slices_[0].begin(), slices_[0].size());
+  } else {
+    stream_.callback = ReadFromSlices;
+    stream_.state = this;
+    stream_.bytes_left = buffer.Length();
   }
+}
 
-  bytes_ = writer.Release();
-  stream_ = pb_istream_from_buffer(bytes_.data(), bytes_.size());
+bool ByteBufferReader::ReadFromSlices(pb_istream_t* stream,
+                                      pb_byte_t* buf,
+                                      size_t count) {
+  auto reader = static_cast<ByteBufferReader*>(stream->state);
+  while (count > 0) {
+    if (reader->slice_index_ == reader->slices_.size()) return false;
+
+    const grpc::Slice& slice = reader->slices_[reader->slice_index_];
+    size_t available = slice.size() - reader->slice_offset_;
+    size_t to_copy = std::min(count, available);
+    if (buf != nullptr) {
+      std::memcpy(buf, slice.begin() + reader->slice_offset_, to_copy);
+      buf += to_copy;
+    }
+    count -= to_copy;
+    reader->slice_offset_ += to_copy;
+    if (reader->slice_offset_ == slice.size()) {
+      ++reader->slice_index_;
+      reader->slice_offset_ = 0;
+    }
+  }
+  return true;
 }
 
 void ByteBufferReader::Read(const pb_field_t* fields, void* dest_struct) {
@@ -63,27 +96,59 @@ void ByteBufferReader::Read(const pb_field_t* fields, void* dest_struct) {
   }
 }
 
-namespace {
+ByteBufferWriter::ByteBufferWriter() : next_slice_size_(kMinSliceSize) {
+  stream_.callback = AppendToSlices;
+  stream_.state = this;
+  stream_.max_size = SIZE_MAX;
+}
 
-bool AppendToGrpcBuffer(pb_ostream_t* stream,
-                        const pb_byte_t* buf,
-                        size_t count) {
-  auto buffer = static_cast<std::vector<grpc::Slice>*>(stream->state);
-  buffer->emplace_back(buf, count);
-  return true;
+ByteBufferWriter::~ByteBufferWriter() {
+  grpc_slice_unref(current_);
 }
 
-}  // namespace
+bool ByteBufferWriter::AppendToSlices(pb_ostream_t* stream,
+                                      const pb_byte_t* buf,
+                                      size_t count) {
+  auto writer = static_cast<ByteBufferWriter*>(stream->state);
+  while (count > 0) {
+    size_t available = GRPC_SLICE_LENGTH(writer->current_) -
+                       writer->current_used_;
+    if (available == 0) {
+      writer->SealCurrentSlice();
+      size_t size = std::max(count, writer->next_slice_size_);
+      writer->next_slice_size_ =
+          std::min(writer->next_slice_size_ * 2, kMaxSliceSize);
+      writer->current_ = grpc_slice_malloc(size);
+      available = size;
+    }
+
+    size_t to_copy = std::min(count, available);
+    std::memcpy(GRPC_SLICE_START_PTR(writer->current_) + writer->current_used_,
+                buf, to_copy);
+    writer->current_used_ += to_copy;
+    buf += to_copy;
+    count -= to_copy;
+  }
+  return true;
+}
 
-ByteBufferWriter::ByteBufferWriter() {
-  stream_.callback = AppendToGrpcBuffer;
-  stream_.state = &buffer_;
-  stream_.max_size = SIZE_MAX;
+void ByteBufferWriter::SealCurrentSlice() {
+  if (current_used_ > 0) {
+    // The sub-slice takes over the reference held by `current_`.
+    slices_.emplace_back(grpc_slice_sub_no_ref(current_, 0, current_used_),
+                         grpc::Slice::STEAL_REF);
+  } else {
+    grpc_slice_unref(current_);
+  }
+  current_ = grpc_empty_slice();
+  current_used_ = 0;
 }
 
 grpc::ByteBuffer ByteBufferWriter::Release() {
-  grpc::ByteBuffer result{buffer_.data(), buffer_.size()};
-  buffer_.clear();
+  SealCurrentSlice();
+  grpc::ByteBuffer result{slices_.data(), slices_.size()};
+  slices_.clear();
+  next_slice_size_ = kMinSliceSize;
   return result;
 }
 
@@ -20,13 +20,15 @@
 #include <pb.h>
 #include <pb_decode.h>
 
+#include <cstddef>
 #include <vector>
 
-#include "Firestore/core/src/nanopb/byte_string.h"
 #include "Firestore/core/src/nanopb/message.h"
 #include "Firestore/core/src/nanopb/reader.h"
 #include "Firestore/core/src/nanopb/writer.h"
+#include "grpc/slice.h"
 #include "grpcpp/support/byte_buffer.h"
+#include "grpcpp/support/slice.h"
 
 namespace firebase {
 namespace firestore {
@@ -36,28 +38,54 @@ namespace remote {
 class ByteBufferReader : public nanopb::Reader {
  public:
   /**
-   * Copies the given `buffer` and associates the resulting stream with this
-   * `ByteBufferReader`.
+   * Associates the slices of the given `buffer` with this `ByteBufferReader`.
+   * The slices are shared with `buffer`, not copied, and decoding reads
+   * across slice boundaries.
    */
-  // TODO(varconst): avoid copying the buffer.
   explicit ByteBufferReader(const grpc::ByteBuffer& buffer);
 
+  ByteBufferReader(const ByteBufferReader&) = delete;
+  ByteBufferReader& operator=(const ByteBufferReader&) = delete;
+
   void Read(const pb_field_t* fields, void* dest_struct) override;
 
  private:
-  nanopb::ByteString bytes_;
+  static bool ReadFromSlices(pb_istream_t* stream,
+                             pb_byte_t* buf,
+                             size_t count);
+
+  std::vector<grpc::Slice> slices_;
+  size_t slice_index_ = 0;
+  size_t slice_offset_ = 0;
   pb_istream_t stream_{};
 };
 
-/** A `Writer` that writes into a `grpc::ByteBuffer`. */
+/**
+ * A `Writer` that writes into a `grpc::ByteBuffer`, encoding directly into
+ * refcounted slices that the resulting buffer takes over.
+ */
 class ByteBufferWriter : public nanopb::Writer {
  public:
   ByteBufferWriter();
+  ~ByteBufferWriter();
+
+  ByteBufferWriter(const ByteBufferWriter&) = delete;
+  ByteBufferWriter& operator=(const ByteBufferWriter&) = delete;
 
   grpc::ByteBuffer Release();
 
  private:
-  std::vector<grpc::Slice> buffer_;
+  static bool AppendToSlices(pb_ostream_t* stream,
+                             const pb_byte_t* buf,
+                             size_t count);
+
+  /** Moves the filled part of `current_` to `slices_`. */
+  void SealCurrentSlice();
+
+  std::vector<grpc::Slice> slices_;
+  grpc_slice current_ = grpc_empty_slice();
+  size_t current_used_ = 0;
+  size_t next_slice_size_;
 };
 
 /**
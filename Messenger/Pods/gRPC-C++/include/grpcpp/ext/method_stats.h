@@ -0,0 +1,97 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_EXT_METHOD_STATS_H
+#define GRPCPP_EXT_METHOD_STATS_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace grpc {
+class ChannelArguments;
+
+namespace experimental {
+
+/// A copy of one of the per-method histograms. Only non-empty buckets are
+/// included; every value in a bucket lies in [lower_bound, upper_bound].
+struct MethodStatsHistogram {
+  struct Bucket {
+    uint64_t lower_bound;
+    uint64_t upper_bound;
+    uint64_t count;
+  };
+  std::vector<Bucket> buckets;
+  uint64_t count = 0;
+  uint64_t sum = 0;
+
+  /// Estimated value at \a percentile (0..100), e.g. 50 or 99. Returns 0 for
+  /// an empty histogram.
+  double Percentile(double percentile) const;
+};
+
+/// What client channels recorded for one method. See \a EnableMethodStats.
+struct MethodStats {
+  /// The method path, e.g. "/package.Service/Method". Once too many distinct
+  /// paths have been seen, the rest are reported together as "(other)".
+  std::string method;
+  uint64_t calls = 0;
+  /// Calls that finished with a status other than OK.
+  uint64_t failed_calls = 0;
+  /// Call latency in microseconds.
+  MethodStatsHistogram latency_us;
+  /// Message sizes in bytes, before compression.
+  MethodStatsHistogram sent_message_bytes;
+  MethodStatsHistogram received_message_bytes;
+  /// Additional attempts per call (retries and hedges).
+  MethodStatsHistogram retries;
+  /// Where the time goes for the TCP writes of sampled calls, in microseconds
+  /// (see \a EnableTcpWriteTimestamps): queued in gRPC from the message being
+  /// sent until sendmsg(), queued in the kernel until the NIC sent it, and on
+  /// the network until the peer acked it. One value per write.
+  MethodStatsHistogram tcp_queue_delay_us;
+  MethodStatsHistogram tcp_kernel_delay_us;
+  MethodStatsHistogram tcp_network_delay_us;
+};
+
+/// Makes channels created with \a args record per-method stats.
+void EnableMethodStats(ChannelArguments* args);
+
+/// Additionally has the kernel timestamp the TCP writes of one call in
+/// \a sample_period (Linux only). Each sampled write costs an allocation and
+/// an error-queue read, so keep the rate low in production.
+void EnableTcpWriteTimestamps(ChannelArguments* args, int sample_period);
+
+/// Returns the stats recorded so far by every channel in the process, sorted
+/// by method.
+std::vector<MethodStats> GetMethodStats();
+
+/// Like \a GetMethodStats, but also clears the stats, so that each call
+/// returns what was recorded since the previous one.
+std::vector<MethodStats> GetAndResetMethodStats();
+
+/// A plain-text table with one row per method of the p50 and p99 of call
+/// latency and of the three TCP delays, for telling time queued in the
+/// application and gRPC apart from time spent in the kernel and the network.
+std::string FormatLatencyBreakdown(const std::vector<MethodStats>& stats);
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_EXT_METHOD_STATS_H
@@ -187,6 +187,24 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
                                   GPR_CLOCK_REALTIME)) == GOT_EVENT);
   }
 
+  /// Read up to \a max_events events from the queue, blocking until at least
+  /// one is available. All events that are ready are taken at once, which
+  /// saves the per-event locking and polling of repeated calls to \a Next on
+  /// busy queues. Each event's tag and ok are stored at the same index of
+  /// \a tags and \a oks, which must both hold \a max_events entries; \a ok
+  /// has the same meaning as for \a Next.
+  ///
+  /// \return the number of events read, or 0 if the queue is fully drained
+  ///         and shut down or \a max_events is 0.
+  size_t NextBatch(void** tags, bool* oks, size_t max_events) {
+    size_t num_events = 0;
+    NextBatchInternal(tags, oks, max_events,
+                      grpc::g_core_codegen_interface->gpr_inf_future(
+                          GPR_CLOCK_REALTIME),
+                      &num_events);
+    return num_events;
+  }
+
   /// Read from the queue, blocking up to \a deadline (or the queue's shutdown).
   /// Both \a tag and \a ok are updated upon success (if an event is available
   /// within the \a deadline).  A \a tag points to an arbitrary location usually
@@ -318,6 +336,8 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
   };
 
   NextStatus AsyncNextInternal(void** tag, bool* ok, gpr_timespec deadline);
+  NextStatus NextBatchInternal(void** tags, bool* oks, size_t max_events,
+                               gpr_timespec deadline, size_t* num_events);
 
   /// Wraps \a grpc_completion_queue_pluck.
   /// \warning Must not be mixed with calls to \a Next.
@@ -106,6 +106,20 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
   /// Establish a channel for in-process communication
   std::shared_ptr<Channel> InProcessChannel(const ChannelArguments& args);
 
+  /// Counters for the work-stealing pool that runs synchronous methods when
+  /// \a ServerBuilder::WORK_STEALING_THREADS is set. All zero otherwise.
+  struct SyncThreadPoolStats {
+    /// Requests that have been taken off a completion queue but have not
+    /// started running yet.
+    int64_t queue_depth = 0;
+    /// The largest \a queue_depth seen so far.
+    int64_t max_queue_depth = 0;
+    /// Requests run by a thread other than the one that dequeued them.
+    uint64_t steals = 0;
+    /// Requests run by the pool in total.
+    uint64_t completed = 0;
+  };
+
   /// NOTE: class experimental_type is not part of the public API of this class.
   /// TODO(yashykt): Integrate into public API when this is no longer
   /// experimental.
@@ -121,6 +135,9 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
             std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
             interceptor_creators);
 
+    /// Returns the counters of the work-stealing sync server pool.
+    SyncThreadPoolStats GetSyncThreadPoolStats();
+
    private:
     Server* server_;
   };
@@ -173,6 +190,10 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
   ///
   /// \param sync_cq_timeout_msec The timeout to use when calling AsyncNext() on
   /// server completion queues passed via sync_server_cqs param.
+  ///
+  /// \param sync_work_stealing If true, sync requests are served by a fixed
+  /// pool with one thread per completion queue in sync_server_cqs instead of
+  /// min_pollers..max_pollers threads per queue.
   Server(ChannelArguments* args,
          std::shared_ptr<std::vector<std::unique_ptr<ServerCompletionQueue>>>
              sync_server_cqs,
@@ -184,7 +205,8 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
          std::vector<
              std::unique_ptr<experimental::ServerInterceptorFactoryInterface>>
              interceptor_creators = std::vector<std::unique_ptr<
-                 experimental::ServerInterceptorFactoryInterface>>());
+                 experimental::ServerInterceptorFactoryInterface>>(),
+         bool sync_work_stealing = false);
 
   /// Start the server.
   ///
@@ -233,6 +255,11 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
   /// interface)
   class SyncRequestThreadManager;
 
+  /// SyncRequestWorkStealingManager runs the sync requests of all the
+  /// sync_server_cqs on a fixed set of threads instead, when
+  /// ServerBuilder::WORK_STEALING_THREADS is set.
+  class SyncRequestWorkStealingManager;
+
   /// Register a generic service. This call does not take ownership of the
   /// service. The service must exist for the lifetime of the Server instance.
   void RegisterAsyncGenericService(AsyncGenericService* service) override;
@@ -291,6 +318,10 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
   /// the \a sync_server_cqs)
   std::vector<std::unique_ptr<SyncRequestThreadManager>> sync_req_mgrs_;
 
+  /// Set if the sync requests on all of \a sync_server_cqs are served by one
+  /// work-stealing pool rather than by the \a sync_req_mgrs_ threads
+  std::unique_ptr<SyncRequestWorkStealingManager> sync_ws_mgr_;
+
   // Server status
   internal::Mutex mu_;
   bool started_;
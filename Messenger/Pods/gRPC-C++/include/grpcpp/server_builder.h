@@ -229,7 +229,12 @@ class ServerBuilder {
     NUM_CQS,         ///< Number of completion queues.
     MIN_POLLERS,     ///< Minimum number of polling threads.
     MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    CQ_TIMEOUT_MSEC,  ///< Completion queue timeout in milliseconds.
+    /// Serve sync methods from a fixed pool of this many threads, each polling
+    /// its own completion queue and stealing ready requests from the others.
+    /// Overrides NUM_CQS, MIN_POLLERS and MAX_POLLERS. A negative value means
+    /// one thread per core; 0 (the default) keeps the dynamic thread manager.
+    WORK_STEALING_THREADS
   };
 
   /// Only useful if this is a Synchronous server.
@@ -357,7 +362,11 @@ class ServerBuilder {
 
   struct SyncServerSettings {
     SyncServerSettings()
-        : num_cqs(1), min_pollers(1), max_pollers(2), cq_timeout_msec(10000) {}
+        : num_cqs(1),
+          min_pollers(1),
+          max_pollers(2),
+          cq_timeout_msec(10000),
+          work_stealing_threads(0) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -372,6 +381,10 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Size of the fixed work-stealing pool for sync methods (one completion
+    /// queue per thread), 0 to disable it or negative for one per core.
+    int work_stealing_threads;
   };
 
   int max_receive_message_size_;
@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 
+#include <string>
+
 #include "src/core/lib/gprpp/unique_type_name.h"
 #include "src/core/lib/gprpp/validation_errors.h"
 #include "src/core/lib/json/json.h"
@@ -36,6 +38,15 @@ UniqueTypeName RequestHashAttributeName();
 struct RingHashConfig {
   uint64_t min_ring_size = 1024;
   uint64_t max_ring_size = 8388608;
+  // How requests are mapped to backends: "ring" (ketama-style ring, binary
+  // searched per pick) or "maglev" (Maglev lookup table, O(1) per pick).
+  std::string lookup_table = "ring";
+  // Number of entries in the Maglev lookup table; must be prime.
+  uint64_t maglev_table_size = 65537;
+  // Bounded-load factor as a percentage, e.g. 125 lets a backend carry up to
+  // 1.25x the mean number of in-flight calls before the pick moves on to the
+  // next backend. 0 disables load bounding.
+  uint32_t hash_balance_factor = 0;
 
   static const JsonLoaderInterface* JsonLoader(const JsonArgs&);
   void JsonPostLoad(const Json& json, const JsonArgs&,
@@ -0,0 +1,146 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/resolver/server_address.h"
+
+namespace grpc_core {
+
+// A process-wide cache of DNS answers, shared by the DNS resolvers of all
+// channels that enable it with GRPC_ARG_DNS_CACHE_TTL_MS.
+//
+// - An answer younger than the TTL is returned without a lookup. One used in
+//   the last tenth of its TTL also starts a refresh in the background, so a
+//   name in steady use is never found expired.
+// - An answer up to max_stale past its TTL is still returned, while a refresh
+//   runs (stale-while-revalidate). A failed refresh keeps it.
+// - Otherwise the caller waits for a lookup, which all concurrent callers for
+//   the same key share.
+//
+// Only successful answers are cached. Callers waiting on a lookup that fails
+// get its error.
+class DnsCache {
+ public:
+  // What one resolution produced. Backends fill in what they query.
+  struct Answer {
+    absl::StatusOr<ServerAddressList> addresses;
+    // grpclb balancers, from SRV records.
+    absl::optional<ServerAddressList> balancer_addresses;
+    // The service config choices, from the TXT record.
+    absl::optional<std::string> service_config_json;
+  };
+
+  struct Options {
+    Duration ttl;
+    Duration max_stale;
+  };
+
+  // Starts a lookup whose I/O is driven by \a interested_parties. It must
+  // call on_done exactly once, even if the returned handle is orphaned
+  // first.
+  using LookupFn = std::function<OrphanablePtr<Orphanable>(
+      grpc_pollset_set* interested_parties,
+      std::function<void(Answer)> on_done)>;
+  using OnAnswerFn = std::function<void(std::shared_ptr<const Answer>)>;
+
+  // At most this many names are cached.
+  static constexpr size_t kMaxEntries = 1024;
+
+  static DnsCache* Get();
+
+  // The options set by GRPC_ARG_DNS_CACHE_TTL_MS and
+  // GRPC_ARG_DNS_CACHE_MAX_STALE_MS, or nullopt if the cache is disabled.
+  static absl::optional<Options> OptionsFromChannelArgs(
+      const ChannelArgs& args);
+
+  // Gets the answer for \a key, which must name everything \a lookup_fn
+  // queries, and calls \a on_answer with it. This may happen before Lookup()
+  // returns. If the answer needs a lookup, \a interested_parties helps drive
+  // it until it completes or the returned handle is orphaned; orphaning the
+  // handle first means \a on_answer is not called.
+  OrphanablePtr<Orphanable> Lookup(const std::string& key,
+                                   const Options& options,
+                                   grpc_pollset_set* interested_parties,
+                                   LookupFn lookup_fn, OnAnswerFn on_answer);
+
+  Json StatsToJson();
+
+ private:
+  class Fetch;
+  class Waiter;
+
+  struct Entry {
+    // The last successful answer, or null.
+    std::shared_ptr<const Answer> answer;
+    Timestamp resolved_at;
+    // When no caller would use the answer anymore.
+    Timestamp evict_after;
+    // The lookup in flight, or null.
+    RefCountedPtr<Fetch> fetch;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t stale_hits = 0;
+    uint64_t misses = 0;
+    uint64_t coalesced = 0;
+    uint64_t refreshes = 0;
+    uint64_t failures = 0;
+  };
+
+  // Starts a lookup for \a entry, returning the new fetch.
+  RefCountedPtr<Fetch> StartFetchLocked(const std::string& key, Entry* entry)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Calls \a lookup_fn for \a fetch, which StartFetchLocked() returned.
+  void RunFetch(RefCountedPtr<Fetch> fetch, LookupFn lookup_fn)
+      ABSL_LOCKS_EXCLUDED(mu_);
+  void OnFetchDone(RefCountedPtr<Fetch> fetch, Answer answer)
+      ABSL_LOCKS_EXCLUDED(mu_);
+  void RemoveWaiter(Waiter* waiter) ABSL_LOCKS_EXCLUDED(mu_);
+  // Makes room for one more entry.
+  void EvictLocked(Timestamp now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Mutex mu_;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mu_);
+  Stats stats_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
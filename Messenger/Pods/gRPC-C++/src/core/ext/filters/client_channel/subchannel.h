@@ -20,11 +20,14 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
@@ -85,12 +88,36 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
 
   size_t GetInitialCallSizeEstimate() const;
 
+  // Number of subchannel calls currently using this connection, and when
+  // the last one finished.  Only tracked when the owning subchannel pools
+  // connections (see GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS).
+  size_t active_calls() const {
+    return active_calls_.load(std::memory_order_relaxed);
+  }
+  Timestamp last_call_finished() const {
+    return Timestamp::FromMillisecondsAfterProcessEpoch(
+        last_call_finished_.load(std::memory_order_relaxed));
+  }
+  void CallStarted() {
+    if (track_calls_) active_calls_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void CallFinished() {
+    if (!track_calls_) return;
+    last_call_finished_.store(
+        Timestamp::Now().milliseconds_after_process_epoch(),
+        std::memory_order_relaxed);
+    active_calls_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
  private:
   grpc_channel_stack* channel_stack_;
   ChannelArgs args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  const bool track_calls_;
+  std::atomic<size_t> active_calls_{0};
+  std::atomic<int64_t> last_call_finished_{0};
 };
 
 // Implements the interface of RefCounted<>.
@@ -260,11 +287,11 @@ class Subchannel : public DualRefCounted<Subchannel> {
       const absl::optional<std::string>& health_check_service_name,
       ConnectivityStateWatcherInterface* watcher) ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Returns the connection to start a call on, or null if not connected.
+  // When the subchannel pools connections, this is the least loaded one,
+  // and another connection may be opened if they are all saturated.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel()
-      ABSL_LOCKS_EXCLUDED(mu_) {
-    MutexLock lock(&mu_);
-    return connected_subchannel_;
-  }
+      ABSL_LOCKS_EXCLUDED(mu_);
 
   // Attempt to connect to the backend.  Has no effect if already connected.
   void RequestConnection() ABSL_LOCKS_EXCLUDED(mu_);
@@ -372,6 +399,23 @@ class Subchannel : public DualRefCounted<Subchannel> {
   void OnConnectingFinishedLocked(grpc_error_handle error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   bool PublishTransportLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Builds the channel stack for connecting_result_.  Returns null on
+  // failure.
+  RefCountedPtr<ConnectedSubchannel> CreateConnectedSubchannelLocked(
+      RefCountedPtr<channelz::SocketNode>* socket)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Methods for the connection pool.
+  void MaybeGrowPoolLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void OnPoolConnectingFinishedLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Replaces a lost primary connection with one from the pool.  Returns
+  // false if the pool is empty.
+  bool PromotePooledConnectionLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void RemovePooledConnectionLocked(uint64_t connection_id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void MaybeStartPoolIdleTimerLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void OnPoolIdleTimer() ABSL_LOCKS_EXCLUDED(mu_);
 
   // The subchannel pool this subchannel is in.
   RefCountedPtr<SubchannelPoolInterface> subchannel_pool_;
@@ -388,6 +432,10 @@ class Subchannel : public DualRefCounted<Subchannel> {
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
   // Minimum connection timeout.
   Duration min_connect_timeout_;
+  // Connection pool limits.
+  const size_t max_connections_;
+  const size_t max_streams_per_connection_;
+  const Duration pool_idle_timeout_;
 
   // Connection state.
   OrphanablePtr<SubchannelConnector> connector_;
@@ -415,6 +463,26 @@ class Subchannel : public DualRefCounted<Subchannel> {
 
   // Active connection, or null.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_ ABSL_GUARDED_BY(mu_);
+  // Identifies connected_subchannel_ to its state watcher.
+  uint64_t connection_id_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t next_connection_id_ ABSL_GUARDED_BY(mu_) = 1;
+
+  // Connections to the same address beyond connected_subchannel_.  They
+  // are opened one at a time through connector_, and only while the
+  // subchannel is READY, so they never overlap with a connection attempt
+  // for connected_subchannel_.  If connected_subchannel_ is lost while one
+  // is in flight, that attempt takes over as the subchannel's attempt.
+  struct PooledConnection {
+    uint64_t id;
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+  };
+  std::vector<PooledConnection> pooled_connections_ ABSL_GUARDED_BY(mu_);
+  // True while connector_ is opening a pooled connection.
+  bool pool_connecting_ ABSL_GUARDED_BY(mu_) = false;
+  bool pool_idle_timer_pending_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_event_engine::experimental::EventEngine::TaskHandle
+      pool_idle_timer_handle_ ABSL_GUARDED_BY(mu_);
+  Timestamp next_pool_attempt_time_ ABSL_GUARDED_BY(mu_);
 
   // Backoff state.
   BackOff backoff_ ABSL_GUARDED_BY(mu_);
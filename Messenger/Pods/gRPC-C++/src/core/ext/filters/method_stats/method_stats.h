@@ -0,0 +1,181 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_METHOD_STATS_METHOD_STATS_H
+#define GRPC_CORE_EXT_FILTERS_METHOD_STATS_METHOD_STATS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/json/json.h"
+
+namespace grpc_core {
+
+// A point-in-time copy of a MethodStatsHistogram.
+struct HistogramSnapshot {
+  std::vector<uint64_t> buckets;
+  uint64_t count = 0;
+  uint64_t sum = 0;
+
+  // Estimated value at the given percentile (0..100): the midpoint of the
+  // bucket holding that rank. 0 if the histogram is empty.
+  double Percentile(double percentile) const;
+  Json ToJson() const;
+};
+
+// A log-linear (HDR-style) histogram of non-negative integers. Values below
+// 16 get a bucket each; above that every power of two is split into 8
+// buckets, so any recorded value is known to within 12.5%. Values above 2^36
+// land in the last bucket.
+//
+// Counts are kept in one set of relaxed atomics per CPU shard, so Record()
+// never takes a lock and rarely shares a cache line with another core.
+class MethodStatsHistogram {
+ public:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int kMaxValueBits = 36;
+  static constexpr size_t kNumBuckets = (kMaxValueBits - kSubBucketBits + 2)
+                                        << (kSubBucketBits - 1);
+
+  explicit MethodStatsHistogram(size_t num_shards);
+
+  MethodStatsHistogram(const MethodStatsHistogram&) = delete;
+  MethodStatsHistogram& operator=(const MethodStatsHistogram&) = delete;
+
+  void Record(size_t shard, uint64_t value);
+
+  // Adds the current counts to *snapshot. If reset is true the counts are
+  // cleared as they are read; a concurrent Record() lands either in this
+  // snapshot or in the next one.
+  void Collect(bool reset, HistogramSnapshot* snapshot);
+
+  static size_t BucketFor(uint64_t value);
+  // Smallest and largest value that fall into bucket index.
+  static uint64_t BucketLowerBound(size_t index);
+  static uint64_t BucketUpperBound(size_t index);
+
+ private:
+  struct Shard {
+    std::atomic<uint64_t> buckets[kNumBuckets];
+    std::atomic<uint64_t> sum;
+  };
+
+  const size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+struct MethodStatsSnapshot {
+  std::string method;
+  uint64_t calls = 0;
+  uint64_t failed_calls = 0;
+  // Call latency in microseconds, from call creation to the final status.
+  HistogramSnapshot latency_us;
+  // Sizes of individual messages, in bytes, before compression.
+  HistogramSnapshot sent_message_bytes;
+  HistogramSnapshot received_message_bytes;
+  // Attempts after the first one, per call: retries, hedges and transparent
+  // retries alike.
+  HistogramSnapshot retries;
+  // Per sampled TCP write, in microseconds (see
+  // GRPC_ARG_TCP_WRITE_TIMESTAMPS_SAMPLE_PERIOD): from the call's most recent
+  // message being handed to gRPC to the sendmsg() that carried its bytes, from
+  // sendmsg() to the NIC sending them, and from then to the peer's ACK.
+  HistogramSnapshot tcp_queue_delay_us;
+  HistogramSnapshot tcp_kernel_delay_us;
+  HistogramSnapshot tcp_network_delay_us;
+
+  Json ToJson() const;
+};
+
+// Everything recorded for one method.
+class MethodStats {
+ public:
+  MethodStats(std::string method, size_t num_shards);
+
+  const std::string& method() const { return method_; }
+
+  void RecordCall(size_t shard, bool failed, uint64_t latency_us,
+                  uint64_t retries);
+  void RecordSentMessage(size_t shard, uint64_t bytes) {
+    sent_message_bytes_.Record(shard, bytes);
+  }
+  void RecordReceivedMessage(size_t shard, uint64_t bytes) {
+    received_message_bytes_.Record(shard, bytes);
+  }
+  void RecordTcpQueueDelay(size_t shard, uint64_t delay_us) {
+    tcp_queue_delay_us_.Record(shard, delay_us);
+  }
+  void RecordTcpKernelDelay(size_t shard, uint64_t delay_us) {
+    tcp_kernel_delay_us_.Record(shard, delay_us);
+  }
+  void RecordTcpNetworkDelay(size_t shard, uint64_t delay_us) {
+    tcp_network_delay_us_.Record(shard, delay_us);
+  }
+
+  MethodStatsSnapshot Collect(bool reset);
+
+ private:
+  // Padded so that shards do not share a cache line.
+  struct ShardCounter {
+    std::atomic<uint64_t> value{0};
+    char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<uint64_t>)];
+  };
+
+  const std::string method_;
+  const size_t num_shards_;
+  // The call count is latency_us_'s count.
+  std::unique_ptr<ShardCounter[]> failed_calls_;
+  MethodStatsHistogram latency_us_;
+  MethodStatsHistogram sent_message_bytes_;
+  MethodStatsHistogram received_message_bytes_;
+  MethodStatsHistogram retries_;
+  MethodStatsHistogram tcp_queue_delay_us_;
+  MethodStatsHistogram tcp_kernel_delay_us_;
+  MethodStatsHistogram tcp_network_delay_us_;
+};
+
+// Process-wide table of MethodStats, keyed by method path. Entries are never
+// removed, so callers may keep the returned pointers. Once kMaxMethods
+// distinct paths have been seen, any further ones share a single entry named
+// kOtherMethod, which bounds memory when servers see arbitrary paths.
+class MethodStatsRegistry {
+ public:
+  static constexpr size_t kMaxMethods = 128;
+  static constexpr absl::string_view kOtherMethod = "(other)";
+
+  static MethodStats* Get(absl::string_view method);
+
+  // The shard the calling thread should record into.
+  static size_t CurrentShard();
+
+  // Snapshots of every method seen so far, sorted by name. If reset is true
+  // all counts are cleared as they are read.
+  static std::vector<MethodStatsSnapshot> Collect(bool reset);
+
+  // {"methodStats": [...]}, in the style of the channelz responses.
+  static Json ToJson(bool reset);
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_METHOD_STATS_METHOD_STATS_H
@@ -50,6 +50,9 @@ class HPackEncoderTable {
   uint32_t max_size() const { return max_table_size_; }
   // Get the current table size
   uint32_t test_only_table_size() const { return table_size_; }
+  // Changes whenever an element is added or evicted: dynamic indices computed
+  // at one generation are only valid while the generation is unchanged.
+  uint32_t generation() const { return generation_; }
 
   // Convert an element index into a dynamic index
   uint32_t DynamicIndex(uint32_t index) const {
@@ -70,6 +73,7 @@ class HPackEncoderTable {
   uint32_t max_table_size_ = hpack_constants::kInitialTableSize;
   uint32_t table_elems_ = 0;
   uint32_t table_size_ = 0;
+  uint32_t generation_ = 0;
   // The size of each element in the HPACK table.
   absl::InlinedVector<EntrySize, hpack_constants::kInitialTableEntries>
       elem_size_;
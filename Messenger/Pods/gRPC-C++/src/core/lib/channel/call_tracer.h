@@ -35,6 +35,8 @@
 
 namespace grpc_core {
 
+struct Timestamps;
+
 // Interface for a tracer that records activities on a call. Actual attempts for
 // this call are traced with CallAttemptTracer after invoking RecordNewAttempt()
 // on the CallTracer object.
@@ -87,6 +89,32 @@ class CallTracer {
   // serves as an indication that the call stack is done with all API calls, and
   // the tracer library is free to destroy it after that.
   virtual CallAttemptTracer* StartNewAttempt(bool is_transparent_retry) = 0;
+
+  // Receives the kernel timestamps of one TCP write that carried bytes of the
+  // call. Created by StartTcpWrite() and deleted by the transport right after
+  // RecordTimestamps(), which can happen after the call is gone, so it must
+  // not point back into the call.
+  class TcpWriteTracer {
+   public:
+    virtual ~TcpWriteTracer() = default;
+    // Called once, after the peer acked the write. \a ts holds the sendmsg,
+    // scheduled, sent and acked times that the kernel reported, plus the
+    // call's byte offset at the end of the write; it is null if the write
+    // failed or the transport shut down first. Does not take ownership of
+    // \a error.
+    virtual void RecordTimestamps(const Timestamps* ts,
+                                  grpc_error_handle error) = 0;
+  };
+
+  // Returns true if the TCP writes that carry this call's bytes should be
+  // timestamped by the kernel (SO_TIMESTAMPING, Linux only). Consulted for
+  // every batch, so the answer should not change during the call. Tracing
+  // costs an allocation and an extra error-queue read per write, so
+  // implementations are expected to sample.
+  virtual bool ShouldTraceTcpWrites() { return false; }
+  // Called by the transport for each traced write. Returning null skips the
+  // write.
+  virtual TcpWriteTracer* StartTcpWrite() { return nullptr; }
 };
 
 }  // namespace grpc_core
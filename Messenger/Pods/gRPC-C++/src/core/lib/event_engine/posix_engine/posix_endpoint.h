@@ -0,0 +1,106 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+
+#include <grpc/event_engine/endpoint_config.h>
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+#include <grpc/event_engine/slice_buffer.h>
+
+#include "src/core/lib/event_engine/executor/executor.h"
+#include "src/core/lib/event_engine/posix_engine/ev_epoll1_linux.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// Socket options read from an EndpointConfig, using the same channel args as
+// the iomgr TCP implementation.
+struct PosixTcpOptions {
+  static constexpr int kDefaultReadChunkSize = 8192;
+  static constexpr int kDefaultMinReadChunkSize = 256;
+  static constexpr int kDefaultMaxReadChunkSize = 4 * 1024 * 1024;
+  static constexpr int kDefaultMaxSimultaneousZerocopySends = 4;
+  static constexpr int kDefaultZerocopySendBytesThreshold = 16 * 1024;
+  static constexpr int kMaxChunkSize = 32 * 1024 * 1024;
+
+  int tcp_read_chunk_size = kDefaultReadChunkSize;
+  int tcp_min_read_chunk_size = kDefaultMinReadChunkSize;
+  int tcp_max_read_chunk_size = kDefaultMaxReadChunkSize;
+  int tcp_tx_zerocopy_send_bytes_threshold = kDefaultZerocopySendBytesThreshold;
+  int tcp_tx_zerocopy_max_simultaneous_sends =
+      kDefaultMaxSimultaneousZerocopySends;
+  bool tcp_tx_zero_copy_enabled = false;
+  bool allow_reuse_port = true;
+  int listener_shards = 1;
+};
+
+PosixTcpOptions TcpOptionsFromEndpointConfig(
+    const grpc_event_engine::experimental::EndpointConfig& config);
+
+// Applies the socket options every connected endpoint wants (TCP_NODELAY,
+// SO_ZEROCOPY when requested). Returns false if zerocopy was requested but is
+// not supported, in which case the caller should disable it.
+bool PrepareConnectedSocket(int fd, const PosixTcpOptions& options);
+
+class PosixEndpointImpl;
+
+// An EventEngine endpoint over a connected, non-blocking TCP socket.
+//
+// Reads go straight into slices obtained from the endpoint's MemoryAllocator,
+// with SO_RCVLOWAT raised from ReadArgs::read_hint_bytes so the poller is not
+// woken for every partial segment of a large message. Writes of at least
+// tcp_tx_zerocopy_send_bytes_threshold bytes use MSG_ZEROCOPY when enabled:
+// the written slices are kept alive until the kernel reports completion on
+// the socket error queue.
+class PosixEndpoint final
+    : public grpc_event_engine::experimental::EventEngine::Endpoint {
+ public:
+  // Takes ownership of \a handle.
+  PosixEndpoint(EpollEventHandle* handle,
+                grpc_event_engine::experimental::Executor* executor,
+                grpc_event_engine::experimental::MemoryAllocator allocator,
+                const PosixTcpOptions& options);
+  ~PosixEndpoint() override;
+
+  void Read(absl::AnyInvocable<void(absl::Status)> on_read,
+            grpc_event_engine::experimental::SliceBuffer* buffer,
+            const ReadArgs* args) override;
+  void Write(absl::AnyInvocable<void(absl::Status)> on_writable,
+             grpc_event_engine::experimental::SliceBuffer* data,
+             const WriteArgs* args) override;
+  const grpc_event_engine::experimental::EventEngine::ResolvedAddress&
+  GetPeerAddress() const override;
+  const grpc_event_engine::experimental::EventEngine::ResolvedAddress&
+  GetLocalAddress() const override;
+
+ private:
+  PosixEndpointImpl* impl_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
@@ -19,8 +19,10 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -33,32 +35,23 @@
 
 #include "src/core/lib/event_engine/executor/threaded_executor.h"
 #include "src/core/lib/event_engine/handle_containers.h"
+#include "src/core/lib/event_engine/posix_engine/ev_epoll1_linux.h"
 #include "src/core/lib/event_engine/posix_engine/timer_manager.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/port.h"
 
 namespace grpc_event_engine {
 namespace experimental {
 
-// An iomgr-based Posix EventEngine implementation.
-// All methods require an ExecCtx to already exist on the thread's stack.
+// A Posix EventEngine implementation.
+//
+// On Linux, network I/O is driven by an epoll poller owned by the engine and
+// serviced by a small set of dedicated poller threads, started on first use.
+// Ready callbacks run on the engine's executor. Elsewhere only the timer and
+// executor halves are implemented.
 class PosixEventEngine final : public EventEngine {
  public:
-  class PosixEndpoint : public EventEngine::Endpoint {
-   public:
-    ~PosixEndpoint() override;
-    void Read(absl::AnyInvocable<void(absl::Status)> on_read,
-              SliceBuffer* buffer, const ReadArgs* args) override;
-    void Write(absl::AnyInvocable<void(absl::Status)> on_writable,
-               SliceBuffer* data, const WriteArgs* args) override;
-    const ResolvedAddress& GetPeerAddress() const override;
-    const ResolvedAddress& GetLocalAddress() const override;
-  };
-  class PosixListener : public EventEngine::Listener {
-   public:
-    ~PosixListener() override;
-    absl::StatusOr<int> Bind(const ResolvedAddress& addr) override;
-    absl::Status Start() override;
-  };
   class PosixDNSResolver : public EventEngine::DNSResolver {
    public:
     ~PosixDNSResolver() override;
@@ -107,12 +100,35 @@ class PosixEventEngine final : public EventEngine {
   EventEngine::TaskHandle RunAfterInternal(Duration when,
                                            absl::AnyInvocable<void()> cb);
 
+#ifdef GRPC_LINUX_EPOLL
+  struct ConnectionState;
+  // Returns the poller, creating it and starting the poller threads on first
+  // use. Returns nullptr if epoll is unavailable.
+  posix_engine::Epoll1Poller* Poller();
+  static void PollerThreadBody(void* arg);
+  void OnConnectWritable(intptr_t connection_id, ConnectionState* state,
+                         absl::Status status);
+  void OnConnectDeadline(intptr_t connection_id);
+#endif
+
   posix_engine::TimerManager timer_manager_;
   ThreadedExecutor executor_{2};
 
   grpc_core::Mutex mu_;
   TaskHandleSet known_handles_ ABSL_GUARDED_BY(mu_);
   std::atomic<intptr_t> aba_token_{0};
+
+#ifdef GRPC_LINUX_EPOLL
+  std::unique_ptr<posix_engine::Epoll1Poller> poller_ ABSL_GUARDED_BY(mu_);
+  std::vector<grpc_core::Thread> poller_threads_ ABSL_GUARDED_BY(mu_);
+  std::atomic<bool> shutting_down_{false};
+  // Connection attempts that have neither completed nor been cancelled.
+  // Whichever of completion, deadline and cancellation removes an entry
+  // first decides the outcome.
+  absl::flat_hash_map<intptr_t, ConnectionState*> pending_connects_
+      ABSL_GUARDED_BY(mu_);
+  intptr_t last_connection_id_ ABSL_GUARDED_BY(mu_) = 0;
+#endif
 };
 
 }  // namespace experimental
@@ -0,0 +1,78 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_CLOSURE_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_CLOSURE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// An EventEngine::Closure that carries the status of the event it reports.
+// Event handles set the status (OK when the fd became ready, the shutdown
+// status otherwise) before handing the closure to the executor.
+//
+// Permanent closures may be run any number of times and are owned by their
+// creator. Non-permanent closures delete themselves after running once.
+class PosixEngineClosure final
+    : public grpc_event_engine::experimental::EventEngine::Closure {
+ public:
+  PosixEngineClosure() = default;
+  PosixEngineClosure(absl::AnyInvocable<void(absl::Status)> cb,
+                     bool is_permanent)
+      : cb_(std::move(cb)), is_permanent_(is_permanent) {}
+  ~PosixEngineClosure() final = default;
+
+  void SetStatus(absl::Status status) { status_ = std::move(status); }
+
+  void Run() override {
+    // Move the status out first: a permanent closure may be re-armed from
+    // within its own callback.
+    absl::Status status = std::move(status_);
+    status_ = absl::OkStatus();
+    if (!is_permanent_) {
+      cb_(std::move(status));
+      delete this;
+    } else {
+      cb_(std::move(status));
+    }
+  }
+
+  static PosixEngineClosure* ToPermanentClosure(
+      absl::AnyInvocable<void(absl::Status)> cb) {
+    return new PosixEngineClosure(std::move(cb), true);
+  }
+
+  static PosixEngineClosure* ToOneShotClosure(
+      absl::AnyInvocable<void(absl::Status)> cb) {
+    return new PosixEngineClosure(std::move(cb), false);
+  }
+
+ private:
+  absl::AnyInvocable<void(absl::Status)> cb_;
+  bool is_permanent_ = false;
+  absl::Status status_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_CLOSURE_H
@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -37,13 +38,14 @@
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/gprpp/time_averaged_stats.h"
+#include "src/core/lib/gprpp/timing_wheel.h"
 
 namespace grpc_event_engine {
 namespace posix_engine {
 
 struct Timer {
   int64_t deadline;
-  // kInvalidHeapIndex if not in heap.
+  // kInvalidHeapIndex if not in heap; the wheel slot when using timing wheels.
   size_t heap_index;
   bool pending;
   struct Timer* next;
@@ -165,11 +167,30 @@ class TimerList {
     Timer list ABSL_GUARDED_BY(mu);
   };
 
+  /* A shard used instead of Shard when the timer_wheel experiment is
+   * enabled. Timers are kept in a hierarchical timing wheel, so insertion and
+   * cancellation are O(1), and 'next_tick' publishes the next tick at which
+   * the wheel has work so that FindExpiredTimers only locks due shards. */
+  struct WheelShard {
+    explicit WheelShard(int64_t now) : wheel(now) {}
+
+    int64_t UpdateNextTick() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu);
+
+    grpc_core::Mutex mu;
+    grpc_core::TimingWheel<Timer> wheel ABSL_GUARDED_BY(mu);
+    std::atomic<int64_t> next_tick{std::numeric_limits<int64_t>::max()};
+  };
+
   void SwapAdjacentShardsInQueue(uint32_t first_shard_queue_index)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void NoteDeadlineChange(Shard* shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   std::vector<experimental::EventEngine::Closure*> FindExpiredTimers(
       grpc_core::Timestamp now, grpc_core::Timestamp* next);
+  void WheelTimerInit(Timer* timer, grpc_core::Timestamp deadline);
+  bool WheelTimerCancel(Timer* timer);
+  std::vector<experimental::EventEngine::Closure*> FindExpiredWheelTimers(
+      grpc_core::Timestamp now, grpc_core::Timestamp* next);
+  bool LowerMinTimer(int64_t tick);
 
   TimerListHost* const host_;
   const size_t num_shards_;
@@ -185,6 +206,9 @@ class TimerList {
   /* Maintains a sorted list of timer shards (sorted by their min_deadline, i.e
    * the deadline of the next timer in each shard). */
   const std::unique_ptr<Shard*[]> shard_queue_ ABSL_GUARDED_BY(mu_);
+  /* Non-empty only when the timer_wheel experiment is enabled, in which case
+   * these replace shards_ and shard_queue_. */
+  std::vector<std::unique_ptr<WheelShard>> wheel_shards_;
 };
 
 }  // namespace posix_engine
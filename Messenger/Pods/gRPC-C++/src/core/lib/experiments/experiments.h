@@ -41,6 +41,7 @@ inline bool IsUnconstrainedMaxQuotaBufferSizeEnabled() {
 }
 inline bool IsNewHpackHuffmanDecoderEnabled() { return IsExperimentEnabled(8); }
 inline bool IsEventEngineClientEnabled() { return IsExperimentEnabled(9); }
+inline bool IsTimerWheelEnabled() { return IsExperimentEnabled(10); }
 
 struct ExperimentMetadata {
   const char* name;
@@ -48,7 +49,7 @@ struct ExperimentMetadata {
   bool default_value;
 };
 
-constexpr const size_t kNumExperiments = 10;
+constexpr const size_t kNumExperiments = 11;
 extern const ExperimentMetadata g_experiment_metadata[kNumExperiments];
 
 }  // namespace grpc_core
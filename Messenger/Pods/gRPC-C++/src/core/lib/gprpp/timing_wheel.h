@@ -0,0 +1,210 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_TIMING_WHEEL_H
+#define GRPC_CORE_LIB_GPRPP_TIMING_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "absl/numeric/bits.h"
+
+namespace grpc_core {
+
+// A hierarchical timing wheel over integer ticks (milliseconds, for the
+// timer implementations). Insert and Remove are O(1); finding the next due
+// tick is a handful of bitmap scans.
+//
+// There are kLevels levels of kSlotsPerLevel slots each. A slot at level l
+// covers 2^(kBitsPerLevel*l) ticks, and level l only ever holds deadlines that
+// share the current tick's level l+1 slot. Deadlines further out than the top
+// level go to a single overflow list that is re-filed every kSpan ticks.
+// Whenever the current tick reaches the start of an occupied slot, the slot's
+// entries cascade down to the level below.
+//
+// T is intrusive: it must expose `deadline` (an int64_t tick), `next` and
+// `prev` (T*), and an integral `heap_index` that records the slot while the
+// entry is in the wheel. The wheel does no locking of its own.
+template <typename T>
+class TimingWheel {
+ public:
+  static constexpr int kBitsPerLevel = 6;
+  static constexpr int kSlotsPerLevel = 1 << kBitsPerLevel;
+  static constexpr int kLevels = 4;
+  static constexpr int64_t kSpan = int64_t{1} << (kBitsPerLevel * kLevels);
+
+  // `now` is the first tick that has not been processed yet; it must not be
+  // negative.
+  explicit TimingWheel(int64_t now) : current_(now) {}
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Adds t. A deadline that has already been processed fires on the next call
+  // to Advance().
+  void Insert(T* t) {
+    File(t);
+    ++size_;
+  }
+
+  // Removes t, which must currently be in this wheel.
+  void Remove(T* t) {
+    Unlink(t);
+    --size_;
+  }
+
+  // The earliest tick at which Advance() has work to do: either an entry
+  // falls due or entries need to cascade. Never earlier than the current
+  // tick; INT64_MAX if the wheel is empty.
+  int64_t NextEventTick() const {
+    if (size_ == 0) return std::numeric_limits<int64_t>::max();
+    for (int level = 0; level < kLevels; ++level) {
+      const int shift = kBitsPerLevel * level;
+      const int index = static_cast<int>((current_ >> shift) & kSlotMask);
+      const uint64_t bits = occupied_[level] & (~uint64_t{0} << index);
+      if (bits != 0) {
+        const int64_t slot = absl::countr_zero(bits);
+        const int64_t base =
+            current_ & ~((int64_t{1} << (shift + kBitsPerLevel)) - 1);
+        return std::max(current_, base + (slot << shift));
+      }
+    }
+    return ((current_ / kSpan) + 1) * kSpan;
+  }
+
+  // Processes every tick up to and including `now`, calling on_expired(T*)
+  // for each entry that falls due. Entries are unlinked before the callback
+  // runs, so it may free them. `now` must be less than INT64_MAX.
+  template <typename F>
+  void Advance(int64_t now, F on_expired) {
+    while (current_ <= now && size_ > 0) {
+      const int index = static_cast<int>(current_ & kSlotMask);
+      if (occupied_[0] & (uint64_t{1} << index)) {
+        T* t = heads_[index];
+        heads_[index] = nullptr;
+        occupied_[0] &= ~(uint64_t{1} << index);
+        while (t != nullptr) {
+          T* next = t->next;
+          --size_;
+          on_expired(t);
+          t = next;
+        }
+      }
+      current_ = std::max(current_ + 1, std::min(NextEventTick(), now + 1));
+      Cascade();
+    }
+    if (size_ == 0) current_ = std::max(current_, now + 1);
+  }
+
+  // Removes every entry, calling f(T*) for each of them.
+  template <typename F>
+  void Clear(F f) {
+    for (T*& head : heads_) {
+      T* t = head;
+      head = nullptr;
+      while (t != nullptr) {
+        T* next = t->next;
+        f(t);
+        t = next;
+      }
+    }
+    for (uint64_t& bits : occupied_) bits = 0;
+    size_ = 0;
+  }
+
+ private:
+  static constexpr int64_t kSlotMask = kSlotsPerLevel - 1;
+  static constexpr size_t kOverflowSlot = kLevels * kSlotsPerLevel;
+
+  void File(T* t) {
+    const int64_t deadline = std::max(t->deadline, current_);
+    size_t slot = kOverflowSlot;
+    for (int level = 0; level < kLevels; ++level) {
+      const int shift = kBitsPerLevel * (level + 1);
+      if ((deadline >> shift) == (current_ >> shift)) {
+        slot = level * kSlotsPerLevel +
+               static_cast<size_t>((deadline >> (shift - kBitsPerLevel)) &
+                                   kSlotMask);
+        break;
+      }
+    }
+    t->heap_index = static_cast<decltype(t->heap_index)>(slot);
+    t->prev = nullptr;
+    t->next = heads_[slot];
+    if (t->next != nullptr) t->next->prev = t;
+    heads_[slot] = t;
+    if (slot != kOverflowSlot) {
+      occupied_[slot / kSlotsPerLevel] |= uint64_t{1}
+                                          << (slot % kSlotsPerLevel);
+    }
+  }
+
+  void Unlink(T* t) {
+    const size_t slot = static_cast<size_t>(t->heap_index);
+    if (t->prev != nullptr) {
+      t->prev->next = t->next;
+    } else {
+      heads_[slot] = t->next;
+    }
+    if (t->next != nullptr) t->next->prev = t->prev;
+    if (heads_[slot] == nullptr && slot != kOverflowSlot) {
+      occupied_[slot / kSlotsPerLevel] &= ~(uint64_t{1}
+                                            << (slot % kSlotsPerLevel));
+    }
+  }
+
+  // Moves every entry in `slot` to wherever it belongs now.
+  void Refile(size_t slot) {
+    T* t = heads_[slot];
+    heads_[slot] = nullptr;
+    if (slot != kOverflowSlot) {
+      occupied_[slot / kSlotsPerLevel] &= ~(uint64_t{1}
+                                            << (slot % kSlotsPerLevel));
+    }
+    while (t != nullptr) {
+      T* next = t->next;
+      File(t);
+      t = next;
+    }
+  }
+
+  // Called whenever current_ moves: pulls down the higher level slots (and
+  // the overflow list) whose range current_ has just entered.
+  void Cascade() {
+    if (current_ % kSpan == 0) Refile(kOverflowSlot);
+    for (int level = kLevels - 1; level > 0; --level) {
+      const int shift = kBitsPerLevel * level;
+      if ((current_ & ((int64_t{1} << shift) - 1)) != 0) continue;
+      Refile(level * kSlotsPerLevel +
+             static_cast<size_t>((current_ >> shift) & kSlotMask));
+    }
+  }
+
+  T* heads_[kOverflowSlot + 1] = {};
+  uint64_t occupied_[kLevels] = {};
+  int64_t current_;
+  size_t size_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_TIMING_WHEEL_H
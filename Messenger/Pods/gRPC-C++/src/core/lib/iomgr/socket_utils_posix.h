@@ -49,12 +49,14 @@ struct PosixTcpOptions {
   static constexpr int kMaxChunkSize = 32 * 1024 * 1024;
   static constexpr int kDefaultMaxSends = 4;
   static constexpr size_t kDefaultSendBytesThreshold = 16 * 1024;
+  static constexpr int kMaxRxBufferPoolSize = 64;
   int tcp_read_chunk_size = kDefaultReadChunkSize;
   int tcp_min_read_chunk_size = kDefaultMinReadChunksize;
   int tcp_max_read_chunk_size = kDefaultMaxReadChunksize;
   int tcp_tx_zerocopy_send_bytes_threshold = kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simultaneous_sends = kDefaultMaxSends;
   bool tcp_tx_zero_copy_enabled = kZerocpTxEnabledDefault;
+  int tcp_rx_buffer_pool_size = 0;
   int keep_alive_time_ms = 0;
   int keep_alive_timeout_ms = 0;
   bool expand_wildcard_addrs = false;
@@ -119,6 +121,7 @@ struct PosixTcpOptions {
     tcp_tx_zerocopy_max_simultaneous_sends =
         other.tcp_tx_zerocopy_max_simultaneous_sends;
     tcp_tx_zero_copy_enabled = other.tcp_tx_zero_copy_enabled;
+    tcp_rx_buffer_pool_size = other.tcp_rx_buffer_pool_size;
     keep_alive_time_ms = other.keep_alive_time_ms;
     keep_alive_timeout_ms = other.keep_alive_timeout_ms;
     expand_wildcard_addrs = other.expand_wildcard_addrs;
@@ -156,6 +159,10 @@ grpc_error_handle grpc_set_socket_low_latency(int fd, int low_latency);
 /* set SO_REUSEPORT */
 grpc_error_handle grpc_set_socket_reuse_port(int fd, int reuse);
 
+/* set SO_INCOMING_CPU, which SO_REUSEPORT groups use to prefer the listening
+   socket tied to the CPU that received a connection */
+grpc_error_handle grpc_set_socket_incoming_cpu(int fd, int cpu);
+
 /* Configure the default values for TCP_USER_TIMEOUT */
 void config_default_tcp_user_timeout(bool enable, int timeout, bool is_client);
 
@@ -188,6 +195,9 @@ grpc_error_handle grpc_set_socket_ipv6_recvpktinfo_if_possible(int fd);
 /* Tries to set the socket's send buffer to given size. */
 grpc_error_handle grpc_set_socket_sndbuf(int fd, int buffer_size_bytes);
 
+/* Reads the size of the socket's send buffer, as reported by the kernel. */
+grpc_error_handle grpc_get_socket_sndbuf(int fd, int* buffer_size_bytes);
+
 /* Tries to set the socket's receive buffer to given size. */
 grpc_error_handle grpc_set_socket_rcvbuf(int fd, int buffer_size_bytes);
 
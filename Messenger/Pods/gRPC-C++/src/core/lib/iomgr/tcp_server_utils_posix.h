@@ -21,6 +21,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
@@ -38,6 +39,15 @@ typedef struct grpc_tcp_listener {
   unsigned fd_index;
   grpc_closure read_closure;
   grpc_closure destroyed_closure;
+  /* With the io_uring engine, accept itself is submitted to the ring and
+     on_read starts with its result: the connection and its address. */
+  grpc_io_uring_op accept_op;
+  grpc_resolved_address accept_addr;
+  /* the only pollset polling this listener, which connections it accepts are
+     then also assigned to; NULL if several pollsets poll it */
+  grpc_pollset* pollset;
+  /* number of connections accepted on this listener */
+  gpr_atm accepted_connections;
   struct grpc_tcp_listener* next;
   /* sibling is a linked list of all listeners for a given port. add_port and
      clone_port place all new listeners in the same sibling list. A member of
@@ -71,6 +81,10 @@ struct grpc_tcp_server {
   bool so_reuseport = false;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs = false;
+  /* SO_REUSEPORT listeners per port, or 0 for one per pollset */
+  int listener_shards = 0;
+  /* tie each listener shard to a CPU with SO_INCOMING_CPU */
+  bool listener_cpu_affinity = false;
 
   /* linked list of server ports */
   grpc_tcp_listener* head = nullptr;
@@ -19,14 +19,10 @@
 
 #include <stddef.h>
 
-#include <memory>
-#include <string>
-#include <vector>
-
 #include "src/core/lib/security/authorization/authorization_engine.h"
 #include "src/core/lib/security/authorization/evaluate_args.h"
-#include "src/core/lib/security/authorization/matchers.h"
 #include "src/core/lib/security/authorization/rbac_policy.h"
+#include "src/core/lib/security/authorization/rbac_policy_compiler.h"
 
 namespace grpc_core {
 
@@ -49,19 +45,15 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
   Rbac::Action action() const { return action_; }
 
   // Required only for testing purpose.
-  size_t num_policies() const { return policies_.size(); }
+  size_t num_policies() const { return policies_.num_policies(); }
 
   // Evaluates incoming request against RBAC policy and makes a decision to
   // whether allow/deny this request.
   Decision Evaluate(const EvaluateArgs& args) const override;
 
  private:
-  struct Policy {
-    std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
-  };
   Rbac::Action action_;
-  std::vector<Policy> policies_;
+  CompiledRbacPolicies policies_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,158 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_SECURITY_AUTHORIZATION_RBAC_POLICY_COMPILER_H
+#define GRPC_CORE_LIB_SECURITY_AUTHORIZATION_RBAC_POLICY_COMPILER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/security/authorization/evaluate_args.h"
+#include "src/core/lib/security/authorization/matchers.h"
+#include "src/core/lib/security/authorization/rbac_policy.h"
+
+namespace grpc_core {
+
+// A set of RBAC policies compiled into one evaluation program.
+//
+// The permission and principal trees of every policy are flattened into a
+// node array whose leaves refer to shared predicates: identical header, path
+// and IP checks that appear in several policies become a single predicate,
+// evaluated at most once per call. Request attributes (headers, path,
+// addresses) are read from EvaluateArgs once, on first use. All exact and
+// prefix path checks are answered together by a hash table and a prefix trie,
+// and all CIDR checks on one address by a table keyed on the masked address,
+// so that the per-call cost no longer grows with the number of such checks.
+//
+// Matching is lazy and short-circuits like AuthorizationMatcher, so the result
+// is the same as evaluating each policy's PolicyAuthorizationMatcher in order.
+class CompiledRbacPolicies {
+ public:
+  CompiledRbacPolicies() = default;
+  explicit CompiledRbacPolicies(std::map<std::string, Rbac::Policy> policies);
+
+  size_t num_policies() const { return policies_.size(); }
+
+  // Returns the name of the first policy, in name order, that matches the
+  // request, or nullptr if none does.
+  const std::string* FindMatchingPolicy(const EvaluateArgs& args) const;
+
+ private:
+  class Compiler;
+  class Evaluation;
+
+  struct Node {
+    enum class Type { kAnd, kOr, kNot, kAny, kPredicate };
+    Type type;
+    // Node indexes, for kAnd, kOr and kNot.
+    std::vector<size_t> children;
+    // For kPredicate.
+    size_t predicate = 0;
+  };
+
+  // Which address an IP predicate looks at.
+  enum AddressSource {
+    kLocalAddress = 0,
+    kPeerAddress = 1,
+    kNumAddressSources,
+  };
+
+  struct Predicate {
+    enum class Type {
+      // Matched with header_matcher against header_names_[header].
+      kHeader,
+      // Path checks answered by path_table_.
+      kIndexedPath,
+      // Other path checks, matched with path_matcher.
+      kPath,
+      // Answered by cidr_tables_[address_source].
+      kIp,
+      // Anything else, delegated to an AuthorizationMatcher.
+      kMatcher,
+    };
+    Type type;
+    size_t header = 0;
+    HeaderMatcher header_matcher;
+    StringMatcher path_matcher;
+    AddressSource address_source = kLocalAddress;
+    std::unique_ptr<AuthorizationMatcher> matcher;
+  };
+
+  // Maps strings to the predicates of the keys that are prefixes of them.
+  class PrefixTrie {
+   public:
+    void Insert(absl::string_view key, size_t predicate);
+    // Appends the predicates of every key that is a prefix of \a s.
+    void FindPrefixesOf(absl::string_view s,
+                        std::vector<size_t>* predicates) const;
+    bool empty() const {
+      return root_.children.empty() && root_.predicates.empty();
+    }
+
+   private:
+    struct Node {
+      std::map<char, std::unique_ptr<Node>> children;
+      std::vector<size_t> predicates;
+    };
+    Node root_;
+  };
+
+  struct PathTable {
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact;
+    // Case-insensitive checks, keyed by the lower-cased value.
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact_ignore_case;
+    PrefixTrie prefixes;
+    PrefixTrie prefixes_ignore_case;
+    // Every kIndexedPath predicate; all are decided together.
+    std::vector<size_t> predicates;
+  };
+
+  struct CidrTable {
+    // Keyed by address family and prefix length, then by the address bytes
+    // masked to that length.
+    std::map<std::pair<int, uint32_t>,
+             absl::flat_hash_map<std::string, std::vector<size_t>>>
+        ranges;
+    // Every kIp predicate for this address; all are decided together.
+    std::vector<size_t> predicates;
+  };
+
+  struct Policy {
+    std::string name;
+    size_t permissions;
+    size_t principals;
+  };
+
+  std::vector<Node> nodes_;
+  std::vector<Predicate> predicates_;
+  std::vector<std::string> header_names_;
+  PathTable path_table_;
+  CidrTable cidr_tables_[kNumAddressSources];
+  std::vector<Policy> policies_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SECURITY_AUTHORIZATION_RBAC_POLICY_COMPILER_H
@@ -88,6 +88,9 @@ class Server : public InternallyRefCounted<Server>,
     grpc_metadata_array* initial_metadata;
     grpc_call_details* details;
     grpc_completion_queue* cq;
+    // The server completion queue to notify of the call, if not the one
+    // the allocator was registered with.
+    grpc_completion_queue* notify_cq = nullptr;
   };
 
   // An object to represent the most relevant characteristics of a
@@ -100,6 +103,9 @@ class Server : public InternallyRefCounted<Server>,
     gpr_timespec* deadline;
     grpc_byte_buffer** optional_payload;
     grpc_completion_queue* cq;
+    // The server completion queue to notify of the call, if not the one
+    // the allocator was registered with.
+    grpc_completion_queue* notify_cq = nullptr;
   };
 
   /// Interface for listeners.
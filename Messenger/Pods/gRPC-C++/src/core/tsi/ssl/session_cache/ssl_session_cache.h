@@ -21,7 +21,11 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <deque>
 #include <map>
+#include <memory>
 
 #if COCOAPODS==1
   #include <openssl_grpc/ssl.h>
@@ -46,6 +50,14 @@
 /// name. Note that servers are required to share session ticket encryption keys
 /// in order for cache to be effective.
 ///
+/// Large caches are split into shards by key, each with its own lock and LRU
+/// order, so that handshakes to different servers do not contend with each
+/// other; eviction is then LRU within a shard. Each key can hold several
+/// sessions (TLS 1.3 servers issue more than one ticket per connection), which
+/// Get() hands out in turn so that a burst of reconnects to one server does
+/// not resume every connection with the same ticket. Expired sessions are
+/// dropped instead of being offered for resumption.
+///
 /// This class is thread safe.
 
 namespace tsi {
@@ -55,13 +67,20 @@ class SslSessionLRUCache
                                   struct tsi_ssl_session_cache>,
       public grpc_core::RefCounted<SslSessionLRUCache> {
  public:
-  /// Create new LRU cache with the given capacity.
-  static grpc_core::RefCountedPtr<SslSessionLRUCache> Create(size_t capacity) {
-    return grpc_core::MakeRefCounted<SslSessionLRUCache>(capacity);
+  /// Caches of at least this many keys are sharded.
+  static constexpr size_t kMinKeysPerShard = 64;
+  static constexpr size_t kMaxShards = 16;
+
+  /// Create new LRU cache for \a capacity keys, each holding up to
+  /// \a sessions_per_key sessions.
+  static grpc_core::RefCountedPtr<SslSessionLRUCache> Create(
+      size_t capacity, size_t sessions_per_key = 1) {
+    return grpc_core::MakeRefCounted<SslSessionLRUCache>(capacity,
+                                                         sessions_per_key);
   }
 
   // Use Create function instead of using this directly.
-  explicit SslSessionLRUCache(size_t capacity);
+  SslSessionLRUCache(size_t capacity, size_t sessions_per_key);
   ~SslSessionLRUCache() override;
 
   // Not copyable nor movable.
@@ -72,30 +91,53 @@ class SslSessionLRUCache
     return GRPC_SSL_SESSION_CACHE_ARG;
   }
 
-  /// Returns current number of sessions in the cache.
+  /// Returns current number of keys in the cache.
   size_t Size();
   /// Add \a session in the cache using \a key. This operation may discard older
   /// sessions.
   void Put(const char* key, SslSessionPtr session);
-  /// Returns the session from the cache associated with \a key or null if not
-  /// found.
+  /// Returns a session from the cache associated with \a key or null if not
+  /// found. Successive calls rotate through the key's unexpired sessions.
   SslSessionPtr Get(const char* key);
 
  private:
   class Node;
 
-  Node* FindLocked(const std::string& key);
-  void Remove(Node* node);
-  void PushFront(Node* node);
-  void AssertInvariants();
-
-  grpc_core::Mutex lock_;
-  size_t capacity_;
-
-  Node* use_order_list_head_ = nullptr;
-  Node* use_order_list_tail_ = nullptr;
-  size_t use_order_list_size_ = 0;
-  std::map<std::string, Node*> entry_by_key_;
+  // One independently locked LRU list.
+  class Shard {
+   public:
+    Shard() = default;
+    ~Shard();
+
+    Shard(const Shard&) = delete;
+    Shard& operator=(const Shard&) = delete;
+
+    size_t Size();
+    void Put(const std::string& key, SslSessionPtr session, int64_t expiry,
+             size_t capacity, size_t sessions_per_key);
+    SslSessionPtr Get(const std::string& key, int64_t now);
+
+   private:
+    Node* FindLocked(const std::string& key)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+    void Remove(Node* node) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+    void PushFront(Node* node) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+    void AssertInvariants() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+    grpc_core::Mutex lock_;
+    Node* use_order_list_head_ ABSL_GUARDED_BY(lock_) = nullptr;
+    Node* use_order_list_tail_ ABSL_GUARDED_BY(lock_) = nullptr;
+    size_t use_order_list_size_ ABSL_GUARDED_BY(lock_) = 0;
+    std::map<std::string, Node*> entry_by_key_ ABSL_GUARDED_BY(lock_);
+  };
+
+  Shard& ShardFor(const std::string& key);
+
+  const size_t num_shards_;
+  // Keys per shard.
+  const size_t shard_capacity_;
+  const size_t sessions_per_key_;
+  std::unique_ptr<Shard[]> shards_;
 };
 
 }  // namespace tsi
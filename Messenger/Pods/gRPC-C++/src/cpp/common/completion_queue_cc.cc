@@ -15,6 +15,7 @@
  *
  */
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
@@ -167,6 +168,42 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+CompletionQueue::NextStatus CompletionQueue::NextBatchInternal(
+    void** tags, bool* oks, size_t max_events, gpr_timespec deadline,
+    size_t* num_events) {
+  // Events read from the core queue per call, bounding the stack array below.
+  constexpr size_t kMaxCoreBatch = 32;
+  grpc_event events[kMaxCoreBatch];
+  *num_events = 0;
+  if (max_events == 0) return GOT_EVENT;
+  for (;;) {
+    int n = grpc_completion_queue_next_batch(
+        cq_, events, static_cast<int>(std::min(max_events, kMaxCoreBatch)),
+        deadline, nullptr);
+    for (int i = 0; i < n; i++) {
+      switch (events[i].type) {
+        case GRPC_QUEUE_TIMEOUT:
+          return TIMEOUT;
+        case GRPC_QUEUE_SHUTDOWN:
+          return SHUTDOWN;
+        case GRPC_OP_COMPLETE:
+          auto core_cq_tag =
+              static_cast<grpc::internal::CompletionQueueTag*>(events[i].tag);
+          void** tag = &tags[*num_events];
+          bool* ok = &oks[*num_events];
+          *ok = events[i].success != 0;
+          *tag = core_cq_tag;
+          if (core_cq_tag->FinalizeResult(tag, ok)) {
+            ++*num_events;
+          }
+          break;
+      }
+    }
+    // Keep going only if every event was swallowed by its tag.
+    if (*num_events > 0) return GOT_EVENT;
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
@@ -0,0 +1,127 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpcpp/ext/method_stats.h>
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/ext/filters/method_stats/method_stats.h"
+
+namespace grpc {
+namespace experimental {
+
+namespace {
+
+MethodStatsHistogram ConvertHistogram(
+    const grpc_core::HistogramSnapshot& snapshot) {
+  MethodStatsHistogram histogram;
+  histogram.count = snapshot.count;
+  histogram.sum = snapshot.sum;
+  for (size_t i = 0; i < snapshot.buckets.size(); ++i) {
+    if (snapshot.buckets[i] == 0) continue;
+    histogram.buckets.push_back(
+        {grpc_core::MethodStatsHistogram::BucketLowerBound(i),
+         grpc_core::MethodStatsHistogram::BucketUpperBound(i),
+         snapshot.buckets[i]});
+  }
+  return histogram;
+}
+
+std::vector<MethodStats> Collect(bool reset) {
+  std::vector<MethodStats> result;
+  for (const grpc_core::MethodStatsSnapshot& snapshot :
+       grpc_core::MethodStatsRegistry::Collect(reset)) {
+    MethodStats stats;
+    stats.method = snapshot.method;
+    stats.calls = snapshot.calls;
+    stats.failed_calls = snapshot.failed_calls;
+    stats.latency_us = ConvertHistogram(snapshot.latency_us);
+    stats.sent_message_bytes = ConvertHistogram(snapshot.sent_message_bytes);
+    stats.received_message_bytes =
+        ConvertHistogram(snapshot.received_message_bytes);
+    stats.retries = ConvertHistogram(snapshot.retries);
+    stats.tcp_queue_delay_us = ConvertHistogram(snapshot.tcp_queue_delay_us);
+    stats.tcp_kernel_delay_us = ConvertHistogram(snapshot.tcp_kernel_delay_us);
+    stats.tcp_network_delay_us =
+        ConvertHistogram(snapshot.tcp_network_delay_us);
+    result.push_back(std::move(stats));
+  }
+  return result;
+}
+
+// "p50/p99" of \a histogram, or "-" if it is empty.
+std::string FormatPercentiles(const MethodStatsHistogram& histogram) {
+  if (histogram.count == 0) return "-";
+  return absl::StrFormat("%.0f/%.0f", histogram.Percentile(50),
+                         histogram.Percentile(99));
+}
+
+}  // namespace
+
+double MethodStatsHistogram::Percentile(double percentile) const {
+  if (count == 0) return 0;
+  const double rank = std::max(1.0, percentile / 100.0 * count);
+  uint64_t seen = 0;
+  for (const Bucket& bucket : buckets) {
+    seen += bucket.count;
+    if (seen >= rank) {
+      return bucket.lower_bound +
+             (bucket.upper_bound - bucket.lower_bound) / 2.0;
+    }
+  }
+  return buckets.back().lower_bound;
+}
+
+void EnableMethodStats(ChannelArguments* args) {
+  args->SetInt(GRPC_ARG_ENABLE_METHOD_STATS, 1);
+}
+
+void EnableTcpWriteTimestamps(ChannelArguments* args, int sample_period) {
+  args->SetInt(GRPC_ARG_TCP_WRITE_TIMESTAMPS_SAMPLE_PERIOD, sample_period);
+}
+
+std::vector<MethodStats> GetMethodStats() { return Collect(false); }
+
+std::vector<MethodStats> GetAndResetMethodStats() { return Collect(true); }
+
+std::string FormatLatencyBreakdown(const std::vector<MethodStats>& stats) {
+  constexpr char kRowFormat[] = "%-40s %8s %8s %14s %14s %14s %14s\n";
+  std::string out = absl::StrFormat(kRowFormat, "method (p50/p99 us)", "calls",
+                                    "writes", "latency", "queue", "kernel",
+                                    "network");
+  for (const MethodStats& s : stats) {
+    absl::StrAppend(
+        &out, absl::StrFormat(kRowFormat, s.method, absl::StrCat(s.calls),
+                              absl::StrCat(s.tcp_kernel_delay_us.count),
+                              FormatPercentiles(s.latency_us),
+                              FormatPercentiles(s.tcp_queue_delay_us),
+                              FormatPercentiles(s.tcp_kernel_delay_us),
+                              FormatPercentiles(s.tcp_network_delay_us)));
+  }
+  return out;
+}
+
+}  // namespace experimental
+}  // namespace grpc
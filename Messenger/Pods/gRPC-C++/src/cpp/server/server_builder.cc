@@ -30,6 +30,7 @@
 #include <grpc/grpc.h>
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/workaround_list.h>
@@ -181,6 +182,9 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case WORK_STEALING_THREADS:
+      sync_server_settings_.work_stealing_threads = val;
+      break;
   }
   return *this;
 }
@@ -329,6 +333,16 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
 
   const bool is_hybrid_server = has_sync_methods && has_frequently_polled_cqs;
 
+  // The work-stealing pool polls one completion queue per thread.
+  const bool sync_work_stealing =
+      has_sync_methods && sync_server_settings_.work_stealing_threads != 0;
+  if (sync_work_stealing) {
+    sync_server_settings_.num_cqs =
+        sync_server_settings_.work_stealing_threads > 0
+            ? sync_server_settings_.work_stealing_threads
+            : static_cast<int>(gpr_cpu_num_cores());
+  }
+
   if (has_sync_methods) {
     grpc_cq_polling_type polling_type =
         is_hybrid_server ? GRPC_CQ_NON_POLLING : GRPC_CQ_DEFAULT_POLLING;
@@ -343,7 +357,13 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
   // TODO(vjpai): Add a section here for plugins once they can support callback
   // methods
 
-  if (has_sync_methods) {
+  if (sync_work_stealing) {
+    gpr_log(GPR_INFO,
+            "Synchronous server. Work-stealing threads: %d, CQ timeout "
+            "(msec): %d",
+            sync_server_settings_.num_cqs,
+            sync_server_settings_.cq_timeout_msec);
+  } else if (has_sync_methods) {
     // This is a Sync server
     gpr_log(GPR_INFO,
             "Synchronous server. Num CQs: %d, Min pollers: %d, Max Pollers: "
@@ -368,7 +388,7 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
       &args, sync_server_cqs, sync_server_settings_.min_pollers,
       sync_server_settings_.max_pollers, sync_server_settings_.cq_timeout_msec,
       std::move(acceptors_), server_config_fetcher_, resource_quota_,
-      std::move(creators)));
+      std::move(creators), sync_work_stealing));
 
   ServerInitializer* initializer = server->initializer();
 
@@ -80,6 +80,7 @@
 #include "src/cpp/server/external_connection_acceptor_impl.h"
 #include "src/cpp/server/health/default_health_check_service.h"
 #include "src/cpp/thread_manager/thread_manager.h"
+#include "src/cpp/thread_manager/work_stealing_thread_manager.h"
 
 namespace grpc {
 namespace {
@@ -862,6 +863,8 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
     }
   }
 
+  bool has_sync_method() const { return has_sync_method_; }
+
  private:
   Server* server_;
   grpc::CompletionQueue* server_cq_;
@@ -871,6 +874,146 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
   std::shared_ptr<Server::GlobalCallbacks> global_callbacks_;
 };
 
+// Implementation of WorkStealingThreadManager. Worker i polls only the i-th
+// sync server CQ. Each sync method is registered once, and every new call is
+// sent to the CQ of an idle worker if there is one, or else to the CQs in
+// turn, so that no CQ starves while its worker is stuck in a handler. The
+// SyncRequestThreadManagers still own the final drain of their CQs; they just
+// never start threads of their own when this manager is in use.
+class Server::SyncRequestWorkStealingManager
+    : public grpc::WorkStealingThreadManager {
+ public:
+  SyncRequestWorkStealingManager(
+      Server* server, std::vector<grpc::CompletionQueue*> server_cqs,
+      std::shared_ptr<GlobalCallbacks> global_callbacks,
+      grpc_resource_quota* rq, int cq_timeout_msec)
+      : WorkStealingThreadManager("SyncServer", rq,
+                                  static_cast<int>(server_cqs.size())),
+        server_(server),
+        server_cqs_(std::move(server_cqs)),
+        cq_timeout_msec_(cq_timeout_msec),
+        global_callbacks_(std::move(global_callbacks)),
+        kick_tags_(server_cqs_.size()) {}
+
+  WorkStatus PollForWork(int index, bool block, void** tag,
+                         bool* ok) override {
+    *tag = nullptr;
+    gpr_timespec deadline =
+        block ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                             gpr_time_from_millis(cq_timeout_msec_,
+                                                  GPR_TIMESPAN))
+              : gpr_time_0(GPR_CLOCK_MONOTONIC);
+
+    switch (server_cqs_[index]->AsyncNext(tag, ok, deadline)) {
+      case grpc::CompletionQueue::TIMEOUT:
+        return TIMEOUT;
+      case grpc::CompletionQueue::SHUTDOWN:
+        return SHUTDOWN;
+      case grpc::CompletionQueue::GOT_EVENT:
+        // A kick only interrupts the poll so that the worker can steal.
+        if (*tag == static_cast<grpc::internal::CompletionQueueTag*>(
+                        &kick_tags_[index])) {
+          return TIMEOUT;
+        }
+        return WORK_FOUND;
+    }
+
+    GPR_UNREACHABLE_CODE(return TIMEOUT);
+  }
+
+  void DoWork(void* tag, bool ok) override {
+    (void)ok;
+    SyncRequest* sync_req = static_cast<SyncRequest*>(tag);
+    GPR_DEBUG_ASSERT(sync_req != nullptr);
+    GPR_DEBUG_ASSERT(ok);
+    // The pool's threads were all reserved up front, so there is never a
+    // shortage of threads to report here.
+    sync_req->Run(global_callbacks_, true);
+  }
+
+  void Kick(int index) override {
+    KickTag* kick = &kick_tags_[index];
+    if (kick->pending.exchange(true, std::memory_order_acq_rel)) return;
+    grpc_completion_queue* cq = server_cqs_[index]->cq();
+    grpc_core::ExecCtx exec_ctx;
+    if (!grpc_cq_begin_op(cq, kick)) {
+      // The CQ is shutting down; the worker will see that on its own.
+      kick->pending.store(false, std::memory_order_release);
+      return;
+    }
+    grpc_cq_end_op(
+        cq, kick, GRPC_ERROR_NONE,
+        [](void* arg, grpc_cq_completion* /*completion*/) {
+          static_cast<KickTag*>(arg)->pending.store(false,
+                                                    std::memory_order_release);
+        },
+        kick, &kick->completion);
+  }
+
+  void AddSyncMethod(grpc::internal::RpcServiceMethod* method, void* tag) {
+    grpc_core::Server::FromC(server_->server())
+        ->SetRegisteredMethodAllocator(
+            server_cqs_[0]->cq(), tag, [this, method] {
+              grpc_core::Server::RegisteredCallAllocation result;
+              new SyncRequest(server_, method, &result);
+              result.notify_cq = PickCq();
+              return result;
+            });
+    has_sync_method_ = true;
+  }
+
+  void AddUnknownSyncMethod() {
+    if (has_sync_method_) {
+      unknown_method_ = absl::make_unique<grpc::internal::RpcServiceMethod>(
+          "unknown", grpc::internal::RpcMethod::BIDI_STREAMING,
+          new grpc::internal::UnknownMethodHandler(kUnknownRpcMethod));
+      grpc_core::Server::FromC(server_->server())
+          ->SetBatchMethodAllocator(server_cqs_[0]->cq(), [this] {
+            grpc_core::Server::BatchCallAllocation result;
+            new SyncRequest(server_, unknown_method_.get(), &result);
+            result.notify_cq = PickCq();
+            return result;
+          });
+    }
+  }
+
+  bool has_sync_method() const { return has_sync_method_; }
+
+ private:
+  // Picks the CQ to notify of a new call: the first idle worker's, starting
+  // from the next one in turn, or just the next one in turn if all are busy.
+  grpc_completion_queue* PickCq() {
+    const size_t n = server_cqs_.size();
+    const size_t start = next_cq_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < n; i++) {
+      const size_t idx = (start + i) % n;
+      if (IsSleeping(static_cast<int>(idx))) return server_cqs_[idx]->cq();
+    }
+    return server_cqs_[start % n]->cq();
+  }
+
+  // Posted to a worker's CQ to wake it from AsyncNext(). At most one is
+  // outstanding per CQ.
+  class KickTag final : public grpc::internal::CompletionQueueTag {
+   public:
+    bool FinalizeResult(void** /*tag*/, bool* /*status*/) override {
+      return true;
+    }
+
+    std::atomic<bool> pending{false};
+    grpc_cq_completion completion;
+  };
+
+  Server* server_;
+  std::vector<grpc::CompletionQueue*> server_cqs_;
+  int cq_timeout_msec_;
+  std::shared_ptr<Server::GlobalCallbacks> global_callbacks_;
+  std::vector<KickTag> kick_tags_;
+  std::atomic<size_t> next_cq_{0};
+  bool has_sync_method_ = false;
+  std::unique_ptr<grpc::internal::RpcServiceMethod> unknown_method_;
+};
+
 static grpc::internal::GrpcLibraryInitializer g_gli_initializer;
 Server::Server(
     grpc::ChannelArguments* args,
@@ -883,7 +1026,8 @@ Server::Server(
     grpc_resource_quota* server_rq,
     std::vector<
         std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>>
-        interceptor_creators)
+        interceptor_creators,
+    bool sync_work_stealing)
     : acceptors_(std::move(acceptors)),
       interceptor_creators_(std::move(interceptor_creators)),
       max_receive_message_size_(INT_MIN),
@@ -914,6 +1058,17 @@ Server::Server(
           max_pollers, sync_cq_timeout_msec));
     }
 
+    if (sync_work_stealing && !sync_server_cqs_->empty()) {
+      std::vector<grpc::CompletionQueue*> cqs;
+      cqs.reserve(sync_server_cqs_->size());
+      for (const auto& it : *sync_server_cqs_) {
+        cqs.push_back(it.get());
+      }
+      sync_ws_mgr_ = absl::make_unique<SyncRequestWorkStealingManager>(
+          this, std::move(cqs), global_callbacks_, server_rq,
+          sync_cq_timeout_msec);
+    }
+
     if (default_rq_created) {
       grpc_resource_quota_unref(server_rq);
     }
@@ -1007,6 +1162,19 @@ Server::experimental_type::InProcessChannelWithInterceptors(
       std::move(interceptor_creators));
 }
 
+Server::SyncThreadPoolStats
+Server::experimental_type::GetSyncThreadPoolStats() {
+  SyncThreadPoolStats stats;
+  if (server_->sync_ws_mgr_ == nullptr) return stats;
+  grpc::WorkStealingThreadManager::Stats pool_stats =
+      server_->sync_ws_mgr_->GetStats();
+  stats.queue_depth = pool_stats.queue_depth;
+  stats.max_queue_depth = pool_stats.max_queue_depth;
+  stats.steals = pool_stats.steals;
+  stats.completed = pool_stats.completed;
+  return stats;
+}
+
 static grpc_server_register_method_payload_handling PayloadHandlingForMethod(
     grpc::internal::RpcServiceMethod* method) {
   switch (method->method_type()) {
@@ -1048,8 +1216,12 @@ bool Server::RegisterService(const std::string* addr, grpc::Service* service) {
       method->set_server_tag(method_registration_tag);
     } else if (method->api_type() ==
                grpc::internal::RpcServiceMethod::ApiType::SYNC) {
-      for (const auto& value : sync_req_mgrs_) {
-        value->AddSyncMethod(method.get(), method_registration_tag);
+      if (sync_ws_mgr_ != nullptr) {
+        sync_ws_mgr_->AddSyncMethod(method.get(), method_registration_tag);
+      } else {
+        for (const auto& value : sync_req_mgrs_) {
+          value->AddSyncMethod(method.get(), method_registration_tag);
+        }
       }
     } else {
       has_callback_methods_ = true;
@@ -1186,7 +1358,10 @@ void Server::Start(grpc::ServerCompletionQueue** cqs, size_t num_cqs) {
     RegisterCallbackGenericService(unimplemented_service_.get());
     unknown_rpc_needed = false;
   }
-  if (unknown_rpc_needed && !sync_req_mgrs_.empty()) {
+  if (unknown_rpc_needed && sync_ws_mgr_ != nullptr) {
+    sync_ws_mgr_->AddUnknownSyncMethod();
+    unknown_rpc_needed = false;
+  } else if (unknown_rpc_needed && !sync_req_mgrs_.empty()) {
     sync_req_mgrs_[0]->AddUnknownSyncMethod();
     unknown_rpc_needed = false;
   }
@@ -1211,8 +1386,12 @@ void Server::Start(grpc::ServerCompletionQueue** cqs, size_t num_cqs) {
             kServerThreadpoolExhausted);
   }
 
-  for (const auto& value : sync_req_mgrs_) {
-    value->Start();
+  if (sync_ws_mgr_ != nullptr) {
+    if (sync_ws_mgr_->has_sync_method()) sync_ws_mgr_->Initialize();
+  } else {
+    for (const auto& value : sync_req_mgrs_) {
+      value->Start();
+    }
   }
 
   for (auto& acceptor : acceptors_) {
@@ -1261,6 +1440,13 @@ void Server::ShutdownInternal(gpr_timespec deadline) {
     value->Shutdown();  // ThreadManager's Shutdown()
   }
 
+  // The work-stealing workers exit once their (now shut down) CQs are empty.
+  // Wait for them before the ThreadManagers drain whatever is left.
+  if (sync_ws_mgr_ != nullptr) {
+    sync_ws_mgr_->Shutdown();
+    sync_ws_mgr_->Wait();
+  }
+
   // Wait for threads in all ThreadManagers to terminate
   for (const auto& value : sync_req_mgrs_) {
     value->Wait();
@@ -0,0 +1,229 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/thread_manager/work_stealing_thread_manager.h"
+
+#include <stdlib.h>
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/resource_quota/resource_quota.h"
+
+namespace grpc {
+
+namespace {
+
+// Upper bound on the number of ready items a worker pulls out of its source
+// after a successful poll. Anything beyond this stays in the source.
+constexpr int kMaxDrainPerPoll = 16;
+
+}  // namespace
+
+WorkStealingThreadManager::WorkStealingThreadManager(
+    const char*, grpc_resource_quota* resource_quota, int num_threads)
+    : num_threads_(num_threads > 0 ? num_threads : 1),
+      thread_quota_(
+          grpc_core::ResourceQuota::FromC(resource_quota)->thread_quota()) {
+  workers_.reserve(num_threads_);
+  for (int i = 0; i < num_threads_; i++) {
+    workers_.push_back(absl::make_unique<Worker>());
+  }
+}
+
+WorkStealingThreadManager::~WorkStealingThreadManager() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    GPR_ASSERT(num_running_ == 0);
+  }
+  // Threads only exist once Initialize() has reserved them.
+  if (!reserved_) return;
+  for (auto& worker : workers_) {
+    worker->thd.Join();
+  }
+  thread_quota_->Release(num_threads_);
+}
+
+void WorkStealingThreadManager::Initialize() {
+  if (!thread_quota_->Reserve(num_threads_)) {
+    gpr_log(GPR_ERROR,
+            "No thread quota available to create the work-stealing pool "
+            "threads (i.e %d). Unable to start the thread manager",
+            num_threads_);
+    abort();
+  }
+  reserved_ = true;
+
+  {
+    grpc_core::MutexLock lock(&mu_);
+    num_running_ = num_threads_;
+  }
+
+  for (int i = 0; i < num_threads_; i++) {
+    struct Arg {
+      WorkStealingThreadManager* mgr;
+      int index;
+    };
+    bool created;
+    workers_[i]->thd = grpc_core::Thread(
+        "grpcpp_sync_server",
+        [](void* arg) {
+          std::unique_ptr<Arg> a(static_cast<Arg*>(arg));
+          a->mgr->WorkLoop(a->index);
+          a->mgr->MarkAsCompleted();
+        },
+        new Arg{this, i}, &created);
+    GPR_ASSERT(created);  // A fixed pool must get all of its threads
+    workers_[i]->thd.Start();
+  }
+}
+
+void WorkStealingThreadManager::Shutdown() {
+  grpc_core::MutexLock lock(&mu_);
+  shutdown_ = true;
+}
+
+bool WorkStealingThreadManager::IsShutdown() {
+  grpc_core::MutexLock lock(&mu_);
+  return shutdown_;
+}
+
+void WorkStealingThreadManager::Wait() {
+  grpc_core::MutexLock lock(&mu_);
+  while (num_running_ != 0) {
+    shutdown_cv_.Wait(&mu_);
+  }
+}
+
+void WorkStealingThreadManager::MarkAsCompleted() {
+  grpc_core::MutexLock lock(&mu_);
+  if (--num_running_ == 0) shutdown_cv_.Signal();
+}
+
+WorkStealingThreadManager::Stats WorkStealingThreadManager::GetStats() const {
+  Stats stats;
+  stats.queue_depth = queued_.load(std::memory_order_relaxed);
+  stats.max_queue_depth = max_queued_.load(std::memory_order_relaxed);
+  stats.steals = steals_.load(std::memory_order_relaxed);
+  stats.completed = completed_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void WorkStealingThreadManager::WorkLoop(int index) {
+  Worker* self = workers_[index].get();
+  while (true) {
+    WorkItem item;
+    if (PopLocal(index, &item) || Steal(index, &item)) {
+      Run(item);
+      continue;
+    }
+
+    // Nothing to run. Only block in the source if nobody else has queued
+    // work: announce that we may sleep first, then look again, so that a
+    // concurrent Push() either sees us sleeping and kicks us or its item is
+    // visible here.
+    self->sleeping.store(true, std::memory_order_seq_cst);
+    bool block = queued_.load(std::memory_order_seq_cst) == 0;
+    void* tag;
+    bool ok;
+    WorkStatus status = PollForWork(index, block, &tag, &ok);
+    self->sleeping.store(false, std::memory_order_relaxed);
+
+    switch (status) {
+      case SHUTDOWN:
+        // The source is drained and only this worker ever pushes to its own
+        // queue, which PopLocal() just found empty.
+        return;
+      case TIMEOUT:
+        break;
+      case WORK_FOUND: {
+        Push(index, {tag, ok});
+        int drained = 0;
+        while (drained < kMaxDrainPerPoll &&
+               PollForWork(index, false, &tag, &ok) == WORK_FOUND) {
+          Push(index, {tag, ok});
+          drained++;
+        }
+        // This worker runs one item itself; offer the rest to idle peers.
+        WakeSleepingWorkers(index, drained);
+        break;
+      }
+    }
+  }
+}
+
+void WorkStealingThreadManager::Push(int index, WorkItem item) {
+  {
+    Worker* worker = workers_[index].get();
+    grpc_core::MutexLock lock(&worker->mu);
+    worker->queue.push_back(item);
+  }
+  int64_t depth = queued_.fetch_add(1, std::memory_order_seq_cst) + 1;
+  int64_t max_depth = max_queued_.load(std::memory_order_relaxed);
+  while (depth > max_depth &&
+         !max_queued_.compare_exchange_weak(max_depth, depth,
+                                            std::memory_order_relaxed)) {
+  }
+}
+
+bool WorkStealingThreadManager::PopLocal(int index, WorkItem* item) {
+  Worker* worker = workers_[index].get();
+  grpc_core::MutexLock lock(&worker->mu);
+  if (worker->queue.empty()) return false;
+  *item = worker->queue.front();
+  worker->queue.pop_front();
+  queued_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool WorkStealingThreadManager::Steal(int index, WorkItem* item) {
+  if (queued_.load(std::memory_order_relaxed) == 0) return false;
+  for (int i = 1; i < num_threads_; i++) {
+    Worker* victim = workers_[(index + i) % num_threads_].get();
+    grpc_core::MutexLock lock(&victim->mu);
+    if (victim->queue.empty()) continue;
+    // The owner takes from the front; take the most recent arrival so that
+    // the two ends rarely meet.
+    *item = victim->queue.back();
+    victim->queue.pop_back();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    steals_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+void WorkStealingThreadManager::Run(const WorkItem& item) {
+  DoWork(item.tag, item.ok);
+  completed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void WorkStealingThreadManager::WakeSleepingWorkers(int index, int count) {
+  for (int i = 1; i < num_threads_ && count > 0; i++) {
+    int peer = (index + i) % num_threads_;
+    if (workers_[peer]->sleeping.load(std::memory_order_seq_cst)) {
+      Kick(peer);
+      count--;
+    }
+  }
+}
+
+}  // namespace grpc
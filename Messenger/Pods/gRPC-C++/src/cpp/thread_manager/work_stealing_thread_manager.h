@@ -0,0 +1,143 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_MANAGER_H
+#define GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_MANAGER_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/resource_quota/api.h"
+#include "src/core/lib/resource_quota/thread_quota.h"
+
+namespace grpc {
+
+// A fixed-size alternative to ThreadManager. Each of the num_threads workers
+// owns one work source (a completion queue, for the sync server) and polls
+// only that source, so there is no shared lock on the polling path and no
+// thread is ever created or retired after Initialize().
+//
+// When a poll finds work, the worker also drains whatever else is already
+// ready in its source into a local queue and wakes sleeping workers. Workers
+// whose own source is empty steal from the other workers' queues before they
+// go back to polling, so one slow handler does not hold up the requests that
+// arrived behind it.
+class WorkStealingThreadManager {
+ public:
+  WorkStealingThreadManager(const char* name,
+                            grpc_resource_quota* resource_quota,
+                            int num_threads);
+  virtual ~WorkStealingThreadManager();
+
+  // Reserves the threads from the resource quota and starts them.
+  void Initialize();
+
+  enum WorkStatus { WORK_FOUND, SHUTDOWN, TIMEOUT };
+
+  // Polls the source owned by worker 'index'. If 'block' is false the call
+  // must not wait for new work and returns TIMEOUT when nothing is ready.
+  // Once the source returns SHUTDOWN the worker exits. A Kick() of this worker
+  // should make a blocked call return TIMEOUT.
+  virtual WorkStatus PollForWork(int index, bool block, void** tag,
+                                 bool* ok) = 0;
+
+  // Performs the work found by PollForWork(). May run on any worker.
+  virtual void DoWork(void* tag, bool ok) = 0;
+
+  // Wakes worker 'index' from a blocking PollForWork() so that it can steal
+  // queued work. Kicks may be coalesced.
+  virtual void Kick(int index) = 0;
+
+  // Mark the manager as shutdown. Workers keep running until their source
+  // reports SHUTDOWN and their local queue is empty.
+  virtual void Shutdown();
+
+  bool IsShutdown();
+
+  // Blocks until every worker has exited.
+  virtual void Wait();
+
+  int num_threads() const { return num_threads_; }
+
+  struct Stats {
+    // Work items that have been polled but have not started running yet.
+    int64_t queue_depth = 0;
+    // The largest queue_depth seen so far.
+    int64_t max_queue_depth = 0;
+    // Work items run by a worker other than the one that polled them.
+    uint64_t steals = 0;
+    // Work items run in total.
+    uint64_t completed = 0;
+  };
+  Stats GetStats() const;
+
+ protected:
+  // Whether worker 'index' is idle, waiting in PollForWork() for its source.
+  bool IsSleeping(int index) const {
+    return workers_[index]->sleeping.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct WorkItem {
+    void* tag;
+    bool ok;
+  };
+
+  struct Worker {
+    grpc_core::Mutex mu;
+    std::deque<WorkItem> queue ABSL_GUARDED_BY(mu);
+    // Set while the worker may be blocked in PollForWork().
+    std::atomic<bool> sleeping{false};
+    grpc_core::Thread thd;
+  };
+
+  void WorkLoop(int index);
+  void Push(int index, WorkItem item);
+  bool PopLocal(int index, WorkItem* item);
+  bool Steal(int index, WorkItem* item);
+  void Run(const WorkItem& item);
+  void WakeSleepingWorkers(int index, int count);
+  void MarkAsCompleted();
+
+  const int num_threads_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  grpc_core::ThreadQuotaPtr thread_quota_;
+  bool reserved_ = false;
+
+  // Protects shutdown_ and num_running_
+  grpc_core::Mutex mu_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  int num_running_ ABSL_GUARDED_BY(mu_) = 0;
+  grpc_core::CondVar shutdown_cv_;
+
+  std::atomic<int64_t> queued_{0};
+  std::atomic<int64_t> max_queued_{0};
+  std::atomic<uint64_t> steals_{0};
+  std::atomic<uint64_t> completed_{0};
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_MANAGER_H
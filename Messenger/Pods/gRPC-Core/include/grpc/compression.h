@@ -68,6 +68,15 @@ GRPCAPI void grpc_compression_options_disable_algorithm(
 GRPCAPI int grpc_compression_options_is_algorithm_enabled(
     const grpc_compression_options* opts, grpc_compression_algorithm algorithm);
 
+/** Registers \a dictionary, a zstd dictionary such as one trained with
+ * `zstd --train`, for GRPC_COMPRESS_ZSTD. Received messages are decompressed
+ * with the registered dictionary their frame names. Sent messages are
+ * compressed with the dictionary registered last, so peers must register it
+ * before it is used to send to them. Dictionaries are never unregistered.
+ * Returns 1 upon success, 0 if \a dictionary carries no dictionary id. */
+GRPCAPI int grpc_compression_register_zstd_dictionary(const void* dictionary,
+                                                      size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -134,6 +134,22 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
                                               gpr_timespec deadline,
                                               void* reserved);
 
+/** Like grpc_completion_queue_next, but returns up to \a max_events events
+    that are ready at once, storing them in \a events. Polling only happens
+    while the queue is empty.
+
+    Returns the number of events stored, which is at least 1: if no event
+    became available before the deadline or the queue's shutdown, a single
+    event with type GRPC_QUEUE_TIMEOUT or GRPC_QUEUE_SHUTDOWN is stored. A
+    \a max_events of 0 or less returns 0 without waiting.
+
+    Only valid on completion queues of type GRPC_CQ_NEXT. */
+GRPCAPI int grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                             grpc_event* events,
+                                             int max_events,
+                                             gpr_timespec deadline,
+                                             void* reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
@@ -590,6 +606,20 @@ GRPCAPI char* grpc_channelz_get_subchannel(intptr_t subchannel_id);
    is allocated and must be freed by the application. */
 GRPCAPI char* grpc_channelz_get_socket(intptr_t socket_id);
 
+/* EXPERIMENTAL: Returns the per-method latency, message size and retry
+   histograms recorded by channels created with
+   GRPC_ARG_ENABLE_METHOD_STATS, as {"methodStats": [...]}. This is not part of
+   the channelz proto. If reset is non-zero, the histograms are cleared as they
+   are read. The returned string is allocated and must be freed by the
+   application. */
+GRPCAPI char* grpc_channelz_get_method_stats(int reset);
+
+/* EXPERIMENTAL: Returns the counters of the DNS cache enabled with
+   GRPC_ARG_DNS_CACHE_TTL_MS (fresh and stale hits, misses, coalesced lookups,
+   background refreshes and failures), as {"dnsCache": {...}}. The returned
+   string is allocated and must be freed by the application. */
+GRPCAPI char* grpc_dns_cache_get_stats(void);
+
 /**
  * EXPERIMENTAL - Subject to change.
  * Fetch a vtable for grpc_channel_arg that points to
@@ -112,6 +112,14 @@ typedef struct grpc_ssl_session_cache grpc_ssl_session_cache;
 GRPCAPI grpc_ssl_session_cache* grpc_ssl_session_cache_create_lru(
     size_t capacity);
 
+/** EXPERIMENTAL. Like grpc_ssl_session_cache_create_lru(), but keeps up to
+    sessions_per_host sessions for each server name and hands them out in
+    turn. Large caches are sharded so that concurrent handshakes to different
+    servers do not contend on one lock. Meant for clients that reconnect to
+    many servers at once, e.g. after a network change. */
+GRPCAPI grpc_ssl_session_cache* grpc_ssl_session_cache_create_sharded_lru(
+    size_t capacity, size_t sessions_per_host);
+
 /** Destroy SSL session cache. */
 GRPCAPI void grpc_ssl_session_cache_destroy(grpc_ssl_session_cache* cache);
 
@@ -265,6 +265,19 @@ typedef struct {
 /** Minimum amount of time between DNS resolutions, in ms */
 #define GRPC_ARG_DNS_MIN_TIME_BETWEEN_RESOLUTIONS_MS \
   "grpc.dns_min_time_between_resolutions_ms"
+/** EXPERIMENTAL. If positive, DNS resolutions for "dns:" targets go through a
+    cache shared by all channels in the process, and an answer is reused for
+    this many ms. Concurrent resolutions of the same name share one lookup,
+    and an answer used in the last tenth of this time is refreshed in the
+    background. Neither DNS resolver sees record TTLs, so this stands in for
+    them. Defaults to 0, which disables the cache. */
+#define GRPC_ARG_DNS_CACHE_TTL_MS "grpc.experimental.dns_cache_ttl_ms"
+/** EXPERIMENTAL. How long, in ms, after GRPC_ARG_DNS_CACHE_TTL_MS a cached
+    answer may still be used while a refresh runs in the background
+    (stale-while-revalidate). A failed refresh leaves the old answer in place
+    for this long. Defaults to the TTL. */
+#define GRPC_ARG_DNS_CACHE_MAX_STALE_MS \
+  "grpc.experimental.dns_cache_max_stale_ms"
 /** The timeout used on servers for finishing handshaking on an incoming
     connection.  Defaults to 120 seconds. */
 #define GRPC_ARG_SERVER_HANDSHAKE_TIMEOUT_MS "grpc.server_handshake_timeout_ms"
@@ -288,6 +301,13 @@ typedef struct {
  *        can break old binaries that don't support larger than 1MiB frame
  *        size. */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, once the handshake is done, a security handshaker offers the
+ *  connection's socket to the TSI implementation, so that encryption of
+ *  outgoing records can move into the kernel. The SSL implementation does
+ *  this on Linux (kTLS) for AES-GCM and ChaCha20-Poly1305, when the kernel
+ *  supports it; received records are still decrypted in userspace. Otherwise
+ *  the connection is protected as usual. Defaults to 0. */
+#define GRPC_ARG_TSI_KERNEL_OFFLOAD "grpc.experimental.tsi_kernel_offload"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
@@ -321,6 +341,17 @@ typedef struct {
  * level. Disabling channelz naturally disables channel tracing. The default
  * is for channelz to be enabled. */
 #define GRPC_ARG_ENABLE_CHANNELZ "grpc.enable_channelz"
+/** EXPERIMENTAL. If non-zero, client channels record per-method latency,
+ * message size and retry histograms, which can be read with
+ * grpc_channelz_get_method_stats(). Calls that already carry a call tracer
+ * (e.g. from OpenCensus) only record latency and status. Defaults to false. */
+#define GRPC_ARG_ENABLE_METHOD_STATS "grpc.experimental.enable_method_stats"
+/** If set to N > 0 along with GRPC_ARG_ENABLE_METHOD_STATS, one call in N has
+ * the kernel timestamp the TCP writes that carry it (SO_TIMESTAMPING, Linux
+ * only), and the time spent queued in gRPC, in the kernel and on the network
+ * is added to the per-method stats. Defaults to 0 (off). */
+#define GRPC_ARG_TCP_WRITE_TIMESTAMPS_SAMPLE_PERIOD \
+  "grpc.experimental.tcp_write_timestamps_sample_period"
 /** If non-zero, Cronet transport will coalesce packets to fewer frames
  * when possible. */
 #define GRPC_ARG_USE_CRONET_PACKET_COALESCING \
@@ -350,6 +381,26 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX buffer pool: number of 256KB page-aligned receive buffers a
+   connection may keep. Reads are made into these buffers and handed up as
+   sub-slices of them, without copying; buffers are reused once all of their
+   data has been released. Zero (the default) disables the pool. */
+#define GRPC_ARG_TCP_RX_BUFFER_POOL_SIZE \
+  "grpc.experimental.tcp_rx_buffer_pool_size"
+/* Number of SO_REUSEPORT listening sockets to open per bound port, letting the
+   kernel spread incoming connections across them. Only honoured when
+   GRPC_ARG_ALLOW_REUSEPORT is enabled and SO_REUSEPORT is available. By
+   default, the EventEngine listener opens 1 and the iomgr TCP server opens
+   one per pollset. Each shard is polled by its own pollset where possible,
+   and connections it accepts stay on that pollset. */
+#define GRPC_ARG_TCP_LISTENER_SHARDS "grpc.experimental.tcp_listener_shards"
+/* If non-zero, each listener shard of the iomgr TCP server is tied to one CPU
+   with SO_INCOMING_CPU (Linux only), so the kernel prefers to hand a
+   connection to the shard of the CPU that processed its packets. Works best
+   with as many shards as CPUs and with NIC queues steered to those CPUs.
+   Defaults to 0. */
+#define GRPC_ARG_TCP_LISTENER_SHARD_CPU_AFFINITY \
+  "grpc.experimental.tcp_listener_shard_cpu_affinity"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -395,19 +446,18 @@ typedef struct {
     retries are enabled when they are configured via the service config.
     For details, see:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    NOTE: Hedging functionality is not yet implemented, so those
-          fields in the service config will currently be ignored.  See
-          also the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below.
+    NOTE: The hedgingPolicy field in the service config is ignored unless
+          the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below is also set.
  */
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Enables hedging functionality, as described in:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    Default is currently false, since this functionality is not yet
-    fully implemented.
+    When set, the hedgingPolicy field in the service config is honored.
+    Default is currently false, since this functionality is new.
     NOTE: This channel arg is experimental and will eventually be removed.
-          Once hedging functionality has been implemented and proves stable,
-          this arg will be removed, and the hedging functionality will
-          be enabled via the GRPC_ARG_ENABLE_RETRIES arg above. */
+          Once hedging functionality proves stable, this arg will be
+          removed, and the hedging functionality will be enabled via the
+          GRPC_ARG_ENABLE_RETRIES arg above. */
 #define GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING "grpc.experimental.enable_hedging"
 /** Per-RPC retry buffer size, in bytes. Default is 256 KiB. */
 #define GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE "grpc.per_rpc_retry_buffer_size"
@@ -447,6 +497,22 @@ typedef struct {
 /** If set, uses a local subchannel pool within the channel. Otherwise, uses the
  * global subchannel pool. */
 #define GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL "grpc.use_local_subchannel_pool"
+/** Maximum number of connections a subchannel may open to its address.
+    Connections beyond the first are opened on demand, when every existing
+    one carries GRPC_ARG_SUBCHANNEL_MAX_STREAMS_PER_CONNECTION calls, and
+    calls are spread over the least loaded connection.  Defaults to 1 (no
+    pooling). */
+#define GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS \
+  "grpc.experimental.subchannel_max_connections"
+/** Number of concurrent calls on each of a subchannel's connections at which
+    another connection is opened (see GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS).
+    Should match the server's MAX_CONCURRENT_STREAMS. Defaults to 100. */
+#define GRPC_ARG_SUBCHANNEL_MAX_STREAMS_PER_CONNECTION \
+  "grpc.experimental.subchannel_max_streams_per_connection"
+/** Time, in ms, after which a subchannel closes a connection beyond the first
+    one that has had no calls. Defaults to 30000. */
+#define GRPC_ARG_SUBCHANNEL_POOL_IDLE_TIMEOUT_MS \
+  "grpc.experimental.subchannel_pool_idle_timeout_ms"
 /** gRPC Objective-C channel pooling domain string. */
 #define GRPC_ARG_CHANNEL_POOL_DOMAIN "grpc.channel_pooling_domain"
 /** gRPC Objective-C channel pooling id. */
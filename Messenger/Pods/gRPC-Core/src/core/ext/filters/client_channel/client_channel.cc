@@ -2729,6 +2729,13 @@ void ClientChannel::LoadBalancedCall::StartTransportStreamOpBatch(
   }
   // Handle call tracing.
   if (call_attempt_tracer_ != nullptr) {
+    // Ask the transport for kernel timestamps of the writes carrying this
+    // call if the tracer sampled it.
+    auto* call_tracer =
+        static_cast<CallTracer*>(call_context_[GRPC_CONTEXT_CALL_TRACER].value);
+    if (call_tracer != nullptr && call_tracer->ShouldTraceTcpWrites()) {
+      batch->is_traced = true;
+    }
     // Record send ops in tracer.
     if (batch->cancel_stream) {
       call_attempt_tracer_->RecordCancel(
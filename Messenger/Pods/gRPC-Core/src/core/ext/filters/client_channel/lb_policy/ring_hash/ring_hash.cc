@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -54,6 +55,7 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/unique_type_name.h"
@@ -78,6 +80,22 @@ UniqueTypeName RequestHashAttributeName() {
   return kFactory.Create();
 }
 
+namespace {
+
+// Ring (or Maglev table) entries looked at past the hashed one when a
+// bounded-load pick looks for a subchannel under the bound.
+constexpr size_t kMaxBoundedLoadProbes = 256;
+
+bool IsPrime(uint64_t n) {
+  if (n < 2) return false;
+  for (uint64_t d = 2; d * d <= n; ++d) {
+    if (n % d == 0) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 // Helper Parser method
 
 const JsonLoaderInterface* RingHashConfig::JsonLoader(const JsonArgs&) {
@@ -85,6 +103,11 @@ const JsonLoaderInterface* RingHashConfig::JsonLoader(const JsonArgs&) {
       JsonObjectLoader<RingHashConfig>()
           .OptionalField("min_ring_size", &RingHashConfig::min_ring_size)
           .OptionalField("max_ring_size", &RingHashConfig::max_ring_size)
+          .OptionalField("lookup_table", &RingHashConfig::lookup_table)
+          .OptionalField("maglev_table_size",
+                         &RingHashConfig::maglev_table_size)
+          .OptionalField("hash_balance_factor",
+                         &RingHashConfig::hash_balance_factor)
           .Finish();
   return loader;
 }
@@ -108,6 +131,27 @@ void RingHashConfig::JsonPostLoad(const Json&, const JsonArgs&,
   if (min_ring_size > max_ring_size) {
     errors->AddError("max_ring_size cannot be smaller than min_ring_size");
   }
+  {
+    ValidationErrors::ScopedField field(errors, ".lookup_table");
+    if (!errors->FieldHasErrors() && lookup_table != "ring" &&
+        lookup_table != "maglev") {
+      errors->AddError("must be \"ring\" or \"maglev\"");
+    }
+  }
+  {
+    ValidationErrors::ScopedField field(errors, ".maglev_table_size");
+    if (!errors->FieldHasErrors() &&
+        (maglev_table_size > 8388608 || !IsPrime(maglev_table_size))) {
+      errors->AddError("must be a prime number no larger than 8388608");
+    }
+  }
+  {
+    ValidationErrors::ScopedField field(errors, ".hash_balance_factor");
+    if (!errors->FieldHasErrors() && hash_balance_factor != 0 &&
+        hash_balance_factor < 100) {
+      errors->AddError("must be 0 (disabled) or at least 100");
+    }
+  }
 }
 
 namespace {
@@ -116,15 +160,25 @@ constexpr absl::string_view kRingHash = "ring_hash_experimental";
 
 class RingHashLbConfig : public LoadBalancingPolicy::Config {
  public:
-  RingHashLbConfig(size_t min_ring_size, size_t max_ring_size)
-      : min_ring_size_(min_ring_size), max_ring_size_(max_ring_size) {}
+  explicit RingHashLbConfig(const RingHashConfig& config)
+      : min_ring_size_(config.min_ring_size),
+        max_ring_size_(config.max_ring_size),
+        use_maglev_(config.lookup_table == "maglev"),
+        maglev_table_size_(config.maglev_table_size),
+        hash_balance_factor_(config.hash_balance_factor) {}
   absl::string_view name() const override { return kRingHash; }
   size_t min_ring_size() const { return min_ring_size_; }
   size_t max_ring_size() const { return max_ring_size_; }
+  bool use_maglev() const { return use_maglev_; }
+  size_t maglev_table_size() const { return maglev_table_size_; }
+  uint32_t hash_balance_factor() const { return hash_balance_factor_; }
 
  private:
   size_t min_ring_size_;
   size_t max_ring_size_;
+  bool use_maglev_;
+  size_t maglev_table_size_;
+  uint32_t hash_balance_factor_;
 };
 
 //
@@ -193,13 +247,44 @@ class RingHash : public LoadBalancingPolicy {
     absl::Status connectivity_status_ ABSL_GUARDED_BY(&mu_);
   };
 
-  // A list of subchannels and the ring containing those subchannels.
+  // Number of calls in flight on each subchannel of a list, for bounded-load
+  // picks. Held by the call trackers, so that calls may outlive the list.
+  class CallCounts : public RefCounted<CallCounts> {
+   public:
+    explicit CallCounts(size_t num_subchannels)
+        : per_subchannel_(num_subchannels) {}
+
+    uint32_t Get(size_t index) const {
+      return per_subchannel_[index].load(std::memory_order_relaxed);
+    }
+    uint64_t total() const { return total_.load(std::memory_order_relaxed); }
+
+    void Add(size_t index) {
+      per_subchannel_[index].fetch_add(1, std::memory_order_relaxed);
+      total_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void Remove(size_t index) {
+      per_subchannel_[index].fetch_sub(1, std::memory_order_relaxed);
+      total_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+   private:
+    std::vector<std::atomic<uint32_t>> per_subchannel_;
+    std::atomic<uint64_t> total_{0};
+  };
+
+  // A list of subchannels and the ring (or Maglev table) containing those
+  // subchannels.
   class RingHashSubchannelList
       : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
    public:
     struct RingEntry {
       uint64_t hash;
-      RingHashSubchannelData* subchannel;
+      // Index of the subchannel in the list.
+      uint32_t subchannel_index;
+      // Which of the subchannel's entries this is. The hash depends only on
+      // the subchannel's address and this, so a rebuild can reuse it.
+      uint32_t ordinal;
     };
 
     RingHashSubchannelList(RingHash* policy, ServerAddressList addresses,
@@ -211,6 +296,14 @@ class RingHash : public LoadBalancingPolicy {
     }
 
     const std::vector<RingEntry>& ring() const { return ring_; }
+    const std::vector<RingHashSubchannelData*>& maglev_table() const {
+      return maglev_table_;
+    }
+    // Non-null if picks are load bounded.
+    const RefCountedPtr<CallCounts>& call_counts() const {
+      return call_counts_;
+    }
+    uint32_t hash_balance_factor() const { return hash_balance_factor_; }
 
     // Updates the counters of subchannels in each state when a
     // subchannel transitions from old_state to new_state.
@@ -229,6 +322,19 @@ class RingHash : public LoadBalancingPolicy {
                                                absl::Status status);
 
    private:
+    struct AddressWeight {
+      std::string address;
+      // Default weight is 1 for the cases where a weight is not provided,
+      // each occurrence of the address will be counted a weight value of 1.
+      uint32_t weight = 1;
+      double normalized_weight;
+    };
+
+    void BuildRing(RingHash* policy,
+                   const std::vector<AddressWeight>& address_weights);
+    void BuildMaglevTable(RingHash* policy,
+                          const std::vector<AddressWeight>& address_weights);
+
     bool AllSubchannelsSeenInitialState() {
       for (size_t i = 0; i < num_subchannels(); ++i) {
         if (!subchannel(i)->connectivity_state().has_value()) return false;
@@ -241,7 +347,12 @@ class RingHash : public LoadBalancingPolicy {
     size_t num_connecting_ = 0;
     size_t num_transient_failure_ = 0;
 
+    // Exactly one of these is populated, depending on the config.
     std::vector<RingEntry> ring_;
+    std::vector<RingHashSubchannelData*> maglev_table_;
+
+    const uint32_t hash_balance_factor_;
+    RefCountedPtr<CallCounts> call_counts_;
 
     // The index of the subchannel currently doing an internally
     // triggered connection attempt, if any.
@@ -268,6 +379,24 @@ class RingHash : public LoadBalancingPolicy {
     PickResult Pick(PickArgs args) override;
 
    private:
+    // Counts the call against its subchannel while it is in flight.
+    class SubchannelCallTracker : public SubchannelCallTrackerInterface {
+     public:
+      SubchannelCallTracker(RefCountedPtr<CallCounts> call_counts,
+                            size_t index)
+          : call_counts_(std::move(call_counts)), index_(index) {}
+
+      void Start() override { call_counts_->Add(index_); }
+      void Finish(FinishArgs) override { call_counts_->Remove(index_); }
+
+     private:
+      RefCountedPtr<CallCounts> call_counts_;
+      const size_t index_;
+    };
+
+    // Returns the result for a pick of the READY subchannel sd.
+    PickResult Complete(RingHashSubchannelData* sd) const;
+
     // An interface for running a callback in the control plane WorkSerializer.
     class WorkSerializerRunner : public Orphanable {
      public:
@@ -349,6 +478,17 @@ class RingHash : public LoadBalancingPolicy {
 // RingHash::Picker
 //
 
+RingHash::PickResult RingHash::Picker::Complete(
+    RingHashSubchannelData* sd) const {
+  const auto& call_counts = subchannel_list_->call_counts();
+  if (call_counts == nullptr) {
+    return PickResult::Complete(sd->subchannel()->Ref());
+  }
+  return PickResult::Complete(
+      sd->subchannel()->Ref(),
+      absl::make_unique<SubchannelCallTracker>(call_counts, sd->Index()));
+}
+
 RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
   auto* call_state = static_cast<ClientChannel::LoadBalancedCall::LbCallState*>(
       args.call_state);
@@ -358,34 +498,49 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     return PickResult::Fail(
         absl::InternalError("ring hash value is not a number"));
   }
+  // Both lookup structures are walked the same way from the first entry on,
+  // wrapping around: the ring in hash order, the Maglev table in slot order.
   const auto& ring = subchannel_list_->ring();
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
-  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
-  // for lowp, highp, and first_index. Do not change them!
-  size_t lowp = 0;
-  size_t highp = ring.size();
+  const auto& maglev_table = subchannel_list_->maglev_table();
+  const bool use_maglev = !maglev_table.empty();
+  const size_t size = use_maglev ? maglev_table.size() : ring.size();
+  auto at = [&](size_t i) {
+    return use_maglev
+               ? maglev_table[i % size]
+               : subchannel_list_->subchannel(ring[i % size].subchannel_index);
+  };
   size_t first_index = 0;
-  while (true) {
-    first_index = (lowp + highp) / 2;
-    if (first_index == ring.size()) {
-      first_index = 0;
-      break;
-    }
-    uint64_t midval = ring[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
-      break;
-    }
-    if (midval < h) {
-      lowp = first_index + 1;
-    } else {
-      highp = first_index - 1;
-    }
-    if (lowp > highp) {
-      first_index = 0;
-      break;
+  if (use_maglev) {
+    first_index = h % size;
+  } else {
+    // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
+    // (ketama_get_server) NOTE: The algorithm depends on using signed integers
+    // for lowp, highp, and first_index. Do not change them!
+    size_t lowp = 0;
+    size_t highp = ring.size();
+    while (true) {
+      first_index = (lowp + highp) / 2;
+      if (first_index == ring.size()) {
+        first_index = 0;
+        break;
+      }
+      uint64_t midval = ring[first_index].hash;
+      uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
+      if (h <= midval && h > midval1) {
+        break;
+      }
+      if (midval < h) {
+        lowp = first_index + 1;
+      } else {
+        highp = first_index - 1;
+      }
+      if (lowp > highp) {
+        first_index = 0;
+        break;
+      }
     }
   }
+  RingHashSubchannelData* first = at(first_index);
   OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
   auto ScheduleSubchannelConnectionAttempt =
       [&](RefCountedPtr<SubchannelInterface> subchannel) {
@@ -397,41 +552,64 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
         }
         subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
       };
-  switch (ring[first_index].subchannel->GetConnectivityState()) {
-    case GRPC_CHANNEL_READY:
-      return PickResult::Complete(
-          ring[first_index].subchannel->subchannel()->Ref());
+  switch (first->GetConnectivityState()) {
+    case GRPC_CHANNEL_READY: {
+      const auto& call_counts = subchannel_list_->call_counts();
+      if (call_counts == nullptr) return Complete(first);
+      // Consistent hashing with bounded loads: no subchannel takes more than
+      // hash_balance_factor percent of the mean number of in-flight calls
+      // (rounded up). Past that, the call goes to the next READY subchannel
+      // along the ring that is under the bound, so a hot key spills over
+      // to the same few neighbours instead of overloading its backend. The
+      // walk is bounded, so that a pick never scans a large ring; a
+      // subchannel seen more than once is just checked again.
+      const size_t num_subchannels = subchannel_list_->num_subchannels();
+      const uint64_t capacity =
+          ((call_counts->total() + 1) *
+               subchannel_list_->hash_balance_factor() +
+           num_subchannels * 100 - 1) /
+          (num_subchannels * 100);
+      if (call_counts->Get(first->Index()) < capacity) return Complete(first);
+      const size_t num_probes = std::min(size, kMaxBoundedLoadProbes + 1);
+      for (size_t i = 1; i < num_probes; ++i) {
+        RingHashSubchannelData* sd = at(first_index + i);
+        if (sd == first) continue;
+        if (sd->GetConnectivityState() == GRPC_CHANNEL_READY &&
+            call_counts->Get(sd->Index()) < capacity) {
+          return Complete(sd);
+        }
+      }
+      // Nothing READY within reach is under the bound: stay with the hashed
+      // subchannel.
+      return Complete(first);
+    }
     case GRPC_CHANNEL_IDLE:
-      ScheduleSubchannelConnectionAttempt(
-          ring[first_index].subchannel->subchannel()->Ref());
+      ScheduleSubchannelConnectionAttempt(first->subchannel()->Ref());
       ABSL_FALLTHROUGH_INTENDED;
     case GRPC_CHANNEL_CONNECTING:
       return PickResult::Queue();
     default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
       break;
   }
-  ScheduleSubchannelConnectionAttempt(
-      ring[first_index].subchannel->subchannel()->Ref());
+  ScheduleSubchannelConnectionAttempt(first->subchannel()->Ref());
   // Loop through remaining subchannels to find one in READY.
   // On the way, we make sure the right set of connection attempts
   // will happen.
   bool found_second_subchannel = false;
   bool found_first_non_failed = false;
-  for (size_t i = 1; i < ring.size(); ++i) {
-    const auto& entry = ring[(first_index + i) % ring.size()];
-    if (entry.subchannel == ring[first_index].subchannel) {
+  for (size_t i = 1; i < size; ++i) {
+    RingHashSubchannelData* sd = at(first_index + i);
+    if (sd == first) {
       continue;
     }
-    grpc_connectivity_state connectivity_state =
-        entry.subchannel->GetConnectivityState();
+    grpc_connectivity_state connectivity_state = sd->GetConnectivityState();
     if (connectivity_state == GRPC_CHANNEL_READY) {
-      return PickResult::Complete(entry.subchannel->subchannel()->Ref());
+      return Complete(sd);
     }
     if (!found_second_subchannel) {
       switch (connectivity_state) {
         case GRPC_CHANNEL_IDLE:
-          ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+          ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
           ABSL_FALLTHROUGH_INTENDED;
         case GRPC_CHANNEL_CONNECTING:
           return PickResult::Queue();
@@ -442,12 +620,10 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     }
     if (!found_first_non_failed) {
       if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-        ScheduleSubchannelConnectionAttempt(
-            entry.subchannel->subchannel()->Ref());
+        ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
       } else {
         if (connectivity_state == GRPC_CHANNEL_IDLE) {
-          ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+          ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
         }
         found_first_non_failed = true;
       }
@@ -455,7 +631,7 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
   }
   return PickResult::Fail(absl::UnavailableError(absl::StrCat(
       "ring hash cannot find a connected subchannel; first failure: ",
-      ring[first_index].subchannel->GetConnectivityStatus().ToString())));
+      first->GetConnectivityStatus().ToString())));
 }
 
 //
@@ -470,20 +646,17 @@ RingHash::RingHashSubchannelList::RingHashSubchannelList(
                           : nullptr),
                      std::move(addresses), policy->channel_control_helper(),
                      args),
-      num_idle_(num_subchannels()) {
+      num_idle_(num_subchannels()),
+      hash_balance_factor_(policy->config_->hash_balance_factor()) {
   // Need to maintain a ref to the LB policy as long as we maintain
   // any references to subchannels, since the subchannels'
   // pollset_sets will include the LB policy's pollset_set.
   policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
-  // Construct the ring.
+  if (num_subchannels() == 0) return;
+  if (hash_balance_factor_ > 0) {
+    call_counts_ = MakeRefCounted<CallCounts>(num_subchannels());
+  }
   // Store the weights while finding the sum.
-  struct AddressWeight {
-    std::string address;
-    // Default weight is 1 for the cases where a weight is not provided,
-    // each occurrence of the address will be counted a weight value of 1.
-    uint32_t weight = 1;
-    double normalized_weight;
-  };
   std::vector<AddressWeight> address_weights;
   size_t sum = 0;
   address_weights.reserve(num_subchannels());
@@ -503,11 +676,34 @@ RingHash::RingHashSubchannelList::RingHashSubchannelList(
     sum += address_weight.weight;
     address_weights.push_back(std::move(address_weight));
   }
-  // Calculating normalized weights and find min and max.
-  double min_normalized_weight = 1.0;
-  double max_normalized_weight = 0.0;
   for (auto& address : address_weights) {
     address.normalized_weight = static_cast<double>(address.weight) / sum;
+  }
+  if (policy->config_->use_maglev()) {
+    BuildMaglevTable(policy, address_weights);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] created subchannel list %p with a %" PRIuPTR
+              "-entry Maglev table",
+              policy, this, maglev_table_.size());
+    }
+  } else {
+    BuildRing(policy, address_weights);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] created subchannel list %p with %" PRIuPTR
+              " ring entries",
+              policy, this, ring_.size());
+    }
+  }
+}
+
+void RingHash::RingHashSubchannelList::BuildRing(
+    RingHash* policy, const std::vector<AddressWeight>& address_weights) {
+  // Find min and max normalized weights.
+  double min_normalized_weight = 1.0;
+  double max_normalized_weight = 0.0;
+  for (const auto& address : address_weights) {
     min_normalized_weight =
         std::min(address.normalized_weight, min_normalized_weight);
     max_normalized_weight =
@@ -533,43 +729,125 @@ RingHash::RingHashSubchannelList::RingHashSubchannelList(
   // host. Since these aren't necessarily whole numbers, we maintain running
   // sums -- current_hashes and target_hashes -- which allows us to populate the
   // ring in a mostly stable way.
-  absl::InlinedVector<char, 196> hash_key_buffer;
+  //
+  // The hash of an entry depends only on its address and ordinal, so the
+  // entries of the previous ring are reused for the addresses that are still
+  // present, and only new addresses and ordinals are hashed. Hashing
+  // dominates the cost of building large rings. Nothing is kept between
+  // builds beyond the rings themselves.
+  std::vector<size_t> counts(num_subchannels());
+  std::map<std::string, size_t> address_indexes;
   double current_hashes = 0.0;
   double target_hashes = 0.0;
-  uint64_t min_hashes_per_host = ring_size;
-  uint64_t max_hashes_per_host = 0;
   for (size_t i = 0; i < num_subchannels(); ++i) {
-    const std::string& address_string = address_weights[i].address;
-    hash_key_buffer.assign(address_string.begin(), address_string.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
     target_hashes += scale * address_weights[i].normalized_weight;
-    size_t count = 0;
     while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash, subchannel(i)});
-      ++count;
+      ++counts[i];
       ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
     }
-    min_hashes_per_host =
-        std::min(static_cast<uint64_t>(i), min_hashes_per_host);
-    max_hashes_per_host =
-        std::max(static_cast<uint64_t>(i), max_hashes_per_host);
+    address_indexes.emplace(address_weights[i].address, i);
+  }
+  // Hashes reused for each subchannel, which are its first reused[i]
+  // ordinals.
+  std::vector<size_t> reused(num_subchannels());
+  RingHashSubchannelList* previous =
+      policy->latest_pending_subchannel_list_ != nullptr
+          ? policy->latest_pending_subchannel_list_.get()
+          : policy->subchannel_list_.get();
+  if (previous != nullptr && !previous->ring_.empty()) {
+    // Maps each previous subchannel to the new one with its address, taking
+    // only the first of any duplicates on either side.
+    constexpr size_t kNone = static_cast<size_t>(-1);
+    std::vector<size_t> new_indexes(previous->num_subchannels(), kNone);
+    std::vector<bool> matched(num_subchannels());
+    for (size_t i = 0; i < previous->num_subchannels(); ++i) {
+      auto address = grpc_sockaddr_to_string(
+          &previous->subchannel(i)->address().address(), false);
+      if (!address.ok()) continue;
+      auto it = address_indexes.find(*address);
+      if (it == address_indexes.end() || matched[it->second]) continue;
+      matched[it->second] = true;
+      new_indexes[i] = it->second;
+    }
+    for (const RingEntry& entry : previous->ring_) {
+      const size_t index = new_indexes[entry.subchannel_index];
+      if (index == kNone || entry.ordinal >= counts[index]) continue;
+      ring_.push_back({entry.hash, static_cast<uint32_t>(index),
+                       entry.ordinal});
+      ++reused[index];
+    }
+  }
+  absl::InlinedVector<char, 196> hash_key_buffer;
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    const std::string& address_string = address_weights[i].address;
+    if (reused[i] == counts[i]) continue;
+    hash_key_buffer.assign(address_string.begin(), address_string.end());
+    hash_key_buffer.emplace_back('_');
+    const size_t prefix_size = hash_key_buffer.size();
+    for (size_t n = reused[i]; n < counts[i]; ++n) {
+      const std::string count_str = absl::StrCat(n);
+      hash_key_buffer.insert(hash_key_buffer.end(), count_str.begin(),
+                             count_str.end());
+      ring_.push_back({XXH64(hash_key_buffer.data(), hash_key_buffer.size(), 0),
+                       static_cast<uint32_t>(i), static_cast<uint32_t>(n)});
+      hash_key_buffer.resize(prefix_size);
+    }
   }
   std::sort(ring_.begin(), ring_.end(),
             [](const RingHashSubchannelList::RingEntry& lhs,
                const RingHashSubchannelList::RingEntry& rhs) -> bool {
               return lhs.hash < rhs.hash;
             });
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
-    gpr_log(GPR_INFO,
-            "[RH %p] created subchannel list %p with %" PRIuPTR " ring entries",
-            policy, this, ring_.size());
+}
+
+void RingHash::RingHashSubchannelList::BuildMaglevTable(
+    RingHash* policy, const std::vector<AddressWeight>& address_weights) {
+  // Maglev (Eisenbud et al., NSDI 2016), with weights: each subchannel walks
+  // its own permutation of the table, derived from its address, claiming the
+  // next free slot on each turn; heavier subchannels get more turns. Picks
+  // are a single lookup, and a membership change moves few slots.
+  const size_t table_size = policy->config_->maglev_table_size();
+  struct BuildEntry {
+    uint64_t offset;
+    uint64_t skip;
+    uint64_t next = 0;
+    double weight;
+    double target_weight = 0;
+  };
+  std::vector<BuildEntry> entries;
+  entries.reserve(num_subchannels());
+  double max_normalized_weight = 0.0;
+  for (const auto& address : address_weights) {
+    BuildEntry entry;
+    entry.offset =
+        XXH64(address.address.data(), address.address.size(), 0) % table_size;
+    // Any skip in [1, table_size) visits every slot, since the size is prime.
+    entry.skip =
+        XXH64(address.address.data(), address.address.size(), 1) %
+            (table_size - 1) +
+        1;
+    entry.weight = address.normalized_weight;
+    max_normalized_weight = std::max(max_normalized_weight, entry.weight);
+    entries.push_back(entry);
+  }
+  maglev_table_.assign(table_size, nullptr);
+  size_t filled = 0;
+  for (uint64_t iteration = 0; filled < table_size; ++iteration) {
+    for (size_t i = 0; i < entries.size() && filled < table_size; ++i) {
+      BuildEntry& entry = entries[i];
+      // A subchannel with the maximum weight takes a turn every iteration,
+      // one with a third of that weight every third iteration.
+      if (iteration * entry.weight < entry.target_weight) continue;
+      entry.target_weight += max_normalized_weight;
+      size_t slot = (entry.offset + entry.skip * entry.next) % table_size;
+      while (maglev_table_[slot] != nullptr) {
+        ++entry.next;
+        slot = (entry.offset + entry.skip * entry.next) % table_size;
+      }
+      maglev_table_[slot] = subchannel(i);
+      ++entry.next;
+      ++filled;
+    }
   }
 }
 
@@ -876,8 +1154,7 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
     auto config = LoadFromJson<RingHashConfig>(
         json, JsonArgs(), "errors validating ring_hash LB policy config");
     if (!config.ok()) return config.status();
-    return MakeRefCounted<RingHashLbConfig>(config->min_ring_size,
-                                            config->max_ring_size);
+    return MakeRefCounted<RingHashLbConfig>(*config);
   }
 };
 
@@ -0,0 +1,904 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/validation_errors.h"
+#include "src/core/lib/gprpp/work_serializer.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_args.h"
+#include "src/core/lib/json/json_object_loader.h"
+#include "src/core/lib/load_balancing/lb_policy.h"
+#include "src/core/lib/load_balancing/lb_policy_factory.h"
+#include "src/core/lib/load_balancing/lb_policy_registry.h"
+#include "src/core/lib/load_balancing/subchannel_interface.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_wrr_trace(false, "weighted_round_robin_lb");
+
+namespace {
+
+constexpr absl::string_view kWeightedRoundRobin = "weighted_round_robin";
+
+// Weights are scaled so that the heaviest backend appears this many times in
+// each round of the pick schedule.
+constexpr uint32_t kMaxScaledWeight = 64;
+
+//
+// config
+//
+
+class WeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  WeightedRoundRobinConfig() = default;
+
+  WeightedRoundRobinConfig(const WeightedRoundRobinConfig&) = delete;
+  WeightedRoundRobinConfig& operator=(const WeightedRoundRobinConfig&) =
+      delete;
+
+  absl::string_view name() const override { return kWeightedRoundRobin; }
+
+  bool enable_oob_load_report() const { return enable_oob_load_report_; }
+  Duration oob_reporting_period() const { return oob_reporting_period_; }
+  Duration blackout_period() const { return blackout_period_; }
+  Duration weight_update_period() const { return weight_update_period_; }
+  Duration weight_expiration_period() const {
+    return weight_expiration_period_;
+  }
+  float error_utilization_penalty() const {
+    return error_utilization_penalty_;
+  }
+
+  static const JsonLoaderInterface* JsonLoader(const JsonArgs&) {
+    static const auto* loader =
+        JsonObjectLoader<WeightedRoundRobinConfig>()
+            .OptionalField("enableOobLoadReport",
+                           &WeightedRoundRobinConfig::enable_oob_load_report_)
+            .OptionalField("oobReportingPeriod",
+                           &WeightedRoundRobinConfig::oob_reporting_period_)
+            .OptionalField("blackoutPeriod",
+                           &WeightedRoundRobinConfig::blackout_period_)
+            .OptionalField("weightUpdatePeriod",
+                           &WeightedRoundRobinConfig::weight_update_period_)
+            .OptionalField(
+                "weightExpirationPeriod",
+                &WeightedRoundRobinConfig::weight_expiration_period_)
+            .OptionalField(
+                "errorUtilizationPenalty",
+                &WeightedRoundRobinConfig::error_utilization_penalty_)
+            .Finish();
+    return loader;
+  }
+
+  void JsonPostLoad(const Json&, const JsonArgs&, ValidationErrors* errors) {
+    // Rebuilding the schedule more often than this buys nothing.
+    weight_update_period_ =
+        std::max(weight_update_period_, Duration::Milliseconds(100));
+    if (error_utilization_penalty_ < 0) {
+      ValidationErrors::ScopedField field(errors, ".errorUtilizationPenalty");
+      errors->AddError("must be non-negative");
+    }
+  }
+
+ private:
+  bool enable_oob_load_report_ = false;
+  Duration oob_reporting_period_ = Duration::Seconds(10);
+  Duration blackout_period_ = Duration::Seconds(10);
+  Duration weight_update_period_ = Duration::Seconds(1);
+  Duration weight_expiration_period_ = Duration::Minutes(3);
+  float error_utilization_penalty_ = 1.0;
+};
+
+//
+// weighted_round_robin LB policy
+//
+
+// Like round_robin, but each READY backend is picked in proportion to a
+// weight derived from the load it reports over ORCA, either per call or out
+// of band:
+//
+//   weight = qps / (cpu_utilization + error_fraction * penalty)
+//
+// where error_fraction is the share of calls to that backend that failed
+// since the previous weight update, as seen by this client.
+//
+// Picks follow an earliest-deadline-first schedule computed from the weights
+// whenever they are updated (every weight_update_period). The schedule is
+// immutable once built, so a pick is a single relaxed atomic increment and an
+// array lookup: no lock is taken on the data plane.
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  absl::string_view name() const override { return kWeightedRoundRobin; }
+
+  absl::Status UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  // Load reported by, and weight computed for, one backend address. Shared
+  // by every subchannel list entry, picker and call tracker for that address
+  // so that it survives address list updates.
+  class AddressWeight : public RefCounted<AddressWeight> {
+   public:
+    AddressWeight(RefCountedPtr<WeightedRoundRobin> wrr, std::string key)
+        : wrr_(std::move(wrr)), key_(std::move(key)) {}
+    ~AddressWeight() override;
+
+    // Records a load report from the backend.
+    void OnLoadReport(double qps, double cpu_utilization);
+    // Records the outcome of a call made to the backend.
+    void OnCallFinished(bool ok) {
+      calls_.fetch_add(1, std::memory_order_relaxed);
+      if (!ok) failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns the current weight, or 0 if it is not known: no load report
+    // yet, still within the blackout period, or the last report expired.
+    float ComputeWeight(Timestamp now, const WeightedRoundRobinConfig& config);
+
+   private:
+    RefCountedPtr<WeightedRoundRobin> wrr_;
+    const std::string key_;
+
+    Mutex mu_;
+    double qps_ ABSL_GUARDED_BY(&mu_) = 0;
+    double cpu_utilization_ ABSL_GUARDED_BY(&mu_) = 0;
+    double error_fraction_ ABSL_GUARDED_BY(&mu_) = 0;
+    Timestamp non_empty_since_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfFuture();
+    Timestamp last_update_time_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfPast();
+
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<uint64_t> failures_{0};
+  };
+
+  class OobWatcher : public OobBackendMetricWatcher {
+   public:
+    explicit OobWatcher(RefCountedPtr<AddressWeight> weight)
+        : weight_(std::move(weight)) {}
+
+    void OnBackendMetricReport(
+        const BackendMetricData& backend_metric_data) override {
+      weight_->OnLoadReport(backend_metric_data.qps,
+                            backend_metric_data.cpu_utilization);
+    }
+
+   private:
+    RefCountedPtr<AddressWeight> weight_;
+  };
+
+  // Forward declaration.
+  class WrrSubchannelList;
+
+  class WrrSubchannelData
+      : public SubchannelData<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelData(
+        SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel);
+
+    absl::optional<grpc_connectivity_state> connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    RefCountedPtr<AddressWeight> weight() const { return weight_; }
+
+   private:
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    void UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+    RefCountedPtr<AddressWeight> weight_;
+    // As for round_robin: after TRANSIENT_FAILURE, this only changes once
+    // the subchannel becomes READY again.
+    absl::optional<grpc_connectivity_state> logical_connectivity_state_;
+  };
+
+  class WrrSubchannelList
+      : public SubchannelList<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelList(WeightedRoundRobin* policy, ServerAddressList addresses,
+                      const ChannelArgs& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)
+                              ? "WrrSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~WrrSubchannelList() override {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    size_t num_ready() const { return num_ready_; }
+
+    void UpdateStateCountersLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state);
+
+    void MaybeUpdateConnectivityStateLocked(absl::Status status_for_tf);
+
+   private:
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+
+    absl::Status last_failure_;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent, WrrSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Reports call results, and per-call load reports unless they come out
+    // of band, to the backend's AddressWeight.
+    class SubchannelCallTracker : public SubchannelCallTrackerInterface {
+     public:
+      SubchannelCallTracker(RefCountedPtr<AddressWeight> weight,
+                            bool use_per_call_reports)
+          : weight_(std::move(weight)),
+            use_per_call_reports_(use_per_call_reports) {}
+
+      void Start() override {}
+      void Finish(FinishArgs args) override;
+
+     private:
+      RefCountedPtr<AddressWeight> weight_;
+      const bool use_per_call_reports_;
+    };
+
+    struct SubchannelInfo {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<AddressWeight> weight;
+    };
+
+    // Builds the EDF schedule for the given weights into schedule_.
+    void BuildSchedule(std::vector<float> weights);
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+    const bool use_per_call_reports_;
+    std::vector<SubchannelInfo> subchannels_;
+    // Indexes into subchannels_, in pick order.
+    std::vector<uint32_t> schedule_;
+    std::atomic<size_t> next_{0};
+  };
+
+  class WeightUpdateTimer : public InternallyRefCounted<WeightUpdateTimer> {
+   public:
+    explicit WeightUpdateTimer(RefCountedPtr<WeightedRoundRobin> parent);
+
+    void Orphan() override;
+
+   private:
+    static void OnTimer(void* arg, grpc_error_handle error);
+    void OnTimerLocked(grpc_error_handle error);
+
+    RefCountedPtr<WeightedRoundRobin> parent_;
+    grpc_timer timer_;
+    grpc_closure on_timer_;
+    bool timer_pending_ = true;
+  };
+
+  ~WeightedRoundRobin() override;
+
+  void ShutdownLocked() override;
+
+  RefCountedPtr<AddressWeight> GetOrCreateWeight(
+      const ServerAddress& address);
+
+  // Reports a new picker, with freshly computed weights, if READY.
+  void UpdatePickerLocked();
+
+  RefCountedPtr<WeightedRoundRobinConfig> config_;
+
+  // List of subchannels.
+  RefCountedPtr<WrrSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  RefCountedPtr<WrrSubchannelList> latest_pending_subchannel_list_;
+
+  // Weights are unreffed from pickers and call trackers, outside the work
+  // serializer.
+  Mutex address_weight_map_mu_;
+  std::map<std::string, AddressWeight*> address_weight_map_
+      ABSL_GUARDED_BY(&address_weight_map_mu_);
+
+  OrphanablePtr<WeightUpdateTimer> weight_update_timer_;
+
+  bool shutdown_ = false;
+};
+
+//
+// WeightedRoundRobin::AddressWeight
+//
+
+WeightedRoundRobin::AddressWeight::~AddressWeight() {
+  MutexLock lock(&wrr_->address_weight_map_mu_);
+  auto it = wrr_->address_weight_map_.find(key_);
+  if (it != wrr_->address_weight_map_.end() && it->second == this) {
+    wrr_->address_weight_map_.erase(it);
+  }
+}
+
+void WeightedRoundRobin::AddressWeight::OnLoadReport(double qps,
+                                                     double cpu_utilization) {
+  // A report without both values carries no information about capacity.
+  if (qps <= 0 || cpu_utilization <= 0) return;
+  const Timestamp now = ExecCtx::Get()->Now();
+  MutexLock lock(&mu_);
+  qps_ = qps;
+  cpu_utilization_ = cpu_utilization;
+  if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
+  last_update_time_ = now;
+}
+
+float WeightedRoundRobin::AddressWeight::ComputeWeight(
+    Timestamp now, const WeightedRoundRobinConfig& config) {
+  const uint64_t calls = calls_.exchange(0, std::memory_order_relaxed);
+  const uint64_t failures = failures_.exchange(0, std::memory_order_relaxed);
+  MutexLock lock(&mu_);
+  if (calls > 0) {
+    error_fraction_ = static_cast<double>(std::min(failures, calls)) /
+                      static_cast<double>(calls);
+  }
+  // Stale reports are dropped, and the blackout period restarts with the
+  // next report.
+  if (now - last_update_time_ >= config.weight_expiration_period()) {
+    non_empty_since_ = Timestamp::InfFuture();
+    return 0;
+  }
+  // Let the backend's load settle before trusting it: a backend that just
+  // came up reports low utilization until the traffic reaches it.
+  if (config.blackout_period() > Duration::Zero() &&
+      now - non_empty_since_ < config.blackout_period()) {
+    return 0;
+  }
+  return static_cast<float>(
+      qps_ / (cpu_utilization_ +
+              error_fraction_ * config.error_utilization_penalty()));
+}
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(WeightedRoundRobin* parent,
+                                   WrrSubchannelList* subchannel_list)
+    : parent_(parent),
+      use_per_call_reports_(!parent->config_->enable_oob_load_report()) {
+  const Timestamp now = ExecCtx::Get()->Now();
+  std::vector<float> weights;
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WrrSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) ==
+        GRPC_CHANNEL_READY) {
+      weights.push_back(sd->weight()->ComputeWeight(now, *parent->config_));
+      subchannels_.push_back({sd->subchannel()->Ref(), sd->weight()});
+    }
+  }
+  BuildSchedule(std::move(weights));
+  // Start each picker at a random point in the schedule, so that clients
+  // created together do not pick in lockstep.
+  absl::BitGen bit_gen;
+  next_.store(absl::Uniform<size_t>(bit_gen, 0, schedule_.size()),
+              std::memory_order_relaxed);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels; schedule length %" PRIuPTR,
+            parent_, this, subchannel_list, subchannels_.size(),
+            schedule_.size());
+  }
+}
+
+void WeightedRoundRobin::Picker::BuildSchedule(std::vector<float> weights) {
+  const size_t n = weights.size();
+  // Backends without a usable weight are given the mean of the others. With
+  // fewer than two known weights there is nothing to balance: fall back to
+  // plain round robin.
+  size_t num_known = 0;
+  double sum = 0;
+  float max_weight = 0;
+  for (float w : weights) {
+    if (w > 0 && std::isfinite(w)) {
+      ++num_known;
+      sum += w;
+      max_weight = std::max(max_weight, w);
+    }
+  }
+  if (num_known < 2) {
+    schedule_.resize(n);
+    for (size_t i = 0; i < n; ++i) schedule_[i] = static_cast<uint32_t>(i);
+    return;
+  }
+  const float mean = static_cast<float>(sum / num_known);
+  std::vector<uint32_t> scaled(n);
+  size_t total = 0;
+  for (size_t i = 0; i < n; ++i) {
+    float w = weights[i];
+    if (!(w > 0 && std::isfinite(w))) w = mean;
+    scaled[i] = std::max<uint32_t>(
+        1, static_cast<uint32_t>(
+               std::lround(w / max_weight * kMaxScaledWeight)));
+    total += scaled[i];
+  }
+  // Earliest deadline first: backend i is due every 1/scaled[i] of a round.
+  // Over one round of `total` picks each backend comes up exactly scaled[i]
+  // times, spread evenly rather than in bursts.
+  using Entry = std::pair<double, uint32_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  for (size_t i = 0; i < n; ++i) {
+    queue.emplace(1.0 / scaled[i], static_cast<uint32_t>(i));
+  }
+  schedule_.reserve(total);
+  for (size_t k = 0; k < total; ++k) {
+    Entry next = queue.top();
+    queue.pop();
+    schedule_.push_back(next.second);
+    queue.emplace(next.first + 1.0 / scaled[next.second], next.second);
+  }
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  const size_t index =
+      schedule_[next_.fetch_add(1, std::memory_order_relaxed) %
+                schedule_.size()];
+  const SubchannelInfo& info = subchannels_[index];
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            parent_, this, index, info.subchannel.get());
+  }
+  return PickResult::Complete(info.subchannel,
+                              absl::make_unique<SubchannelCallTracker>(
+                                  info.weight, use_per_call_reports_));
+}
+
+void WeightedRoundRobin::Picker::SubchannelCallTracker::Finish(
+    FinishArgs args) {
+  weight_->OnCallFinished(args.status.ok());
+  if (!use_per_call_reports_ || args.backend_metric_accessor == nullptr) {
+    return;
+  }
+  const BackendMetricData* backend_metric_data =
+      args.backend_metric_accessor->GetBackendMetricData();
+  if (backend_metric_data != nullptr) {
+    weight_->OnLoadReport(backend_metric_data->qps,
+                          backend_metric_data->cpu_utilization);
+  }
+}
+
+//
+// WeightedRoundRobin::WeightUpdateTimer
+//
+
+WeightedRoundRobin::WeightUpdateTimer::WeightUpdateTimer(
+    RefCountedPtr<WeightedRoundRobin> parent)
+    : parent_(std::move(parent)) {
+  GRPC_CLOSURE_INIT(&on_timer_, OnTimer, this, nullptr);
+  Ref().release();
+  grpc_timer_init(&timer_,
+                  ExecCtx::Get()->Now() +
+                      parent_->config_->weight_update_period(),
+                  &on_timer_);
+}
+
+void WeightedRoundRobin::WeightUpdateTimer::Orphan() {
+  if (timer_pending_) {
+    timer_pending_ = false;
+    grpc_timer_cancel(&timer_);
+  }
+  Unref();
+}
+
+void WeightedRoundRobin::WeightUpdateTimer::OnTimer(void* arg,
+                                                    grpc_error_handle error) {
+  auto* self = static_cast<WeightUpdateTimer*>(arg);
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  self->parent_->work_serializer()->Run(
+      [self, error]() { self->OnTimerLocked(error); }, DEBUG_LOCATION);
+}
+
+void WeightedRoundRobin::WeightUpdateTimer::OnTimerLocked(
+    grpc_error_handle error) {
+  if (GRPC_ERROR_IS_NONE(error) && timer_pending_) {
+    timer_pending_ = false;
+    parent_->UpdatePickerLocked();
+    parent_->weight_update_timer_ =
+        MakeOrphanable<WeightUpdateTimer>(parent_);
+  }
+  Unref(DEBUG_LOCATION, "Timer");
+  GRPC_ERROR_UNREF(error);
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying weighted_round_robin policy",
+            this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  weight_update_timer_.reset();
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RefCountedPtr<WeightedRoundRobin::AddressWeight>
+WeightedRoundRobin::GetOrCreateWeight(const ServerAddress& address) {
+  // Use only the address, not the attributes.
+  auto addr_str = grpc_sockaddr_to_string(&address.address(), false);
+  std::string key =
+      addr_str.ok() ? std::move(*addr_str) : addr_str.status().ToString();
+  MutexLock lock(&address_weight_map_mu_);
+  auto it = address_weight_map_.find(key);
+  if (it != address_weight_map_.end()) {
+    // The weight may be on its way out: only reuse it if it is still live.
+    auto weight = it->second->RefIfNonZero();
+    if (weight != nullptr) return weight;
+  }
+  auto weight = MakeRefCounted<AddressWeight>(
+      Ref(DEBUG_LOCATION, "AddressWeight"), key);
+  address_weight_map_[std::move(key)] = weight.get();
+  return weight;
+}
+
+void WeightedRoundRobin::UpdatePickerLocked() {
+  if (shutdown_ || subchannel_list_ == nullptr ||
+      subchannel_list_->num_ready() == 0) {
+    return;
+  }
+  channel_control_helper()->UpdateState(
+      GRPC_CHANNEL_READY, absl::Status(),
+      absl::make_unique<Picker>(this, subchannel_list_.get()));
+}
+
+absl::Status WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with address error: %s",
+              this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then keep using the existing
+    // list, but still report back that the update was not accepted.
+    if (subchannel_list_ != nullptr) return args.addresses.status();
+  }
+  // (Re)start the weight update timer so a new period takes effect.
+  weight_update_timer_ =
+      MakeOrphanable<WeightUpdateTimer>(Ref(DEBUG_LOCATION, "Timer"));
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[WRR %p] replacing previous pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeRefCounted<WrrSubchannelList>(
+      this, std::move(addresses), args.args);
+  latest_pending_subchannel_list_->StartWatchingLocked();
+  // If the new list is empty, immediately promote it to
+  // subchannel_list_ and report TRANSIENT_FAILURE.
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+        subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO, "[WRR %p] replacing previous subchannel list %p", this,
+              subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+    return status;
+  }
+  // Otherwise, if this is the initial update, immediately promote it to
+  // subchannel_list_ and report CONNECTING.
+  if (subchannel_list_.get() == nullptr) {
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(Ref(DEBUG_LOCATION, "QueuePicker")));
+  }
+  return absl::OkStatus();
+}
+
+//
+// WrrSubchannelList
+//
+
+void WeightedRoundRobin::WrrSubchannelList::UpdateStateCountersLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  if (old_state.has_value()) {
+    GPR_ASSERT(*old_state != GRPC_CHANNEL_SHUTDOWN);
+    if (*old_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(num_ready_ > 0);
+      --num_ready_;
+    } else if (*old_state == GRPC_CHANNEL_CONNECTING) {
+      GPR_ASSERT(num_connecting_ > 0);
+      --num_connecting_;
+    } else if (*old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(num_transient_failure_ > 0);
+      --num_transient_failure_;
+    }
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelList::MaybeUpdateConnectivityStateLocked(
+    absl::Status status_for_tf) {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // Swap in latest_pending_subchannel_list_ under the same conditions as
+  // round_robin.
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_->num_ready_ == 0 || num_ready_ > 0 ||
+       num_transient_failure_ == num_subchannels())) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(
+          GPR_INFO,
+          "[WRR %p] swapping out subchannel list %p (%s) in favor of %p (%s)",
+          p, p->subchannel_list_.get(), old_counters_string.c_str(), this,
+          CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting READY with subchannel list %p", p,
+              this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting CONNECTING with subchannel list %p",
+              p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(
+          GPR_INFO,
+          "[WRR %p] reporting TRANSIENT_FAILURE with subchannel list %p: %s", p,
+          this, status_for_tf.ToString().c_str());
+    }
+    if (!status_for_tf.ok()) {
+      last_failure_ = absl::UnavailableError(
+          absl::StrCat("connections to all backends failing; last error: ",
+                       status_for_tf.ToString()));
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, last_failure_,
+        absl::make_unique<TransientFailurePicker>(last_failure_));
+  }
+}
+
+//
+// WrrSubchannelData
+//
+
+WeightedRoundRobin::WrrSubchannelData::WrrSubchannelData(
+    SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+    const ServerAddress& address, RefCountedPtr<SubchannelInterface> subchannel)
+    : SubchannelData(subchannel_list, address, std::move(subchannel)) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list->policy());
+  weight_ = p->GetOrCreateWeight(address);
+  if (p->config_->enable_oob_load_report()) {
+    this->subchannel()->AddDataWatcher(MakeOobBackendMetricWatcher(
+        p->config_->oob_reporting_period(),
+        absl::make_unique<OobWatcher>(weight_)));
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelData::ProcessConnectivityChangeLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p reported %s; requesting re-resolution", p,
+              subchannel(), ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+  }
+  if (new_state == GRPC_CHANNEL_IDLE) {
+    subchannel()->RequestConnection();
+  }
+  UpdateLogicalConnectivityStateLocked(new_state);
+  subchannel_list()->MaybeUpdateConnectivityStateLocked(connectivity_status());
+}
+
+void WeightedRoundRobin::WrrSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return;
+  }
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == connectivity_state) {
+    return;
+  }
+  subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                               connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  absl::string_view name() const override { return kWeightedRoundRobin; }
+
+  absl::StatusOr<RefCountedPtr<LoadBalancingPolicy::Config>>
+  ParseLoadBalancingConfig(const Json& json) const override {
+    if (json.type() == Json::Type::JSON_NULL) {
+      // Selected by name through the deprecated loadBalancingPolicy field:
+      // use the defaults.
+      return MakeRefCounted<WeightedRoundRobinConfig>();
+    }
+    return LoadRefCountedFromJson<WeightedRoundRobinConfig>(
+        json, JsonArgs(),
+        "errors validating weighted_round_robin LB policy config");
+  }
+};
+
+}  // namespace
+
+void RegisterWeightedRoundRobinLbPolicy(CoreConfiguration::Builder* builder) {
+  builder->lb_policy_registry()->RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<WeightedRoundRobinFactory>());
+}
+
+}  // namespace grpc_core
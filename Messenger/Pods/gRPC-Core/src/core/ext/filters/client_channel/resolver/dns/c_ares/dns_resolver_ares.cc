@@ -71,6 +71,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.h"
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
@@ -102,11 +103,18 @@ class AresClientChannelDNSResolver : public PollingResolver {
   OrphanablePtr<Orphanable> StartRequest() override;
 
  private:
+  // Resolves one name: its addresses and, if enabled, its SRV and TXT
+  // records. Holds no reference to the resolver, so that a DnsCache lookup
+  // can outlive the channel that started it.
   class AresRequestWrapper : public InternallyRefCounted<AresRequestWrapper> {
    public:
-    explicit AresRequestWrapper(
-        RefCountedPtr<AresClientChannelDNSResolver> resolver)
-        : resolver_(std::move(resolver)) {
+    AresRequestWrapper(std::string authority, std::string name_to_resolve,
+                       grpc_pollset_set* interested_parties,
+                       bool enable_srv_queries, bool request_service_config,
+                       int query_timeout_ms,
+                       std::function<void(DnsCache::Answer)> on_done)
+        : name_to_resolve_(std::move(name_to_resolve)),
+          on_done_(std::move(on_done)) {
       // TODO(hork): replace this callback bookkeeping with promises.
       // Locking to prevent completion before all records are queried
       MutexLock lock(&on_resolved_mu_);
@@ -114,42 +122,35 @@ class AresClientChannelDNSResolver : public PollingResolver {
       GRPC_CLOSURE_INIT(&on_hostname_resolved_, OnHostnameResolved, this,
                         nullptr);
       hostname_request_.reset(grpc_dns_lookup_hostname_ares(
-          resolver_->authority().c_str(), resolver_->name_to_resolve().c_str(),
-          kDefaultSecurePort, resolver_->interested_parties(),
-          &on_hostname_resolved_, &addresses_, resolver_->query_timeout_ms_));
+          authority.c_str(), name_to_resolve_.c_str(), kDefaultSecurePort,
+          interested_parties, &on_hostname_resolved_, &addresses_,
+          query_timeout_ms));
       GRPC_CARES_TRACE_LOG(
-          "resolver:%p Started resolving hostnames. hostname_request_:%p",
-          resolver_.get(), hostname_request_.get());
-      if (resolver_->enable_srv_queries_) {
+          "request:%p Started resolving hostnames. hostname_request_:%p", this,
+          hostname_request_.get());
+      if (enable_srv_queries) {
         Ref(DEBUG_LOCATION, "OnSRVResolved").release();
         GRPC_CLOSURE_INIT(&on_srv_resolved_, OnSRVResolved, this, nullptr);
         srv_request_.reset(grpc_dns_lookup_srv_ares(
-            resolver_->authority().c_str(),
-            resolver_->name_to_resolve().c_str(),
-            resolver_->interested_parties(), &on_srv_resolved_,
-            &balancer_addresses_, resolver_->query_timeout_ms_));
+            authority.c_str(), name_to_resolve_.c_str(), interested_parties,
+            &on_srv_resolved_, &balancer_addresses_, query_timeout_ms));
         GRPC_CARES_TRACE_LOG(
-            "resolver:%p Started resolving SRV records. srv_request_:%p",
-            resolver_.get(), srv_request_.get());
+            "request:%p Started resolving SRV records. srv_request_:%p", this,
+            srv_request_.get());
       }
-      if (resolver_->request_service_config_) {
+      if (request_service_config) {
         Ref(DEBUG_LOCATION, "OnTXTResolved").release();
         GRPC_CLOSURE_INIT(&on_txt_resolved_, OnTXTResolved, this, nullptr);
         txt_request_.reset(grpc_dns_lookup_txt_ares(
-            resolver_->authority().c_str(),
-            resolver_->name_to_resolve().c_str(),
-            resolver_->interested_parties(), &on_txt_resolved_,
-            &service_config_json_, resolver_->query_timeout_ms_));
+            authority.c_str(), name_to_resolve_.c_str(), interested_parties,
+            &on_txt_resolved_, &service_config_json_, query_timeout_ms));
         GRPC_CARES_TRACE_LOG(
-            "resolver:%p Started resolving TXT records. txt_request_:%p",
-            resolver_.get(), srv_request_.get());
+            "request:%p Started resolving TXT records. txt_request_:%p", this,
+            txt_request_.get());
       }
     }
 
-    ~AresRequestWrapper() override {
-      gpr_free(service_config_json_);
-      resolver_.reset(DEBUG_LOCATION, "dns-resolving");
-    }
+    ~AresRequestWrapper() override { gpr_free(service_config_json_); }
 
     // Note that thread safety cannot be analyzed due to this being invoked from
     // OrphanablePtr<>, and there's no way to pass the lock annotation through
@@ -174,11 +175,12 @@ class AresClientChannelDNSResolver : public PollingResolver {
     static void OnHostnameResolved(void* arg, grpc_error_handle error);
     static void OnSRVResolved(void* arg, grpc_error_handle error);
     static void OnTXTResolved(void* arg, grpc_error_handle error);
-    absl::optional<Result> OnResolvedLocked(grpc_error_handle error)
+    absl::optional<DnsCache::Answer> OnResolvedLocked(grpc_error_handle error)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(on_resolved_mu_);
 
+    const std::string name_to_resolve_;
+    const std::function<void(DnsCache::Answer)> on_done_;
     Mutex on_resolved_mu_;
-    RefCountedPtr<AresClientChannelDNSResolver> resolver_;
     grpc_closure on_hostname_resolved_;
     std::unique_ptr<grpc_ares_request> hostname_request_
         ABSL_GUARDED_BY(on_resolved_mu_);
@@ -198,12 +200,16 @@ class AresClientChannelDNSResolver : public PollingResolver {
 
   ~AresClientChannelDNSResolver() override;
 
+  Result ResultFromAnswer(const DnsCache::Answer& answer);
+
   /// whether to request the service config
   const bool request_service_config_;
   // whether or not to enable SRV DNS queries
   const bool enable_srv_queries_;
   // timeout in milliseconds for active DNS queries
   const int query_timeout_ms_;
+  // set if resolutions go through the DnsCache
+  const absl::optional<DnsCache::Options> cache_options_;
 };
 
 AresClientChannelDNSResolver::AresClientChannelDNSResolver(
@@ -230,7 +236,8 @@ AresClientChannelDNSResolver::AresClientChannelDNSResolver(
                               .value_or(false)),
       query_timeout_ms_(
           std::max(0, channel_args.GetInt(GRPC_ARG_DNS_ARES_QUERY_TIMEOUT_MS)
-                          .value_or(GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS))) {}
+                          .value_or(GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS))),
+      cache_options_(DnsCache::OptionsFromChannelArgs(channel_args)) {}
 
 AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
   GRPC_CARES_TRACE_LOG("resolver:%p destroying AresClientChannelDNSResolver",
@@ -238,8 +245,36 @@ AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> AresClientChannelDNSResolver::StartRequest() {
-  return MakeOrphanable<AresRequestWrapper>(
-      Ref(DEBUG_LOCATION, "dns-resolving"));
+  DnsCache::LookupFn lookup =
+      [authority = authority(), name_to_resolve = name_to_resolve(),
+       enable_srv_queries = enable_srv_queries_,
+       request_service_config = request_service_config_,
+       query_timeout_ms = query_timeout_ms_](
+          grpc_pollset_set* interested_parties,
+          std::function<void(DnsCache::Answer)> on_done)
+      -> OrphanablePtr<Orphanable> {
+    return MakeOrphanable<AresRequestWrapper>(
+        authority, name_to_resolve, interested_parties, enable_srv_queries,
+        request_service_config, query_timeout_ms, std::move(on_done));
+  };
+  if (cache_options_.has_value()) {
+    // The key covers every input of the lookup, so that channels querying
+    // different records do not share answers.
+    return DnsCache::Get()->Lookup(
+        absl::StrCat("ares:", authority(), "/", name_to_resolve(),
+                     enable_srv_queries_ ? "+srv" : "",
+                     request_service_config_ ? "+txt" : ""),
+        *cache_options_, interested_parties(), std::move(lookup),
+        [this, self = Ref(DEBUG_LOCATION, "dns-resolving")](
+            std::shared_ptr<const DnsCache::Answer> answer) {
+          OnRequestComplete(ResultFromAnswer(*answer));
+        });
+  }
+  return lookup(interested_parties(),
+                [this, self = Ref(DEBUG_LOCATION, "dns-resolving")](
+                    DnsCache::Answer answer) {
+                  OnRequestComplete(ResultFromAnswer(answer));
+                });
 }
 
 bool ValueInJsonArray(const Json::Array& array, const char* value) {
@@ -251,7 +286,7 @@ bool ValueInJsonArray(const Json::Array& array, const char* value) {
   return false;
 }
 
-std::string ChooseServiceConfig(char* service_config_choice_json,
+std::string ChooseServiceConfig(absl::string_view service_config_choice_json,
                                 grpc_error_handle* error) {
   auto json = Json::Parse(service_config_choice_json);
   if (!json.ok()) {
@@ -336,114 +371,122 @@ std::string ChooseServiceConfig(char* service_config_choice_json,
 void AresClientChannelDNSResolver::AresRequestWrapper::OnHostnameResolved(
     void* arg, grpc_error_handle error) {
   auto* self = static_cast<AresRequestWrapper*>(arg);
-  absl::optional<Result> result;
+  absl::optional<DnsCache::Answer> answer;
   {
     MutexLock lock(&self->on_resolved_mu_);
     self->hostname_request_.reset();
-    result = self->OnResolvedLocked(error);
-  }
-  if (result.has_value()) {
-    self->resolver_->OnRequestComplete(std::move(*result));
+    answer = self->OnResolvedLocked(error);
   }
+  if (answer.has_value()) self->on_done_(std::move(*answer));
   self->Unref(DEBUG_LOCATION, "OnHostnameResolved");
 }
 
 void AresClientChannelDNSResolver::AresRequestWrapper::OnSRVResolved(
     void* arg, grpc_error_handle error) {
   auto* self = static_cast<AresRequestWrapper*>(arg);
-  absl::optional<Result> result;
+  absl::optional<DnsCache::Answer> answer;
   {
     MutexLock lock(&self->on_resolved_mu_);
     self->srv_request_.reset();
-    result = self->OnResolvedLocked(error);
-  }
-  if (result.has_value()) {
-    self->resolver_->OnRequestComplete(std::move(*result));
+    answer = self->OnResolvedLocked(error);
   }
+  if (answer.has_value()) self->on_done_(std::move(*answer));
   self->Unref(DEBUG_LOCATION, "OnSRVResolved");
 }
 
 void AresClientChannelDNSResolver::AresRequestWrapper::OnTXTResolved(
     void* arg, grpc_error_handle error) {
   auto* self = static_cast<AresRequestWrapper*>(arg);
-  absl::optional<Result> result;
+  absl::optional<DnsCache::Answer> answer;
   {
     MutexLock lock(&self->on_resolved_mu_);
     self->txt_request_.reset();
-    result = self->OnResolvedLocked(error);
-  }
-  if (result.has_value()) {
-    self->resolver_->OnRequestComplete(std::move(*result));
+    answer = self->OnResolvedLocked(error);
   }
+  if (answer.has_value()) self->on_done_(std::move(*answer));
   self->Unref(DEBUG_LOCATION, "OnTXTResolved");
 }
 
-// Returns a Result if resolution is complete.
-// callers must release the lock and call OnRequestComplete if a Result is
-// returned. This is because OnRequestComplete may Orphan the resolver, which
-// requires taking the lock.
-absl::optional<AresClientChannelDNSResolver::Result>
+// Returns an Answer if resolution is complete.
+// callers must release the lock and call on_done_ if an Answer is returned.
+// This is because on_done_ may Orphan this request, which requires taking the
+// lock.
+absl::optional<DnsCache::Answer>
 AresClientChannelDNSResolver::AresRequestWrapper::OnResolvedLocked(
     grpc_error_handle error) ABSL_EXCLUSIVE_LOCKS_REQUIRED(on_resolved_mu_) {
   if (hostname_request_ != nullptr || srv_request_ != nullptr ||
       txt_request_ != nullptr) {
     GRPC_CARES_TRACE_LOG(
-        "resolver:%p OnResolved() waiting for results (hostname: %s, srv: %s, "
+        "request:%p OnResolved() waiting for results (hostname: %s, srv: %s, "
         "txt: %s)",
         this, hostname_request_ != nullptr ? "waiting" : "done",
         srv_request_ != nullptr ? "waiting" : "done",
         txt_request_ != nullptr ? "waiting" : "done");
     return absl::nullopt;
   }
-  GRPC_CARES_TRACE_LOG("resolver:%p OnResolved() proceeding", this);
-  Result result;
-  result.args = resolver_->channel_args();
+  GRPC_CARES_TRACE_LOG("request:%p OnResolved() proceeding", this);
+  DnsCache::Answer answer;
   // TODO(roth): Change logic to be able to report failures for addresses
   // and service config independently of each other.
   if (addresses_ != nullptr || balancer_addresses_ != nullptr) {
     if (addresses_ != nullptr) {
-      result.addresses = std::move(*addresses_);
+      answer.addresses = std::move(*addresses_);
     } else {
-      result.addresses = ServerAddressList();
+      answer.addresses = ServerAddressList();
     }
     if (service_config_json_ != nullptr) {
-      grpc_error_handle service_config_error = GRPC_ERROR_NONE;
-      std::string service_config_string =
-          ChooseServiceConfig(service_config_json_, &service_config_error);
-      if (!GRPC_ERROR_IS_NONE(service_config_error)) {
-        result.service_config = absl::UnavailableError(
-            absl::StrCat("failed to parse service config: ",
-                         grpc_error_std_string(service_config_error)));
-        GRPC_ERROR_UNREF(service_config_error);
-      } else if (!service_config_string.empty()) {
-        GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
-                             this, service_config_string.c_str());
-        result.service_config = ServiceConfigImpl::Create(
-            resolver_->channel_args(), service_config_string);
-        if (!result.service_config.ok()) {
-          result.service_config = absl::UnavailableError(
-              absl::StrCat("failed to parse service config: ",
-                           result.service_config.status().message()));
-        }
-      }
+      answer.service_config_json = std::string(service_config_json_);
     }
     if (balancer_addresses_ != nullptr) {
-      result.args = SetGrpcLbBalancerAddresses(
-          result.args, ServerAddressList(*balancer_addresses_));
+      answer.balancer_addresses = std::move(*balancer_addresses_);
     }
   } else {
-    GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", this,
+    GRPC_CARES_TRACE_LOG("request:%p dns resolution failed: %s", this,
                          grpc_error_std_string(error).c_str());
     std::string error_message;
     grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
-    absl::Status status = absl::UnavailableError(
-        absl::StrCat("DNS resolution failed for ", resolver_->name_to_resolve(),
-                     ": ", error_message));
-    result.addresses = status;
-    result.service_config = status;
+    answer.addresses = absl::UnavailableError(absl::StrCat(
+        "DNS resolution failed for ", name_to_resolve_, ": ", error_message));
   }
+  return std::move(answer);
+}
 
-  return std::move(result);
+AresClientChannelDNSResolver::Result
+AresClientChannelDNSResolver::ResultFromAnswer(const DnsCache::Answer& answer) {
+  Result result;
+  result.args = channel_args();
+  if (!answer.addresses.ok()) {
+    result.addresses = answer.addresses.status();
+    result.service_config = answer.addresses.status();
+    return result;
+  }
+  result.addresses = *answer.addresses;
+  if (answer.service_config_json.has_value()) {
+    grpc_error_handle service_config_error = GRPC_ERROR_NONE;
+    std::string service_config_string =
+        ChooseServiceConfig(*answer.service_config_json, &service_config_error);
+    if (!GRPC_ERROR_IS_NONE(service_config_error)) {
+      result.service_config = absl::UnavailableError(
+          absl::StrCat("failed to parse service config: ",
+                       grpc_error_std_string(service_config_error)));
+      GRPC_ERROR_UNREF(service_config_error);
+    } else if (!service_config_string.empty()) {
+      GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
+                           this, service_config_string.c_str());
+      result.service_config =
+          ServiceConfigImpl::Create(channel_args(), service_config_string);
+      if (!result.service_config.ok()) {
+        result.service_config = absl::UnavailableError(
+            absl::StrCat("failed to parse service config: ",
+                         result.service_config.status().message()));
+      }
+    }
+  }
+  if (answer.balancer_addresses.has_value()) {
+    result.args = SetGrpcLbBalancerAddresses(
+        result.args, ServerAddressList(*answer.balancer_addresses));
+  }
+  return result;
 }
 
 //
@@ -0,0 +1,271 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <grpc/grpc.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+
+namespace grpc_core {
+
+constexpr size_t DnsCache::kMaxEntries;
+
+namespace {
+
+// Returned by Lookup() when the answer came from the cache.
+class AnsweredLookup : public Orphanable {
+ public:
+  void Orphan() override { delete this; }
+};
+
+}  // namespace
+
+// One lookup in flight for a key. Its I/O is driven by the interested parties
+// of the callers waiting on it. A background refresh has none; it relies on
+// the polling engine (or, for the native resolver, the executor) to make
+// progress without them.
+class DnsCache::Fetch : public RefCounted<Fetch> {
+ public:
+  explicit Fetch(std::string key)
+      : key(std::move(key)), pollset_set(grpc_pollset_set_create()) {}
+  ~Fetch() override {
+    handle.reset();
+    grpc_pollset_set_destroy(pollset_set);
+  }
+
+  const std::string key;
+  grpc_pollset_set* const pollset_set;
+  // The rest is guarded by the cache's mu_.
+  bool done = false;
+  OrphanablePtr<Orphanable> handle;
+  std::vector<Waiter*> waiters;
+};
+
+// A caller waiting on a Fetch. Owned by the caller.
+class DnsCache::Waiter : public Orphanable {
+ public:
+  Waiter(DnsCache* cache, Fetch* fetch, grpc_pollset_set* interested_parties,
+         OnAnswerFn on_answer)
+      : cache(cache),
+        fetch(fetch),
+        interested_parties(interested_parties),
+        on_answer(std::move(on_answer)) {}
+
+  void Orphan() override {
+    cache->RemoveWaiter(this);
+    delete this;
+  }
+
+  DnsCache* const cache;
+  // Guarded by the cache's mu_. Null once answered.
+  Fetch* fetch;
+  grpc_pollset_set* const interested_parties;
+  OnAnswerFn on_answer;
+};
+
+DnsCache* DnsCache::Get() {
+  static DnsCache* cache = new DnsCache();
+  return cache;
+}
+
+absl::optional<DnsCache::Options> DnsCache::OptionsFromChannelArgs(
+    const ChannelArgs& args) {
+  const Duration ttl = args.GetDurationFromIntMillis(GRPC_ARG_DNS_CACHE_TTL_MS)
+                           .value_or(Duration::Zero());
+  if (ttl <= Duration::Zero()) return absl::nullopt;
+  Options options;
+  options.ttl = ttl;
+  options.max_stale = std::max(
+      Duration::Zero(),
+      args.GetDurationFromIntMillis(GRPC_ARG_DNS_CACHE_MAX_STALE_MS)
+          .value_or(ttl));
+  return options;
+}
+
+OrphanablePtr<Orphanable> DnsCache::Lookup(const std::string& key,
+                                           const Options& options,
+                                           grpc_pollset_set* interested_parties,
+                                           LookupFn lookup_fn,
+                                           OnAnswerFn on_answer) {
+  std::shared_ptr<const Answer> answer;
+  RefCountedPtr<Fetch> new_fetch;
+  OrphanablePtr<Orphanable> waiter;
+  {
+    MutexLock lock(&mu_);
+    const Timestamp now = Timestamp::Now();
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      if (entries_.size() >= kMaxEntries) EvictLocked(now);
+      it = entries_.emplace(key, Entry()).first;
+    }
+    Entry& entry = it->second;
+    entry.evict_after =
+        std::max(entry.evict_after, now + options.ttl + options.max_stale);
+    if (entry.answer != nullptr) {
+      const Duration age = now - entry.resolved_at;
+      bool refresh = false;
+      if (age < options.ttl) {
+        ++stats_.hits;
+        answer = entry.answer;
+        // Prefetch in the last tenth of the TTL.
+        refresh = age >= options.ttl - options.ttl / 10;
+      } else if (age < options.ttl + options.max_stale) {
+        ++stats_.stale_hits;
+        answer = entry.answer;
+        refresh = true;
+      }
+      if (refresh && entry.fetch == nullptr) {
+        ++stats_.refreshes;
+        new_fetch = StartFetchLocked(key, &entry);
+      }
+    }
+    if (answer == nullptr) {
+      if (entry.fetch != nullptr) {
+        ++stats_.coalesced;
+      } else {
+        ++stats_.misses;
+        new_fetch = StartFetchLocked(key, &entry);
+      }
+      auto* w = new Waiter(this, entry.fetch.get(), interested_parties,
+                           std::move(on_answer));
+      entry.fetch->waiters.push_back(w);
+      grpc_pollset_set_add_pollset_set(entry.fetch->pollset_set,
+                                       interested_parties);
+      waiter.reset(w);
+    }
+  }
+  if (new_fetch != nullptr) {
+    RunFetch(std::move(new_fetch), std::move(lookup_fn));
+  }
+  if (answer != nullptr) {
+    on_answer(std::move(answer));
+    return MakeOrphanable<AnsweredLookup>();
+  }
+  return waiter;
+}
+
+RefCountedPtr<DnsCache::Fetch> DnsCache::StartFetchLocked(
+    const std::string& key, Entry* entry) {
+  entry->fetch = MakeRefCounted<Fetch>(key);
+  return entry->fetch;
+}
+
+void DnsCache::RunFetch(RefCountedPtr<Fetch> fetch, LookupFn lookup_fn) {
+  Fetch* f = fetch.get();
+  OrphanablePtr<Orphanable> handle = lookup_fn(
+      f->pollset_set, [this, fetch = std::move(fetch)](Answer answer) {
+        OnFetchDone(fetch, std::move(answer));
+      });
+  MutexLock lock(&mu_);
+  // If the lookup already finished, the handle is dropped on return.
+  if (!f->done) f->handle = std::move(handle);
+}
+
+void DnsCache::OnFetchDone(RefCountedPtr<Fetch> fetch, Answer answer) {
+  auto shared_answer = std::make_shared<const Answer>(std::move(answer));
+  std::vector<OnAnswerFn> callbacks;
+  // Orphaned outside the lock. This also drops the lookup's ref to fetch.
+  OrphanablePtr<Orphanable> handle;
+  {
+    MutexLock lock(&mu_);
+    fetch->done = true;
+    handle = std::move(fetch->handle);
+    if (!shared_answer->addresses.ok()) ++stats_.failures;
+    auto it = entries_.find(fetch->key);
+    if (it != entries_.end() && it->second.fetch == fetch) {
+      Entry& entry = it->second;
+      entry.fetch.reset();
+      // A failure leaves the previous answer, if any, to age out.
+      if (shared_answer->addresses.ok()) {
+        entry.answer = shared_answer;
+        entry.resolved_at = Timestamp::Now();
+      }
+      if (entry.answer == nullptr) entries_.erase(it);
+    }
+    for (Waiter* w : fetch->waiters) {
+      grpc_pollset_set_del_pollset_set(fetch->pollset_set,
+                                       w->interested_parties);
+      w->fetch = nullptr;
+      callbacks.push_back(std::move(w->on_answer));
+    }
+    fetch->waiters.clear();
+  }
+  for (OnAnswerFn& callback : callbacks) callback(shared_answer);
+}
+
+void DnsCache::RemoveWaiter(Waiter* waiter) {
+  MutexLock lock(&mu_);
+  Fetch* fetch = waiter->fetch;
+  if (fetch == nullptr) return;
+  // The lookup keeps running; its answer is still worth caching.
+  fetch->waiters.erase(
+      std::find(fetch->waiters.begin(), fetch->waiters.end(), waiter));
+  grpc_pollset_set_del_pollset_set(fetch->pollset_set,
+                                   waiter->interested_parties);
+  waiter->fetch = nullptr;
+}
+
+void DnsCache::EvictLocked(Timestamp now) {
+  // Drop the answers no caller would use anymore.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.fetch == nullptr && it->second.evict_after <= now) {
+      entries_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  if (entries_.size() < kMaxEntries) return;
+  // Still full: drop the answer resolved longest ago.
+  auto oldest = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->second.fetch != nullptr) continue;
+    if (oldest == entries_.end() ||
+        it->second.resolved_at < oldest->second.resolved_at) {
+      oldest = it;
+    }
+  }
+  if (oldest != entries_.end()) entries_.erase(oldest);
+}
+
+Json DnsCache::StatsToJson() {
+  MutexLock lock(&mu_);
+  return Json::Object{
+      {"dnsCache",
+       Json::Object{
+           {"entries", std::to_string(entries_.size())},
+           {"hits", std::to_string(stats_.hits)},
+           {"staleHits", std::to_string(stats_.stale_hits)},
+           {"misses", std::to_string(stats_.misses)},
+           {"coalesced", std::to_string(stats_.coalesced)},
+           {"refreshes", std::to_string(stats_.refreshes)},
+           {"failures", std::to_string(stats_.failures)},
+       }},
+  };
+}
+
+}  // namespace grpc_core
+
+char* grpc_dns_cache_get_stats(void) {
+  grpc_core::ExecCtx exec_ctx;
+  return gpr_strdup(grpc_core::DnsCache::Get()->StatsToJson().Dump().c_str());
+}
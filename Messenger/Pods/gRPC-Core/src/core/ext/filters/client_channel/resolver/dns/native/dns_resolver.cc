@@ -34,6 +34,7 @@
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
@@ -87,6 +88,10 @@ class NativeClientChannelDNSResolver : public PollingResolver {
 
   void OnResolved(
       absl::StatusOr<std::vector<grpc_resolved_address>> addresses_or);
+  void OnCachedAnswer(const DnsCache::Answer& answer);
+
+  // Set if resolutions go through the DnsCache.
+  const absl::optional<DnsCache::Options> cache_options_;
 };
 
 NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
@@ -105,7 +110,8 @@ NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
               .set_jitter(GRPC_DNS_RECONNECT_JITTER)
               .set_max_backoff(Duration::Milliseconds(
                   GRPC_DNS_RECONNECT_MAX_BACKOFF_SECONDS * 1000)),
-          &grpc_trace_dns_resolver) {
+          &grpc_trace_dns_resolver),
+      cache_options_(DnsCache::OptionsFromChannelArgs(channel_args)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
     gpr_log(GPR_DEBUG, "[dns_resolver=%p] created", this);
   }
@@ -118,6 +124,38 @@ NativeClientChannelDNSResolver::~NativeClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> NativeClientChannelDNSResolver::StartRequest() {
+  if (cache_options_.has_value()) {
+    return DnsCache::Get()->Lookup(
+        absl::StrCat("native:", name_to_resolve()), *cache_options_,
+        interested_parties(),
+        [name = name_to_resolve()](
+            grpc_pollset_set* interested_parties,
+            std::function<void(DnsCache::Answer)> on_done) {
+          GetDNSResolver()->LookupHostname(
+              [on_done = std::move(on_done)](
+                  absl::StatusOr<std::vector<grpc_resolved_address>>
+                      addresses_or) {
+                DnsCache::Answer answer;
+                if (addresses_or.ok()) {
+                  ServerAddressList addresses;
+                  for (auto& addr : *addresses_or) {
+                    addresses.emplace_back(addr, ChannelArgs());
+                  }
+                  answer.addresses = std::move(addresses);
+                } else {
+                  answer.addresses = addresses_or.status();
+                }
+                on_done(std::move(answer));
+              },
+              name, kDefaultSecurePort, kDefaultDNSRequestTimeout,
+              interested_parties, /*name_server=*/"");
+          return MakeOrphanable<Request>();
+        },
+        [this, self = Ref(DEBUG_LOCATION, "dns_cache")](
+            std::shared_ptr<const DnsCache::Answer> answer) {
+          OnCachedAnswer(*answer);
+        });
+  }
   Ref(DEBUG_LOCATION, "dns_request").release();
   auto dns_request_handle = GetDNSResolver()->LookupHostname(
       absl::bind_front(&NativeClientChannelDNSResolver::OnResolved, this),
@@ -154,6 +192,24 @@ void NativeClientChannelDNSResolver::OnResolved(
   Unref(DEBUG_LOCATION, "dns_request");
 }
 
+void NativeClientChannelDNSResolver::OnCachedAnswer(
+    const DnsCache::Answer& answer) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
+    gpr_log(GPR_DEBUG, "[dns_resolver=%p] cached answer, status=\"%s\"", this,
+            answer.addresses.status().ToString().c_str());
+  }
+  Result result;
+  if (answer.addresses.ok()) {
+    result.addresses = *answer.addresses;
+  } else {
+    result.addresses = absl::UnavailableError(
+        absl::StrCat("DNS resolution failed for ", name_to_resolve(), ": ",
+                     answer.addresses.status().ToString()));
+  }
+  result.args = channel_args();
+  OnRequestComplete(std::move(result));
+}
+
 //
 // Factory
 //
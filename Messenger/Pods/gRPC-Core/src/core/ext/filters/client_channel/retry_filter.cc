@@ -114,9 +114,14 @@
 // When constructing the "child" batches, we compare the state in the
 // CallAttempt object against the state in the CallData object to see
 // which batches need to be sent on the LB call for a given attempt.
-
-// TODO(roth): In subsequent PRs:
-// - implement hedging
+//
+// With a hedging policy, we do not wait for an attempt to fail before
+// starting the next one: a new attempt is started every hedgingDelay,
+// up to maxAttempts, and each of them is sent every op from the surface.
+// The first attempt to get a response (or a fatal status) wins; we
+// commit to it and cancel all of the others.  An attempt that fails with
+// one of the nonFatalStatusCodes is dropped, and the call carries on with
+// the remaining attempts.
 
 // By default, we buffer 256 KiB per RPC for retries.
 // TODO(roth): Do we have any data to suggest a better value?
@@ -251,11 +256,17 @@ class RetryFilter::CallData {
     ~CallAttempt() override;
 
     bool lb_call_committed() const { return lb_call_committed_; }
+    size_t started_send_message_count() const {
+      return started_send_message_count_;
+    }
 
     // Constructs and starts whatever batches are needed on this call
     // attempt.
     void StartRetriableBatches();
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
     // Frees cached send ops that have already been completed after
     // committing the call.
     void FreeCachedSendOpDataAfterCommit();
@@ -263,6 +274,9 @@ class RetryFilter::CallData {
     // Cancels the call attempt.
     void CancelFromSurface(grpc_transport_stream_op_batch* cancel_batch);
 
+    // Cancels and abandons a hedged attempt that lost to another one.
+    void CancelLosingHedge(CallCombinerClosureList* closures);
+
    private:
     // State used for starting a retryable batch on the call attempt's LB call.
     // This provides its own grpc_transport_stream_op_batch and other data
@@ -421,9 +435,6 @@ class RetryFilter::CallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -440,6 +451,11 @@ class RetryFilter::CallData {
     bool ShouldRetry(absl::optional<grpc_status_code> status,
                      absl::optional<Duration> server_pushback_ms);
 
+    // The hedging counterpart of ShouldRetry(): returns true if this attempt
+    // should be dropped in favor of the other (current or future) attempts.
+    bool ShouldAbandonHedgedAttempt(absl::optional<grpc_status_code> status,
+                                    absl::optional<Duration> server_pushback);
+
     // Abandons the call attempt.  Unrefs any deferred batches.
     void Abandon();
 
@@ -480,6 +496,9 @@ class RetryFilter::CallData {
     size_t completed_send_message_count_ = 0;
     size_t started_recv_message_count_ = 0;
     size_t completed_recv_message_count_ = 0;
+    // Batches with send ops that have not completed yet.  They may still
+    // point at the send op data cached in calld_.
+    int send_batches_in_flight_ = 0;
     bool started_send_initial_metadata_ : 1;
     bool completed_send_initial_metadata_ : 1;
     bool started_send_trailing_metadata_ : 1;
@@ -536,13 +555,18 @@ class RetryFilter::CallData {
   // Caches data for send ops so that it can be retried later, if not
   // already cached.
   void MaybeCacheSendOpsForBatch(PendingBatch* pending);
+  // The Free*() methods defer freeing while send batches of abandoned
+  // attempts, which may still point at the cached data, are in flight.
   void FreeCachedSendInitialMetadata();
   // Frees cached send_message at index idx.
   void FreeCachedSendMessage(size_t idx);
   void FreeCachedSendTrailingMetadata();
   void FreeAllCachedSendOpData();
+  // Runs the deferred frees once the last such batch completes.
+  void OnAbandonedSendBatchComplete();
 
   // Commits the call so that no further retry attempts will be performed.
+  // When hedging, also cancels every attempt other than call_attempt.
   void RetryCommit(CallAttempt* call_attempt);
 
   // Starts a timer to retry after appropriate back-off.
@@ -552,6 +576,24 @@ class RetryFilter::CallData {
   static void OnRetryTimer(void* arg, grpc_error_handle error);
   static void OnRetryTimerLocked(void* arg, grpc_error_handle error);
 
+  bool hedging() const {
+    return retry_policy_ != nullptr && retry_policy_->hedging();
+  }
+  // Returns true if another hedged attempt may be started now.
+  bool CanStartHedgedAttempt();
+  // Starts a timer to start the next hedged attempt after delay, replacing
+  // any timer that is already pending.
+  void StartHedgingTimer(Duration delay, bool is_transparent_retry);
+  void MaybeCancelHedgingTimer();
+  static void OnHedgingTimer(void* arg, grpc_error_handle error);
+  static void OnHedgingTimerLocked(void* arg, grpc_error_handle error);
+  // Removes a failed hedged attempt from hedged_attempts_.  If delay is
+  // set, the next attempt is started after delay instead of on the normal
+  // hedging schedule.
+  void DropHedgedAttempt(CallAttempt* call_attempt,
+                         absl::optional<Duration> delay,
+                         bool is_transparent_retry);
+
   // Adds a closure to closures to start a transparent retry.
   void AddClosureToStartTransparentRetry(CallCombinerClosureList* closures);
   static void StartTransparentRetry(void* arg, grpc_error_handle error);
@@ -579,10 +621,12 @@ class RetryFilter::CallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
+  // The most recently started attempt.  When hedging, this is also the
+  // last entry in hedged_attempts_ until the call is committed.
   RefCountedPtr<CallAttempt> call_attempt_;
+  // All hedged attempts that are still in flight.  Empty when not hedging
+  // and once the call is committed.
+  absl::InlinedVector<RefCountedPtr<CallAttempt>, 3> hedged_attempts_;
 
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
@@ -605,22 +649,39 @@ class RetryFilter::CallData {
   bool retry_timer_pending_ : 1;
   bool retry_codepath_started_ : 1;
   bool sent_transparent_retry_not_seen_by_server_ : 1;
+  bool hedging_stopped_ : 1;
   int num_attempts_completed_ = 0;
   grpc_timer retry_timer_;
   grpc_closure retry_closure_;
 
+  // Hedging state.  A new timer is allocated on the arena each time one is
+  // started, so that a cancelled timer whose callback has not run yet never
+  // shares its closure with the timer that replaced it.
+  struct HedgingTimer {
+    CallData* calld;
+    bool is_transparent_retry;
+    grpc_timer timer;
+    grpc_closure closure;
+  };
+  HedgingTimer* hedging_timer_ = nullptr;
+  int num_attempts_started_ = 0;
+
   // Cached data for retrying send ops.
+  // Send batches still in flight on abandoned attempts (losing hedges and
+  // failed attempts).
+  int abandoned_send_batches_in_flight_ = 0;
   // send_initial_metadata
   bool seen_send_initial_metadata_ = false;
+  bool free_send_initial_metadata_deferred_ = false;
   grpc_metadata_batch send_initial_metadata_{arena_};
-  // TODO(roth): As part of implementing hedging, we'll probably need to
-  // have the LB call set a value in CallAttempt and then propagate it
-  // from CallAttempt to the parent call when we commit.  Otherwise, we
-  // may leave this with a value for a peer other than the one we
-  // actually commit to.  Alternatively, maybe see if there's a way to
-  // change the surface API such that the peer isn't available until
-  // after initial metadata is received?  (Could even change the
-  // transport API to return this with the recv_initial_metadata op.)
+  // TODO(roth): With hedging, we'll probably need to have the LB call set
+  // a value in CallAttempt and then propagate it from CallAttempt to the
+  // parent call when we commit.  Otherwise, we may leave this with a value
+  // for a peer other than the one we actually commit to.  Alternatively,
+  // maybe see if there's a way to change the surface API such that the
+  // peer isn't available until after initial metadata is received?  (Could
+  // even change the transport API to return this with the
+  // recv_initial_metadata op.)
   gpr_atm* peer_string_;
   // send_message
   // When we get a send_message op, we replace the original byte stream
@@ -632,10 +693,12 @@ class RetryFilter::CallData {
   struct CachedSendMessage {
     SliceBuffer* slices;
     uint32_t flags;
+    bool free_deferred = false;
   };
   absl::InlinedVector<CachedSendMessage, 3> send_messages_;
   // send_trailing_metadata
   bool seen_send_trailing_metadata_ = false;
+  bool free_send_trailing_metadata_deferred_ = false;
   grpc_metadata_batch send_trailing_metadata_{arena_};
 };
 
@@ -752,10 +815,6 @@ RetryFilter::CallData::CallAttempt::~CallAttempt() {
 }
 
 void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
   if (completed_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
@@ -796,11 +855,9 @@ bool RetryFilter::CallData::CallAttempt::HaveSendOpsToReplay() {
 
 void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
   // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
   if (!calld_->retry_committed_) return;
+  // Only the attempt we committed to can switch.
+  if (calld_->call_attempt_.get() != this) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
   // If the perAttemptRecvTimeout timer is pending, we can't switch yet.
@@ -930,7 +987,7 @@ void RetryFilter::CallData::CallAttempt::MaybeAddBatchForCancelOp(
     return;
   }
   sent_cancel_stream_ = true;
-  BatchData* cancel_batch_data = CreateBatch(1, /*set_on_complete=*/true);
+  BatchData* cancel_batch_data = CreateBatch(1, /*set_on_complete=*/false);
   cancel_batch_data->AddCancelStreamOp(error);
   AddClosureForBatch(cancel_batch_data->batch(),
                      "start cancellation batch on call attempt", closures);
@@ -1125,11 +1182,30 @@ void RetryFilter::CallData::CallAttempt::CancelFromSurface(
   lb_call_->StartTransportStreamOpBatch(cancel_batch);
 }
 
+void RetryFilter::CallData::CallAttempt::CancelLosingHedge(
+    CallCombinerClosureList* closures) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: cancelling losing hedged attempt",
+            calld_->chand_, calld_, this);
+  }
+  MaybeCancelPerAttemptRecvTimer();
+  MaybeAddBatchForCancelOp(
+      grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                             "committed to another hedged attempt"),
+                         GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED),
+      closures);
+  Abandon();
+}
+
 bool RetryFilter::CallData::CallAttempt::ShouldRetry(
     absl::optional<grpc_status_code> status,
     absl::optional<Duration> server_pushback) {
   // If no retry policy, don't retry.
   if (calld_->retry_policy_ == nullptr) return false;
+  if (calld_->retry_policy_->hedging()) {
+    return ShouldAbandonHedgedAttempt(status, server_pushback);
+  }
   // Check status.
   if (status.has_value()) {
     if (GPR_LIKELY(*status == GRPC_STATUS_OK)) {
@@ -1226,7 +1302,94 @@ bool RetryFilter::CallData::CallAttempt::ShouldRetry(
   return true;
 }
 
+bool RetryFilter::CallData::CallAttempt::ShouldAbandonHedgedAttempt(
+    absl::optional<grpc_status_code> status,
+    absl::optional<Duration> server_pushback) {
+  if (status.has_value()) {
+    if (GPR_LIKELY(*status == GRPC_STATUS_OK)) {
+      if (calld_->retry_throttle_data_ != nullptr) {
+        calld_->retry_throttle_data_->RecordSuccess();
+      }
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: call succeeded",
+                calld_->chand_, calld_, this);
+      }
+      return false;
+    }
+    // Any status that is not configured as non-fatal ends the call.
+    if (!calld_->retry_policy_->non_fatal_status_codes().Contains(*status)) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p attempt=%p: status %s is fatal for "
+                "hedging",
+                calld_->chand_, calld_, this,
+                grpc_status_code_to_string(*status));
+      }
+      return false;
+    }
+  }
+  // Record the failure.  Unlike with retries, being throttled only stops
+  // us from starting new attempts; the ones already in flight carry on.
+  if (calld_->retry_throttle_data_ != nullptr &&
+      !calld_->retry_throttle_data_->RecordFailure()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: hedging throttled",
+              calld_->chand_, calld_, this);
+    }
+    calld_->hedging_stopped_ = true;
+  }
+  // Check whether the call is committed.
+  if (calld_->retry_committed_) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: retries already committed",
+              calld_->chand_, calld_, this);
+    }
+    return false;
+  }
+  ++calld_->num_attempts_completed_;
+  // A negative server push-back means that no more attempts may be sent.
+  if (server_pushback.has_value() && *server_pushback < Duration::Zero()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: hedging stopped by server "
+              "push-back",
+              calld_->chand_, calld_, this);
+    }
+    calld_->hedging_stopped_ = true;
+  }
+  // Check with call dispatch controller.
+  auto* service_config_call_data =
+      static_cast<ClientChannelServiceConfigCallData*>(
+          calld_->call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+  if (!service_config_call_data->call_dispatch_controller()->ShouldRetry()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: call dispatch controller denied "
+              "hedging",
+              calld_->chand_, calld_, this);
+    }
+    calld_->hedging_stopped_ = true;
+  }
+  // Drop this attempt if there is anything left to wait for.  Otherwise,
+  // its status is the call's status.
+  if (calld_->hedged_attempts_.size() > 1 ||
+      calld_->CanStartHedgedAttempt()) {
+    return true;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: last hedged attempt failed",
+            calld_->chand_, calld_, this);
+  }
+  return false;
+}
+
 void RetryFilter::CallData::CallAttempt::Abandon() {
+  // Send batches still in flight keep the cached send op data alive.
+  if (!abandoned_) {
+    calld_->abandoned_send_batches_in_flight_ += send_batches_in_flight_;
+  }
   abandoned_ = true;
   // Unref batches for deferred completion callbacks that will now never
   // be invoked.
@@ -1282,9 +1445,8 @@ void RetryFilter::CallData::CallAttempt::OnPerAttemptRecvTimerLocked(
   if (GRPC_ERROR_IS_NONE(error) &&
       call_attempt->per_attempt_recv_timer_pending_) {
     call_attempt->per_attempt_recv_timer_pending_ = false;
-    // Cancel this attempt.
-    // TODO(roth): When implementing hedging, we should not cancel the
-    // current attempt.
+    // Cancel this attempt.  (Hedging policies have no per-attempt timeout,
+    // so we only get here for retries.)
     call_attempt->MaybeAddBatchForCancelOp(
         grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                                "retry perAttemptRecvTimeout exceeded"),
@@ -1350,6 +1512,11 @@ RetryFilter::CallData::CallAttempt::BatchData::BatchData(
   if (set_on_complete) {
     GRPC_CLOSURE_INIT(&on_complete_, OnComplete, this, nullptr);
     batch_.on_complete = &on_complete_;
+    // Only batches with send ops use on_complete.
+    ++call_attempt_->send_batches_in_flight_;
+    if (call_attempt_->abandoned_) {
+      ++call_attempt_->calld_->abandoned_send_batches_in_flight_;
+    }
   }
 }
 
@@ -1367,10 +1534,6 @@ RetryFilter::CallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::CallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
@@ -1783,6 +1946,16 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
         calld->sent_transparent_retry_not_seen_by_server_ = true;
         retry = kTransparentRetry;
       }
+      // A hedged attempt that never reached the server is replaced right
+      // away and does not count against maxAttempts, as long as another
+      // attempt may be started at all.
+      if (retry == kTransparentRetry && calld->hedging()) {
+        --calld->num_attempts_started_;
+        if (!calld->CanStartHedgedAttempt()) {
+          ++calld->num_attempts_started_;
+          retry = kNoRetry;
+        }
+      }
     }
     // If not transparently retrying, check for configurable retry.
     if (retry == kNoRetry &&
@@ -1800,10 +1973,18 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
                     GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED)
               : GRPC_ERROR_REF(error),
           &closures);
+      // When hedging, drop this attempt and leave the rest to the others.
       // For transparent retries, add a closure to immediately start a new
       // call attempt.
       // For configurable retries, start retry timer.
-      if (retry == kTransparentRetry) {
+      if (calld->hedging()) {
+        calld->DropHedgedAttempt(
+            call_attempt,
+            retry == kTransparentRetry
+                ? absl::optional<Duration>(Duration::Zero())
+                : server_pushback,
+            retry == kTransparentRetry);
+      } else if (retry == kTransparentRetry) {
         calld->AddClosureToStartTransparentRetry(&closures);
       } else {
         calld->StartRetryTimer(server_pushback);
@@ -1841,6 +2022,16 @@ void RetryFilter::CallData::CallAttempt::BatchData::
                batch_.send_message == batch->send_message &&
                batch_.send_trailing_metadata == batch->send_trailing_metadata;
       });
+  // When hedging, an attempt that is behind the others may finish replaying
+  // a send_message op after the surface has already moved on to the next
+  // message.  Only complete the pending batch if it holds the message that
+  // this batch just sent.
+  if (pending != nullptr && batch_.send_message &&
+      (!pending->send_ops_cached ||
+       call_attempt_->completed_send_message_count_ !=
+           calld->send_messages_.size())) {
+    pending = nullptr;
+  }
   // If batch_data is a replay batch, then there will be no pending
   // batch to complete.
   if (pending == nullptr) {
@@ -1901,9 +2092,11 @@ void RetryFilter::CallData::CallAttempt::BatchData::OnComplete(
             grpc_error_std_string(error).c_str(),
             grpc_transport_stream_op_batch_string(&batch_data->batch_).c_str());
   }
+  --call_attempt->send_batches_in_flight_;
   // If this attempt has been abandoned, then we're not going to propagate
   // the completion of this batch, so do nothing.
   if (call_attempt->abandoned_) {
+    calld->OnAbandonedSendBatchComplete();
     GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
                             "on_complete for abandoned attempt");
     return;
@@ -1994,11 +2187,15 @@ void RetryFilter::CallData::CallAttempt::BatchData::
   // want those modifications to be passed forward to subsequent attempts.
   //
   // If we've already completed one or more attempts, add the
-  // grpc-retry-attempts header.
+  // grpc-retry-attempts header.  When hedging, this counts the attempts
+  // started before this one instead.
   call_attempt_->send_initial_metadata_ = calld->send_initial_metadata_.Copy();
-  if (GPR_UNLIKELY(calld->num_attempts_completed_ > 0)) {
+  const int previous_attempts = calld->hedging()
+                                    ? calld->num_attempts_started_ - 1
+                                    : calld->num_attempts_completed_;
+  if (GPR_UNLIKELY(previous_attempts > 0)) {
     call_attempt_->send_initial_metadata_.Set(GrpcPreviousRpcAttemptsMetadata(),
-                                              calld->num_attempts_completed_);
+                                              previous_attempts);
   } else {
     call_attempt_->send_initial_metadata_.Remove(
         GrpcPreviousRpcAttemptsMetadata());
@@ -2090,8 +2287,8 @@ void RetryFilter::CallData::CallAttempt::BatchData::AddCancelStreamOp(
     grpc_error_handle error) {
   batch_.cancel_stream = true;
   batch_.payload->cancel_stream.cancel_error = error;
-  // Override on_complete callback.
   GRPC_CLOSURE_INIT(&on_complete_, OnCompleteForCancelOp, this, nullptr);
+  batch_.on_complete = &on_complete_;
 }
 
 //
@@ -2183,7 +2380,8 @@ RetryFilter::CallData::CallData(RetryFilter* chand,
       retry_committed_(false),
       retry_timer_pending_(false),
       retry_codepath_started_(false),
-      sent_transparent_retry_not_seen_by_server_(false) {}
+      sent_transparent_retry_not_seen_by_server_(false),
+      hedging_stopped_(false) {}
 
 RetryFilter::CallData::~CallData() {
   FreeAllCachedSendOpData();
@@ -2231,18 +2429,19 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     // If we have a current call attempt, commit the call, then send
     // the cancellation down to that attempt.  When the call fails, it
     // will not be retried, because we have committed it here.
+    // When hedging, committing also cancels all of the other attempts, so
+    // only this one is left to pass the batch down to.
     if (call_attempt_ != nullptr) {
       RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
       // Note: This will release the call combiner.
       call_attempt_->CancelFromSurface(batch);
       return;
     }
+    // Cancel hedging timer if needed.
+    if (hedging_timer_ != nullptr) {
+      MaybeCancelHedgingTimer();
+      FreeAllCachedSendOpData();
+    }
     // Cancel retry timer if needed.
     if (retry_timer_pending_) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2269,6 +2468,13 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
                             "added pending batch while retry timer pending");
     return;
   }
+  // Likewise if every hedged attempt has failed and the timer to start the
+  // next one is pending.
+  if (call_attempt_ == nullptr && hedging_timer_ != nullptr) {
+    GRPC_CALL_COMBINER_STOP(call_combiner_,
+                            "added pending batch while hedging timer pending");
+    return;
+  }
   // If we do not yet have a call attempt, create one.
   if (call_attempt_ == nullptr) {
     // If this is the first batch and retries are already committed
@@ -2316,6 +2522,23 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     CreateCallAttempt(/*is_transparent_retry=*/false);
     return;
   }
+  // If there are several hedged attempts in flight, send batches to all
+  // of them.
+  if (hedged_attempts_.size() > 1) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: starting batch on %" PRIuPTR
+              " hedged attempts",
+              chand_, this, hedged_attempts_.size());
+    }
+    CallCombinerClosureList closures;
+    for (auto& call_attempt : hedged_attempts_) {
+      call_attempt->AddRetriableBatches(&closures);
+    }
+    // Note: This will yield the call combiner.
+    closures.RunClosures(call_combiner_);
+    return;
+  }
   // Send batches to call attempt.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p", chand_,
@@ -2341,6 +2564,14 @@ RetryFilter::CallData::CreateLoadBalancedCall(
 
 void RetryFilter::CallData::CreateCallAttempt(bool is_transparent_retry) {
   call_attempt_ = MakeRefCounted<CallAttempt>(this, is_transparent_retry);
+  if (hedging() && !retry_committed_) {
+    hedged_attempts_.push_back(call_attempt_);
+    ++num_attempts_started_;
+    if (CanStartHedgedAttempt()) {
+      StartHedgingTimer(retry_policy_->hedging_delay(),
+                        /*is_transparent_retry=*/false);
+    }
+  }
   call_attempt_->StartRetriableBatches();
 }
 
@@ -2376,6 +2607,8 @@ void RetryFilter::CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
 }
 
 void RetryFilter::CallData::FreeCachedSendInitialMetadata() {
+  free_send_initial_metadata_deferred_ = abandoned_send_batches_in_flight_ > 0;
+  if (free_send_initial_metadata_deferred_) return;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: destroying send_initial_metadata",
             chand_, this);
@@ -2384,6 +2617,8 @@ void RetryFilter::CallData::FreeCachedSendInitialMetadata() {
 }
 
 void RetryFilter::CallData::FreeCachedSendMessage(size_t idx) {
+  send_messages_[idx].free_deferred = abandoned_send_batches_in_flight_ > 0;
+  if (send_messages_[idx].free_deferred) return;
   if (send_messages_[idx].slices != nullptr) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
       gpr_log(GPR_INFO,
@@ -2395,6 +2630,8 @@ void RetryFilter::CallData::FreeCachedSendMessage(size_t idx) {
 }
 
 void RetryFilter::CallData::FreeCachedSendTrailingMetadata() {
+  free_send_trailing_metadata_deferred_ = abandoned_send_batches_in_flight_ > 0;
+  if (free_send_trailing_metadata_deferred_) return;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: destroying send_trailing_metadata",
             chand_, this);
@@ -2414,6 +2651,20 @@ void RetryFilter::CallData::FreeAllCachedSendOpData() {
   }
 }
 
+void RetryFilter::CallData::OnAbandonedSendBatchComplete() {
+  GPR_ASSERT(abandoned_send_batches_in_flight_ > 0);
+  if (--abandoned_send_batches_in_flight_ > 0) return;
+  if (free_send_initial_metadata_deferred_) {
+    FreeCachedSendInitialMetadata();
+  }
+  for (size_t i = 0; i < send_messages_.size(); ++i) {
+    if (send_messages_[i].free_deferred) FreeCachedSendMessage(i);
+  }
+  if (free_send_trailing_metadata_deferred_) {
+    FreeCachedSendTrailingMetadata();
+  }
+}
+
 //
 // pending_batches management
 //
@@ -2459,9 +2710,6 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
   if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
                    chand_->per_rpc_retry_buffer_size_)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2469,7 +2717,16 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
               "chand=%p calld=%p: exceeded retry buffer size, committing",
               chand_, this);
     }
-    RetryCommit(call_attempt_.get());
+    // If there are hedged attempts in flight, commit to the one that has
+    // sent the most messages.
+    CallAttempt* call_attempt = call_attempt_.get();
+    for (const auto& hedged_attempt : hedged_attempts_) {
+      if (hedged_attempt->started_send_message_count() >
+          call_attempt->started_send_message_count()) {
+        call_attempt = hedged_attempt.get();
+      }
+    }
+    RetryCommit(call_attempt);
   }
   return pending;
 }
@@ -2578,6 +2835,21 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand_, this);
   }
   if (call_attempt != nullptr) {
+    // Stop hedging and cancel the attempts we did not commit to.  (If there
+    // is no attempt yet, the pending hedging timer starts the one we'll
+    // commit to.)
+    if (hedging()) {
+      MaybeCancelHedgingTimer();
+      CallCombinerClosureList closures;
+      for (auto& hedged_attempt : hedged_attempts_) {
+        if (hedged_attempt.get() != call_attempt) {
+          hedged_attempt->CancelLosingHedge(&closures);
+        }
+      }
+      call_attempt_ = call_attempt->Ref(DEBUG_LOCATION, "RetryCommit");
+      hedged_attempts_.clear();
+      closures.RunClosuresWithoutYielding(call_combiner_);
+    }
     // If the call attempt's LB call has been committed, inform the call
     // dispatch controller that the call has been committed.
     // Note: If call_attempt is null, this is happening before the first
@@ -2639,6 +2911,103 @@ void RetryFilter::CallData::OnRetryTimerLocked(void* arg,
   GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnRetryTimer");
 }
 
+bool RetryFilter::CallData::CanStartHedgedAttempt() {
+  if (!hedging() || retry_committed_ || hedging_stopped_) return false;
+  if (num_attempts_started_ >= retry_policy_->max_attempts()) return false;
+  // Hedged attempts share the retry throttle, but only the attempts that
+  // fail are recorded against it.
+  return retry_throttle_data_ == nullptr ||
+         retry_throttle_data_->CanSendRetry();
+}
+
+void RetryFilter::CallData::StartHedgingTimer(Duration delay,
+                                              bool is_transparent_retry) {
+  MaybeCancelHedgingTimer();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting next hedged attempt in %" PRId64
+            " ms",
+            chand_, this, delay.millis());
+  }
+  hedging_timer_ = arena_->New<HedgingTimer>();
+  hedging_timer_->calld = this;
+  hedging_timer_->is_transparent_retry = is_transparent_retry;
+  GRPC_CLOSURE_INIT(&hedging_timer_->closure, OnHedgingTimer, hedging_timer_,
+                    nullptr);
+  GRPC_CALL_STACK_REF(owning_call_, "OnHedgingTimer");
+  grpc_timer_init(&hedging_timer_->timer, Timestamp::Now() + delay,
+                  &hedging_timer_->closure);
+}
+
+void RetryFilter::CallData::MaybeCancelHedgingTimer() {
+  if (hedging_timer_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: cancelling hedging timer", chand_,
+              this);
+    }
+    // Lame timer callback.
+    grpc_timer_cancel(&std::exchange(hedging_timer_, nullptr)->timer);
+  }
+}
+
+void RetryFilter::CallData::OnHedgingTimer(void* arg, grpc_error_handle error) {
+  auto* hedging_timer = static_cast<HedgingTimer*>(arg);
+  GRPC_CLOSURE_INIT(&hedging_timer->closure, OnHedgingTimerLocked,
+                    hedging_timer, nullptr);
+  GRPC_CALL_COMBINER_START(hedging_timer->calld->call_combiner_,
+                           &hedging_timer->closure, GRPC_ERROR_REF(error),
+                           "hedging timer fired");
+}
+
+void RetryFilter::CallData::OnHedgingTimerLocked(void* arg,
+                                                 grpc_error_handle error) {
+  auto* hedging_timer = static_cast<HedgingTimer*>(arg);
+  auto* calld = hedging_timer->calld;
+  // If every attempt has failed, this timer is starting the replacement, so
+  // it goes ahead even if we have since been throttled.
+  if (GRPC_ERROR_IS_NONE(error) && calld->hedging_timer_ == hedging_timer &&
+      GRPC_ERROR_IS_NONE(calld->cancelled_from_surface_) &&
+      (calld->call_attempt_ == nullptr || calld->CanStartHedgedAttempt())) {
+    calld->hedging_timer_ = nullptr;
+    calld->CreateCallAttempt(hedging_timer->is_transparent_retry);
+  } else {
+    if (calld->hedging_timer_ == hedging_timer) calld->hedging_timer_ = nullptr;
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "hedging timer cancelled");
+  }
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgingTimer");
+}
+
+void RetryFilter::CallData::DropHedgedAttempt(CallAttempt* call_attempt,
+                                              absl::optional<Duration> delay,
+                                              bool is_transparent_retry) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO, "chand=%p calld=%p: dropping hedged attempt=%p", chand_,
+            this, call_attempt);
+  }
+  for (auto it = hedged_attempts_.begin(); it != hedged_attempts_.end();
+       ++it) {
+    if (it->get() == call_attempt) {
+      hedged_attempts_.erase(it);
+      break;
+    }
+  }
+  if (call_attempt_.get() == call_attempt) {
+    if (hedged_attempts_.empty()) {
+      call_attempt_.reset(DEBUG_LOCATION, "DropHedgedAttempt");
+    } else {
+      call_attempt_ = hedged_attempts_.back();
+    }
+  }
+  // With no attempts left in flight, start the replacement right away (or
+  // after the server push-back).  ShouldAbandonHedgedAttempt() only lets us
+  // get here if a replacement is allowed.
+  if (hedged_attempts_.empty()) {
+    StartHedgingTimer(delay.value_or(Duration::Zero()), is_transparent_retry);
+  } else if (delay.has_value() && CanStartHedgedAttempt()) {
+    StartHedgingTimer(*delay, is_transparent_retry);
+  }
+}
+
 void RetryFilter::CallData::AddClosureToStartTransparentRetry(
     CallCombinerClosureList* closures) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
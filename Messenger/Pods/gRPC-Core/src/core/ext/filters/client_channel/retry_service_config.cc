@@ -163,39 +163,75 @@ RetryServiceConfigParser::ParseGlobalParams(const ChannelArgs& /*args*/,
 
 namespace {
 
-grpc_error_handle ParseRetryPolicy(
-    const ChannelArgs& args, const Json& json, int* max_attempts,
-    Duration* initial_backoff, Duration* max_backoff, float* backoff_multiplier,
-    StatusCodeSet* retryable_status_codes,
-    absl::optional<Duration>* per_attempt_recv_timeout) {
-  if (json.type() != Json::Type::OBJECT) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-        "field:retryPolicy error:should be of type object");
-  }
-  std::vector<grpc_error_handle> error_list;
-  // Parse maxAttempts.
+// Parses the maxAttempts field shared by retryPolicy and hedgingPolicy.
+void ParseMaxAttempts(const Json& json, const char* policy_name,
+                      int* max_attempts,
+                      std::vector<grpc_error_handle>* error_list) {
   auto it = json.object_value().find("maxAttempts");
   if (it == json.object_value().end()) {
-    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "field:maxAttempts error:required field missing"));
   } else {
     if (it->second.type() != Json::Type::NUMBER) {
-      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "field:maxAttempts error:should be of type number"));
     } else {
       *max_attempts =
           gpr_parse_nonnegative_int(it->second.string_value().c_str());
       if (*max_attempts <= 1) {
-        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             "field:maxAttempts error:should be at least 2"));
       } else if (*max_attempts > MAX_MAX_RETRY_ATTEMPTS) {
-        gpr_log(GPR_ERROR,
-                "service config: clamped retryPolicy.maxAttempts at %d",
-                MAX_MAX_RETRY_ATTEMPTS);
+        gpr_log(GPR_ERROR, "service config: clamped %s.maxAttempts at %d",
+                policy_name, MAX_MAX_RETRY_ATTEMPTS);
         *max_attempts = MAX_MAX_RETRY_ATTEMPTS;
       }
     }
   }
+}
+
+// Parses an optional array of status code names, such as
+// retryableStatusCodes or nonFatalStatusCodes.
+void ParseStatusCodes(const Json& json, const std::string& field_name,
+                      StatusCodeSet* status_codes,
+                      std::vector<grpc_error_handle>* error_list) {
+  auto it = json.object_value().find(field_name);
+  if (it == json.object_value().end()) return;
+  if (it->second.type() != Json::Type::ARRAY) {
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        absl::StrCat("field:", field_name, " error:must be of type array")));
+    return;
+  }
+  for (const Json& element : it->second.array_value()) {
+    if (element.type() != Json::Type::STRING) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
+          absl::StrCat("field:", field_name,
+                       " error:status codes should be of type string")));
+      continue;
+    }
+    grpc_status_code status;
+    if (!grpc_status_code_from_string(element.string_value().c_str(),
+                                      &status)) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
+          "field:", field_name, " error:failed to parse status code")));
+      continue;
+    }
+    status_codes->Add(status);
+  }
+}
+
+grpc_error_handle ParseRetryPolicy(
+    const ChannelArgs& args, const Json& json, int* max_attempts,
+    Duration* initial_backoff, Duration* max_backoff, float* backoff_multiplier,
+    StatusCodeSet* retryable_status_codes,
+    absl::optional<Duration>* per_attempt_recv_timeout) {
+  if (json.type() != Json::Type::OBJECT) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:retryPolicy error:should be of type object");
+  }
+  std::vector<grpc_error_handle> error_list;
+  // Parse maxAttempts.
+  ParseMaxAttempts(json, "retryPolicy", max_attempts, &error_list);
   // Parse initialBackoff.
   if (ParseJsonObjectFieldAsDuration(json.object_value(), "initialBackoff",
                                      initial_backoff, &error_list) &&
@@ -211,7 +247,7 @@ grpc_error_handle ParseRetryPolicy(
         "field:maxBackoff error:must be greater than 0"));
   }
   // Parse backoffMultiplier.
-  it = json.object_value().find("backoffMultiplier");
+  auto it = json.object_value().find("backoffMultiplier");
   if (it == json.object_value().end()) {
     error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "field:backoffMultiplier error:required field missing"));
@@ -231,30 +267,8 @@ grpc_error_handle ParseRetryPolicy(
     }
   }
   // Parse retryableStatusCodes.
-  it = json.object_value().find("retryableStatusCodes");
-  if (it != json.object_value().end()) {
-    if (it->second.type() != Json::Type::ARRAY) {
-      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-          "field:retryableStatusCodes error:must be of type array"));
-    } else {
-      for (const Json& element : it->second.array_value()) {
-        if (element.type() != Json::Type::STRING) {
-          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-              "field:retryableStatusCodes error:status codes should be of type "
-              "string"));
-          continue;
-        }
-        grpc_status_code status;
-        if (!grpc_status_code_from_string(element.string_value().c_str(),
-                                          &status)) {
-          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-              "field:retryableStatusCodes error:failed to parse status code"));
-          continue;
-        }
-        retryable_status_codes->Add(status);
-      }
-    }
-  }
+  ParseStatusCodes(json, "retryableStatusCodes", retryable_status_codes,
+                   &error_list);
   // Parse perAttemptRecvTimeout.
   if (args.GetBool(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING).value_or(false)) {
     it = json.object_value().find("perAttemptRecvTimeout");
@@ -266,8 +280,6 @@ grpc_error_handle ParseRetryPolicy(
             "form given by google.proto.Duration."));
       } else {
         *per_attempt_recv_timeout = per_attempt_recv_timeout_value;
-        // TODO(roth): As part of implementing hedging, relax this check such
-        // that we allow a value of 0 if a hedging policy is specified.
         if (per_attempt_recv_timeout_value == Duration::Zero()) {
           error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
               "field:perAttemptRecvTimeout error:must be greater than 0"));
@@ -291,14 +303,63 @@ grpc_error_handle ParseRetryPolicy(
   return GRPC_ERROR_CREATE_FROM_VECTOR("retryPolicy", &error_list);
 }
 
+grpc_error_handle ParseHedgingPolicy(const Json& json, int* max_attempts,
+                                     Duration* hedging_delay,
+                                     StatusCodeSet* non_fatal_status_codes) {
+  if (json.type() != Json::Type::OBJECT) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:hedgingPolicy error:should be of type object");
+  }
+  std::vector<grpc_error_handle> error_list;
+  // Parse maxAttempts.
+  ParseMaxAttempts(json, "hedgingPolicy", max_attempts, &error_list);
+  // Parse hedgingDelay.  If unset, all attempts are sent at once.
+  ParseJsonObjectFieldAsDuration(json.object_value(), "hedgingDelay",
+                                 hedging_delay, &error_list,
+                                 /*required=*/false);
+  // Parse nonFatalStatusCodes.
+  ParseStatusCodes(json, "nonFatalStatusCodes", non_fatal_status_codes,
+                   &error_list);
+  return GRPC_ERROR_CREATE_FROM_VECTOR("hedgingPolicy", &error_list);
+}
+
 }  // namespace
 
 absl::StatusOr<std::unique_ptr<ServiceConfigParser::ParsedConfig>>
 RetryServiceConfigParser::ParsePerMethodParams(const ChannelArgs& args,
                                                const Json& json) {
+  auto retry_it = json.object_value().find("retryPolicy");
+  auto hedging_it = json.object_value().end();
+  // Hedging is still experimental, so hedgingPolicy is ignored unless the
+  // channel opts in.
+  if (args.GetBool(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING).value_or(false)) {
+    hedging_it = json.object_value().find("hedgingPolicy");
+  }
+  // Parse hedging policy.
+  if (hedging_it != json.object_value().end()) {
+    if (retry_it != json.object_value().end()) {
+      return absl::InvalidArgumentError(
+          "error parsing retry method parameters: retryPolicy and "
+          "hedgingPolicy are mutually exclusive");
+    }
+    int max_attempts = 0;
+    Duration hedging_delay;
+    StatusCodeSet non_fatal_status_codes;
+    grpc_error_handle error =
+        ParseHedgingPolicy(hedging_it->second, &max_attempts, &hedging_delay,
+                           &non_fatal_status_codes);
+    if (!GRPC_ERROR_IS_NONE(error)) {
+      absl::Status status = absl::InvalidArgumentError(
+          absl::StrCat("error parsing retry method parameters: ",
+                       grpc_error_std_string(error)));
+      GRPC_ERROR_UNREF(error);
+      return status;
+    }
+    return absl::make_unique<RetryMethodConfig>(max_attempts, hedging_delay,
+                                                non_fatal_status_codes);
+  }
   // Parse retry policy.
-  auto it = json.object_value().find("retryPolicy");
-  if (it == json.object_value().end()) return nullptr;
+  if (retry_it == json.object_value().end()) return nullptr;
   int max_attempts = 0;
   Duration initial_backoff;
   Duration max_backoff;
@@ -306,7 +367,7 @@ RetryServiceConfigParser::ParsePerMethodParams(const ChannelArgs& args,
   StatusCodeSet retryable_status_codes;
   absl::optional<Duration> per_attempt_recv_timeout;
   grpc_error_handle error = ParseRetryPolicy(
-      args, it->second, &max_attempts, &initial_backoff, &max_backoff,
+      args, retry_it->second, &max_attempts, &initial_backoff, &max_backoff,
       &backoff_multiplier, &retryable_status_codes, &per_attempt_recv_timeout);
   if (!GRPC_ERROR_IS_NONE(error)) {
     absl::Status status = absl::InvalidArgumentError(
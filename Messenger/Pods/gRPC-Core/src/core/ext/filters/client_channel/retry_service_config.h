@@ -52,8 +52,11 @@ class RetryGlobalConfig : public ServiceConfigParser::ParsedConfig {
   intptr_t milli_token_ratio_ = 0;
 };
 
+// Holds either a retryPolicy or a hedgingPolicy; the two are mutually
+// exclusive in the service config.
 class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
  public:
+  // Retry policy.
   RetryMethodConfig(int max_attempts, Duration initial_backoff,
                     Duration max_backoff, float backoff_multiplier,
                     StatusCodeSet retryable_status_codes,
@@ -65,6 +68,24 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
         retryable_status_codes_(retryable_status_codes),
         per_attempt_recv_timeout_(per_attempt_recv_timeout) {}
 
+  // Hedging policy.
+  RetryMethodConfig(int max_attempts, Duration hedging_delay,
+                    StatusCodeSet non_fatal_status_codes)
+      : max_attempts_(max_attempts),
+        retryable_status_codes_(non_fatal_status_codes),
+        hedging_delay_(hedging_delay) {}
+
+  // True for a hedgingPolicy.  Then max_attempts() bounds the number of
+  // hedged attempts started, and the backoff parameters are unused.
+  bool hedging() const { return hedging_delay_.has_value(); }
+  Duration hedging_delay() const {
+    return hedging_delay_.value_or(Duration::Zero());
+  }
+  // Statuses after which a hedged attempt is dropped rather than committed.
+  StatusCodeSet non_fatal_status_codes() const {
+    return retryable_status_codes_;
+  }
+
   int max_attempts() const { return max_attempts_; }
   Duration initial_backoff() const { return initial_backoff_; }
   Duration max_backoff() const { return max_backoff_; }
@@ -83,6 +104,7 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   float backoff_multiplier_ = 0;
   StatusCodeSet retryable_status_codes_;
   absl::optional<Duration> per_attempt_recv_timeout_;
+  absl::optional<Duration> hedging_delay_;
 };
 
 class RetryServiceConfigParser : public ServiceConfigParser::Parser {
@@ -72,6 +72,11 @@
 #define GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS 120
 #define GRPC_SUBCHANNEL_RECONNECT_JITTER 0.2
 
+// Connection pool parameters.
+#define GRPC_SUBCHANNEL_DEFAULT_MAX_STREAMS_PER_CONNECTION 100
+#define GRPC_SUBCHANNEL_DEFAULT_POOL_IDLE_TIMEOUT_MS 30000
+#define GRPC_SUBCHANNEL_POOL_CONNECT_FAILURE_DELAY_MS 1000
+
 // Conversion between subchannel call and call stack.
 #define SUBCHANNEL_CALL_TO_CALL_STACK(call) \
   (grpc_call_stack*)((char*)(call) +        \
@@ -99,7 +104,9 @@ ConnectedSubchannel::ConnectedSubchannel(
               : nullptr),
       channel_stack_(channel_stack),
       args_(args),
-      channelz_subchannel_(std::move(channelz_subchannel)) {}
+      channelz_subchannel_(std::move(channelz_subchannel)),
+      track_calls_(args_.GetInt(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS)
+                       .value_or(1) > 1) {}
 
 ConnectedSubchannel::~ConnectedSubchannel() {
   GRPC_CHANNEL_STACK_UNREF(channel_stack_, "connected_subchannel_dtor");
@@ -147,6 +154,7 @@ RefCountedPtr<SubchannelCall> SubchannelCall::Create(Args args,
 SubchannelCall::SubchannelCall(Args args, grpc_error_handle* error)
     : connected_subchannel_(std::move(args.connected_subchannel)),
       deadline_(args.deadline) {
+  connected_subchannel_->CallStarted();
   grpc_call_stack* callstk = SUBCHANNEL_CALL_TO_CALL_STACK(this);
   const grpc_call_element_args call_args = {
       callstk,             /* call_stack */
@@ -223,6 +231,7 @@ void SubchannelCall::Destroy(void* arg, grpc_error_handle /*error*/) {
   // call arena.
   grpc_call_stack_destroy(SUBCHANNEL_CALL_TO_CALL_STACK(self), nullptr,
                           after_call_stack_destroy);
+  connected_subchannel->CallFinished();
   // Automatically reset connected_subchannel. This should be after destroying
   // the call stack, because destroying call stack needs access to the channel
   // stack.
@@ -301,8 +310,9 @@ class Subchannel::ConnectedSubchannelStateWatcher
     : public AsyncConnectivityStateWatcherInterface {
  public:
   // Must be instantiated while holding c->mu.
-  explicit ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c)
-      : subchannel_(std::move(c)) {}
+  ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c,
+                                  uint64_t connection_id)
+      : subchannel_(std::move(c)), connection_id_(connection_id) {}
 
   ~ConnectedSubchannelStateWatcher() override {
     subchannel_.reset(DEBUG_LOCATION, "state_watcher");
@@ -313,6 +323,14 @@ class Subchannel::ConnectedSubchannelStateWatcher
                                  const absl::Status& status) override {
     Subchannel* c = subchannel_.get();
     MutexLock lock(&c->mu_);
+    // Losing a pooled connection does not change the subchannel's state.
+    if (connection_id_ != c->connection_id_) {
+      if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+          new_state == GRPC_CHANNEL_SHUTDOWN) {
+        c->RemovePooledConnectionLocked(connection_id_);
+      }
+      return;
+    }
     // If we're either shutting down or have already seen this connection
     // failure (i.e., c->connected_subchannel_ is null), do nothing.
     //
@@ -331,9 +349,22 @@ class Subchannel::ConnectedSubchannelStateWatcher
                 ConnectivityStateName(new_state), status.ToString().c_str());
       }
       c->connected_subchannel_.reset();
+      c->connection_id_ = 0;
+      // If there are other connections to the same address, keep going
+      // with one of them.
+      if (c->PromotePooledConnectionLocked()) return;
       if (c->channelz_node() != nullptr) {
         c->channelz_node()->SetChildSocket(nullptr);
       }
+      // If a pooled connection attempt is in flight, it becomes the
+      // subchannel's connection attempt.
+      if (c->pool_connecting_) {
+        c->pool_connecting_ = false;
+        c->backoff_.Reset();
+        c->next_attempt_time_ = c->backoff_.NextAttemptTime();
+        c->SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, status);
+        return;
+      }
       // Even though we're reporting IDLE instead of TRANSIENT_FAILURE here,
       // pass along the status from the transport, since it may have
       // keepalive info attached to it that the channel needs.
@@ -344,6 +375,7 @@ class Subchannel::ConnectedSubchannelStateWatcher
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
+  const uint64_t connection_id_;
 };
 
 // Asynchronously notifies the \a watcher of a change in the connectvity state
@@ -626,6 +658,18 @@ Subchannel::Subchannel(SubchannelKey key,
       key_(std::move(key)),
       args_(args),
       pollset_set_(grpc_pollset_set_create()),
+      max_connections_(std::max(
+          1, args_.GetInt(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS).value_or(1))),
+      max_streams_per_connection_(std::max(
+          1, args_.GetInt(GRPC_ARG_SUBCHANNEL_MAX_STREAMS_PER_CONNECTION)
+                 .value_or(
+                     GRPC_SUBCHANNEL_DEFAULT_MAX_STREAMS_PER_CONNECTION))),
+      pool_idle_timeout_(std::max(
+          Duration::Seconds(1),
+          args_.GetDurationFromIntMillis(
+                   GRPC_ARG_SUBCHANNEL_POOL_IDLE_TIMEOUT_MS)
+              .value_or(Duration::Milliseconds(
+                  GRPC_SUBCHANNEL_DEFAULT_POOL_IDLE_TIMEOUT_MS)))),
       connector_(std::move(connector)),
       backoff_(ParseArgsForBackoffValues(args_, &min_connect_timeout_)) {
   // A grpc_init is added here to ensure that grpc_shutdown does not happen
@@ -783,6 +827,11 @@ void Subchannel::Orphan() {
   shutdown_ = true;
   connector_.reset();
   connected_subchannel_.reset();
+  pooled_connections_.clear();
+  if (pool_idle_timer_pending_) {
+    GetDefaultEventEngine()->Cancel(pool_idle_timer_handle_);
+    pool_idle_timer_pending_ = false;
+  }
   health_watcher_map_.ShutdownLocked();
 }
 
@@ -899,6 +948,10 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
     (void)GRPC_ERROR_UNREF(error);
     return;
   }
+  if (pool_connecting_) {
+    OnPoolConnectingFinishedLocked(error);
+    return;
+  }
   // If we didn't get a transport or we fail to publish it, report
   // TRANSIENT_FAILURE and start the retry timer.
   // Note that if the connection attempt took longer than the backoff
@@ -934,13 +987,14 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
   (void)GRPC_ERROR_UNREF(error);
 }
 
-bool Subchannel::PublishTransportLocked() {
+RefCountedPtr<ConnectedSubchannel> Subchannel::CreateConnectedSubchannelLocked(
+    RefCountedPtr<channelz::SocketNode>* socket) {
   // Construct channel stack.
   ChannelStackBuilderImpl builder("subchannel", GRPC_CLIENT_SUBCHANNEL);
   builder.SetChannelArgs(connecting_result_.channel_args)
       .SetTransport(connecting_result_.transport);
   if (!CoreConfiguration::Get().channel_init().CreateStack(&builder)) {
-    return false;
+    return nullptr;
   }
   absl::StatusOr<RefCountedPtr<grpc_channel_stack>> stk = builder.Build();
   if (!stk.ok()) {
@@ -950,15 +1004,23 @@ bool Subchannel::PublishTransportLocked() {
             "subchannel %p %s: error initializing subchannel stack: %s", this,
             key_.ToString().c_str(), grpc_error_std_string(error).c_str());
     GRPC_ERROR_UNREF(error);
-    return false;
+    return nullptr;
   }
-  RefCountedPtr<channelz::SocketNode> socket =
-      std::move(connecting_result_.socket_node);
+  *socket = std::move(connecting_result_.socket_node);
   connecting_result_.Reset();
-  if (shutdown_) return false;
+  if (shutdown_) return nullptr;
+  return MakeRefCounted<ConnectedSubchannel>(stk->release(), args_,
+                                             channelz_node_);
+}
+
+bool Subchannel::PublishTransportLocked() {
+  RefCountedPtr<channelz::SocketNode> socket;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel =
+      CreateConnectedSubchannelLocked(&socket);
+  if (connected_subchannel == nullptr) return false;
   // Publish.
-  connected_subchannel_.reset(
-      new ConnectedSubchannel(stk->release(), args_, channelz_node_));
+  connected_subchannel_ = std::move(connected_subchannel);
+  connection_id_ = next_connection_id_++;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
     gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
             key_.ToString().c_str(), connected_subchannel_.get());
@@ -968,11 +1030,170 @@ bool Subchannel::PublishTransportLocked() {
   }
   // Start watching connected subchannel.
   connected_subchannel_->StartWatch(
-      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
-                        WeakRef(DEBUG_LOCATION, "state_watcher")));
+      pollset_set_,
+      MakeOrphanable<ConnectedSubchannelStateWatcher>(
+          WeakRef(DEBUG_LOCATION, "state_watcher"), connection_id_));
   // Report initial state.
   SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
   return true;
 }
 
+//
+// connection pool
+//
+
+RefCountedPtr<ConnectedSubchannel> Subchannel::connected_subchannel() {
+  MutexLock lock(&mu_);
+  if (max_connections_ <= 1 || connected_subchannel_ == nullptr) {
+    return connected_subchannel_;
+  }
+  // Use the least loaded connection.  Opening another one when they are
+  // all at the stream limit keeps new calls from queueing in the transport
+  // behind the peer's MAX_CONCURRENT_STREAMS.
+  ConnectedSubchannel* best = connected_subchannel_.get();
+  size_t best_calls = best->active_calls();
+  for (const PooledConnection& pooled : pooled_connections_) {
+    const size_t calls = pooled.connected_subchannel->active_calls();
+    if (calls < best_calls) {
+      best = pooled.connected_subchannel.get();
+      best_calls = calls;
+    }
+  }
+  if (best_calls >= max_streams_per_connection_) MaybeGrowPoolLocked();
+  return best->Ref();
+}
+
+void Subchannel::MaybeGrowPoolLocked() {
+  if (shutdown_ || state_ != GRPC_CHANNEL_READY || pool_connecting_) return;
+  if (pooled_connections_.size() + 1 >= max_connections_) return;
+  const Timestamp now = Timestamp::Now();
+  if (now < next_pool_attempt_time_) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: all %" PRIuPTR
+            " connections saturated, opening another",
+            this, key_.ToString().c_str(), pooled_connections_.size() + 1);
+  }
+  pool_connecting_ = true;
+  SubchannelConnector::Args args;
+  args.address = &address_for_connect_;
+  args.interested_parties = pollset_set_;
+  args.deadline = now + min_connect_timeout_;
+  args.channel_args = args_;
+  WeakRef(DEBUG_LOCATION, "Connect").release();  // Ref held by callback.
+  connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
+}
+
+void Subchannel::OnPoolConnectingFinishedLocked(grpc_error_handle error) {
+  pool_connecting_ = false;
+  RefCountedPtr<channelz::SocketNode> socket;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+  if (connecting_result_.transport != nullptr) {
+    connected_subchannel = CreateConnectedSubchannelLocked(&socket);
+  }
+  // The primary connection may have been lost in the meantime without
+  // handing this attempt over (e.g., after shutdown); in that case there
+  // is nothing to add the connection to.
+  if (connected_subchannel == nullptr || connected_subchannel_ == nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+      gpr_log(GPR_INFO, "subchannel %p %s: pooled connect failed (%s)", this,
+              key_.ToString().c_str(), grpc_error_std_string(error).c_str());
+    }
+    next_pool_attempt_time_ =
+        Timestamp::Now() +
+        Duration::Milliseconds(GRPC_SUBCHANNEL_POOL_CONNECT_FAILURE_DELAY_MS);
+    (void)GRPC_ERROR_UNREF(error);
+    return;
+  }
+  (void)GRPC_ERROR_UNREF(error);
+  const uint64_t id = next_connection_id_++;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: new pooled connected subchannel at %p, "
+            "%" PRIuPTR " connections",
+            this, key_.ToString().c_str(), connected_subchannel.get(),
+            pooled_connections_.size() + 2);
+  }
+  connected_subchannel->StartWatch(
+      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
+                        WeakRef(DEBUG_LOCATION, "state_watcher"), id));
+  pooled_connections_.push_back({id, std::move(connected_subchannel)});
+  MaybeStartPoolIdleTimerLocked();
+}
+
+bool Subchannel::PromotePooledConnectionLocked() {
+  if (pooled_connections_.empty()) return false;
+  PooledConnection& pooled = pooled_connections_.back();
+  connection_id_ = pooled.id;
+  connected_subchannel_ = std::move(pooled.connected_subchannel);
+  pooled_connections_.pop_back();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: promoted pooled connected subchannel %p", this,
+            key_.ToString().c_str(), connected_subchannel_.get());
+  }
+  return true;
+}
+
+void Subchannel::RemovePooledConnectionLocked(uint64_t connection_id) {
+  auto it = std::find_if(pooled_connections_.begin(),
+                         pooled_connections_.end(),
+                         [connection_id](const PooledConnection& pooled) {
+                           return pooled.id == connection_id;
+                         });
+  if (it == pooled_connections_.end()) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO, "subchannel %p %s: lost pooled connected subchannel %p",
+            this, key_.ToString().c_str(), it->connected_subchannel.get());
+  }
+  pooled_connections_.erase(it);
+}
+
+void Subchannel::MaybeStartPoolIdleTimerLocked() {
+  if (pool_idle_timer_pending_ || pooled_connections_.empty()) return;
+  pool_idle_timer_pending_ = true;
+  pool_idle_timer_handle_ = GetDefaultEventEngine()->RunAfter(
+      pool_idle_timeout_,
+      [self = WeakRef(DEBUG_LOCATION, "PoolIdleTimer")]() mutable {
+        ApplicationCallbackExecCtx callback_exec_ctx;
+        ExecCtx exec_ctx;
+        self->OnPoolIdleTimer();
+        // Subchannel deletion might require an active ExecCtx, as in the
+        // retry timer callback.
+        self.reset();
+      });
+}
+
+void Subchannel::OnPoolIdleTimer() {
+  // Connections are released outside of the lock, since dropping the last
+  // ref destroys the channel stack.
+  std::vector<RefCountedPtr<ConnectedSubchannel>> closed;
+  {
+    MutexLock lock(&mu_);
+    pool_idle_timer_pending_ = false;
+    if (shutdown_) return;
+    const Timestamp now = Timestamp::Now();
+    for (auto it = pooled_connections_.begin();
+         it != pooled_connections_.end();) {
+      ConnectedSubchannel* connected_subchannel =
+          it->connected_subchannel.get();
+      if (connected_subchannel->active_calls() == 0 &&
+          now - connected_subchannel->last_call_finished() >=
+              pool_idle_timeout_) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+          gpr_log(GPR_INFO,
+                  "subchannel %p %s: closing idle pooled connected "
+                  "subchannel %p",
+                  this, key_.ToString().c_str(), connected_subchannel);
+        }
+        closed.push_back(std::move(it->connected_subchannel));
+        it = pooled_connections_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    MaybeStartPoolIdleTimerLocked();
+  }
+}
+
 }  // namespace grpc_core
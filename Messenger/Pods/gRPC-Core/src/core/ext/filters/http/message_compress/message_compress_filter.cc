@@ -153,6 +153,8 @@ void CallData::ProcessSendInitialMetadata(
       break;
     case GRPC_COMPRESS_DEFLATE:
     case GRPC_COMPRESS_GZIP:
+    case GRPC_COMPRESS_ZSTD:
+    case GRPC_COMPRESS_LZ4:
       initial_metadata->Set(grpc_core::GrpcEncodingMetadata(),
                             compression_algorithm_);
       break;
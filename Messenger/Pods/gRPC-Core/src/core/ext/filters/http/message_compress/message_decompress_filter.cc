@@ -40,6 +40,7 @@
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/slice/slice.h"
 #include "src/core/lib/slice/slice_buffer.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
@@ -182,15 +183,44 @@ void CallData::OnRecvMessageReady(void* arg, grpc_error_handle error) {
         return calld->ContinueRecvMessageReadyCallback(
             GRPC_ERROR_REF(calld->error_));
       }
+      // Decompress the message a slice at a time, releasing each compressed
+      // slice once it is decoded, and bound the decompressed size so that a
+      // small message that inflates past the limit is rejected without
+      // inflating all of it.
+      SliceBuffer* compressed = &**calld->recv_message_;
+      const size_t compressed_length = compressed->Length();
       SliceBuffer decompressed_slices;
-      if (grpc_msg_decompress(calld->algorithm_,
-                              (*calld->recv_message_)->c_slice_buffer(),
-                              decompressed_slices.c_slice_buffer()) == 0) {
+      int too_large = 0;
+      grpc_msg_decompressor* decompressor = grpc_msg_decompressor_create(
+          calld->algorithm_,
+          calld->max_recv_message_length_ >= 0
+              ? static_cast<size_t>(calld->max_recv_message_length_)
+              : SIZE_MAX);
+      bool ok = decompressor != nullptr;
+      while (ok && compressed->Count() > 0) {
+        Slice slice = compressed->TakeFirst();
+        ok = grpc_msg_decompressor_next(decompressor, slice.c_slice(),
+                                        decompressed_slices.c_slice_buffer(),
+                                        &too_large) != 0;
+      }
+      ok = ok && grpc_msg_decompressor_finish(
+                     decompressor, decompressed_slices.c_slice_buffer()) != 0;
+      if (decompressor != nullptr) grpc_msg_decompressor_destroy(decompressor);
+      if (!ok) {
         GPR_DEBUG_ASSERT(GRPC_ERROR_IS_NONE(calld->error_));
-        calld->error_ = GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
-            "Unexpected error decompressing data for algorithm with "
-            "enum value ",
-            calld->algorithm_));
+        if (too_large) {
+          calld->error_ = grpc_error_set_int(
+              GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrFormat(
+                  "Received message larger than max when decompressed "
+                  "(compressed %u, max %d)",
+                  compressed_length, calld->max_recv_message_length_)),
+              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED);
+        } else {
+          calld->error_ = GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
+              "Unexpected error decompressing data for algorithm with "
+              "enum value ",
+              calld->algorithm_));
+        }
       } else {
         *calld->recv_message_flags_ =
             (*calld->recv_message_flags_ & (~GRPC_WRITE_INTERNAL_COMPRESS)) |
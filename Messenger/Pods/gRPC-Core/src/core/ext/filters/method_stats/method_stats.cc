@@ -0,0 +1,298 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/method_stats/method_stats.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/memory/memory.h"
+#include "absl/numeric/bits.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+constexpr size_t MethodStatsHistogram::kNumBuckets;
+constexpr size_t MethodStatsRegistry::kMaxMethods;
+constexpr absl::string_view MethodStatsRegistry::kOtherMethod;
+
+//
+// HistogramSnapshot
+//
+
+double HistogramSnapshot::Percentile(double percentile) const {
+  if (count == 0) return 0;
+  // The 1-based rank of the value we are after.
+  const double rank = std::max(1.0, percentile / 100.0 * count);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      const uint64_t lower = MethodStatsHistogram::BucketLowerBound(i);
+      const uint64_t upper = MethodStatsHistogram::BucketUpperBound(i);
+      return lower + (upper - lower) / 2.0;
+    }
+  }
+  return MethodStatsHistogram::BucketLowerBound(buckets.size() - 1);
+}
+
+Json HistogramSnapshot::ToJson() const {
+  Json::Array bucket_array;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    if (buckets[i] == 0) continue;
+    bucket_array.emplace_back(Json::Object{
+        {"lowerBound",
+         std::to_string(MethodStatsHistogram::BucketLowerBound(i))},
+        {"count", std::to_string(buckets[i])},
+    });
+  }
+  return Json::Object{
+      {"count", std::to_string(count)},
+      {"sum", std::to_string(sum)},
+      {"p50", Percentile(50)},
+      {"p90", Percentile(90)},
+      {"p99", Percentile(99)},
+      {"buckets", std::move(bucket_array)},
+  };
+}
+
+//
+// MethodStatsHistogram
+//
+
+MethodStatsHistogram::MethodStatsHistogram(size_t num_shards)
+    : num_shards_(num_shards), shards_(new Shard[num_shards]) {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    for (auto& bucket : shards_[i].buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    shards_[i].sum.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t MethodStatsHistogram::BucketFor(uint64_t value) {
+  constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  if (value < kSubBuckets) return static_cast<size_t>(value);
+  const int msb = std::min(63 - absl::countl_zero(value), kMaxValueBits - 1);
+  const int shift = msb - (kSubBucketBits - 1);
+  // The top kSubBucketBits bits of the value, so in [kSubBuckets / 2,
+  // kSubBuckets).
+  const uint64_t top = std::min(value >> shift, kSubBuckets - 1);
+  return static_cast<size_t>(shift) * (kSubBuckets / 2) +
+         static_cast<size_t>(top);
+}
+
+uint64_t MethodStatsHistogram::BucketLowerBound(size_t index) {
+  constexpr size_t kHalf = size_t{1} << (kSubBucketBits - 1);
+  if (index < 2 * kHalf) return index;
+  const size_t shift = index / kHalf - 1;
+  const uint64_t top = index % kHalf + kHalf;
+  return top << shift;
+}
+
+uint64_t MethodStatsHistogram::BucketUpperBound(size_t index) {
+  if (index + 1 >= kNumBuckets) return BucketLowerBound(index);
+  return BucketLowerBound(index + 1) - 1;
+}
+
+void MethodStatsHistogram::Record(size_t shard, uint64_t value) {
+  Shard& s = shards_[shard % num_shards_];
+  s.buckets[BucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+  s.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void MethodStatsHistogram::Collect(bool reset, HistogramSnapshot* snapshot) {
+  snapshot->buckets.resize(kNumBuckets);
+  for (size_t i = 0; i < num_shards_; ++i) {
+    Shard& s = shards_[i];
+    for (size_t b = 0; b < kNumBuckets; ++b) {
+      const uint64_t n =
+          reset ? s.buckets[b].exchange(0, std::memory_order_relaxed)
+                : s.buckets[b].load(std::memory_order_relaxed);
+      snapshot->buckets[b] += n;
+      snapshot->count += n;
+    }
+    snapshot->sum += reset ? s.sum.exchange(0, std::memory_order_relaxed)
+                           : s.sum.load(std::memory_order_relaxed);
+  }
+}
+
+//
+// MethodStats
+//
+
+Json MethodStatsSnapshot::ToJson() const {
+  return Json::Object{
+      {"method", method},
+      {"calls", std::to_string(calls)},
+      {"failedCalls", std::to_string(failed_calls)},
+      {"latencyUs", latency_us.ToJson()},
+      {"sentMessageBytes", sent_message_bytes.ToJson()},
+      {"receivedMessageBytes", received_message_bytes.ToJson()},
+      {"retries", retries.ToJson()},
+      {"tcpQueueDelayUs", tcp_queue_delay_us.ToJson()},
+      {"tcpKernelDelayUs", tcp_kernel_delay_us.ToJson()},
+      {"tcpNetworkDelayUs", tcp_network_delay_us.ToJson()},
+  };
+}
+
+MethodStats::MethodStats(std::string method, size_t num_shards)
+    : method_(std::move(method)),
+      num_shards_(num_shards),
+      failed_calls_(new ShardCounter[num_shards]),
+      latency_us_(num_shards),
+      sent_message_bytes_(num_shards),
+      received_message_bytes_(num_shards),
+      retries_(num_shards),
+      tcp_queue_delay_us_(num_shards),
+      tcp_kernel_delay_us_(num_shards),
+      tcp_network_delay_us_(num_shards) {}
+
+void MethodStats::RecordCall(size_t shard, bool failed, uint64_t latency_us,
+                             uint64_t retries) {
+  latency_us_.Record(shard, latency_us);
+  retries_.Record(shard, retries);
+  if (failed) {
+    failed_calls_[shard % num_shards_].value.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+}
+
+MethodStatsSnapshot MethodStats::Collect(bool reset) {
+  MethodStatsSnapshot snapshot;
+  snapshot.method = method_;
+  latency_us_.Collect(reset, &snapshot.latency_us);
+  sent_message_bytes_.Collect(reset, &snapshot.sent_message_bytes);
+  received_message_bytes_.Collect(reset, &snapshot.received_message_bytes);
+  retries_.Collect(reset, &snapshot.retries);
+  tcp_queue_delay_us_.Collect(reset, &snapshot.tcp_queue_delay_us);
+  tcp_kernel_delay_us_.Collect(reset, &snapshot.tcp_kernel_delay_us);
+  tcp_network_delay_us_.Collect(reset, &snapshot.tcp_network_delay_us);
+  snapshot.calls = snapshot.latency_us.count;
+  for (size_t i = 0; i < num_shards_; ++i) {
+    snapshot.failed_calls +=
+        reset ? failed_calls_[i].value.exchange(0, std::memory_order_relaxed)
+              : failed_calls_[i].value.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+//
+// MethodStatsRegistry
+//
+
+namespace {
+
+// The method table is split by hash so that calls to different methods do not
+// contend on one lock. Only the first call to each method allocates.
+constexpr size_t kTableShards = 16;
+
+struct TableShard {
+  Mutex mu;
+  absl::flat_hash_map<std::string, std::unique_ptr<MethodStats>> methods
+      ABSL_GUARDED_BY(mu);
+};
+
+struct Table {
+  // At most one histogram shard per CPU, bounded to keep the per-method
+  // footprint reasonable on very large machines.
+  size_t num_cpu_shards =
+      Clamp(static_cast<size_t>(gpr_cpu_num_cores()), size_t{1}, size_t{8});
+  std::atomic<size_t> num_methods{0};
+  TableShard shards[kTableShards];
+};
+
+Table* GetTable() {
+  static Table* table = new Table();
+  return table;
+}
+
+MethodStats* GetOrCreate(Table* table, absl::string_view method,
+                         bool enforce_limit) {
+  TableShard& shard =
+      table->shards[absl::Hash<absl::string_view>()(method) % kTableShards];
+  MutexLock lock(&shard.mu);
+  auto it = shard.methods.find(method);
+  if (it != shard.methods.end()) return it->second.get();
+  if (enforce_limit &&
+      table->num_methods.fetch_add(1, std::memory_order_relaxed) >=
+          MethodStatsRegistry::kMaxMethods) {
+    table->num_methods.fetch_sub(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  auto stats = absl::make_unique<MethodStats>(std::string(method),
+                                              table->num_cpu_shards);
+  MethodStats* result = stats.get();
+  shard.methods.emplace(std::string(method), std::move(stats));
+  return result;
+}
+
+}  // namespace
+
+MethodStats* MethodStatsRegistry::Get(absl::string_view method) {
+  Table* table = GetTable();
+  MethodStats* stats = GetOrCreate(table, method, /*enforce_limit=*/true);
+  if (stats != nullptr) return stats;
+  return GetOrCreate(table, kOtherMethod, /*enforce_limit=*/false);
+}
+
+size_t MethodStatsRegistry::CurrentShard() {
+  return ExecCtx::Get() != nullptr ? ExecCtx::Get()->starting_cpu()
+                                   : gpr_cpu_current_cpu();
+}
+
+std::vector<MethodStatsSnapshot> MethodStatsRegistry::Collect(bool reset) {
+  Table* table = GetTable();
+  std::vector<MethodStatsSnapshot> snapshots;
+  for (TableShard& shard : table->shards) {
+    MutexLock lock(&shard.mu);
+    for (auto& p : shard.methods) {
+      snapshots.push_back(p.second->Collect(reset));
+    }
+  }
+  std::sort(snapshots.begin(), snapshots.end(),
+            [](const MethodStatsSnapshot& a, const MethodStatsSnapshot& b) {
+              return a.method < b.method;
+            });
+  return snapshots;
+}
+
+Json MethodStatsRegistry::ToJson(bool reset) {
+  Json::Array array;
+  for (const MethodStatsSnapshot& snapshot : Collect(reset)) {
+    array.emplace_back(snapshot.ToJson());
+  }
+  return Json::Object{{"methodStats", std::move(array)}};
+}
+
+}  // namespace grpc_core
+
+char* grpc_channelz_get_method_stats(int reset) {
+  grpc_core::ExecCtx exec_ctx;
+  return gpr_strdup(
+      grpc_core::MethodStatsRegistry::ToJson(reset != 0).Dump().c_str());
+}
@@ -0,0 +1,269 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include "absl/status/status.h"
+
+#include <grpc/impl/codegen/gpr_types.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/status.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/method_stats/method_stats.h"
+#include "src/core/lib/channel/call_tracer.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/slice/slice_buffer.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Microseconds from \a from to \a to, or -1 if the kernel did not report
+// one of them (it leaves them zeroed) or the clocks went backwards.
+int64_t DelayUs(gpr_timespec from, gpr_timespec to) {
+  if ((from.tv_sec == 0 && from.tv_nsec == 0) ||
+      (to.tv_sec == 0 && to.tv_nsec == 0) || gpr_time_cmp(to, from) < 0) {
+    return -1;
+  }
+  const gpr_timespec delta = gpr_time_sub(to, from);
+  return delta.tv_sec * GPR_US_PER_SEC + delta.tv_nsec / GPR_NS_PER_US;
+}
+
+// Turns the kernel timestamps of one sampled write into the three TCP delay
+// histograms. Outlives the call, so it only keeps what it needs.
+class MethodStatsTcpWriteTracer : public CallTracer::TcpWriteTracer {
+ public:
+  MethodStatsTcpWriteTracer(MethodStats* stats, gpr_timespec last_send_message)
+      : stats_(stats), last_send_message_(last_send_message) {}
+
+  void RecordTimestamps(const Timestamps* ts,
+                        grpc_error_handle error) override {
+    if (ts == nullptr || !GRPC_ERROR_IS_NONE(error)) return;
+    const size_t shard = MethodStatsRegistry::CurrentShard();
+    int64_t delay = DelayUs(last_send_message_, ts->sendmsg_time.time);
+    if (delay >= 0) stats_->RecordTcpQueueDelay(shard, delay);
+    delay = DelayUs(ts->sendmsg_time.time, ts->sent_time.time);
+    if (delay >= 0) stats_->RecordTcpKernelDelay(shard, delay);
+    delay = DelayUs(ts->sent_time.time, ts->acked_time.time);
+    if (delay >= 0) stats_->RecordTcpNetworkDelay(shard, delay);
+  }
+
+ private:
+  MethodStats* const stats_;
+  const gpr_timespec last_send_message_;
+};
+
+// The built-in CallTracer. It only counts attempts and message sizes; latency
+// and status come from the filter below, which sees them even when another
+// tracer owns the call.
+class MethodStatsCallTracer : public CallTracer {
+ public:
+  class MethodStatsCallAttemptTracer : public CallAttemptTracer {
+   public:
+    MethodStatsCallAttemptTracer(MethodStats* stats,
+                                 MethodStatsCallTracer* call_tracer)
+        : stats_(stats), call_tracer_(call_tracer) {}
+
+    void RecordSendInitialMetadata(
+        grpc_metadata_batch* /*send_initial_metadata*/) override {}
+    void RecordOnDoneSendInitialMetadata(gpr_atm* /*peer_string*/) override {}
+    void RecordSendTrailingMetadata(
+        grpc_metadata_batch* /*send_trailing_metadata*/) override {}
+    void RecordSendMessage(const SliceBuffer& send_message) override {
+      stats_->RecordSentMessage(MethodStatsRegistry::CurrentShard(),
+                                send_message.Length());
+      if (call_tracer_->tcp_writes_sampled_) {
+        const gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+        call_tracer_->last_send_message_.store(
+            now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec,
+            std::memory_order_relaxed);
+      }
+    }
+    void RecordReceivedInitialMetadata(
+        grpc_metadata_batch* /*recv_initial_metadata*/,
+        uint32_t /*flags*/) override {}
+    void RecordReceivedMessage(const SliceBuffer& recv_message) override {
+      stats_->RecordReceivedMessage(MethodStatsRegistry::CurrentShard(),
+                                    recv_message.Length());
+    }
+    void RecordReceivedTrailingMetadata(
+        absl::Status /*status*/,
+        grpc_metadata_batch* /*recv_trailing_metadata*/,
+        const grpc_transport_stream_stats* /*transport_stream_stats*/)
+        override {}
+    void RecordCancel(grpc_error_handle cancel_error) override {
+      GRPC_ERROR_UNREF(cancel_error);
+    }
+    // Allocated on the call arena, so there is nothing to free.
+    void RecordEnd(const gpr_timespec& /*latency*/) override {}
+
+   private:
+    MethodStats* const stats_;
+    MethodStatsCallTracer* const call_tracer_;
+  };
+
+  MethodStatsCallTracer(MethodStats* stats, Arena* arena,
+                        bool tcp_writes_sampled)
+      : stats_(stats), arena_(arena), tcp_writes_sampled_(tcp_writes_sampled) {}
+
+  CallAttemptTracer* StartNewAttempt(bool /*is_transparent_retry*/) override {
+    attempts_.fetch_add(1, std::memory_order_relaxed);
+    return arena_->New<MethodStatsCallAttemptTracer>(stats_, this);
+  }
+
+  bool ShouldTraceTcpWrites() override { return tcp_writes_sampled_; }
+
+  TcpWriteTracer* StartTcpWrite() override {
+    if (!tcp_writes_sampled_) return nullptr;
+    const int64_t ns = last_send_message_.load(std::memory_order_relaxed);
+    return new MethodStatsTcpWriteTracer(
+        stats_, gpr_time_from_nanos(ns, GPR_CLOCK_REALTIME));
+  }
+
+  uint64_t retries() const {
+    const uint64_t attempts = attempts_.load(std::memory_order_relaxed);
+    return attempts > 0 ? attempts - 1 : 0;
+  }
+
+ private:
+  MethodStats* const stats_;
+  Arena* const arena_;
+  const bool tcp_writes_sampled_;
+  std::atomic<uint64_t> attempts_{0};
+  // When the most recent message was handed to gRPC, in realtime nanoseconds
+  // to match the kernel timestamps. 0 until then.
+  std::atomic<int64_t> last_send_message_{0};
+};
+
+struct ChannelData {
+  // One call in this many has its TCP writes timestamped; 0 for none.
+  uint32_t tcp_write_sample_period;
+};
+
+// Shared by all channels so that the sampled calls are spread evenly however
+// the application distributes its calls across channels.
+std::atomic<uint32_t> g_tcp_write_sample_counter{0};
+
+bool SampleTcpWrites(const ChannelData* chand) {
+  if (chand->tcp_write_sample_period == 0) return false;
+  return g_tcp_write_sample_counter.fetch_add(1, std::memory_order_relaxed) %
+             chand->tcp_write_sample_period ==
+         0;
+}
+
+struct CallData {
+  MethodStats* stats;
+  // Null if the call already had a tracer when this filter saw it.
+  MethodStatsCallTracer* tracer;
+};
+
+grpc_error_handle MethodStatsInitCallElem(grpc_call_element* elem,
+                                          const grpc_call_element_args* args) {
+  CallData* calld = new (elem->call_data) CallData();
+  calld->stats = MethodStatsRegistry::Get(StringViewFromSlice(args->path));
+  grpc_call_context_element& context =
+      args->context[GRPC_CONTEXT_CALL_TRACER];
+  if (context.value == nullptr) {
+    calld->tracer = args->arena->New<MethodStatsCallTracer>(
+        calld->stats, args->arena,
+        SampleTcpWrites(static_cast<ChannelData*>(elem->channel_data)));
+    context.value = calld->tracer;
+    context.destroy = nullptr;
+  }
+  return GRPC_ERROR_NONE;
+}
+
+void MethodStatsDestroyCallElem(grpc_call_element* elem,
+                                const grpc_call_final_info* final_info,
+                                grpc_closure* /*ignored*/) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  const gpr_timespec& latency = final_info->stats.latency;
+  const int64_t latency_us =
+      latency.tv_sec * GPR_US_PER_SEC + latency.tv_nsec / GPR_NS_PER_US;
+  calld->stats->RecordCall(
+      MethodStatsRegistry::CurrentShard(),
+      final_info->final_status != GRPC_STATUS_OK,
+      latency_us > 0 ? static_cast<uint64_t>(latency_us) : 0,
+      calld->tracer != nullptr ? calld->tracer->retries() : 0);
+  calld->~CallData();
+}
+
+grpc_error_handle MethodStatsInitChannelElem(grpc_channel_element* elem,
+                                             grpc_channel_element_args* args) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  chand->tcp_write_sample_period = static_cast<uint32_t>(std::max(
+      0, ChannelArgs::FromC(args->channel_args)
+             .GetInt(GRPC_ARG_TCP_WRITE_TIMESTAMPS_SAMPLE_PERIOD)
+             .value_or(0)));
+  return GRPC_ERROR_NONE;
+}
+
+void MethodStatsDestroyChannelElem(grpc_channel_element* /*elem*/) {}
+
+const grpc_channel_filter kMethodStatsFilter = {
+    grpc_call_next_op,
+    nullptr,
+    grpc_channel_next_op,
+    sizeof(CallData),
+    MethodStatsInitCallElem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    MethodStatsDestroyCallElem,
+    sizeof(ChannelData),
+    MethodStatsInitChannelElem,
+    grpc_channel_stack_no_post_init,
+    MethodStatsDestroyChannelElem,
+    grpc_channel_next_get_info,
+    "method_stats"};
+
+bool MaybeAddMethodStatsFilter(ChannelStackBuilder* builder) {
+  const ChannelArgs& args = builder->channel_args();
+  if (!args.WantMinimalStack() &&
+      args.GetBool(GRPC_ARG_ENABLE_METHOD_STATS).value_or(false)) {
+    builder->PrependFilter(&kMethodStatsFilter);
+  }
+  return true;
+}
+
+}  // namespace
+
+void RegisterMethodStatsFilter(CoreConfiguration::Builder* builder) {
+  builder->channel_init()->RegisterStage(GRPC_CLIENT_CHANNEL,
+                                         GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                         MaybeAddMethodStatsFilter);
+  builder->channel_init()->RegisterStage(GRPC_CLIENT_DIRECT_CHANNEL,
+                                         GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                         MaybeAddMethodStatsFilter);
+}
+
+}  // namespace grpc_core
@@ -93,21 +93,36 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   return output;
 }
 
+size_t grpc_chttp2_huffman_compressed_length(const uint8_t* begin,
+                                             const uint8_t* end) {
+  /* The per-byte lookups are independent: sum into separate accumulators so
+     they are not serialized behind a single add chain. */
+  size_t nbits0 = 0;
+  size_t nbits1 = 0;
+  size_t nbits2 = 0;
+  size_t nbits3 = 0;
+  for (; end - begin >= 4; begin += 4) {
+    nbits0 += grpc_chttp2_huffsyms[begin[0]].length;
+    nbits1 += grpc_chttp2_huffsyms[begin[1]].length;
+    nbits2 += grpc_chttp2_huffsyms[begin[2]].length;
+    nbits3 += grpc_chttp2_huffsyms[begin[3]].length;
+  }
+  for (; begin != end; ++begin) {
+    nbits0 += grpc_chttp2_huffsyms[*begin].length;
+  }
+  size_t nbits = nbits0 + nbits1 + nbits2 + nbits3;
+  return nbits / 8 + (nbits % 8 != 0);
+}
+
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
-  size_t nbits;
   const uint8_t* in;
   uint8_t* out;
   grpc_slice output;
   uint64_t temp = 0;
   uint32_t temp_length = 0;
 
-  nbits = 0;
-  for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
-       ++in) {
-    nbits += grpc_chttp2_huffsyms[*in].length;
-  }
-
-  output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
+  output = GRPC_SLICE_MALLOC(grpc_chttp2_huffman_compressed_length(
+      GRPC_SLICE_START_PTR(input), GRPC_SLICE_END_PTR(input)));
   out = GRPC_SLICE_START_PTR(output);
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
        ++in) {
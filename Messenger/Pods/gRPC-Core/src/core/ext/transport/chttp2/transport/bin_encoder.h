@@ -21,6 +21,9 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <grpc/slice.h>
 
 /* base64 encode a slice. Returns a new slice, does not take ownership of the
@@ -31,6 +34,11 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input);
    standard. Returns a new slice, does not take ownership of the input */
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input);
 
+/* Returns the number of bytes grpc_chttp2_huffman_compress would produce for
+   the given bytes, without encoding them */
+size_t grpc_chttp2_huffman_compressed_length(const uint8_t* begin,
+                                             const uint8_t* end);
+
 /* equivalent to:
    grpc_slice x = grpc_chttp2_base64_encode(input);
    grpc_slice y = grpc_chttp2_huffman_compress(x);
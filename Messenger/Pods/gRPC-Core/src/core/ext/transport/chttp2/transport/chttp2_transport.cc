@@ -72,6 +72,7 @@
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/promise/poll.h"
 #include "src/core/lib/resource_quota/arena.h"
@@ -91,6 +92,10 @@
 #include "src/core/lib/transport/transport.h"
 #include "src/core/lib/transport/transport_impl.h"
 
+#ifdef GRPC_POSIX_SOCKET_UTILS_COMMON
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#endif
+
 #define DEFAULT_CONNECTION_WINDOW_TARGET (1024 * 1024)
 #define MAX_WINDOW 0x7fffffffu
 #define MAX_WRITE_BUFFER_SIZE (64 * 1024 * 1024)
@@ -109,6 +114,10 @@
 
 #define DEFAULT_MAX_PENDING_INDUCED_FRAMES 10000
 
+/* Writes averaging less than this many bytes are deferred once to coalesce
+   frames from other streams */
+#define COALESCE_WRITE_SIZE_THRESHOLD (16 * 1024)
+
 static int g_default_client_keepalive_time_ms =
     DEFAULT_CLIENT_KEEPALIVE_TIME_MS;
 static int g_default_client_keepalive_timeout_ms =
@@ -135,6 +144,8 @@ grpc_core::DebugOnlyTraceFlag grpc_trace_chttp2_refcount(false,
 
 // forward declarations of various callbacks that we'll build closures around
 static void write_action_begin_locked(void* t, grpc_error_handle error);
+static void write_action_coalesce(void* t, grpc_error_handle error);
+static void write_action_coalesce_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
@@ -478,6 +489,9 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   GPR_ASSERT(strlen(GRPC_CHTTP2_CLIENT_CONNECT_STRING) ==
              GRPC_CHTTP2_CLIENT_CONNECT_STRLEN);
   base.vtable = get_vtable();
+  // Traced streams (see ContextList) get their kernel write timestamps
+  // through this callback; it is a no-op where the endpoint cannot track them.
+  grpc_core::ContextList::RegisterTimestampsCallback();
   // 8 is a random stab in the dark as to a good initial size: it's small enough
   //   that it shouldn't waste memory for infrequently used connections, yet
   //   large enough that the exponential growth should happen nicely when it's
@@ -517,6 +531,18 @@ grpc_chttp2_transport::grpc_chttp2_transport(
 
   read_channel_args(this, channel_args, is_client);
 
+#ifdef GRPC_POSIX_SOCKET_UTILS_COMMON
+  int fd = grpc_endpoint_get_fd(ep);
+  if (fd >= 0) {
+    grpc_error_handle error =
+        grpc_get_socket_sndbuf(fd, &socket_send_buffer_size);
+    if (!GRPC_ERROR_IS_NONE(error)) {
+      socket_send_buffer_size = 0;
+      GRPC_ERROR_UNREF(error);
+    }
+  }
+#endif
+
   // No pings allowed before receiving a header or data frame.
   ping_state.pings_before_data_required = 0;
   ping_state.is_delayed_ping_timer_set = false;
@@ -790,6 +816,20 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
+      // If recent writes have been small and other streams are open, step
+      // out of the combiner once before gathering: stream ops from other
+      // calls that are already queued on this ExecCtx then get to add their
+      // frames, and go out in the same write instead of one write each.
+      if (t->average_write_size < COALESCE_WRITE_SIZE_THRESHOLD &&
+          grpc_chttp2_stream_map_size(&t->stream_map) > 1) {
+        GRPC_STATS_INC_HTTP2_WRITES_COALESCED();
+        grpc_core::ExecCtx::Run(
+            DEBUG_LOCATION,
+            GRPC_CLOSURE_INIT(&t->write_action_coalesce, write_action_coalesce,
+                              t, nullptr),
+            GRPC_ERROR_NONE);
+        break;
+      }
       // Note that the 'write_action_begin_locked' closure is being scheduled
       // on the 'finally_scheduler' of t->combiner. This means that
       // 'write_action_begin_locked' is called only *after* all the other
@@ -828,6 +868,22 @@ void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
   }
 }
 
+static void write_action_coalesce(void* gt, grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
+  t->combiner->Run(GRPC_CLOSURE_INIT(&t->write_action_coalesce,
+                                     write_action_coalesce_locked, t, nullptr),
+                   GRPC_ERROR_NONE);
+}
+
+static void write_action_coalesce_locked(void* gt,
+                                         grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
+  t->combiner->FinallyRun(
+      GRPC_CLOSURE_INIT(&t->write_action_begin_locked,
+                        write_action_begin_locked, t, nullptr),
+      GRPC_ERROR_NONE);
+}
+
 static const char* begin_writing_desc(bool partial) {
   if (partial) {
     return "begin partial write in background";
@@ -23,22 +23,20 @@
 #include <stdint.h>
 
 #include "src/core/ext/transport/chttp2/transport/internal.h"
-
-namespace {
-void (*write_timestamps_callback_g)(void*, grpc_core::Timestamps*,
-                                    grpc_error_handle error) = nullptr;
-void* (*get_copied_context_fn_g)(void*) = nullptr;
-}  // namespace
+#include "src/core/lib/channel/context.h"
 
 namespace grpc_core {
 void ContextList::Append(ContextList** head, grpc_chttp2_stream* s) {
-  if (get_copied_context_fn_g == nullptr ||
-      write_timestamps_callback_g == nullptr) {
-    return;
-  }
+  if (s->context == nullptr) return;
+  auto* context = static_cast<grpc_call_context_element*>(s->context);
+  CallTracer* tracer =
+      static_cast<CallTracer*>(context[GRPC_CONTEXT_CALL_TRACER].value);
+  if (tracer == nullptr) return;
+  CallTracer::TcpWriteTracer* write_tracer = tracer->StartTcpWrite();
+  if (write_tracer == nullptr) return;
   /* Create a new element in the list and add it at the front */
   ContextList* elem = new ContextList();
-  elem->trace_context_ = get_copied_context_fn_g(s->context);
+  elem->tracer_ = write_tracer;
   elem->byte_offset_ = s->byte_counter;
   elem->next_ = *head;
   *head = elem;
@@ -48,24 +46,22 @@ void ContextList::Execute(void* arg, Timestamps* ts, grpc_error_handle error) {
   ContextList* head = static_cast<ContextList*>(arg);
   ContextList* to_be_freed;
   while (head != nullptr) {
-    if (write_timestamps_callback_g) {
-      if (ts) {
-        ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
-      }
-      write_timestamps_callback_g(head->trace_context_, ts, error);
+    if (ts) {
+      ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
     }
+    head->tracer_->RecordTimestamps(ts, error);
+    delete head->tracer_;
     to_be_freed = head;
     head = head->next_;
     delete to_be_freed;
   }
 }
 
-void grpc_http2_set_write_timestamps_callback(
-    void (*fn)(void*, Timestamps*, grpc_error_handle error)) {
-  write_timestamps_callback_g = fn;
-}
-
-void grpc_http2_set_fn_get_copied_context(void* (*fn)(void*)) {
-  get_copied_context_fn_g = fn;
+void ContextList::RegisterTimestampsCallback() {
+  static const bool registered = [] {
+    grpc_tcp_set_write_timestamps_callback(Execute);
+    return true;
+  }();
+  (void)registered;
 }
 } /* namespace grpc_core */
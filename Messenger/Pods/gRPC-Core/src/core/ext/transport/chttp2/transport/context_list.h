@@ -24,31 +24,34 @@
 #include <stddef.h>
 
 #include "src/core/ext/transport/chttp2/transport/frame.h"
+#include "src/core/lib/channel/call_tracer.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/error.h"
 
 namespace grpc_core {
-/** A list of RPC Contexts */
+
+/** A list of the traced streams that have bytes in one TCP write */
 class ContextList {
  public:
-  /* Creates a new element with \a context as the value and appends it to the
-   * list. */
+  /* If the CallTracer of \a s wants this write, appends a TcpWriteTracer for
+   * it to the list. The list does not refer to the stream or the call, which
+   * may be gone by the time the write is acked. */
   static void Append(ContextList** head, grpc_chttp2_stream* s);
 
-  /* Executes a function \a fn with each context in the list and \a ts. It also
-   * frees up the entire list after this operation. It is intended as a callback
-   * and hence does not take a ref on \a error */
+  /* Hands \a ts to each TcpWriteTracer in the list and frees the
+   * list. It is intended as a callback and hence does not take a ref on
+   * \a error */
   static void Execute(void* arg, Timestamps* ts, grpc_error_handle error);
 
+  /* Installs Execute() as the TCP layer's write timestamps callback. Safe to
+   * call more than once. */
+  static void RegisterTimestampsCallback();
+
  private:
-  void* trace_context_ = nullptr;
+  CallTracer::TcpWriteTracer* tracer_ = nullptr;
   ContextList* next_ = nullptr;
   size_t byte_offset_ = 0;
 };
-
-void grpc_http2_set_write_timestamps_callback(
-    void (*fn)(void*, Timestamps*, grpc_error_handle error));
-void grpc_http2_set_fn_get_copied_context(void* (*fn)(void*));
 } /* namespace grpc_core */
 
 #endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_CONTEXT_LIST_H */
@@ -0,0 +1,94 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/decode_huff_multi.h"
+
+#include <string.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
+
+namespace grpc_core {
+
+namespace {
+
+MultiSymbolHuffTables* BuildTables() {
+  using Tables = MultiSymbolHuffTables;
+  constexpr int kLookupBits = Tables::kLookupBits;
+  constexpr uint32_t kTableSize = 1u << kLookupBits;
+  auto* tables = new Tables;
+  memset(tables, 0, sizeof(*tables));
+
+  // Single symbol decode of every kLookupBits-bit window: (sym | len << 8),
+  // or 0 if the window starts with a longer code.
+  auto* single = new uint16_t[kTableSize]();
+  for (int sym = 0; sym < GRPC_CHTTP2_NUM_HUFFSYMS; sym++) {
+    const int len = static_cast<int>(grpc_chttp2_huffsyms[sym].length);
+    if (len > kLookupBits) continue;
+    const uint32_t base = grpc_chttp2_huffsyms[sym].bits << (kLookupBits - len);
+    for (uint32_t suffix = 0; suffix < (1u << (kLookupBits - len)); suffix++) {
+      single[base | suffix] = static_cast<uint16_t>(sym | (len << 8));
+    }
+  }
+  for (uint32_t i = 0; i < kTableSize; i++) {
+    if (single[i] == 0) continue;
+    const uint32_t sym0 = single[i] & 0xff;
+    const uint32_t len0 = single[i] >> 8;
+    uint32_t entry = sym0 | (len0 << 16) | (1u << 20) | (len0 << 22);
+    const uint16_t next = single[(i << len0) & (kTableSize - 1)];
+    if (next != 0 && static_cast<uint32_t>(next >> 8) <= kLookupBits - len0) {
+      const uint32_t len1 = next >> 8;
+      entry = sym0 | ((next & 0xffu) << 8) | ((len0 + len1) << 16) |
+              (2u << 20) | (len0 << 22);
+    }
+    tables->fast[i] = entry;
+  }
+  delete[] single;
+
+  // Canonical decoding for the long codes: symbols ordered by code length and
+  // then by code, with the first code and symbol count of each length.
+  for (int sym = 0; sym < GRPC_CHTTP2_NUM_HUFFSYMS; sym++) {
+    tables->count[grpc_chttp2_huffsyms[sym].length]++;
+  }
+  uint16_t next_offset = 0;
+  for (int len = 1; len <= Tables::kMaxCodeLength; len++) {
+    tables->offset[len] = next_offset;
+    next_offset += tables->count[len];
+    tables->first_code[len] = UINT32_MAX;
+  }
+  uint16_t filled[Tables::kMaxCodeLength + 1] = {};
+  for (int sym = 0; sym < GRPC_CHTTP2_NUM_HUFFSYMS; sym++) {
+    const int len = static_cast<int>(grpc_chttp2_huffsyms[sym].length);
+    const uint32_t code = grpc_chttp2_huffsyms[sym].bits;
+    if (filled[len] == 0) tables->first_code[len] = code;
+    // The HPACK code is canonical: within a length, codes are consecutive in
+    // symbol order.
+    GPR_ASSERT(code == tables->first_code[len] + filled[len]);
+    tables->symbols[tables->offset[len] + filled[len]++] =
+        static_cast<uint16_t>(sym);
+  }
+  return tables;
+}
+
+}  // namespace
+
+const MultiSymbolHuffTables& MultiSymbolHuffTables::Get() {
+  static const MultiSymbolHuffTables* tables = BuildTables();
+  return *tables;
+}
+
+}  // namespace grpc_core
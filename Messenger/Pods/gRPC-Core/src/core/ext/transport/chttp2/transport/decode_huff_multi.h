@@ -0,0 +1,143 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_DECODE_HUFF_MULTI_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_DECODE_HUFF_MULTI_H
+
+#include <grpc/support/port_platform.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace grpc_core {
+
+// Lookup tables shared by all MultiSymbolHuffDecoder instances.
+//
+// The fast table is indexed by the next kLookupBits bits of input and decodes
+// every symbol that fits entirely within them - up to two, since the shortest
+// HPACK code is five bits long. Each entry packs:
+//   bits  0..7:  first symbol
+//   bits  8..15: second symbol
+//   bits 16..19: total bits consumed by the decoded symbols
+//   bits 20..21: number of symbols decoded (0 if the next code is longer
+//                than kLookupBits)
+//   bits 22..25: length of the first symbol's code
+// Longer codes, which only encode rarely used bytes, are decoded
+// canonically from first_code/count/offset.
+struct MultiSymbolHuffTables {
+  static constexpr int kLookupBits = 12;
+  static constexpr int kMaxCodeLength = 30;
+
+  uint32_t fast[1 << kLookupBits];
+  uint32_t first_code[kMaxCodeLength + 1];
+  uint16_t count[kMaxCodeLength + 1];
+  uint16_t offset[kMaxCodeLength + 1];
+  uint16_t symbols[257];
+
+  static const MultiSymbolHuffTables& Get();
+};
+
+// Decodes an HPACK Huffman string (RFC 7541 section 5.2), calling sink(uint8_t)
+// for each decoded byte. Most lookups emit two symbols, against one per nibble
+// (or per code) for the table-driven state machines.
+// Returns false if the input is not a valid encoding: an explicit EOS, or
+// trailing bits that are not a prefix of EOS.
+template <typename F>
+class MultiSymbolHuffDecoder {
+ public:
+  MultiSymbolHuffDecoder(F sink, const uint8_t* begin, const uint8_t* end)
+      : sink_(sink), begin_(begin), end_(end) {}
+
+  bool Run() {
+    using Tables = MultiSymbolHuffTables;
+    constexpr int kLookupBits = Tables::kLookupBits;
+    constexpr uint32_t kLookupMask = (1u << kLookupBits) - 1;
+    const Tables& tables = Tables::Get();
+    while (true) {
+      Refill();
+      if (buffer_len_ < kLookupBits) break;
+      const uint32_t entry =
+          tables.fast[(buffer_ >> (buffer_len_ - kLookupBits)) & kLookupMask];
+      const uint32_t n = (entry >> 20) & 3;
+      if (GPR_UNLIKELY(n == 0)) {
+        if (!DecodeLong(tables)) return RemainingBitsArePadding();
+        continue;
+      }
+      sink_(static_cast<uint8_t>(entry));
+      if (n == 2) sink_(static_cast<uint8_t>(entry >> 8));
+      buffer_len_ -= (entry >> 16) & 15;
+    }
+    // Fewer than kLookupBits bits remain: pad with ones (the EOS prefix) so
+    // the same table applies, but only accept codes within the real bits.
+    while (buffer_len_ > 0) {
+      const int pad = kLookupBits - buffer_len_;
+      const uint32_t index =
+          ((static_cast<uint32_t>(buffer_) << pad) | ((1u << pad) - 1)) &
+          kLookupMask;
+      const uint32_t entry = tables.fast[index];
+      const int first_len = static_cast<int>((entry >> 22) & 15);
+      if (((entry >> 20) & 3) == 0 || first_len > buffer_len_) break;
+      sink_(static_cast<uint8_t>(entry));
+      buffer_len_ -= first_len;
+    }
+    return RemainingBitsArePadding();
+  }
+
+ private:
+  void Refill() {
+    while (buffer_len_ <= 56 && begin_ != end_) {
+      buffer_ = (buffer_ << 8) | *begin_++;
+      buffer_len_ += 8;
+    }
+  }
+
+  // What is left must be a prefix of EOS, i.e. all ones. RFC 7541 limits this
+  // to seven bits; like the other decoders, longer padding is tolerated.
+  bool RemainingBitsArePadding() {
+    if (begin_ != end_) return false;
+    const uint64_t pad_mask = buffer_len_ == 64
+                                  ? ~uint64_t{0}
+                                  : (uint64_t{1} << buffer_len_) - 1;
+    return (buffer_ & pad_mask) == pad_mask;
+  }
+
+  bool DecodeLong(const MultiSymbolHuffTables& tables) {
+    for (int len = MultiSymbolHuffTables::kLookupBits + 1;
+         len <= MultiSymbolHuffTables::kMaxCodeLength; len++) {
+      if (len > buffer_len_) return false;
+      const uint32_t code = static_cast<uint32_t>(
+          (buffer_ >> (buffer_len_ - len)) & ((uint64_t{1} << len) - 1));
+      const uint32_t rel = code - tables.first_code[len];
+      if (rel < tables.count[len]) {
+        const uint16_t sym = tables.symbols[tables.offset[len] + rel];
+        // EOS must not appear inside a string.
+        if (sym > 255) return false;
+        sink_(static_cast<uint8_t>(sym));
+        buffer_len_ -= len;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  F sink_;
+  const uint8_t* begin_;
+  const uint8_t* const end_;
+  uint64_t buffer_ = 0;
+  int buffer_len_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_DECODE_HUFF_MULTI_H
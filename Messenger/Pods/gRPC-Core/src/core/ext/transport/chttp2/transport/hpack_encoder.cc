@@ -20,9 +20,12 @@
 
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <type_traits>
 
 #include <grpc/slice.h>
 #include <grpc/slice_buffer.h>
@@ -33,6 +36,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_constants.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder_table.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/surface/validate_metadata.h"
 #include "src/core/lib/transport/timeout_encoding.h"
 
@@ -41,6 +45,98 @@ namespace grpc_core {
 namespace {
 
 constexpr size_t kDataFrameHeaderSize = 9;
+// Largest frame payload HTTP/2 allows (2^24-1).
+constexpr size_t kMaxFrameSize = 16777215;
+
+// Fields that the Framer emits indexed, or as literals drawn from a small set
+// of values, so that a block of them is likely to be sent again as is. All
+// other fields are emitted as non-indexing literals: custom metadata (which
+// includes sensitive fields such as authorization and cookie) and per-call
+// values such as grpc-trace-bin.
+template <typename Which>
+struct IsCacheableField : std::false_type {};
+template <>
+struct IsCacheableField<HttpPathMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<HttpAuthorityMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<HttpStatusMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<HttpSchemeMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<HttpMethodMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<TeMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<ContentTypeMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<UserAgentMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<GrpcStatusMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<GrpcEncodingMetadata> : std::true_type {};
+template <>
+struct IsCacheableField<GrpcAcceptEncodingMetadata> : std::true_type {};
+
+// Builds the header block cache key for a metadata batch: every encoded field
+// except grpc-timeout, length prefixed so that distinct batches never collide.
+// A batch with any field that is not cacheable gets no key at all, and none
+// of its values are copied.
+class HeaderBlockKeyBuilder {
+ public:
+  explicit HeaderBlockKeyBuilder(bool use_true_binary_metadata)
+      : key_(1, use_true_binary_metadata ? '1' : '0') {}
+
+  void Encode(const Slice&, const Slice&) { cacheable_ = false; }
+  void Encode(GrpcTimeoutMetadata, Timestamp) {}
+  // Not emitted at all when empty.
+  void Encode(GrpcMessageMetadata, const Slice& slice) {
+    if (!slice.empty()) cacheable_ = false;
+  }
+  template <typename Which>
+  void Encode(Which, const typename Which::ValueType& value) {
+    if (!cacheable_) return;
+    if (!IsCacheableField<Which>::value) {
+      cacheable_ = false;
+      return;
+    }
+    Append(Which::key(), MetadataValueAsSlice<Which>(value).as_string_view());
+  }
+
+  bool cacheable() const { return cacheable_; }
+  std::string TakeKey() { return std::move(key_); }
+
+ private:
+  void Append(absl::string_view key, absl::string_view value) {
+    AppendLength(key.size());
+    key_.append(key.data(), key.size());
+    AppendLength(value.size());
+    key_.append(value.data(), value.size());
+  }
+  void AppendLength(size_t length) {
+    const uint32_t n = static_cast<uint32_t>(length);
+    key_.append(reinterpret_cast<const char*>(&n), sizeof(n));
+  }
+
+  bool cacheable_ = true;
+  std::string key_;
+};
+
+// Forwards every field but grpc-timeout to a framer.
+class SkipTimeoutEncoder {
+ public:
+  explicit SkipTimeoutEncoder(HPackCompressor::Framer* framer)
+      : framer_(framer) {}
+
+  void Encode(GrpcTimeoutMetadata, Timestamp) {}
+  template <typename Key, typename Value>
+  void Encode(const Key& key, const Value& value) {
+    framer_->Encode(key, value);
+  }
+
+ private:
+  HPackCompressor::Framer* const framer_;
+};
 
 } /* namespace */
 
@@ -154,6 +250,9 @@ uint8_t* HPackCompressor::Framer::AddTiny(size_t len) {
 }
 
 void HPackCompressor::Framer::EmitIndexed(uint32_t elem_index) {
+  if (elem_index > hpack_constants::kLastStaticEntry) {
+    used_dynamic_table_ = true;
+  }
   VarintWriter<1> w(elem_index);
   w.Write(0x80, AddTiny(w.length()));
 }
@@ -182,7 +281,13 @@ static WireValue GetWireValue(Slice value, bool true_binary_enabled,
                            value.c_slice())));
     }
   } else {
-    /* TODO(ctiller): opportunistically compress non-binary headers */
+    /* Huffman code the value when that makes it shorter: sizing it first is
+       a table lookup per byte, much cheaper than the encode itself. */
+    if (grpc_chttp2_huffman_compressed_length(value.begin(), value.end()) <
+        value.length()) {
+      return WireValue(0x80, false,
+                       Slice(grpc_chttp2_huffman_compress(value.c_slice())));
+    }
     return WireValue(0x00, false, std::move(value));
   }
 }
@@ -227,16 +332,19 @@ class BinaryStringValue {
 class NonBinaryStringValue {
  public:
   explicit NonBinaryStringValue(Slice value)
-      : value_(std::move(value)), len_val_(value_.length()) {}
+      : wire_value_(GetWireValue(std::move(value), false, false)),
+        len_val_(wire_value_.length) {}
 
   size_t prefix_length() const { return len_val_.length(); }
 
-  void WritePrefix(uint8_t* prefix_data) { len_val_.Write(0x00, prefix_data); }
+  void WritePrefix(uint8_t* prefix_data) {
+    len_val_.Write(wire_value_.huffman_prefix, prefix_data);
+  }
 
-  Slice data() { return std::move(value_); }
+  Slice data() { return std::move(wire_value_.data); }
 
  private:
-  Slice value_;
+  WireValue wire_value_;
   VarintWriter<1> len_val_;
 };
 
@@ -291,6 +399,9 @@ void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyIncIdx(
 
 void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyNotIdx(
     uint32_t key_index, Slice value_slice) {
+  if (key_index > hpack_constants::kLastStaticEntry) {
+    used_dynamic_table_ = true;
+  }
   BinaryStringValue emit(std::move(value_slice), use_true_binary_metadata_);
   VarintWriter<4> key(key_index);
   uint8_t* data = AddTiny(key.length() + emit.prefix_length());
@@ -634,6 +745,85 @@ void HPackCompressor::Framer::Encode(GrpcAcceptEncodingMetadata,
                                          std::move(encoded_value));
 }
 
+void HPackCompressor::EncodeHeaders(const EncodeHeaderOptions& options,
+                                   const grpc_metadata_batch& headers,
+                                   grpc_slice_buffer* output) {
+  Framer framer(options, this, output);
+  HeaderBlockKeyBuilder key_builder(options.use_true_binary_metadata);
+  headers.Encode(&key_builder);
+  if (!key_builder.cacheable()) {
+    headers.Encode(&framer);
+    return;
+  }
+  std::string key = key_builder.TakeKey();
+  if (key.size() > kMaxCachedHeaderBlockKeySize) {
+    headers.Encode(&framer);
+    return;
+  }
+  const uint64_t now = ++header_block_cache_clock_;
+  auto it = header_block_cache_.find(key);
+  if (it != header_block_cache_.end() &&
+      (!it->second.uses_dynamic_table ||
+       it->second.generation == table_.generation())) {
+    GRPC_STATS_INC_HTTP2_HEADER_BLOCK_CACHE_HITS();
+    it->second.last_use = now;
+    framer.Add(it->second.block.Ref());
+  } else {
+    GRPC_STATS_INC_HTTP2_HEADER_BLOCK_CACHE_MISSES();
+    // Encode into a scratch frame, then copy the block out of it.
+    const uint32_t generation = table_.generation();
+    bool uses_dynamic_table;
+    grpc_transport_one_way_stats scratch_stats;
+    grpc_slice_buffer scratch;
+    grpc_slice_buffer_init(&scratch);
+    {
+      Framer scratch_framer(
+          EncodeHeaderOptions{options.stream_id, false,
+                              options.use_true_binary_metadata,
+                              kMaxFrameSize, &scratch_stats},
+          this, &scratch);
+      SkipTimeoutEncoder encoder(&scratch_framer);
+      headers.Encode(&encoder);
+      uses_dynamic_table = scratch_framer.used_dynamic_table_;
+    }
+    // The first slice is the reserved frame header.
+    GPR_DEBUG_ASSERT(scratch.count > 0);
+    MutableSlice encoded = MutableSlice::CreateUninitialized(
+        scratch.length - GRPC_SLICE_LENGTH(scratch.slices[0]));
+    uint8_t* p = encoded.data();
+    for (size_t i = 1; i < scratch.count; i++) {
+      const size_t len = GRPC_SLICE_LENGTH(scratch.slices[i]);
+      memcpy(p, GRPC_SLICE_START_PTR(scratch.slices[i]), len);
+      p += len;
+    }
+    grpc_slice_buffer_destroy(&scratch);
+    Slice block(std::move(encoded));
+    if (table_.generation() != generation) {
+      // Encoding added to the table, so the block would not replay.
+      if (it != header_block_cache_.end()) header_block_cache_.erase(it);
+    } else if (it != header_block_cache_.end()) {
+      it->second = CachedHeaderBlock{block.Ref(), uses_dynamic_table,
+                                     generation, now};
+    } else {
+      if (header_block_cache_.size() >= kMaxCachedHeaderBlocks) {
+        auto lru = header_block_cache_.begin();
+        for (auto jt = header_block_cache_.begin();
+             jt != header_block_cache_.end(); ++jt) {
+          if (jt->second.last_use < lru->second.last_use) lru = jt;
+        }
+        header_block_cache_.erase(lru);
+      }
+      header_block_cache_.emplace(
+          std::move(key),
+          CachedHeaderBlock{block.Ref(), uses_dynamic_table, generation, now});
+    }
+    framer.Add(std::move(block));
+  }
+  if (auto* deadline = headers.get_pointer(GrpcTimeoutMetadata())) {
+    framer.Encode(GrpcTimeoutMetadata(), *deadline);
+  }
+}
+
 void HPackCompressor::SetMaxUsableSize(uint32_t max_table_size) {
   max_usable_size_ = max_table_size;
   SetMaxTableSize(std::min(table_.max_size(), max_table_size));
@@ -24,9 +24,11 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 
@@ -80,6 +82,15 @@ class HPackCompressor {
     headers.Encode(&framer);
   }
 
+  // Encodes a metadata batch. When an earlier batch on this connection had
+  // the same fields and encoded to an already-indexed block, that block is
+  // copied out as-is instead of being encoded again. Batches with fields that
+  // are never indexed (custom metadata such as authorization, grpc-trace-bin
+  // and the like) always go field by field.
+  void EncodeHeaders(const EncodeHeaderOptions& options,
+                     const grpc_metadata_batch& headers,
+                     grpc_slice_buffer* output);
+
   class Framer {
    public:
     Framer(const EncodeHeaderOptions& options, HPackCompressor* compressor,
@@ -122,6 +133,7 @@ class HPackCompressor {
     }
 
    private:
+    friend class HPackCompressor;
     friend class SliceIndex;
 
     struct FramePrefix {
@@ -173,11 +185,17 @@ class HPackCompressor {
     grpc_transport_one_way_stats* const stats_;
     HPackCompressor* const compressor_;
     FramePrefix prefix_;
+    // Whether anything emitted so far refers to the dynamic table.
+    bool used_dynamic_table_ = false;
   };
 
  private:
   static constexpr size_t kNumFilterValues = 64;
   static constexpr uint32_t kNumCachedGrpcStatusValues = 16;
+  static constexpr size_t kMaxCachedHeaderBlocks = 16;
+  // Bounds the encoded size of a cached block well below the largest frame,
+  // so that it is always encoded into a single scratch frame.
+  static constexpr size_t kMaxCachedHeaderBlockKeySize = 16 * 1024;
 
   // maximum number of bytes we'll use for the decode table (to guard against
   // peers ooming us by setting decode table size high)
@@ -229,6 +247,22 @@ class HPackCompressor {
   SliceIndex path_index_;
   SliceIndex authority_index_;
   std::vector<PreviousTimeout> previous_timeouts_;
+  // A pre-encoded header block. It is only cached if encoding it left table_
+  // untouched - i.e. every field was emitted indexed or as a non-indexing
+  // literal. A block that refers to the dynamic table can only be replayed
+  // while table_ stays at the generation it was encoded at.
+  struct CachedHeaderBlock {
+    Slice block;
+    bool uses_dynamic_table;
+    uint32_t generation;
+    // Value of header_block_cache_clock_ when the block was last used.
+    uint64_t last_use;
+  };
+  // Pre-encoded header blocks, keyed by the fields (other than grpc-timeout,
+  // which changes from call to call) that they encode. Once full, the least
+  // recently used block makes way for a new one.
+  absl::flat_hash_map<std::string, CachedHeaderBlock> header_block_cache_;
+  uint64_t header_block_cache_clock_ = 0;
 };
 
 }  // namespace grpc_core
@@ -273,6 +273,7 @@ struct grpc_chttp2_transport {
   grpc_chttp2_stream_map stream_map;
 
   grpc_closure write_action_begin_locked;
+  grpc_closure write_action_coalesce;
   grpc_closure write_action;
   grpc_closure write_action_end_locked;
 
@@ -438,6 +439,13 @@ struct grpc_chttp2_transport {
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
   uint32_t num_messages_in_next_write = 0;
+  /** Send buffer size of the underlying socket, or 0 if unknown. Together
+   * with the BDP estimate this sizes each write (see target_write_size). */
+  int socket_send_buffer_size = 0;
+  /** Moving average of the number of bytes put into each write. While it
+   * stays small, writes are deferred once so that frames from other streams
+   * can join them. */
+  uint32_t average_write_size = 0;
   /** The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
    * RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
    * DEFAULT_MAX_PENDING_INDUCED_FRAMES, we pause reading new frames. We would
@@ -48,6 +48,7 @@
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -228,9 +229,21 @@ static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
   }
 }
 
-/* How many bytes would we like to put on the wire during a single syscall */
-static uint32_t target_write_size(grpc_chttp2_transport* /*t*/) {
-  return 1024 * 1024;
+/* Bounds on how many bytes we gather into a single write. The floor is the
+   previous fixed target, so small BDP estimates never shrink writes. */
+static constexpr int64_t kMinTargetWriteSize = 1024 * 1024;
+static constexpr int64_t kMaxTargetWriteSize = 8 * 1024 * 1024;
+
+/* How many bytes would we like to put on the wire during a single syscall:
+   enough to keep the pipe full until the next write is ready (twice the
+   estimated bandwidth-delay product), and at least whatever the socket will
+   take in one go, but never less than kMinTargetWriteSize. */
+static uint32_t target_write_size(grpc_chttp2_transport* t) {
+  int64_t target = std::max<int64_t>(
+      2 * t->flow_control.bdp_estimator()->EstimateBdp(),
+      t->socket_send_buffer_size);
+  return static_cast<uint32_t>(
+      grpc_core::Clamp(target, kMinTargetWriteSize, kMaxTargetWriteSize));
 }
 
 namespace {
@@ -328,6 +341,7 @@ class WriteContext {
 
   grpc_chttp2_stream* NextStream() {
     if (t_->outbuf.length > target_write_size(t_)) {
+      GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
       result_.partial = true;
       return nullptr;
     }
@@ -658,7 +672,16 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
 
   maybe_initiate_ping(t);
 
-  return ctx.Result();
+  grpc_chttp2_begin_write_result result = ctx.Result();
+  if (result.writing) {
+    GRPC_STATS_INC_HTTP2_WRITE_SIZE(t->outbuf.length);
+    // Weight the latest write by 1/8th.
+    t->average_write_size = static_cast<uint32_t>(
+        (7 * static_cast<uint64_t>(t->average_write_size) +
+         std::min<size_t>(t->outbuf.length, kMaxTargetWriteSize)) /
+        8);
+  }
+  return result;
 }
 
 void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error) {
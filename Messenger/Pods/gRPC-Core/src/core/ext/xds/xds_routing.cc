@@ -27,8 +27,10 @@
 #include <cctype>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 
@@ -175,6 +177,208 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+//
+// XdsRouting::IndexTrie
+//
+
+void XdsRouting::IndexTrie::Insert(absl::string_view key, size_t index) {
+  Node* node = &root_;
+  for (char c : key) {
+    std::unique_ptr<Node>& child = node->children[c];
+    if (child == nullptr) child = absl::make_unique<Node>();
+    node = child.get();
+  }
+  // Callers insert in index order, so this keeps the list sorted.
+  if (node->indexes.empty() || node->indexes.back() != index) {
+    node->indexes.push_back(index);
+  }
+}
+
+template <typename F>
+void XdsRouting::IndexTrie::ForEachPrefixOf(absl::string_view s, F fn) const {
+  const Node* node = &root_;
+  for (size_t depth = 0;; ++depth) {
+    if (!node->indexes.empty()) fn(depth, node->indexes);
+    if (depth == s.size()) return;
+    auto it = node->children.find(s[depth]);
+    if (it == node->children.end()) return;
+    node = it->second.get();
+  }
+}
+
+//
+// XdsRouting::CompiledVirtualHostTable
+//
+
+XdsRouting::CompiledVirtualHostTable::CompiledVirtualHostTable(
+    const VirtualHostListIterator& vhost_iterator) {
+  for (size_t i = 0; i < vhost_iterator.Size(); ++i) {
+    for (const std::string& domain_pattern :
+         vhost_iterator.GetDomainsForVirtualHost(i)) {
+      const std::string pattern = absl::AsciiStrToLower(domain_pattern);
+      const MatchType match_type = DomainPatternMatchType(pattern);
+      // This should be caught by RouteConfigParse().
+      GPR_ASSERT(match_type != INVALID_MATCH);
+      switch (match_type) {
+        case EXACT_MATCH:
+          // Keeps the first virtual host if the pattern repeats.
+          exact_.emplace(pattern, i);
+          break;
+        case SUFFIX_MATCH:
+          suffixes_.Insert(std::string(pattern.rbegin(), pattern.rend() - 1),
+                           i);
+          break;
+        case PREFIX_MATCH:
+          prefixes_.Insert(
+              absl::string_view(pattern).substr(0, pattern.size() - 1), i);
+          break;
+        case UNIVERSE_MATCH:
+          if (!universe_.has_value()) universe_ = i;
+          break;
+        case INVALID_MATCH:
+          break;
+      }
+    }
+  }
+}
+
+absl::optional<size_t> XdsRouting::CompiledVirtualHostTable::Find(
+    absl::string_view domain) const {
+  // Same precedence as FindVirtualHostForDomain(): exact, then the longest
+  // suffix, then the longest prefix, then "*".
+  const std::string host = absl::AsciiStrToLower(domain);
+  auto it = exact_.find(host);
+  if (it != exact_.end()) return it->second;
+  absl::optional<size_t> target_index;
+  // The asterisk must match at least one char, so a pattern as long as the
+  // whole host does not count. Deeper matches are longer and win.
+  auto on_match = [&](size_t depth, const std::vector<size_t>& indexes) {
+    if (depth < host.size()) target_index = indexes.front();
+  };
+  suffixes_.ForEachPrefixOf(std::string(host.rbegin(), host.rend()), on_match);
+  if (target_index.has_value()) return target_index;
+  prefixes_.ForEachPrefixOf(host, on_match);
+  if (target_index.has_value()) return target_index;
+  return universe_;
+}
+
+//
+// XdsRouting::CompiledRouteTable
+//
+
+XdsRouting::CompiledRouteTable::CompiledRouteTable(
+    const RouteListIterator& route_list_iterator) {
+  std::vector<size_t> regex_routes;
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    const StringMatcher& path_matcher =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher;
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+        if (path_matcher.case_sensitive()) {
+          exact_[path_matcher.string_matcher()].push_back(i);
+        } else {
+          exact_ignore_case_[absl::AsciiStrToLower(
+                                 path_matcher.string_matcher())]
+              .push_back(i);
+        }
+        break;
+      case StringMatcher::Type::kPrefix:
+        if (path_matcher.case_sensitive()) {
+          prefixes_.Insert(path_matcher.string_matcher(), i);
+        } else {
+          prefixes_ignore_case_.Insert(
+              absl::AsciiStrToLower(path_matcher.string_matcher()), i);
+        }
+        break;
+      case StringMatcher::Type::kSafeRegex:
+        regex_routes.push_back(i);
+        break;
+      default:
+        unindexed_routes_.push_back(i);
+        break;
+    }
+  }
+  if (regex_routes.empty()) return;
+  // StringMatcher compiles its regexes with the default options and matches
+  // them with FullMatch().
+  auto regex_set =
+      absl::make_unique<RE2::Set>(RE2::DefaultOptions, RE2::ANCHOR_BOTH);
+  bool ok = true;
+  for (size_t i : regex_routes) {
+    const RE2* regex =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher.regex_matcher();
+    if (regex_set->Add(regex->pattern(), nullptr) < 0) {
+      ok = false;
+      break;
+    }
+  }
+  if (ok && regex_set->Compile()) {
+    regex_set_ = std::move(regex_set);
+    regex_routes_ = std::move(regex_routes);
+  } else {
+    // Too large for one automaton; fall back to matching them one by one.
+    unindexed_routes_.insert(unindexed_routes_.end(), regex_routes.begin(),
+                             regex_routes.end());
+  }
+}
+
+void XdsRouting::CompiledRouteTable::FindPathMatches(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    std::vector<size_t>* routes) const {
+  auto append = [routes](size_t /*depth*/, const std::vector<size_t>& indexes) {
+    routes->insert(routes->end(), indexes.begin(), indexes.end());
+  };
+  auto it = exact_.find(path);
+  if (it != exact_.end()) append(0, it->second);
+  prefixes_.ForEachPrefixOf(path, append);
+  if (!exact_ignore_case_.empty() || !prefixes_ignore_case_.empty()) {
+    const std::string lower_path = absl::AsciiStrToLower(path);
+    it = exact_ignore_case_.find(lower_path);
+    if (it != exact_ignore_case_.end()) append(0, it->second);
+    prefixes_ignore_case_.ForEachPrefixOf(lower_path, append);
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(re2::StringPiece(path.data(), path.size()),
+                          &matches, &error_info)) {
+      for (int match : matches) routes->push_back(regex_routes_[match]);
+    } else if (error_info.kind != RE2::Set::kNoError) {
+      // The DFA ran out of memory on this input.
+      for (size_t i : regex_routes_) {
+        if (route_list_iterator.GetMatchersForRoute(i).path_matcher.Match(
+                path)) {
+          routes->push_back(i);
+        }
+      }
+    }
+  }
+  for (size_t i : unindexed_routes_) {
+    if (route_list_iterator.GetMatchersForRoute(i).path_matcher.Match(path)) {
+      routes->push_back(i);
+    }
+  }
+}
+
+absl::optional<size_t> XdsRouting::CompiledRouteTable::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    grpc_metadata_batch* initial_metadata) const {
+  std::vector<size_t> routes;
+  FindPathMatches(route_list_iterator, path, &routes);
+  // The first route in the list wins, as in XdsRouting::GetRouteForRequest().
+  std::sort(routes.begin(), routes.end());
+  for (size_t i : routes) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(i);
+    if (HeadersMatch(matchers.header_matchers, initial_metadata) &&
+        (!matchers.fraction_per_million.has_value() ||
+         UnderFraction(*matchers.fraction_per_million))) {
+      return i;
+    }
+  }
+  return absl::nullopt;
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
@@ -24,12 +24,16 @@
 #include <stddef.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "re2/re2.h"
+#include "re2/set.h"
 
 #include "src/core/ext/xds/xds_listener.h"
 #include "src/core/ext/xds/xds_route_config.h"
@@ -70,6 +74,86 @@ class XdsRouting {
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+ private:
+  // Maps strings to the sorted indexes they were inserted with, and finds
+  // every key that is a prefix of a given string.
+  class IndexTrie {
+   public:
+    void Insert(absl::string_view key, size_t index);
+    bool empty() const {
+      return root_.children.empty() && root_.indexes.empty();
+    }
+    // Calls fn(depth, indexes) for each key that is a prefix of \a s, shortest
+    // first, where depth is the key's length.
+    template <typename F>
+    void ForEachPrefixOf(absl::string_view s, F fn) const;
+
+   private:
+    struct Node {
+      std::map<char, std::unique_ptr<Node>> children;
+      std::vector<size_t> indexes;
+    };
+    Node root_;
+  };
+
+ public:
+  // The virtual host list compiled into lookup tables when a
+  // RouteConfiguration arrives. Find() returns the same result as
+  // FindVirtualHostForDomain() on the list it was built from, but only walks
+  // the domain once instead of matching it against every pattern.
+  class CompiledVirtualHostTable {
+   public:
+    CompiledVirtualHostTable() = default;
+    explicit CompiledVirtualHostTable(
+        const VirtualHostListIterator& vhost_iterator);
+
+    absl::optional<size_t> Find(absl::string_view domain) const;
+
+   private:
+    // Keyed by the lower-cased pattern; the value is the first virtual host
+    // with that pattern.
+    absl::flat_hash_map<std::string, size_t> exact_;
+    // "*suffix" patterns, keyed by the reversed suffix.
+    IndexTrie suffixes_;
+    // "prefix*" patterns, keyed by the prefix.
+    IndexTrie prefixes_;
+    absl::optional<size_t> universe_;
+  };
+
+  // The route list compiled into lookup tables. Exact paths are hashed,
+  // prefixes live in a trie and all regexes are matched in one pass by an
+  // RE2::Set, which yields the few routes whose path matcher accepts the
+  // request. Those are then checked in list order against their header
+  // matchers and runtime fraction, so the result is the same as
+  // GetRouteForRequest() on the list it was built from.
+  class CompiledRouteTable {
+   public:
+    CompiledRouteTable() = default;
+    explicit CompiledRouteTable(const RouteListIterator& route_list_iterator);
+
+    // \a route_list_iterator must be the list the table was built from.
+    absl::optional<size_t> GetRouteForRequest(
+        const RouteListIterator& route_list_iterator, absl::string_view path,
+        grpc_metadata_batch* initial_metadata) const;
+
+   private:
+    // Appends the routes whose path matcher accepts \a path, unsorted.
+    void FindPathMatches(const RouteListIterator& route_list_iterator,
+                         absl::string_view path,
+                         std::vector<size_t>* routes) const;
+
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact_;
+    // Case-insensitive matchers, keyed by the lower-cased path.
+    absl::flat_hash_map<std::string, std::vector<size_t>> exact_ignore_case_;
+    IndexTrie prefixes_;
+    IndexTrie prefixes_ignore_case_;
+    // Null if there are no regex routes. Set index i is route regex_routes_[i].
+    std::unique_ptr<RE2::Set> regex_set_;
+    std::vector<size_t> regex_routes_;
+    // Routes whose path matcher cannot be indexed; matched one by one.
+    std::vector<size_t> unindexed_routes_;
+  };
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
@@ -347,6 +347,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    XdsRouting::CompiledRouteTable route_table;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -367,6 +368,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   };
 
   std::vector<VirtualHost> virtual_hosts_;
+  XdsRouting::CompiledVirtualHostTable virtual_host_table_;
 };
 
 // An XdsServerConfigSelectorProvider implementation for when the
@@ -1172,6 +1174,14 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       }
     }
   }
+  // Compile the lookup tables once the vectors are final; they are consulted
+  // on every call.
+  for (auto& virtual_host : config_selector->virtual_hosts_) {
+    virtual_host.route_table = XdsRouting::CompiledRouteTable(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
+  }
+  config_selector->virtual_host_table_ = XdsRouting::CompiledVirtualHostTable(
+      VirtualHostListIterator(&config_selector->virtual_hosts_));
   return config_selector;
 }
 
@@ -1192,8 +1202,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
   }
   absl::string_view authority =
       metadata->get_pointer(HttpAuthorityMetadata())->as_string_view();
-  auto vhost_index = XdsRouting::FindVirtualHostForDomain(
-      VirtualHostListIterator(&virtual_hosts_), authority);
+  auto vhost_index = virtual_host_table_.Find(authority);
   if (!vhost_index.has_value()) {
     call_config.error =
         grpc_error_set_int(GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
@@ -1203,7 +1212,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
     return call_config;
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = virtual_host.route_table.GetRouteForRequest(
       VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
@@ -18,6 +18,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -28,6 +29,7 @@
 #include <grpc/slice.h>
 
 #include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -94,3 +96,11 @@ int grpc_compression_options_is_algorithm_enabled(
              opts->enabled_algorithms_bitset)
       .IsSet(algorithm);
 }
+
+int grpc_compression_register_zstd_dictionary(const void* dictionary,
+                                              size_t size) {
+  GRPC_API_TRACE("grpc_compression_register_zstd_dictionary(dictionary=%p, "
+                 "size=%" PRIuPTR ")",
+                 2, (dictionary, size));
+  return grpc_msg_zstd_register_dictionary(dictionary, size);
+}
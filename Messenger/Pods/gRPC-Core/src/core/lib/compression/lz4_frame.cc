@@ -0,0 +1,510 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/compression/lz4_frame.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include <grpc/slice.h>
+
+namespace grpc_core {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x184D2204;
+constexpr size_t kMinHeaderSize = 7;
+constexpr size_t kMaxHeaderSize = 19;
+// Largest match offset, and so the history linked blocks may refer to.
+constexpr size_t kHistorySize = 64 * 1024;
+constexpr uint32_t kUncompressedBlockBit = 0x80000000u;
+// Block format limits: matches are at least 4 bytes, the last match starts
+// at least 12 bytes before the end of the block and the last 5 bytes are
+// always literals.
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kLastLiterals = 5;
+// The encoder writes 64KB blocks, so a uint16_t holds any position.
+constexpr size_t kBlockSize = 64 * 1024;
+constexpr uint8_t kBlockMaxSize64K = 4 << 4;
+constexpr int kHashLog = 12;
+
+// FLG byte.
+constexpr uint8_t kVersion = 1 << 6;
+constexpr uint8_t kBlockIndependence = 1 << 5;
+constexpr uint8_t kBlockChecksum = 1 << 4;
+constexpr uint8_t kContentSize = 1 << 3;
+constexpr uint8_t kContentChecksum = 1 << 2;
+constexpr uint8_t kDictId = 1 << 0;
+
+uint32_t Get32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+         static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+uint64_t Get64(const uint8_t* p) {
+  return static_cast<uint64_t>(Get32(p)) |
+         static_cast<uint64_t>(Get32(p + 4)) << 32;
+}
+
+void Put32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+  p[2] = static_cast<uint8_t>(v >> 16);
+  p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+void Put64(uint8_t* p, uint64_t v) {
+  Put32(p, static_cast<uint32_t>(v));
+  Put32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+uint32_t Read32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+uint8_t HeaderChecksum(const uint8_t* descriptor, size_t length) {
+  return static_cast<uint8_t>(XXH32(descriptor, length, 0) >> 8);
+}
+
+size_t HeaderSize(uint8_t flg) {
+  return kMinHeaderSize + ((flg & kContentSize) != 0 ? 8 : 0) +
+         ((flg & kDictId) != 0 ? 4 : 0);
+}
+
+uint8_t* PutLength(uint8_t* op, size_t length) {
+  for (; length >= 255; length -= 255) *op++ = 255;
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+// Appends one sequence: the literals, then a match of match_length bytes at
+// offset (none if match_length is 0, as for the last sequence of a block).
+// Returns nullptr if it does not fit before op_end.
+uint8_t* PutSequence(uint8_t* op, uint8_t* op_end, const uint8_t* literals,
+                     size_t literal_length, size_t offset,
+                     size_t match_length) {
+  const size_t bound = 1 + literal_length / 255 + 1 + literal_length + 2 +
+                       match_length / 255 + 1;
+  if (bound > static_cast<size_t>(op_end - op)) return nullptr;
+  uint8_t* token = op++;
+  *token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4);
+  if (literal_length >= 15) op = PutLength(op, literal_length - 15);
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+  if (match_length == 0) return op;
+  *op++ = static_cast<uint8_t>(offset);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+  match_length -= kMinMatch;
+  *token |= static_cast<uint8_t>(std::min<size_t>(match_length, 15));
+  if (match_length >= 15) op = PutLength(op, match_length - 15);
+  return op;
+}
+
+// Compresses one independent block of at most kBlockSize bytes with a greedy
+// single-probe match finder. Returns the compressed size, or 0 if it would
+// not fit in capacity bytes.
+size_t CompressBlock(const uint8_t* src, size_t n, uint8_t* dst,
+                     size_t capacity) {
+  uint8_t* op = dst;
+  uint8_t* const op_end = dst + capacity;
+  size_t anchor = 0;
+  if (n > kMatchFindLimit) {
+    uint16_t table[1 << kHashLog] = {};
+    const size_t match_start_limit = n - kMatchFindLimit;
+    const size_t match_end_limit = n - kLastLiterals;
+    size_t ip = 0;
+    while (ip <= match_start_limit) {
+      const uint32_t sequence = Read32(src + ip);
+      const uint32_t h = Hash(sequence);
+      size_t candidate = table[h];
+      table[h] = static_cast<uint16_t>(ip);
+      if (candidate >= ip || Read32(src + candidate) != sequence) {
+        ++ip;
+        continue;
+      }
+      size_t match_end = ip + kMinMatch;
+      size_t ref_end = candidate + kMinMatch;
+      while (match_end < match_end_limit && src[match_end] == src[ref_end]) {
+        ++match_end;
+        ++ref_end;
+      }
+      while (ip > anchor && candidate > 0 &&
+             src[ip - 1] == src[candidate - 1]) {
+        --ip;
+        --candidate;
+      }
+      op = PutSequence(op, op_end, src + anchor, ip - anchor, ip - candidate,
+                       match_end - ip);
+      if (op == nullptr) return 0;
+      anchor = ip = match_end;
+      if (ip <= match_start_limit) {
+        table[Hash(Read32(src + ip - 2))] = static_cast<uint16_t>(ip - 2);
+      }
+    }
+  }
+  op = PutSequence(op, op_end, src + anchor, n - anchor, 0, 0);
+  if (op == nullptr) return 0;
+  return static_cast<size_t>(op - dst);
+}
+
+void AddBlock(const uint8_t* src, size_t n, grpc_slice_buffer* output) {
+  grpc_slice block = GRPC_SLICE_MALLOC(4 + n);
+  uint8_t* start = GRPC_SLICE_START_PTR(block);
+  // Blocks that do not shrink are stored as they are.
+  size_t size = CompressBlock(src, n, start + 4, n - 1);
+  if (size == 0) {
+    Put32(start, static_cast<uint32_t>(n) | kUncompressedBlockBit);
+    memcpy(start + 4, src, n);
+    size = n;
+  } else {
+    Put32(start, static_cast<uint32_t>(size));
+  }
+  block.data.refcounted.length = 4 + size;
+  grpc_slice_buffer_add_indexed(output, block);
+}
+
+enum class BlockResult { kOk, kCorrupt, kOutputFull };
+
+// Decodes a compressed block into [out, out + capacity). Matches may reach
+// back as far as low. On success *size is the decoded size.
+BlockResult DecompressBlock(const uint8_t* src, size_t n, const uint8_t* low,
+                            uint8_t* out, size_t capacity, size_t* size) {
+  const uint8_t* ip = src;
+  const uint8_t* const ip_end = src + n;
+  uint8_t* op = out;
+  uint8_t* const op_end = out + capacity;
+  auto read_length = [&ip, ip_end](size_t* length) {
+    uint8_t b;
+    do {
+      if (ip == ip_end) return false;
+      b = *ip++;
+      *length += b;
+    } while (b == 255);
+    return true;
+  };
+  for (;;) {
+    if (ip == ip_end) return BlockResult::kCorrupt;
+    const uint8_t token = *ip++;
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !read_length(&literal_length)) {
+      return BlockResult::kCorrupt;
+    }
+    if (literal_length > static_cast<size_t>(ip_end - ip)) {
+      return BlockResult::kCorrupt;
+    }
+    if (literal_length > static_cast<size_t>(op_end - op)) {
+      return BlockResult::kOutputFull;
+    }
+    memcpy(op, ip, literal_length);
+    op += literal_length;
+    ip += literal_length;
+    if (ip == ip_end) break;
+    if (ip_end - ip < 2) return BlockResult::kCorrupt;
+    const size_t offset = static_cast<size_t>(ip[0]) |
+                          static_cast<size_t>(ip[1]) << 8;
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - low)) {
+      return BlockResult::kCorrupt;
+    }
+    size_t match_length = token & 15;
+    if (match_length == 15 && !read_length(&match_length)) {
+      return BlockResult::kCorrupt;
+    }
+    match_length += kMinMatch;
+    if (match_length > static_cast<size_t>(op_end - op)) {
+      return BlockResult::kOutputFull;
+    }
+    const uint8_t* match = op - offset;
+    if (offset >= match_length) {
+      memcpy(op, match, match_length);
+      op += match_length;
+    } else {
+      // The match overlaps the bytes it produces.
+      for (size_t i = 0; i < match_length; ++i) *op++ = *match++;
+    }
+  }
+  *size = static_cast<size_t>(op - out);
+  return BlockResult::kOk;
+}
+
+}  // namespace
+
+void Lz4FrameCompress(grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  uint8_t header[kMaxHeaderSize];
+  Put32(header, kMagic);
+  header[4] = kVersion | kBlockIndependence | kContentSize;
+  header[5] = kBlockMaxSize64K;
+  Put64(header + 6, input->length);
+  header[14] = HeaderChecksum(header + 4, 10);
+  grpc_slice_buffer_add(output, grpc_slice_from_copied_buffer(
+                                    reinterpret_cast<const char*>(header), 15));
+  // Blocks are compressed straight from the input slices when they hold a
+  // whole block, and gathered into a buffer when they do not.
+  std::unique_ptr<uint8_t[]> buffer;
+  size_t buffered = 0;
+  for (size_t i = 0; i < input->count; i++) {
+    const uint8_t* p = GRPC_SLICE_START_PTR(input->slices[i]);
+    size_t remaining = GRPC_SLICE_LENGTH(input->slices[i]);
+    while (remaining > 0) {
+      if (buffered == 0 && remaining >= kBlockSize) {
+        AddBlock(p, kBlockSize, output);
+        p += kBlockSize;
+        remaining -= kBlockSize;
+        continue;
+      }
+      if (buffer == nullptr) buffer.reset(new uint8_t[kBlockSize]);
+      const size_t n = std::min(remaining, kBlockSize - buffered);
+      memcpy(buffer.get() + buffered, p, n);
+      buffered += n;
+      p += n;
+      remaining -= n;
+      if (buffered == kBlockSize) {
+        AddBlock(buffer.get(), buffered, output);
+        buffered = 0;
+      }
+    }
+  }
+  if (buffered > 0) AddBlock(buffer.get(), buffered, output);
+  uint8_t end_mark[4] = {};
+  grpc_slice_buffer_add(output, grpc_slice_from_copied_buffer(
+                                    reinterpret_cast<const char*>(end_mark),
+                                    sizeof(end_mark)));
+}
+
+struct Lz4FrameDecoder::Checksum {
+  XXH32_state_t state;
+};
+
+Lz4FrameDecoder::Lz4FrameDecoder(size_t max_output)
+    : max_output_(max_output) {}
+
+Lz4FrameDecoder::~Lz4FrameDecoder() = default;
+
+bool Lz4FrameDecoder::Stage(const uint8_t** next_in, size_t* avail_in) {
+  if (stage_size_ < need_) {
+    std::unique_ptr<uint8_t[]> stage(new uint8_t[need_]);
+    if (staged_ > 0) memcpy(stage.get(), stage_.get(), staged_);
+    stage_ = std::move(stage);
+    stage_size_ = need_;
+  }
+  const size_t n = std::min(need_ - staged_, *avail_in);
+  if (n > 0) {
+    memcpy(stage_.get() + staged_, *next_in, n);
+    staged_ += n;
+    *next_in += n;
+    *avail_in -= n;
+  }
+  return staged_ == need_;
+}
+
+bool Lz4FrameDecoder::Gather(const uint8_t** next_in, size_t* avail_in,
+                             const uint8_t** data) {
+  if (staged_ == 0 && *avail_in >= need_) {
+    *data = *next_in;
+    *next_in += need_;
+    *avail_in -= need_;
+    return true;
+  }
+  if (!Stage(next_in, avail_in)) return false;
+  staged_ = 0;
+  *data = stage_.get();
+  return true;
+}
+
+Lz4FrameDecoder::Result Lz4FrameDecoder::ParseHeader(const uint8_t* header) {
+  const uint8_t flg = header[4];
+  const uint8_t bd = header[5];
+  if (Get32(header) != kMagic || (flg & 0xC2) != kVersion ||
+      (bd & 0x8F) != 0 || (flg & kDictId) != 0) {
+    return Result::kError;
+  }
+  const int block_max_id = bd >> 4;
+  if (block_max_id < 4) return Result::kError;
+  size_t descriptor_end = 6;
+  has_content_size_ = (flg & kContentSize) != 0;
+  if (has_content_size_) {
+    content_size_ = Get64(header + descriptor_end);
+    descriptor_end += 8;
+  }
+  if (header[descriptor_end] !=
+      HeaderChecksum(header + 4, descriptor_end - 4)) {
+    return Result::kError;
+  }
+  if (has_content_size_ && content_size_ > max_output_) {
+    return Result::kTooLarge;
+  }
+  linked_blocks_ = (flg & kBlockIndependence) == 0;
+  block_checksum_ = (flg & kBlockChecksum) != 0;
+  content_checksum_ = (flg & kContentChecksum) != 0;
+  block_max_ = size_t{1} << (2 * block_max_id + 8);
+  // No block may decode past max_output_, so there is no need for room for
+  // more than that.
+  block_capacity_ = std::min(block_max_, std::max<size_t>(max_output_, 1));
+  const size_t window_size =
+      block_capacity_ + (linked_blocks_ ? kHistorySize : 0);
+  if (window_size_ < window_size) {
+    window_.reset(new uint8_t[window_size]);
+    window_size_ = window_size;
+  }
+  window_pos_ = 0;
+  flush_pos_ = 0;
+  frame_output_ = 0;
+  if (content_checksum_) {
+    if (checksum_ == nullptr) checksum_.reset(new Checksum);
+    XXH32_reset(&checksum_->state, 0);
+  }
+  started_ = true;
+  return Result::kOk;
+}
+
+Lz4FrameDecoder::Result Lz4FrameDecoder::DecodeBlock(const uint8_t* block) {
+  if (block_checksum_ &&
+      Get32(block + block_size_) != XXH32(block, block_size_, 0)) {
+    return Result::kError;
+  }
+  if (!linked_blocks_) {
+    window_pos_ = 0;
+  } else if (window_pos_ > kHistorySize) {
+    memmove(window_.get(), window_.get() + window_pos_ - kHistorySize,
+            kHistorySize);
+    window_pos_ = kHistorySize;
+  }
+  uint8_t* out = window_.get() + window_pos_;
+  size_t size;
+  if (block_compressed_) {
+    switch (DecompressBlock(block, block_size_, window_.get(), out,
+                            block_capacity_, &size)) {
+      case BlockResult::kOk:
+        break;
+      case BlockResult::kCorrupt:
+        return Result::kError;
+      case BlockResult::kOutputFull:
+        return block_capacity_ < block_max_ ? Result::kTooLarge
+                                            : Result::kError;
+    }
+  } else {
+    if (block_size_ > block_capacity_) return Result::kTooLarge;
+    memcpy(out, block, block_size_);
+    size = block_size_;
+  }
+  flush_pos_ = window_pos_;
+  window_pos_ += size;
+  frame_output_ += size;
+  if (has_content_size_ && frame_output_ > content_size_) {
+    return Result::kError;
+  }
+  if (frame_output_ > max_output_) return Result::kTooLarge;
+  if (content_checksum_) XXH32_update(&checksum_->state, out, size);
+  return Result::kOk;
+}
+
+Lz4FrameDecoder::Result Lz4FrameDecoder::EndFrame(const uint8_t* checksum) {
+  if (has_content_size_ && frame_output_ != content_size_) {
+    return Result::kError;
+  }
+  if (checksum != nullptr &&
+      Get32(checksum) != XXH32_digest(&checksum_->state)) {
+    return Result::kError;
+  }
+  state_ = State::kHeader;
+  return Result::kOk;
+}
+
+Lz4FrameDecoder::Result Lz4FrameDecoder::Decode(const uint8_t** next_in,
+                                                size_t* avail_in,
+                                                uint8_t** next_out,
+                                                size_t* avail_out) {
+  const uint8_t* data;
+  Result result;
+  for (;;) {
+    switch (state_) {
+      case State::kHeader:
+        // The FLG byte gives the size of the rest of the header.
+        need_ = staged_ > 4 ? HeaderSize(stage_[4]) : kMinHeaderSize;
+        if (!Stage(next_in, avail_in)) return Result::kOk;
+        if (need_ != HeaderSize(stage_[4])) break;
+        staged_ = 0;
+        result = ParseHeader(stage_.get());
+        if (result != Result::kOk) return result;
+        state_ = State::kBlockSize;
+        need_ = 4;
+        break;
+      case State::kBlockSize: {
+        if (!Gather(next_in, avail_in, &data)) return Result::kOk;
+        const uint32_t block_size = Get32(data);
+        if (block_size == 0) {
+          if (content_checksum_) {
+            state_ = State::kContentChecksum;
+            need_ = 4;
+            break;
+          }
+          result = EndFrame(nullptr);
+          if (result != Result::kOk) return result;
+          break;
+        }
+        block_compressed_ = (block_size & kUncompressedBlockBit) == 0;
+        block_size_ = block_size & ~kUncompressedBlockBit;
+        if (block_size_ > block_max_) return Result::kError;
+        state_ = State::kBlock;
+        need_ = block_size_ + (block_checksum_ ? 4 : 0);
+        break;
+      }
+      case State::kBlock:
+        if (!Gather(next_in, avail_in, &data)) return Result::kOk;
+        result = DecodeBlock(data);
+        if (result != Result::kOk) return result;
+        state_ = State::kFlush;
+        break;
+      case State::kFlush: {
+        const size_t n = std::min(window_pos_ - flush_pos_, *avail_out);
+        memcpy(*next_out, window_.get() + flush_pos_, n);
+        flush_pos_ += n;
+        *next_out += n;
+        *avail_out -= n;
+        if (flush_pos_ != window_pos_) return Result::kOk;
+        state_ = State::kBlockSize;
+        need_ = 4;
+        break;
+      }
+      case State::kContentChecksum:
+        if (!Gather(next_in, avail_in, &data)) return Result::kOk;
+        result = EndFrame(data);
+        if (result != Result::kOk) return result;
+        break;
+    }
+  }
+}
+
+bool Lz4FrameDecoder::Finished() const {
+  return started_ && state_ == State::kHeader && staged_ == 0;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,119 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_COMPRESSION_LZ4_FRAME_H
+#define GRPC_CORE_LIB_COMPRESSION_LZ4_FRAME_H
+
+/*
+   The LZ4 frame format (lz4_Frame_format.md in the lz4 repository), as
+   produced and read by `lz4` and liblz4's LZ4F_* functions. Messages are
+   encoded as a single frame of independent 64KB blocks carrying the content
+   size. The decoder accepts any frame liblz4 writes except ones that need a
+   dictionary.
+*/
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include <grpc/slice_buffer.h>
+
+namespace grpc_core {
+
+/// Appends \a input, encoded as one LZ4 frame, to \a output.
+void Lz4FrameCompress(grpc_slice_buffer* input, grpc_slice_buffer* output);
+
+/// Incremental LZ4 frame decoder. Input may be split anywhere, and output
+/// is produced into whatever space the caller provides.
+class Lz4FrameDecoder {
+ public:
+  enum class Result { kOk, kError, kTooLarge };
+
+  /// Frames whose declared content size exceeds \a max_output fail with
+  /// kTooLarge before any of their blocks are decoded.
+  explicit Lz4FrameDecoder(size_t max_output);
+  ~Lz4FrameDecoder();
+
+  Lz4FrameDecoder(const Lz4FrameDecoder&) = delete;
+  Lz4FrameDecoder& operator=(const Lz4FrameDecoder&) = delete;
+
+  /// Consumes bytes from [*next_in, *next_in + *avail_in) and writes decoded
+  /// bytes to [*next_out, *next_out + *avail_out), advancing both. Returns
+  /// once all input is consumed or the output space is full.
+  Result Decode(const uint8_t** next_in, size_t* avail_in, uint8_t** next_out,
+                size_t* avail_out);
+
+  /// Whether the input so far ends on a frame boundary, with all of the
+  /// decoded bytes handed out.
+  bool Finished() const;
+
+ private:
+  enum class State {
+    kHeader,
+    kBlockSize,
+    kBlock,
+    kFlush,
+    kContentChecksum,
+  };
+
+  struct Checksum;
+
+  // Copies input into stage_ until it holds need_ bytes. Returns false if
+  // the input runs out first.
+  bool Stage(const uint8_t** next_in, size_t* avail_in);
+  // As Stage, but points *data at the need_ bytes once they are available,
+  // taking them straight from the input when it holds all of them.
+  bool Gather(const uint8_t** next_in, size_t* avail_in, const uint8_t** data);
+  Result ParseHeader(const uint8_t* header);
+  Result DecodeBlock(const uint8_t* block);
+  Result EndFrame(const uint8_t* checksum);
+
+  const size_t max_output_;
+  State state_ = State::kHeader;
+  bool started_ = false;
+  // Bytes gathered for the header, block or checksum currently being read.
+  std::unique_ptr<uint8_t[]> stage_;
+  size_t stage_size_ = 0;
+  size_t staged_ = 0;
+  size_t need_ = 0;
+  // Frame descriptor.
+  bool linked_blocks_ = false;
+  bool block_checksum_ = false;
+  bool content_checksum_ = false;
+  bool has_content_size_ = false;
+  uint64_t content_size_ = 0;
+  size_t block_max_ = 0;
+  size_t block_capacity_ = 0;
+  // Current block.
+  uint32_t block_size_ = 0;
+  bool block_compressed_ = false;
+  // Decoded data, preceded by up to 64KB of history when blocks are linked.
+  std::unique_ptr<uint8_t[]> window_;
+  size_t window_size_ = 0;
+  size_t window_pos_ = 0;
+  size_t flush_pos_ = 0;
+  uint64_t frame_output_ = 0;
+  std::unique_ptr<Checksum> checksum_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_COMPRESSION_LZ4_FRAME_H */
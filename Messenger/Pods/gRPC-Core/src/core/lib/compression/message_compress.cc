@@ -20,15 +20,27 @@
 
 #include "src/core/lib/compression/message_compress.h"
 
+#include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include <zconf.h>
 #include <zlib.h>
 
+#include "absl/base/thread_annotations.h"
+
+#define ZSTD_STATIC_LINKING_ONLY /* ZSTD_getFrameHeader */
+#include "zstd.h"
+
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/compression/lz4_frame.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice_refcount.h"
 
 #define OUTPUT_BLOCK_SIZE 1024
@@ -118,19 +130,114 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
   return r;
 }
 
-static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                           int gzip) {
-  z_stream zs;
+namespace {
+
+struct ZstdDictionary {
+  unsigned id;
+  ZSTD_CDict* cdict;
+  ZSTD_DDict* ddict;
+};
+
+struct ZstdDictionaries {
+  grpc_core::Mutex mu;
+  std::vector<ZstdDictionary> dictionaries ABSL_GUARDED_BY(mu);
+  /* The dictionary messages are compressed with, if any. */
+  std::atomic<ZSTD_CDict*> current{nullptr};
+};
+
+ZstdDictionaries* zstd_dictionaries() {
+  static ZstdDictionaries* dictionaries = new ZstdDictionaries();
+  return dictionaries;
+}
+
+ZSTD_DDict* zstd_find_ddict(unsigned id) {
+  ZstdDictionaries* d = zstd_dictionaries();
+  grpc_core::MutexLock lock(&d->mu);
+  for (const ZstdDictionary& dictionary : d->dictionaries) {
+    if (dictionary.id == id) return dictionary.ddict;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+int grpc_msg_zstd_register_dictionary(const void* dictionary, size_t size) {
+  const unsigned id = ZSTD_getDictID_fromDict(dictionary, size);
+  if (id == 0) return 0;
+  ZstdDictionaries* d = zstd_dictionaries();
+  grpc_core::MutexLock lock(&d->mu);
+  for (const ZstdDictionary& existing : d->dictionaries) {
+    if (existing.id == id) {
+      d->current.store(existing.cdict, std::memory_order_release);
+      return 1;
+    }
+  }
+  ZstdDictionary added;
+  added.id = id;
+  added.cdict = ZSTD_createCDict(dictionary, size, ZSTD_CLEVEL_DEFAULT);
+  added.ddict = ZSTD_createDDict(dictionary, size);
+  if (added.cdict == nullptr || added.ddict == nullptr) {
+    ZSTD_freeCDict(added.cdict);
+    ZSTD_freeDDict(added.ddict);
+    return 0;
+  }
+  d->dictionaries.push_back(added);
+  d->current.store(added.cdict, std::memory_order_release);
+  return 1;
+}
+
+static int zstd_body(ZSTD_CCtx* cctx, grpc_slice_buffer* input,
+                     grpc_slice_buffer* output) {
+  size_t r;
+  size_t i;
+  ZSTD_inBuffer in;
+  grpc_slice outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+  ZSTD_outBuffer out = {GRPC_SLICE_START_PTR(outbuf), GRPC_SLICE_LENGTH(outbuf),
+                        0};
+  for (i = 0; i <= input->count; i++) {
+    ZSTD_EndDirective mode = ZSTD_e_end;
+    in.src = nullptr;
+    in.size = 0;
+    in.pos = 0;
+    if (i < input->count) {
+      mode = ZSTD_e_continue;
+      in.src = GRPC_SLICE_START_PTR(input->slices[i]);
+      in.size = GRPC_SLICE_LENGTH(input->slices[i]);
+    }
+    do {
+      if (out.pos == out.size) {
+        grpc_slice_buffer_add_indexed(output, outbuf);
+        outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+        out.dst = GRPC_SLICE_START_PTR(outbuf);
+        out.size = GRPC_SLICE_LENGTH(outbuf);
+        out.pos = 0;
+      }
+      r = ZSTD_compressStream2(cctx, &out, &in, mode);
+      if (ZSTD_isError(r)) {
+        gpr_log(GPR_INFO, "zstd error (%s)", ZSTD_getErrorName(r));
+        grpc_slice_unref_internal(outbuf);
+        return 0;
+      }
+    } while (mode == ZSTD_e_end ? r != 0 : in.pos < in.size);
+  }
+  outbuf.data.refcounted.length = out.pos;
+  grpc_slice_buffer_add_indexed(output, outbuf);
+  return 1;
+}
+
+static int zstd_compress(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  GPR_ASSERT(cctx != nullptr);
+  ZSTD_CCtx_setPledgedSrcSize(cctx, input->length);
+  ZSTD_CDict* cdict =
+      zstd_dictionaries()->current.load(std::memory_order_acquire);
+  if (cdict != nullptr) ZSTD_CCtx_refCDict(cctx, cdict);
+  r = zstd_body(cctx, input, output) &&
+      output->length - length_before < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref_internal(output->slices[i]);
@@ -138,10 +245,322 @@ static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  inflateEnd(&zs);
+  ZSTD_freeCCtx(cctx);
   return r;
 }
 
+static int lz4_compress(grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  size_t i;
+  size_t count_before = output->count;
+  size_t length_before = output->length;
+  grpc_core::Lz4FrameCompress(input, output);
+  if (output->length - length_before < input->length) return 1;
+  for (i = count_before; i < output->count; i++) {
+    grpc_slice_unref_internal(output->slices[i]);
+  }
+  output->count = count_before;
+  output->length = length_before;
+  return 0;
+}
+
+struct grpc_msg_decompressor {
+  grpc_compression_algorithm algorithm;
+  size_t max_output;
+  size_t produced;
+  /* Whether any compressed bytes have been seen: no bytes at all decompress
+     to an empty message. */
+  bool started;
+  /* Whether the input so far is a complete compressed stream. */
+  bool ended;
+  /* Partly filled output block. */
+  grpc_slice outbuf;
+  size_t outbuf_used;
+  z_stream zs;
+  ZSTD_DCtx* zstd;
+  /* The zstd frame header is gathered here before decoding starts, to pick
+     the dictionary it names. */
+  uint8_t zstd_header[ZSTD_FRAMEHEADERSIZE_MAX];
+  size_t zstd_header_length;
+  bool zstd_in_frame;
+  /* Largest window a zstd frame may ask for: the decoder allocates its
+     window before producing any output. */
+  int zstd_window_log_max;
+  grpc_core::Lz4FrameDecoder* lz4;
+};
+
+/* Each step decodes from [*in, *in + *in_len) into [*out, *out + *out_len),
+   advancing both, and returns 0 on corrupt input. */
+
+static int zlib_step(grpc_msg_decompressor* d, const uint8_t** in,
+                     size_t* in_len, uint8_t** out, size_t* out_len) {
+  const uInt uint_max = ~static_cast<uInt>(0);
+  int r;
+  if (d->ended) {
+    if (*in_len == 0) return 1;
+    gpr_log(GPR_INFO, "zlib: not all input consumed");
+    return 0;
+  }
+  d->zs.next_in = const_cast<Bytef*>(*in);
+  d->zs.avail_in = static_cast<uInt>(std::min<size_t>(*in_len, uint_max));
+  d->zs.next_out = *out;
+  d->zs.avail_out = static_cast<uInt>(std::min<size_t>(*out_len, uint_max));
+  r = inflate(&d->zs, Z_NO_FLUSH);
+  *in_len -= static_cast<size_t>(d->zs.next_in - *in);
+  *in = d->zs.next_in;
+  *out_len -= static_cast<size_t>(d->zs.next_out - *out);
+  *out = d->zs.next_out;
+  if (r == Z_STREAM_END) {
+    d->ended = true;
+  } else if (r < 0 && r != Z_BUF_ERROR /* not fatal */) {
+    gpr_log(GPR_INFO, "zlib error (%d)", r);
+    return 0;
+  }
+  return 1;
+}
+
+/* Gathers the header of the next zstd frame and loads the dictionary it
+   names. Returns 1 with d->zstd_in_frame unset if the input ran out first. */
+static int zstd_start_frame(grpc_msg_decompressor* d, const uint8_t** in,
+                            size_t* in_len, uint8_t** out, size_t* out_len,
+                            int* too_large) {
+  ZSTD_frameHeader header;
+  size_t r;
+  for (;;) {
+    r = ZSTD_getFrameHeader(&header, d->zstd_header, d->zstd_header_length);
+    if (ZSTD_isError(r)) {
+      gpr_log(GPR_INFO, "zstd error (%s)", ZSTD_getErrorName(r));
+      return 0;
+    }
+    if (r == 0) break;
+    if (*in_len == 0) return 1;
+    GPR_ASSERT(r <= sizeof(d->zstd_header));
+    const size_t n = std::min<size_t>(r - d->zstd_header_length, *in_len);
+    memcpy(d->zstd_header + d->zstd_header_length, *in, n);
+    d->zstd_header_length += n;
+    *in += n;
+    *in_len -= n;
+  }
+  if (header.frameType == ZSTD_frame &&
+      header.frameContentSize != ZSTD_CONTENTSIZE_UNKNOWN &&
+      header.frameContentSize > d->max_output) {
+    *too_large = 1;
+    return 0;
+  }
+  if (header.frameType == ZSTD_frame &&
+      header.windowSize > (1ull << d->zstd_window_log_max)) {
+    *too_large = 1;
+    return 0;
+  }
+  /* A frame that names no dictionary must not be decoded with one. */
+  ZSTD_DCtx_reset(d->zstd, ZSTD_reset_session_and_parameters);
+  ZSTD_DCtx_setParameter(d->zstd, ZSTD_d_windowLogMax,
+                         d->zstd_window_log_max);
+  if (header.frameType == ZSTD_frame && header.dictID != 0) {
+    ZSTD_DDict* ddict = zstd_find_ddict(header.dictID);
+    if (ddict == nullptr) {
+      gpr_log(GPR_INFO, "zstd: unknown dictionary %u", header.dictID);
+      return 0;
+    }
+    ZSTD_DCtx_refDDict(d->zstd, ddict);
+  }
+  ZSTD_inBuffer zin = {d->zstd_header, d->zstd_header_length, 0};
+  ZSTD_outBuffer zout = {*out, *out_len, 0};
+  r = ZSTD_decompressStream(d->zstd, &zout, &zin);
+  if (ZSTD_isError(r) || zin.pos != zin.size) {
+    gpr_log(GPR_INFO, "zstd: Data error");
+    return 0;
+  }
+  *out += zout.pos;
+  *out_len -= zout.pos;
+  d->zstd_header_length = 0;
+  d->zstd_in_frame = true;
+  return 1;
+}
+
+static int zstd_step(grpc_msg_decompressor* d, const uint8_t** in,
+                     size_t* in_len, uint8_t** out, size_t* out_len,
+                     int* too_large) {
+  size_t r;
+  if (!d->zstd_in_frame) {
+    if (*in_len == 0) return 1;
+    d->ended = false;
+    if (!zstd_start_frame(d, in, in_len, out, out_len, too_large)) return 0;
+    if (!d->zstd_in_frame) return 1;
+  }
+  ZSTD_inBuffer zin = {*in, *in_len, 0};
+  ZSTD_outBuffer zout = {*out, *out_len, 0};
+  r = ZSTD_decompressStream(d->zstd, &zout, &zin);
+  if (ZSTD_isError(r)) {
+    gpr_log(GPR_INFO, "zstd error (%s)", ZSTD_getErrorName(r));
+    return 0;
+  }
+  *in += zin.pos;
+  *in_len -= zin.pos;
+  *out += zout.pos;
+  *out_len -= zout.pos;
+  if (r == 0) {
+    /* The frame is complete; any further input starts another. */
+    d->zstd_in_frame = false;
+    d->ended = true;
+  }
+  return 1;
+}
+
+static int lz4_step(grpc_msg_decompressor* d, const uint8_t** in,
+                    size_t* in_len, uint8_t** out, size_t* out_len,
+                    int* too_large) {
+  switch (d->lz4->Decode(in, in_len, out, out_len)) {
+    case grpc_core::Lz4FrameDecoder::Result::kOk:
+      return 1;
+    case grpc_core::Lz4FrameDecoder::Result::kTooLarge:
+      *too_large = 1;
+      return 0;
+    case grpc_core::Lz4FrameDecoder::Result::kError:
+      break;
+  }
+  gpr_log(GPR_INFO, "lz4: Data error");
+  return 0;
+}
+
+static int decompressor_step(grpc_msg_decompressor* d, const uint8_t** in,
+                             size_t* in_len, uint8_t** out, size_t* out_len,
+                             int* too_large) {
+  switch (d->algorithm) {
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP:
+      return zlib_step(d, in, in_len, out, out_len);
+    case GRPC_COMPRESS_ZSTD:
+      return zstd_step(d, in, in_len, out, out_len, too_large);
+    case GRPC_COMPRESS_LZ4:
+      return lz4_step(d, in, in_len, out, out_len, too_large);
+    case GRPC_COMPRESS_NONE:
+    case GRPC_COMPRESS_ALGORITHMS_COUNT:
+      break;
+  }
+  GPR_UNREACHABLE_CODE(return 0);
+}
+
+grpc_msg_decompressor* grpc_msg_decompressor_create(
+    grpc_compression_algorithm algorithm, size_t max_output_size) {
+  switch (algorithm) {
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP:
+    case GRPC_COMPRESS_ZSTD:
+    case GRPC_COMPRESS_LZ4:
+      break;
+    case GRPC_COMPRESS_NONE:
+    case GRPC_COMPRESS_ALGORITHMS_COUNT:
+      gpr_log(GPR_ERROR, "invalid compression algorithm %d", algorithm);
+      return nullptr;
+  }
+  grpc_msg_decompressor* d = new grpc_msg_decompressor();
+  d->algorithm = algorithm;
+  d->max_output = max_output_size;
+  d->outbuf = grpc_empty_slice();
+  switch (algorithm) {
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP: {
+      d->zs.zalloc = zalloc_gpr;
+      d->zs.zfree = zfree_gpr;
+      int r = inflateInit2(
+          &d->zs, 15 | (algorithm == GRPC_COMPRESS_GZIP ? 16 : 0));
+      GPR_ASSERT(r == Z_OK);
+      break;
+    }
+    case GRPC_COMPRESS_ZSTD:
+      d->zstd = ZSTD_createDCtx();
+      GPR_ASSERT(d->zstd != nullptr);
+      /* No window needs to be larger than the largest message allowed. */
+      d->zstd_window_log_max = ZSTD_WINDOWLOG_MIN;
+      while (d->zstd_window_log_max < ZSTD_WINDOWLOG_LIMIT_DEFAULT &&
+             (size_t{1} << d->zstd_window_log_max) < max_output_size) {
+        d->zstd_window_log_max++;
+      }
+      break;
+    case GRPC_COMPRESS_LZ4:
+      d->lz4 = new grpc_core::Lz4FrameDecoder(max_output_size);
+      break;
+    default:
+      break;
+  }
+  return d;
+}
+
+int grpc_msg_decompressor_next(grpc_msg_decompressor* d, grpc_slice input,
+                               grpc_slice_buffer* output, int* too_large) {
+  const uint8_t* in = GRPC_SLICE_START_PTR(input);
+  size_t in_len = GRPC_SLICE_LENGTH(input);
+  *too_large = 0;
+  if (in_len > 0) d->started = true;
+  for (;;) {
+    if (d->outbuf_used == GRPC_SLICE_LENGTH(d->outbuf)) {
+      if (d->outbuf_used > 0) {
+        grpc_slice_buffer_add_indexed(output, d->outbuf);
+      } else {
+        grpc_slice_unref_internal(d->outbuf);
+      }
+      d->outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+      d->outbuf_used = 0;
+    }
+    uint8_t* out = GRPC_SLICE_START_PTR(d->outbuf) + d->outbuf_used;
+    const size_t out_space = GRPC_SLICE_LENGTH(d->outbuf) - d->outbuf_used;
+    const size_t in_before = in_len;
+    size_t out_len = out_space;
+    if (!decompressor_step(d, &in, &in_len, &out, &out_len, too_large)) {
+      return 0;
+    }
+    d->outbuf_used += out_space - out_len;
+    d->produced += out_space - out_len;
+    if (d->produced > d->max_output) {
+      *too_large = 1;
+      return 0;
+    }
+    /* Stop once the input is used up and the decoder has nothing left to
+       hand out. */
+    if (out_len > 0 && in_len == 0) return 1;
+    if (out_len == out_space && in_len == in_before) {
+      gpr_log(GPR_INFO, "decompression made no progress");
+      return 0;
+    }
+  }
+}
+
+int grpc_msg_decompressor_finish(grpc_msg_decompressor* d,
+                                 grpc_slice_buffer* output) {
+  bool ended = d->ended;
+  if (d->algorithm == GRPC_COMPRESS_LZ4) ended = d->lz4->Finished();
+  if (d->started && !ended) {
+    gpr_log(GPR_INFO, "decompression: message ends mid-stream");
+    return 0;
+  }
+  if (d->outbuf_used > 0) {
+    d->outbuf.data.refcounted.length = d->outbuf_used;
+    grpc_slice_buffer_add_indexed(output, d->outbuf);
+    d->outbuf = grpc_empty_slice();
+    d->outbuf_used = 0;
+  }
+  return 1;
+}
+
+void grpc_msg_decompressor_destroy(grpc_msg_decompressor* d) {
+  grpc_slice_unref_internal(d->outbuf);
+  switch (d->algorithm) {
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP:
+      inflateEnd(&d->zs);
+      break;
+    case GRPC_COMPRESS_ZSTD:
+      ZSTD_freeDCtx(d->zstd);
+      break;
+    case GRPC_COMPRESS_LZ4:
+      delete d->lz4;
+      break;
+    default:
+      break;
+  }
+  delete d;
+}
+
 static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   size_t i;
   for (i = 0; i < input->count; i++) {
@@ -161,6 +580,10 @@ static int compress_inner(grpc_compression_algorithm algorithm,
       return zlib_compress(input, output, 0);
     case GRPC_COMPRESS_GZIP:
       return zlib_compress(input, output, 1);
+    case GRPC_COMPRESS_ZSTD:
+      return zstd_compress(input, output);
+    case GRPC_COMPRESS_LZ4:
+      return lz4_compress(input, output);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -179,16 +602,41 @@ int grpc_msg_compress(grpc_compression_algorithm algorithm,
 
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  switch (algorithm) {
-    case GRPC_COMPRESS_NONE:
-      return copy(input, output);
-    case GRPC_COMPRESS_DEFLATE:
-      return zlib_decompress(input, output, 0);
-    case GRPC_COMPRESS_GZIP:
-      return zlib_decompress(input, output, 1);
-    case GRPC_COMPRESS_ALGORITHMS_COUNT:
-      break;
+  int too_large;
+  return grpc_msg_decompress_with_limit(algorithm, input, output, SIZE_MAX,
+                                        &too_large);
+}
+
+int grpc_msg_decompress_with_limit(grpc_compression_algorithm algorithm,
+                                   grpc_slice_buffer* input,
+                                   grpc_slice_buffer* output,
+                                   size_t max_output_size, int* too_large) {
+  int r = 1;
+  size_t i;
+  size_t count_before = output->count;
+  size_t length_before = output->length;
+  *too_large = 0;
+  if (algorithm == GRPC_COMPRESS_NONE) {
+    if (input->length > max_output_size) {
+      *too_large = 1;
+      return 0;
+    }
+    return copy(input, output);
   }
-  gpr_log(GPR_ERROR, "invalid compression algorithm %d", algorithm);
-  return 0;
+  grpc_msg_decompressor* d =
+      grpc_msg_decompressor_create(algorithm, max_output_size);
+  if (d == nullptr) return 0;
+  for (i = 0; r && i < input->count; i++) {
+    r = grpc_msg_decompressor_next(d, input->slices[i], output, too_large);
+  }
+  r = r && grpc_msg_decompressor_finish(d, output);
+  if (!r) {
+    for (i = count_before; i < output->count; i++) {
+      grpc_slice_unref_internal(output->slices[i]);
+    }
+    output->count = count_before;
+    output->length = length_before;
+  }
+  grpc_msg_decompressor_destroy(d);
+  return r;
 }
@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/slice.h>
 
@@ -36,4 +38,42 @@ int grpc_msg_compress(grpc_compression_algorithm algorithm,
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+/* decompress 'input' to 'output' using 'algorithm', producing at most
+   'max_output_size' bytes. Decompression stops as soon as the limit is
+   exceeded, so an oversized message is never fully inflated; in that case
+   *too_large is set to 1 and 0 is returned. Otherwise as
+   grpc_msg_decompress, with *too_large set to 0. */
+int grpc_msg_decompress_with_limit(grpc_compression_algorithm algorithm,
+                                   grpc_slice_buffer* input,
+                                   grpc_slice_buffer* output,
+                                   size_t max_output_size, int* too_large);
+
+/* Incremental decompression of one message, for callers that want to
+   decompress it piece by piece as its compressed slices become available. */
+typedef struct grpc_msg_decompressor grpc_msg_decompressor;
+
+/* Create a decompressor for 'algorithm' that fails once more than
+   'max_output_size' bytes have been produced. Returns nullptr for
+   GRPC_COMPRESS_NONE and invalid algorithms. */
+grpc_msg_decompressor* grpc_msg_decompressor_create(
+    grpc_compression_algorithm algorithm, size_t max_output_size);
+
+/* decompress the next piece 'input' of the message, appending whatever can
+   be decoded so far to 'output'. Returns 0 on corrupt input, or with
+   *too_large set to 1 once the limit is exceeded; 'output' may then hold
+   part of the message. */
+int grpc_msg_decompressor_next(grpc_msg_decompressor* d, grpc_slice input,
+                               grpc_slice_buffer* output, int* too_large);
+
+/* Appends the last of the decompressed message to 'output'. Returns 0 if the
+   input fed so far is not a complete compressed message. */
+int grpc_msg_decompressor_finish(grpc_msg_decompressor* d,
+                                 grpc_slice_buffer* output);
+
+void grpc_msg_decompressor_destroy(grpc_msg_decompressor* d);
+
+/* Register a zstd dictionary; see
+   grpc_compression_register_zstd_dictionary(). */
+int grpc_msg_zstd_register_dictionary(const void* dictionary, size_t size);
+
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
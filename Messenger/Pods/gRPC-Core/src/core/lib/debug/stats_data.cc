@@ -47,9 +47,16 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_writes_begun",
     "http2_transport_stalls",
     "http2_stream_stalls",
+    "http2_partial_writes",
+    "http2_writes_coalesced",
+    "http2_header_block_cache_hits",
+    "http2_header_block_cache_misses",
     "cq_pluck_creates",
     "cq_next_creates",
     "cq_callback_creates",
+    "cq_ev_queue_trylock_failures",
+    "cq_ev_queue_trylock_successes",
+    "cq_ev_queue_transient_pop_failures",
 };
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
@@ -69,17 +76,29 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "control window",
     "Number of times sending was completely stalled by the stream flow control "
     "window",
+    "Number of HTTP2 writes cut short at the target write size, with more "
+    "data left to send",
+    "Number of HTTP2 writes deferred to pick up frames from other streams",
+    "Number of header blocks sent from the HPACK encoder's cache of "
+    "pre-encoded blocks",
+    "Number of cacheable header blocks that had to be encoded field by field",
     "Number of completion queues created for cq_pluck (indicates sync api "
     "usage)",
     "Number of completion queues created for cq_next (indicates cq async api "
     "usage)",
     "Number of completion queues created for cq_callback (indicates callback "
     "api usage)",
+    "Number of lock (trylock) acquisition failures on completion queue event "
+    "queue. High value here indicates high contention on completion queues",
+    "Number of lock (trylock) acquisition successes on completion queue event "
+    "queue.",
+    "Number of times NULL was popped out of completion queue's event queue "
+    "even though the event queue was not empty",
 };
 const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "call_initial_size",       "tcp_write_size", "tcp_write_iov_size",
     "tcp_read_size",           "tcp_read_offer", "tcp_read_offer_iov_size",
-    "http2_send_message_size",
+    "http2_send_message_size", "http2_write_size",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
@@ -89,6 +108,7 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of bytes offered to each syscall_read",
     "Number of byte segments offered to each syscall_read",
     "Size of messages received by HTTP2 transport",
+    "Number of bytes gathered into each HTTP2 write",
 };
 const int grpc_stats_table_0[25] = {
     0,   1,   2,   4,    7,    11,   17,   26,   40,   61,    93,    142,  216,
@@ -174,17 +194,18 @@ int BucketForHistogramValue_80_10(int value) {
   }
 }
 }  // namespace grpc_core
-const int grpc_stats_histo_buckets[7] = {24, 20, 10, 20, 20, 10, 20};
-const int grpc_stats_histo_start[7] = {0, 24, 44, 54, 74, 94, 104};
-const int* const grpc_stats_histo_bucket_boundaries[7] = {
+const int grpc_stats_histo_buckets[8] = {24, 20, 10, 20, 20, 10, 20, 20};
+const int grpc_stats_histo_start[8] = {0, 24, 44, 54, 74, 94, 104, 124};
+const int* const grpc_stats_histo_bucket_boundaries[8] = {
     grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
     grpc_stats_table_2, grpc_stats_table_2, grpc_stats_table_4,
-    grpc_stats_table_2};
-int (*const grpc_stats_get_bucket[7])(int value) = {
+    grpc_stats_table_2, grpc_stats_table_2};
+int (*const grpc_stats_get_bucket[8])(int value) = {
     grpc_core::BucketForHistogramValue_32768_24,
     grpc_core::BucketForHistogramValue_16777216_20,
     grpc_core::BucketForHistogramValue_80_10,
     grpc_core::BucketForHistogramValue_16777216_20,
     grpc_core::BucketForHistogramValue_16777216_20,
     grpc_core::BucketForHistogramValue_80_10,
+    grpc_core::BucketForHistogramValue_16777216_20,
     grpc_core::BucketForHistogramValue_16777216_20};
@@ -40,9 +40,16 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_WRITES_BEGUN,
   GRPC_STATS_COUNTER_HTTP2_TRANSPORT_STALLS,
   GRPC_STATS_COUNTER_HTTP2_STREAM_STALLS,
+  GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED,
+  GRPC_STATS_COUNTER_HTTP2_HEADER_BLOCK_CACHE_HITS,
+  GRPC_STATS_COUNTER_HTTP2_HEADER_BLOCK_CACHE_MISSES,
   GRPC_STATS_COUNTER_CQ_PLUCK_CREATES,
   GRPC_STATS_COUNTER_CQ_NEXT_CREATES,
   GRPC_STATS_COUNTER_CQ_CALLBACK_CREATES,
+  GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
+  GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
+  GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -55,6 +62,7 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER,
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -74,7 +82,9 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_BUCKETS = 10,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_FIRST_SLOT = 104,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_BUCKETS = 20,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 124
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE_FIRST_SLOT = 124,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE_BUCKETS = 20,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 144
 } grpc_stats_histogram_constants;
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
@@ -104,12 +114,26 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_TRANSPORT_STALLS)
 #define GRPC_STATS_INC_HTTP2_STREAM_STALLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_STREAM_STALLS)
+#define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED)
+#define GRPC_STATS_INC_HTTP2_HEADER_BLOCK_CACHE_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_HEADER_BLOCK_CACHE_HITS)
+#define GRPC_STATS_INC_HTTP2_HEADER_BLOCK_CACHE_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_HEADER_BLOCK_CACHE_MISSES)
 #define GRPC_STATS_INC_CQ_PLUCK_CREATES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_PLUCK_CREATES)
 #define GRPC_STATS_INC_CQ_NEXT_CREATES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_NEXT_CREATES)
 #define GRPC_STATS_INC_CQ_CALLBACK_CREATES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_CALLBACK_CREATES)
+#define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES)
+#define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES)
+#define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value) \
   GRPC_STATS_INC_HISTOGRAM(                     \
       GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE,   \
@@ -138,14 +162,18 @@ typedef enum {
   GRPC_STATS_INC_HISTOGRAM(                           \
       GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE,   \
       grpc_core::BucketForHistogramValue_16777216_20(static_cast<int>(value)))
+#define GRPC_STATS_INC_HTTP2_WRITE_SIZE(value) \
+  GRPC_STATS_INC_HISTOGRAM(                    \
+      GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE,   \
+      grpc_core::BucketForHistogramValue_16777216_20(static_cast<int>(value)))
 namespace grpc_core {
 int BucketForHistogramValue_32768_24(int value);
 int BucketForHistogramValue_16777216_20(int value);
 int BucketForHistogramValue_80_10(int value);
 }  // namespace grpc_core
-extern const int grpc_stats_histo_buckets[7];
-extern const int grpc_stats_histo_start[7];
-extern const int* const grpc_stats_histo_bucket_boundaries[7];
-extern int (*const grpc_stats_get_bucket[7])(int value);
+extern const int grpc_stats_histo_buckets[8];
+extern const int grpc_stats_histo_start[8];
+extern const int* const grpc_stats_histo_bucket_boundaries[8];
+extern int (*const grpc_stats_get_bucket[8])(int value);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -0,0 +1,274 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/ev_epoll1_linux.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/trace.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::Poller;
+
+EpollEventHandle::EpollEventHandle(int fd, bool track_err,
+                                   Epoll1Poller* poller)
+    : fd_(fd), track_err_(track_err), poller_(poller) {}
+
+void EpollEventHandle::Reset(int fd, bool track_err) {
+  grpc_core::MutexLock lock(&mu_);
+  fd_ = fd;
+  track_err_ = track_err;
+  is_shutdown_ = false;
+  shutdown_status_ = absl::OkStatus();
+  read_op_ = Op();
+  write_op_ = Op();
+  error_op_ = Op();
+}
+
+void EpollEventHandle::NotifyOn(Op& op, PosixEngineClosure* closure) {
+  grpc_core::ReleasableMutexLock lock(&mu_);
+  if (is_shutdown_) {
+    closure->SetStatus(shutdown_status_);
+    lock.Release();
+    poller_->executor_->Run(closure);
+    return;
+  }
+  if (op.ready) {
+    // The fd became ready before anybody asked: consume the edge now.
+    op.ready = false;
+    lock.Release();
+    closure->SetStatus(absl::OkStatus());
+    poller_->executor_->Run(closure);
+    return;
+  }
+  GPR_ASSERT(op.closure == nullptr);
+  op.closure = closure;
+}
+
+void EpollEventHandle::SetReady(Op& op) {
+  grpc_core::ReleasableMutexLock lock(&mu_);
+  if (is_shutdown_) return;
+  PosixEngineClosure* closure = op.closure;
+  if (closure == nullptr) {
+    op.ready = true;
+    return;
+  }
+  op.closure = nullptr;
+  lock.Release();
+  closure->SetStatus(absl::OkStatus());
+  poller_->executor_->Run(closure);
+}
+
+void EpollEventHandle::NotifyOnRead(PosixEngineClosure* on_read) {
+  NotifyOn(read_op_, on_read);
+}
+
+void EpollEventHandle::NotifyOnWrite(PosixEngineClosure* on_write) {
+  NotifyOn(write_op_, on_write);
+}
+
+void EpollEventHandle::NotifyOnError(PosixEngineClosure* on_error) {
+  NotifyOn(error_op_, on_error);
+}
+
+void EpollEventHandle::SetReadable() { SetReady(read_op_); }
+
+void EpollEventHandle::SetWritable() { SetReady(write_op_); }
+
+void EpollEventHandle::SetHasError() { SetReady(error_op_); }
+
+void EpollEventHandle::ShutdownLocked(absl::Status why, bool releasing_fd) {
+  if (is_shutdown_) return;
+  is_shutdown_ = true;
+  shutdown_status_ = why;
+  if (releasing_fd) {
+    // We are handing the fd back to the caller: stop watching it instead of
+    // shutting the connection down.
+    epoll_event phony_event;
+    if (epoll_ctl(poller_->epfd_, EPOLL_CTL_DEL, fd_, &phony_event) != 0) {
+      gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    }
+  } else {
+    shutdown(fd_, SHUT_RDWR);
+  }
+  for (Op* op : {&read_op_, &write_op_, &error_op_}) {
+    op->ready = false;
+    if (op->closure != nullptr) {
+      op->closure->SetStatus(why);
+      poller_->executor_->Run(op->closure);
+      op->closure = nullptr;
+    }
+  }
+}
+
+void EpollEventHandle::ShutdownHandle(absl::Status why) {
+  grpc_core::MutexLock lock(&mu_);
+  ShutdownLocked(std::move(why), false);
+}
+
+bool EpollEventHandle::IsHandleShutdown() {
+  grpc_core::MutexLock lock(&mu_);
+  return is_shutdown_;
+}
+
+void EpollEventHandle::OrphanHandle(int* release_fd, absl::string_view reason) {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    ShutdownLocked(absl::UnavailableError(reason), release_fd != nullptr);
+    if (release_fd != nullptr) {
+      *release_fd = fd_;
+    } else {
+      // close() removes the fd from the epoll set.
+      close(fd_);
+    }
+    fd_ = -1;
+  }
+  poller_->ReleaseHandle(this);
+}
+
+Epoll1Poller::Epoll1Poller(grpc_event_engine::experimental::Executor* executor)
+    : executor_(executor) {
+  epfd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epfd_ < 0) {
+    gpr_log(GPR_ERROR, "epoll_create1 unavailable: %s", strerror(errno));
+    return;
+  }
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    gpr_log(GPR_ERROR, "eventfd unavailable: %s", strerror(errno));
+    return;
+  }
+  epoll_event ev;
+  // Level triggered: a kick stays visible until a worker consumes it.
+  ev.events = static_cast<uint32_t>(EPOLLIN);
+  ev.data.ptr = this;
+  if (epoll_ctl(epfd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    close(wakeup_fd_);
+    wakeup_fd_ = -1;
+  }
+}
+
+Epoll1Poller::~Epoll1Poller() {
+  if (wakeup_fd_ >= 0) close(wakeup_fd_);
+  if (epfd_ >= 0) close(epfd_);
+  grpc_core::MutexLock lock(&mu_);
+  for (EpollEventHandle* handle : all_handles_) delete handle;
+}
+
+EpollEventHandle* Epoll1Poller::CreateHandle(int fd, absl::string_view name,
+                                             bool track_err) {
+  EpollEventHandle* handle = nullptr;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (!free_list_.empty()) {
+      handle = free_list_.back();
+      free_list_.pop_back();
+    }
+    if (handle == nullptr) {
+      handle = new EpollEventHandle(fd, track_err, this);
+      all_handles_.push_back(handle);
+    }
+  }
+  handle->Reset(fd, track_err);
+  GRPC_EVENT_ENGINE_TRACE("Epoll1Poller:%p created handle %p for %s fd=%d",
+                          this, handle, std::string(name).c_str(), fd);
+  epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
+  ev.data.ptr = handle;
+  if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  }
+  return handle;
+}
+
+void Epoll1Poller::ReleaseHandle(EpollEventHandle* handle) {
+  grpc_core::MutexLock lock(&mu_);
+  free_list_.push_back(handle);
+}
+
+Poller::WorkResult Epoll1Poller::Work(
+    EventEngine::Duration timeout,
+    absl::FunctionRef<void()> schedule_poll_again) {
+  epoll_event events[kMaxEpollEvents];
+  int timeout_ms = static_cast<int>(std::min<int64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count(),
+      INT32_MAX));
+  int r;
+  do {
+    r = epoll_wait(epfd_, events, kMaxEpollEvents, std::max(timeout_ms, 0));
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) {
+    gpr_log(GPR_ERROR, "epoll_wait failed: %s", strerror(errno));
+    return WorkResult::kDeadlineExceeded;
+  }
+  if (r == 0) return WorkResult::kDeadlineExceeded;
+  bool kicked = false;
+  bool scheduled_poll_again = false;
+  for (int i = 0; i < r; i++) {
+    void* data_ptr = events[i].data.ptr;
+    if (data_ptr == this) {
+      eventfd_t value;
+      eventfd_read(wakeup_fd_, &value);
+      kicked = true;
+      continue;
+    }
+    if (!scheduled_poll_again) {
+      schedule_poll_again();
+      scheduled_poll_again = true;
+    }
+    auto* handle = static_cast<EpollEventHandle*>(data_ptr);
+    uint32_t ev = events[i].events;
+    bool cancel = (ev & EPOLLHUP) != 0;
+    bool error = (ev & EPOLLERR) != 0;
+    bool read_ev = (ev & (EPOLLIN | EPOLLPRI)) != 0;
+    bool write_ev = (ev & EPOLLOUT) != 0;
+    // track_err_ is only written while the handle is not registered, so
+    // reading it without the lock is fine.
+    bool err_fallback = error && !handle->track_err_;
+    if (error && !err_fallback) handle->SetHasError();
+    if (read_ev || cancel || err_fallback) handle->SetReadable();
+    if (write_ev || cancel || err_fallback) handle->SetWritable();
+  }
+  if (kicked && !scheduled_poll_again) return WorkResult::kKicked;
+  return WorkResult::kOk;
+}
+
+void Epoll1Poller::Kick() {
+  if (eventfd_write(wakeup_fd_, 1) != 0) {
+    gpr_log(GPR_ERROR, "eventfd_write failed: %s", strerror(errno));
+  }
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
@@ -0,0 +1,139 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_EPOLL1_LINUX_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_EPOLL1_LINUX_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <sys/epoll.h>
+
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/executor/executor.h"
+#include "src/core/lib/event_engine/poller.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+class Epoll1Poller;
+
+// Wraps a non-blocking fd registered (edge triggered) with an Epoll1Poller and
+// delivers its readiness to at most one registered closure per direction.
+// Readiness that arrives while no closure is registered is remembered, so a
+// later NotifyOnXXX runs immediately.
+class EpollEventHandle {
+ public:
+  int WrappedFd() const { return fd_; }
+  // Register a closure to run when the fd becomes readable / writable / has
+  // pending socket errors. The closure runs on the poller's executor with an
+  // OK status, or with the shutdown status if the handle is shut down.
+  void NotifyOnRead(PosixEngineClosure* on_read);
+  void NotifyOnWrite(PosixEngineClosure* on_write);
+  void NotifyOnError(PosixEngineClosure* on_error);
+  void SetReadable();
+  void SetWritable();
+  void SetHasError();
+  // Shut down the fd (shutdown(2), unless the fd is going to be released) and
+  // fail any registered closures with \a why. Idempotent.
+  void ShutdownHandle(absl::Status why);
+  bool IsHandleShutdown();
+  // Stop watching the fd. It is closed unless \a release_fd is non-null, in
+  // which case ownership moves to the caller. The handle must not be used
+  // afterwards.
+  void OrphanHandle(int* release_fd, absl::string_view reason);
+
+ private:
+  friend class Epoll1Poller;
+  struct Op {
+    PosixEngineClosure* closure = nullptr;
+    bool ready = false;
+  };
+
+  EpollEventHandle(int fd, bool track_err, Epoll1Poller* poller);
+  void Reset(int fd, bool track_err);
+  void NotifyOn(Op& op, PosixEngineClosure* closure);
+  void SetReady(Op& op);
+  void ShutdownLocked(absl::Status why, bool releasing_fd)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  grpc_core::Mutex mu_;
+  int fd_;
+  bool track_err_;
+  Epoll1Poller* const poller_;
+  bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  absl::Status shutdown_status_ ABSL_GUARDED_BY(mu_);
+  Op read_op_ ABSL_GUARDED_BY(mu_);
+  Op write_op_ ABSL_GUARDED_BY(mu_);
+  Op error_op_ ABSL_GUARDED_BY(mu_);
+};
+
+// A singleton-epoll-set poller, modelled on the iomgr epoll1 engine. Any
+// number of threads may call Work() concurrently; closures for ready handles
+// are handed to the executor rather than run inline.
+class Epoll1Poller final : public grpc_event_engine::experimental::Poller {
+ public:
+  explicit Epoll1Poller(grpc_event_engine::experimental::Executor* executor);
+  ~Epoll1Poller() override;
+  Epoll1Poller(const Epoll1Poller&) = delete;
+  Epoll1Poller& operator=(const Epoll1Poller&) = delete;
+
+  // Returns false if epoll or eventfd are unavailable on this kernel.
+  bool ok() const { return epfd_ >= 0 && wakeup_fd_ >= 0; }
+
+  // Start watching \a fd. When \a track_err is set, EPOLLERR is delivered to
+  // NotifyOnError closures instead of waking readers and writers.
+  EpollEventHandle* CreateHandle(int fd, absl::string_view name,
+                                 bool track_err);
+
+  WorkResult Work(
+      grpc_event_engine::experimental::EventEngine::Duration timeout,
+      absl::FunctionRef<void()> schedule_poll_again) override;
+  void Kick() override;
+
+ private:
+  friend class EpollEventHandle;
+  static constexpr int kMaxEpollEvents = 100;
+
+  void ReleaseHandle(EpollEventHandle* handle);
+
+  grpc_event_engine::experimental::Executor* const executor_;
+  int epfd_ = -1;
+  int wakeup_fd_ = -1;
+  grpc_core::Mutex mu_;
+  // Handles are recycled rather than freed: another thread's epoll_wait may
+  // still hold an event pointing at an orphaned handle. Losing that race only
+  // produces a spurious readiness notification on a reused handle.
+  std::vector<EpollEventHandle*> free_list_ ABSL_GUARDED_BY(mu_);
+  std::vector<EpollEventHandle*> all_handles_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EV_EPOLL1_LINUX_H
@@ -0,0 +1,678 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <limits.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+
+#ifdef GRPC_LINUX_ERRQUEUE
+#include <linux/errqueue.h>
+#endif
+
+// Fallbacks for older library headers, see tcp_posix.cc. These values are part
+// of the kernel ABI and will not change.
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EndpointConfig;
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::Executor;
+using ::grpc_event_engine::experimental::MemoryAllocator;
+using ::grpc_event_engine::experimental::SliceBuffer;
+
+namespace {
+
+constexpr size_t kMaxReadIovec = 64;
+constexpr size_t kMaxWriteIovec = 260;
+constexpr int kRcvLowatMax = 16 * 1024 * 1024;
+constexpr int kRcvLowatThreshold = 16 * 1024;
+
+int AdjustValue(int default_value, int min_value, int max_value,
+                absl::optional<int> actual_value) {
+  if (!actual_value.has_value() || *actual_value < min_value ||
+      *actual_value > max_value) {
+    return default_value;
+  }
+  return *actual_value;
+}
+
+EventEngine::ResolvedAddress SockName(
+    int fd, int (*fn)(int, struct sockaddr*, socklen_t*)) {
+  sockaddr_storage addr;
+  socklen_t len = sizeof(addr);
+  if (fn(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+    return EventEngine::ResolvedAddress();
+  }
+  return EventEngine::ResolvedAddress(reinterpret_cast<sockaddr*>(&addr), len);
+}
+
+// Holds the data of one zerocopy write until the kernel reports that every
+// sendmsg() it was split into has completed.
+struct ZerocopySendRecord {
+  SliceBuffer buf;
+  size_t slice_idx = 0;
+  size_t byte_idx = 0;
+  std::atomic<int> refs{0};
+};
+
+}  // namespace
+
+PosixTcpOptions TcpOptionsFromEndpointConfig(const EndpointConfig& config) {
+  PosixTcpOptions options;
+  options.tcp_read_chunk_size = AdjustValue(
+      PosixTcpOptions::kDefaultReadChunkSize, 1, PosixTcpOptions::kMaxChunkSize,
+      config.GetInt(GRPC_ARG_TCP_READ_CHUNK_SIZE));
+  options.tcp_min_read_chunk_size = AdjustValue(
+      PosixTcpOptions::kDefaultMinReadChunkSize, 1,
+      PosixTcpOptions::kMaxChunkSize,
+      config.GetInt(GRPC_ARG_TCP_MIN_READ_CHUNK_SIZE));
+  options.tcp_max_read_chunk_size = AdjustValue(
+      PosixTcpOptions::kDefaultMaxReadChunkSize, 1,
+      PosixTcpOptions::kMaxChunkSize,
+      config.GetInt(GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE));
+  if (options.tcp_min_read_chunk_size > options.tcp_max_read_chunk_size) {
+    std::swap(options.tcp_min_read_chunk_size,
+              options.tcp_max_read_chunk_size);
+  }
+  options.tcp_read_chunk_size =
+      grpc_core::Clamp(options.tcp_read_chunk_size,
+                       options.tcp_min_read_chunk_size,
+                       options.tcp_max_read_chunk_size);
+  options.tcp_tx_zerocopy_send_bytes_threshold =
+      AdjustValue(PosixTcpOptions::kDefaultZerocopySendBytesThreshold, 0,
+                  INT_MAX,
+                  config.GetInt(GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD));
+  options.tcp_tx_zerocopy_max_simultaneous_sends =
+      AdjustValue(PosixTcpOptions::kDefaultMaxSimultaneousZerocopySends, 0,
+                  INT_MAX,
+                  config.GetInt(GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS));
+  options.tcp_tx_zero_copy_enabled =
+      AdjustValue(0, 0, 1, config.GetInt(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) !=
+      0;
+  options.allow_reuse_port =
+      AdjustValue(1, 0, 1, config.GetInt(GRPC_ARG_ALLOW_REUSEPORT)) != 0;
+  options.listener_shards =
+      AdjustValue(1, 1, 64, config.GetInt(GRPC_ARG_TCP_LISTENER_SHARDS));
+  return options;
+}
+
+bool PrepareConnectedSocket(int fd, const PosixTcpOptions& options) {
+  int one = 1;
+  if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) != 0) {
+    gpr_log(GPR_DEBUG, "setsockopt(TCP_NODELAY) failed: %s", strerror(errno));
+  }
+  if (!options.tcp_tx_zero_copy_enabled) return true;
+#ifdef GRPC_LINUX_ERRQUEUE
+  if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0) {
+    return true;
+  }
+#endif
+  gpr_log(GPR_ERROR, "Failed to set zerocopy options on the socket.");
+  return false;
+}
+
+class PosixEndpointImpl : public grpc_core::RefCounted<PosixEndpointImpl> {
+ public:
+  PosixEndpointImpl(EpollEventHandle* handle, Executor* executor,
+                    MemoryAllocator allocator, const PosixTcpOptions& options);
+  ~PosixEndpointImpl() override;
+
+  void Read(absl::AnyInvocable<void(absl::Status)> on_read,
+            SliceBuffer* buffer, const EventEngine::Endpoint::ReadArgs* args);
+  void Write(absl::AnyInvocable<void(absl::Status)> on_writable,
+             SliceBuffer* data);
+  void MaybeShutdown(absl::Status why);
+  const EventEngine::ResolvedAddress& peer_address() const {
+    return peer_address_;
+  }
+  const EventEngine::ResolvedAddress& local_address() const {
+    return local_address_;
+  }
+
+ private:
+  void HandleRead(absl::Status status);
+  bool TcpDoRead(absl::Status& status) ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
+  void MaybeMakeReadSlices() ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
+  void UpdateRcvLowat() ABSL_EXCLUSIVE_LOCKS_REQUIRED(read_mu_);
+
+  void HandleWrite(absl::Status status);
+  bool FlushCurrentWrite(absl::Status& status);
+  bool DoFlush(grpc_slice_buffer* buf, size_t* slice_idx, size_t* byte_idx,
+               ZerocopySendRecord* record, absl::Status& status);
+  void FinishCurrentWrite();
+
+  ZerocopySendRecord* TryGetZerocopyRecord(SliceBuffer* data);
+  void UnrefZerocopyRecord(ZerocopySendRecord* record);
+  void HandleError(absl::Status status);
+  void ProcessErrorQueue();
+
+  void RunCallback(absl::AnyInvocable<void(absl::Status)> cb,
+                   absl::Status status);
+
+  EpollEventHandle* handle_;
+  const int fd_;
+  Executor* executor_;
+  MemoryAllocator allocator_;
+  const PosixTcpOptions options_;
+  EventEngine::ResolvedAddress peer_address_;
+  EventEngine::ResolvedAddress local_address_;
+
+  grpc_core::Mutex read_mu_;
+  absl::AnyInvocable<void(absl::Status)> read_cb_ ABSL_GUARDED_BY(read_mu_);
+  SliceBuffer* incoming_buffer_ ABSL_GUARDED_BY(read_mu_) = nullptr;
+  // Unused tail of the previous read, reused by the next one.
+  SliceBuffer last_read_buffer_ ABSL_GUARDED_BY(read_mu_);
+  int target_length_ ABSL_GUARDED_BY(read_mu_);
+  int min_progress_size_ ABSL_GUARDED_BY(read_mu_) = 1;
+  int set_rcvlowat_ ABSL_GUARDED_BY(read_mu_) = 0;
+
+  // At most one write is outstanding; the writer and HandleWrite never run
+  // concurrently, so the write state needs no lock.
+  absl::AnyInvocable<void(absl::Status)> write_cb_;
+  SliceBuffer* outgoing_buffer_ = nullptr;
+  size_t outgoing_slice_idx_ = 0;
+  size_t outgoing_byte_idx_ = 0;
+  ZerocopySendRecord* current_zerocopy_record_ = nullptr;
+
+  bool zerocopy_enabled_;
+  std::vector<std::unique_ptr<ZerocopySendRecord>> zerocopy_records_;
+  grpc_core::Mutex zerocopy_mu_;
+  std::vector<ZerocopySendRecord*> free_zerocopy_records_
+      ABSL_GUARDED_BY(zerocopy_mu_);
+  // Kernel zerocopy sequence number -> record awaiting its completion.
+  absl::flat_hash_map<uint32_t, ZerocopySendRecord*> zerocopy_in_flight_
+      ABSL_GUARDED_BY(zerocopy_mu_);
+  uint32_t next_zerocopy_seq_ ABSL_GUARDED_BY(zerocopy_mu_) = 0;
+
+  PosixEngineClosure* on_read_;
+  PosixEngineClosure* on_write_;
+  PosixEngineClosure* on_error_;
+};
+
+PosixEndpointImpl::PosixEndpointImpl(EpollEventHandle* handle,
+                                     Executor* executor,
+                                     MemoryAllocator allocator,
+                                     const PosixTcpOptions& options)
+    : handle_(handle),
+      fd_(handle->WrappedFd()),
+      executor_(executor),
+      allocator_(std::move(allocator)),
+      options_(options),
+      peer_address_(SockName(fd_, getpeername)),
+      local_address_(SockName(fd_, getsockname)),
+      target_length_(options.tcp_read_chunk_size),
+      zerocopy_enabled_(options.tcp_tx_zero_copy_enabled &&
+                        options.tcp_tx_zerocopy_max_simultaneous_sends > 0) {
+  on_read_ = PosixEngineClosure::ToPermanentClosure(
+      [this](absl::Status status) { HandleRead(std::move(status)); });
+  on_write_ = PosixEngineClosure::ToPermanentClosure(
+      [this](absl::Status status) { HandleWrite(std::move(status)); });
+  on_error_ = PosixEngineClosure::ToPermanentClosure(
+      [this](absl::Status status) { HandleError(std::move(status)); });
+  if (zerocopy_enabled_) {
+    grpc_core::MutexLock lock(&zerocopy_mu_);
+    for (int i = 0; i < options.tcp_tx_zerocopy_max_simultaneous_sends; i++) {
+      zerocopy_records_.push_back(absl::make_unique<ZerocopySendRecord>());
+      free_zerocopy_records_.push_back(zerocopy_records_.back().get());
+    }
+    // Completions are delivered on the socket error queue; keep listening
+    // until the handle is shut down.
+    Ref().release();
+    handle_->NotifyOnError(on_error_);
+  }
+}
+
+PosixEndpointImpl::~PosixEndpointImpl() {
+  handle_->OrphanHandle(nullptr, "PosixEndpoint destroyed");
+  delete on_read_;
+  delete on_write_;
+  delete on_error_;
+}
+
+void PosixEndpointImpl::MaybeShutdown(absl::Status why) {
+  handle_->ShutdownHandle(std::move(why));
+  Unref();
+}
+
+void PosixEndpointImpl::RunCallback(absl::AnyInvocable<void(absl::Status)> cb,
+                                    absl::Status status) {
+  executor_->Run([cb = std::move(cb), status = std::move(status)]() mutable {
+    cb(std::move(status));
+  });
+}
+
+void PosixEndpointImpl::UpdateRcvLowat() {
+  int remaining = std::min(min_progress_size_, kRcvLowatMax);
+  // Setting SO_RCVLOWAT for small quantities does not save on CPU.
+  if (remaining < kRcvLowatThreshold) {
+    remaining = 0;
+  }
+  // Wake shortly before the full message is here: more can show up while
+  // recvmsg() is copying, so an early wakeup aids latency.
+  if (!zerocopy_enabled_ && remaining > 0) {
+    remaining -= kRcvLowatThreshold;
+  }
+  // We still do not know the message size. Do not set SO_RCVLOWAT.
+  if (set_rcvlowat_ <= 1 && remaining <= 1) return;
+  // Previous value is still valid. No change needed in SO_RCVLOWAT.
+  if (set_rcvlowat_ == remaining) return;
+  if (setsockopt(fd_, SOL_SOCKET, SO_RCVLOWAT, &remaining, sizeof(remaining)) !=
+      0) {
+    gpr_log(GPR_ERROR, "Cannot set SO_RCVLOWAT on fd=%d err=%s", fd_,
+            strerror(errno));
+    return;
+  }
+  set_rcvlowat_ = remaining;
+}
+
+void PosixEndpointImpl::MaybeMakeReadSlices() {
+  grpc_slice_buffer_move_into(last_read_buffer_.c_slice_buffer(),
+                              incoming_buffer_->c_slice_buffer());
+  int target = std::max(target_length_, min_progress_size_);
+  target = std::min(target, options_.tcp_max_read_chunk_size);
+  size_t have = incoming_buffer_->Length();
+  if (have >= static_cast<size_t>(target)) return;
+  size_t want = static_cast<size_t>(target) - have;
+  incoming_buffer_->Append(
+      grpc_event_engine::experimental::Slice(allocator_.MakeSlice(
+          grpc_event_engine::experimental::MemoryRequest(
+              std::min<size_t>(want, options_.tcp_min_read_chunk_size),
+              want))));
+}
+
+bool PosixEndpointImpl::TcpDoRead(absl::Status& status) {
+  MaybeMakeReadSlices();
+  grpc_slice_buffer* buf = incoming_buffer_->c_slice_buffer();
+  iovec iov[kMaxReadIovec];
+  size_t iov_len = std::min(kMaxReadIovec, buf->count);
+  size_t capacity = 0;
+  for (size_t i = 0; i < iov_len; i++) {
+    iov[i].iov_base = GRPC_SLICE_START_PTR(buf->slices[i]);
+    iov[i].iov_len = GRPC_SLICE_LENGTH(buf->slices[i]);
+    capacity += iov[i].iov_len;
+  }
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = iov_len;
+  ssize_t read_bytes;
+  do {
+    read_bytes = recvmsg(fd_, &msg, 0);
+  } while (read_bytes < 0 && errno == EINTR);
+  if (read_bytes < 0 && errno == EAGAIN) {
+    // Keep the slices we allocated for the next attempt.
+    grpc_slice_buffer_move_into(buf, last_read_buffer_.c_slice_buffer());
+    return false;
+  }
+  if (read_bytes <= 0) {
+    incoming_buffer_->Clear();
+    status = read_bytes == 0
+                 ? absl::UnavailableError("Socket closed")
+                 : absl::InternalError(
+                       absl::StrCat("recvmsg:", strerror(errno)));
+    return true;
+  }
+  size_t read = static_cast<size_t>(read_bytes);
+  if (read == capacity) {
+    // Filled every slice: the peer is sending faster than we read.
+    target_length_ =
+        std::min(target_length_ * 2, options_.tcp_max_read_chunk_size);
+  } else {
+    target_length_ = std::max(
+        (target_length_ + static_cast<int>(read)) / 2,
+        options_.tcp_min_read_chunk_size);
+  }
+  if (incoming_buffer_->Length() > read) {
+    grpc_slice_buffer_trim_end(buf, incoming_buffer_->Length() - read,
+                               last_read_buffer_.c_slice_buffer());
+  }
+  status = absl::OkStatus();
+  return true;
+}
+
+void PosixEndpointImpl::HandleRead(absl::Status status) {
+  grpc_core::ReleasableMutexLock lock(&read_mu_);
+  if (status.ok()) {
+    if (!TcpDoRead(status)) {
+      UpdateRcvLowat();
+      handle_->NotifyOnRead(on_read_);
+      return;
+    }
+  } else {
+    incoming_buffer_->Clear();
+    last_read_buffer_.Clear();
+  }
+  auto cb = std::move(read_cb_);
+  read_cb_ = nullptr;
+  incoming_buffer_ = nullptr;
+  lock.Release();
+  cb(std::move(status));
+  Unref();
+}
+
+void PosixEndpointImpl::Read(absl::AnyInvocable<void(absl::Status)> on_read,
+                             SliceBuffer* buffer,
+                             const EventEngine::Endpoint::ReadArgs* args) {
+  grpc_core::ReleasableMutexLock lock(&read_mu_);
+  GPR_ASSERT(read_cb_ == nullptr);
+  buffer->Clear();
+  if (args != nullptr && args->read_hint_bytes > 0) {
+    min_progress_size_ = static_cast<int>(
+        std::min<int64_t>(args->read_hint_bytes, kRcvLowatMax));
+  } else {
+    min_progress_size_ = 1;
+  }
+  absl::Status status;
+  incoming_buffer_ = buffer;
+  if (handle_->IsHandleShutdown()) {
+    status = absl::CancelledError("Endpoint shut down");
+  } else if (!TcpDoRead(status)) {
+    read_cb_ = std::move(on_read);
+    UpdateRcvLowat();
+    Ref().release();
+    handle_->NotifyOnRead(on_read_);
+    return;
+  }
+  incoming_buffer_ = nullptr;
+  lock.Release();
+  RunCallback(std::move(on_read), std::move(status));
+}
+
+ZerocopySendRecord* PosixEndpointImpl::TryGetZerocopyRecord(SliceBuffer* data) {
+  if (!zerocopy_enabled_ ||
+      data->Length() <
+          static_cast<size_t>(options_.tcp_tx_zerocopy_send_bytes_threshold)) {
+    return nullptr;
+  }
+  ZerocopySendRecord* record;
+  {
+    grpc_core::MutexLock lock(&zerocopy_mu_);
+    if (free_zerocopy_records_.empty()) return nullptr;
+    record = free_zerocopy_records_.back();
+    free_zerocopy_records_.pop_back();
+  }
+  // The caller may reuse its buffer as soon as the write callback runs, but the
+  // kernel may still be reading the pages: take the slices over.
+  record->buf = std::move(*data);
+  record->slice_idx = 0;
+  record->byte_idx = 0;
+  record->refs.store(1, std::memory_order_relaxed);
+  return record;
+}
+
+void PosixEndpointImpl::UnrefZerocopyRecord(ZerocopySendRecord* record) {
+  if (record->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+  record->buf.Clear();
+  grpc_core::MutexLock lock(&zerocopy_mu_);
+  free_zerocopy_records_.push_back(record);
+}
+
+bool PosixEndpointImpl::DoFlush(grpc_slice_buffer* buf, size_t* slice_idx,
+                                size_t* byte_idx, ZerocopySendRecord* record,
+                                absl::Status& status) {
+  iovec iov[kMaxWriteIovec];
+  while (true) {
+    while (*slice_idx < buf->count &&
+           GRPC_SLICE_LENGTH(buf->slices[*slice_idx]) == *byte_idx) {
+      ++*slice_idx;
+      *byte_idx = 0;
+    }
+    if (*slice_idx == buf->count) {
+      status = absl::OkStatus();
+      return true;
+    }
+    size_t iov_size = 0;
+    for (size_t i = *slice_idx; i < buf->count && iov_size < kMaxWriteIovec;
+         i++, iov_size++) {
+      size_t offset = i == *slice_idx ? *byte_idx : 0;
+      iov[iov_size].iov_base = GRPC_SLICE_START_PTR(buf->slices[i]) + offset;
+      iov[iov_size].iov_len = GRPC_SLICE_LENGTH(buf->slices[i]) - offset;
+    }
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_size;
+    int flags = MSG_NOSIGNAL;
+    uint32_t seq = 0;
+    if (record != nullptr) {
+      // Register before sending: the completion may be processed by a poller
+      // thread before sendmsg() returns here.
+      grpc_core::MutexLock lock(&zerocopy_mu_);
+      seq = next_zerocopy_seq_;
+      zerocopy_in_flight_[seq] = record;
+      record->refs.fetch_add(1, std::memory_order_relaxed);
+      flags |= MSG_ZEROCOPY;
+    }
+    ssize_t sent;
+    do {
+      sent = sendmsg(fd_, &msg, flags);
+    } while (sent < 0 && errno == EINTR);
+    if (record != nullptr) {
+      grpc_core::MutexLock lock(&zerocopy_mu_);
+      if (sent >= 0) {
+        ++next_zerocopy_seq_;
+      } else {
+        zerocopy_in_flight_.erase(seq);
+        record->refs.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+    if (sent < 0 && errno == ENOBUFS && record != nullptr) {
+      // Out of optmem for pinned pages: send this chunk with a copy instead.
+      do {
+        sent = sendmsg(fd_, &msg, MSG_NOSIGNAL);
+      } while (sent < 0 && errno == EINTR);
+    }
+    if (sent < 0) {
+      if (errno == EAGAIN) return false;
+      status = absl::InternalError(absl::StrCat("sendmsg:", strerror(errno)));
+      return true;
+    }
+    size_t remaining = static_cast<size_t>(sent);
+    while (remaining > 0) {
+      size_t left = GRPC_SLICE_LENGTH(buf->slices[*slice_idx]) - *byte_idx;
+      if (remaining < left) {
+        *byte_idx += remaining;
+        break;
+      }
+      remaining -= left;
+      ++*slice_idx;
+      *byte_idx = 0;
+    }
+  }
+}
+
+bool PosixEndpointImpl::FlushCurrentWrite(absl::Status& status) {
+  if (current_zerocopy_record_ != nullptr) {
+    ZerocopySendRecord* record = current_zerocopy_record_;
+    return DoFlush(record->buf.c_slice_buffer(), &record->slice_idx,
+                   &record->byte_idx, record, status);
+  }
+  return DoFlush(outgoing_buffer_->c_slice_buffer(), &outgoing_slice_idx_,
+                 &outgoing_byte_idx_, nullptr, status);
+}
+
+void PosixEndpointImpl::FinishCurrentWrite() {
+  if (current_zerocopy_record_ != nullptr) {
+    UnrefZerocopyRecord(current_zerocopy_record_);
+    current_zerocopy_record_ = nullptr;
+  }
+  outgoing_buffer_ = nullptr;
+}
+
+void PosixEndpointImpl::HandleWrite(absl::Status status) {
+  if (status.ok() && !FlushCurrentWrite(status)) {
+    handle_->NotifyOnWrite(on_write_);
+    return;
+  }
+  FinishCurrentWrite();
+  auto cb = std::move(write_cb_);
+  write_cb_ = nullptr;
+  cb(std::move(status));
+  Unref();
+}
+
+void PosixEndpointImpl::Write(
+    absl::AnyInvocable<void(absl::Status)> on_writable, SliceBuffer* data) {
+  GPR_ASSERT(write_cb_ == nullptr);
+  absl::Status status;
+  if (handle_->IsHandleShutdown()) {
+    RunCallback(std::move(on_writable),
+                absl::CancelledError("Endpoint shut down"));
+    return;
+  }
+  if (data->Length() == 0) {
+    RunCallback(std::move(on_writable), absl::OkStatus());
+    return;
+  }
+  current_zerocopy_record_ = TryGetZerocopyRecord(data);
+  if (current_zerocopy_record_ == nullptr) {
+    outgoing_buffer_ = data;
+    outgoing_slice_idx_ = 0;
+    outgoing_byte_idx_ = 0;
+  }
+  if (!FlushCurrentWrite(status)) {
+    write_cb_ = std::move(on_writable);
+    Ref().release();
+    handle_->NotifyOnWrite(on_write_);
+    return;
+  }
+  FinishCurrentWrite();
+  RunCallback(std::move(on_writable), std::move(status));
+}
+
+void PosixEndpointImpl::ProcessErrorQueue() {
+#ifdef GRPC_LINUX_ERRQUEUE
+  while (true) {
+    // Room for a batch of IP{,V6}_RECVERR messages.
+    constexpr size_t kCmsgSpace =
+        16 * CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6));
+    union {
+      char buf[kCmsgSpace];
+      cmsghdr align;
+    } control;
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    ssize_t r;
+    do {
+      r = recvmsg(fd_, &msg, MSG_ERRQUEUE);
+    } while (r < 0 && errno == EINTR);
+    // EAGAIN: the queue is drained.
+    if (r < 0) return;
+    if (msg.msg_flags & MSG_CTRUNC) {
+      gpr_log(GPR_ERROR, "Error message was truncated.");
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      bool is_ip_level =
+          (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR) ||
+          (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR);
+      if (!is_ip_level) continue;
+      auto* serr = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+      if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      // [ee_info, ee_data] is the (inclusive) range of completed sends.
+      for (uint32_t seq = serr->ee_info; seq != serr->ee_data + 1; ++seq) {
+        ZerocopySendRecord* record = nullptr;
+        {
+          grpc_core::MutexLock lock(&zerocopy_mu_);
+          auto it = zerocopy_in_flight_.find(seq);
+          if (it == zerocopy_in_flight_.end()) continue;
+          record = it->second;
+          zerocopy_in_flight_.erase(it);
+        }
+        UnrefZerocopyRecord(record);
+      }
+    }
+  }
+#endif
+}
+
+void PosixEndpointImpl::HandleError(absl::Status status) {
+  if (!status.ok()) {
+    Unref();
+    return;
+  }
+  ProcessErrorQueue();
+  handle_->NotifyOnError(on_error_);
+}
+
+PosixEndpoint::PosixEndpoint(EpollEventHandle* handle, Executor* executor,
+                             MemoryAllocator allocator,
+                             const PosixTcpOptions& options)
+    : impl_(new PosixEndpointImpl(handle, executor, std::move(allocator),
+                                  options)) {}
+
+PosixEndpoint::~PosixEndpoint() {
+  impl_->MaybeShutdown(absl::CancelledError("Endpoint closing"));
+}
+
+void PosixEndpoint::Read(absl::AnyInvocable<void(absl::Status)> on_read,
+                         SliceBuffer* buffer, const ReadArgs* args) {
+  impl_->Read(std::move(on_read), buffer, args);
+}
+
+void PosixEndpoint::Write(absl::AnyInvocable<void(absl::Status)> on_writable,
+                          SliceBuffer* data, const WriteArgs* /*args*/) {
+  impl_->Write(std::move(on_writable), data);
+}
+
+const EventEngine::ResolvedAddress& PosixEndpoint::GetPeerAddress() const {
+  return impl_->peer_address();
+}
+
+const EventEngine::ResolvedAddress& PosixEndpoint::GetLocalAddress() const {
+  return impl_->local_address();
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
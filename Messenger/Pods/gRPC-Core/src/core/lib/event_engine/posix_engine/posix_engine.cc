@@ -30,9 +30,43 @@
 #include "src/core/lib/event_engine/trace.h"
 #include "src/core/lib/event_engine/utils.h"
 
+#ifdef GRPC_LINUX_EPOLL
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine_listener.h"
+#include "src/core/lib/gpr/useful.h"
+#endif
+
 namespace grpc_event_engine {
 namespace experimental {
 
+#ifdef GRPC_LINUX_EPOLL
+namespace {
+// Readiness work is handed off to the executor, so a few threads are enough
+// to keep up with the kernel even on large machines.
+unsigned NumPollerThreads() {
+  return grpc_core::Clamp(gpr_cpu_num_cores() / 4, 1u, 4u);
+}
+}  // namespace
+
+struct PosixEventEngine::ConnectionState {
+  OnConnectCallback on_connect;
+  posix_engine::EpollEventHandle* handle;
+  MemoryAllocator allocator;
+  posix_engine::PosixTcpOptions options;
+  ConnectionHandle connection_handle;
+  TaskHandle deadline_timer{0, 0};
+};
+#endif
+
 struct PosixEventEngine::ClosureData final : public EventEngine::Closure {
   absl::AnyInvocable<void()> cb;
   posix_engine::Timer timer;
@@ -52,6 +86,20 @@ struct PosixEventEngine::ClosureData final : public EventEngine::Closure {
 };
 
 PosixEventEngine::~PosixEventEngine() {
+#ifdef GRPC_LINUX_EPOLL
+  std::vector<grpc_core::Thread> poller_threads;
+  posix_engine::Epoll1Poller* poller;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    poller_threads.swap(poller_threads_);
+    poller = poller_.get();
+  }
+  if (!poller_threads.empty()) {
+    shutting_down_.store(true, std::memory_order_release);
+    poller->Kick();
+    for (auto& thread : poller_threads) thread.Join();
+  }
+#endif
   grpc_core::MutexLock lock(&mu_);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_event_engine_trace)) {
     for (auto handle : known_handles_) {
@@ -118,6 +166,203 @@ bool PosixEventEngine::IsWorkerThread() {
   GPR_ASSERT(false && "unimplemented");
 }
 
+#ifdef GRPC_LINUX_EPOLL
+
+posix_engine::Epoll1Poller* PosixEventEngine::Poller() {
+  grpc_core::MutexLock lock(&mu_);
+  if (poller_ == nullptr) {
+    poller_ = absl::make_unique<posix_engine::Epoll1Poller>(&executor_);
+    if (poller_->ok()) {
+      for (unsigned i = 0; i < NumPollerThreads(); i++) {
+        poller_threads_.emplace_back(
+            "event_engine_poller", &PosixEventEngine::PollerThreadBody, this,
+            nullptr, grpc_core::Thread::Options().set_tracked(false));
+        poller_threads_.back().Start();
+      }
+    }
+  }
+  return poller_->ok() ? poller_.get() : nullptr;
+}
+
+void PosixEventEngine::PollerThreadBody(void* arg) {
+  auto* engine = static_cast<PosixEventEngine*>(arg);
+  posix_engine::Epoll1Poller* poller;
+  {
+    grpc_core::MutexLock lock(&engine->mu_);
+    poller = engine->poller_.get();
+  }
+  while (!engine->shutting_down_.load(std::memory_order_acquire)) {
+    // Block until there are events or a kick.
+    poller->Work(Duration::max(), []() {});
+  }
+  // A kick wakes a single thread: pass shutdown on to the next one.
+  poller->Kick();
+}
+
+void PosixEventEngine::OnConnectWritable(intptr_t connection_id,
+                                         ConnectionState* state,
+                                         absl::Status status) {
+  bool abandoned;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    abandoned = pending_connects_.erase(connection_id) == 0;
+  }
+  if (abandoned) {
+    // Cancelled or timed out: the handle was shut down and nobody else
+    // refers to the attempt any more.
+    state->handle->OrphanHandle(nullptr, "connect abandoned");
+    delete state;
+    return;
+  }
+  Cancel(state->deadline_timer);
+  int fd = state->handle->WrappedFd();
+  if (status.ok()) {
+    int so_error = 0;
+    socklen_t len = sizeof(so_error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len) != 0) {
+      status = absl::InternalError(
+          absl::StrCat("getsockopt(SO_ERROR): ", strerror(errno)));
+    } else if (so_error != 0) {
+      status = absl::UnavailableError(
+          absl::StrCat("Failed to connect to remote host: ",
+                       strerror(so_error)));
+    }
+  }
+  absl::StatusOr<std::unique_ptr<Endpoint>> result;
+  if (status.ok()) {
+    result = absl::make_unique<posix_engine::PosixEndpoint>(
+        state->handle, &executor_, std::move(state->allocator),
+        state->options);
+  } else {
+    state->handle->OrphanHandle(nullptr, "connect failed");
+    result = std::move(status);
+  }
+  auto on_connect = std::move(state->on_connect);
+  delete state;
+  on_connect(std::move(result));
+}
+
+void PosixEventEngine::OnConnectDeadline(intptr_t connection_id) {
+  OnConnectCallback on_connect;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    auto it = pending_connects_.find(connection_id);
+    if (it == pending_connects_.end()) return;
+    on_connect = std::move(it->second->on_connect);
+    // Fails the pending write notification, which cleans up the attempt. Done
+    // under the lock so the handle cannot be orphaned and reused first.
+    it->second->handle->ShutdownHandle(
+        absl::DeadlineExceededError("connect timed out"));
+    pending_connects_.erase(it);
+  }
+  on_connect(absl::DeadlineExceededError("Connection timed out"));
+}
+
+bool PosixEventEngine::CancelConnect(EventEngine::ConnectionHandle handle) {
+  TaskHandle deadline_timer;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    auto it = pending_connects_.find(handle.keys[0]);
+    if (it == pending_connects_.end() ||
+        it->second->connection_handle.keys[1] != handle.keys[1]) {
+      return false;
+    }
+    deadline_timer = it->second->deadline_timer;
+    it->second->handle->ShutdownHandle(
+        absl::CancelledError("connect cancelled"));
+    pending_connects_.erase(it);
+  }
+  Cancel(deadline_timer);
+  return true;
+}
+
+EventEngine::ConnectionHandle PosixEventEngine::Connect(
+    OnConnectCallback on_connect, const ResolvedAddress& addr,
+    const EndpointConfig& args, MemoryAllocator memory_allocator,
+    Duration timeout) {
+  auto finish = [this, &on_connect](
+                    absl::StatusOr<std::unique_ptr<Endpoint>> result) {
+    Run([on_connect = std::move(on_connect),
+         result = std::move(result)]() mutable {
+      on_connect(std::move(result));
+    });
+    return ConnectionHandle{0, 0};
+  };
+  posix_engine::Epoll1Poller* poller = Poller();
+  if (poller == nullptr) {
+    return finish(absl::UnavailableError("epoll is not available"));
+  }
+  posix_engine::PosixTcpOptions options =
+      posix_engine::TcpOptionsFromEndpointConfig(args);
+  int fd = socket(addr.address()->sa_family,
+                  SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return finish(
+        absl::InternalError(absl::StrCat("socket: ", strerror(errno))));
+  }
+  if (!posix_engine::PrepareConnectedSocket(fd, options)) {
+    options.tcp_tx_zero_copy_enabled = false;
+  }
+  int err;
+  do {
+    err = connect(fd, addr.address(), addr.size());
+  } while (err < 0 && errno == EINTR);
+  if (err < 0 && errno != EINPROGRESS) {
+    absl::Status status =
+        absl::UnavailableError(absl::StrCat("connect: ", strerror(errno)));
+    close(fd);
+    return finish(std::move(status));
+  }
+  posix_engine::EpollEventHandle* handle = poller->CreateHandle(
+      fd, "tcp-client", options.tcp_tx_zero_copy_enabled);
+  if (err == 0) {
+    return finish(absl::make_unique<posix_engine::PosixEndpoint>(
+        handle, &executor_, std::move(memory_allocator), options));
+  }
+  auto* state = new ConnectionState{std::move(on_connect), handle,
+                                    std::move(memory_allocator), options};
+  intptr_t connection_id;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    connection_id = ++last_connection_id_;
+    state->connection_handle = {connection_id, aba_token_.fetch_add(1)};
+    pending_connects_.emplace(connection_id, state);
+  }
+  TaskHandle deadline_timer = RunAfter(
+      timeout, [this, connection_id]() { OnConnectDeadline(connection_id); });
+  ConnectionHandle connection_handle;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    connection_handle = state->connection_handle;
+    // The timer may already have fired and taken the attempt.
+    if (pending_connects_.contains(connection_id)) {
+      state->deadline_timer = deadline_timer;
+    }
+  }
+  handle->NotifyOnWrite(posix_engine::PosixEngineClosure::ToOneShotClosure(
+      [this, connection_id, state](absl::Status status) {
+        OnConnectWritable(connection_id, state, std::move(status));
+      }));
+  return connection_handle;
+}
+
+absl::StatusOr<std::unique_ptr<EventEngine::Listener>>
+PosixEventEngine::CreateListener(
+    Listener::AcceptCallback on_accept,
+    absl::AnyInvocable<void(absl::Status)> on_shutdown,
+    const EndpointConfig& config,
+    std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory) {
+  posix_engine::Epoll1Poller* poller = Poller();
+  if (poller == nullptr) {
+    return absl::UnavailableError("epoll is not available");
+  }
+  return absl::make_unique<posix_engine::PosixEngineListener>(
+      std::move(on_accept), std::move(on_shutdown), config,
+      std::move(memory_allocator_factory), poller, &executor_);
+}
+
+#else  // GRPC_LINUX_EPOLL
+
 bool PosixEventEngine::CancelConnect(EventEngine::ConnectionHandle /*handle*/) {
   GPR_ASSERT(false && "unimplemented");
 }
@@ -138,5 +383,7 @@ PosixEventEngine::CreateListener(
   GPR_ASSERT(false && "unimplemented");
 }
 
+#endif  // GRPC_LINUX_EPOLL
+
 }  // namespace experimental
 }  // namespace grpc_event_engine
@@ -0,0 +1,299 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine_listener.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine_closure.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EndpointConfig;
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::Executor;
+using ::grpc_event_engine::experimental::MemoryAllocatorFactory;
+
+namespace {
+
+int SockaddrGetPort(const EventEngine::ResolvedAddress& addr) {
+  switch (addr.address()->sa_family) {
+    case AF_INET:
+      return ntohs(
+          reinterpret_cast<const sockaddr_in*>(addr.address())->sin_port);
+    case AF_INET6:
+      return ntohs(
+          reinterpret_cast<const sockaddr_in6*>(addr.address())->sin6_port);
+    default:
+      return -1;
+  }
+}
+
+absl::Status ErrnoStatus(absl::string_view call) {
+  return absl::InternalError(absl::StrCat(call, ": ", strerror(errno)));
+}
+
+}  // namespace
+
+// State shared by the listener and its acceptors. Each armed acceptor holds a
+// ref, so on_shutdown only runs after the last accept callback has returned.
+class PosixEngineListenerImpl
+    : public grpc_core::RefCounted<PosixEngineListenerImpl> {
+ public:
+  PosixEngineListenerImpl(
+      EventEngine::Listener::AcceptCallback on_accept,
+      absl::AnyInvocable<void(absl::Status)> on_shutdown,
+      const EndpointConfig& config,
+      std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory,
+      Epoll1Poller* poller, Executor* executor)
+      : on_accept_(std::move(on_accept)),
+        on_shutdown_(std::move(on_shutdown)),
+        options_(TcpOptionsFromEndpointConfig(config)),
+        memory_allocator_factory_(std::move(memory_allocator_factory)),
+        poller_(poller),
+        executor_(executor) {}
+  ~PosixEngineListenerImpl() override { on_shutdown_(absl::OkStatus()); }
+
+  absl::StatusOr<int> Bind(const EventEngine::ResolvedAddress& addr);
+  absl::Status Start();
+  void Shutdown();
+
+ private:
+  class AsyncAcceptor;
+
+  absl::StatusOr<int> CreateListeningSocket(
+      const EventEngine::ResolvedAddress& addr, bool reuse_port);
+
+  EventEngine::Listener::AcceptCallback on_accept_;
+  absl::AnyInvocable<void(absl::Status)> on_shutdown_;
+  const PosixTcpOptions options_;
+  std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory_;
+  Epoll1Poller* const poller_;
+  Executor* const executor_;
+  grpc_core::Mutex mu_;
+  bool started_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<AsyncAcceptor*> acceptors_ ABSL_GUARDED_BY(mu_);
+};
+
+// Accepts connections from one listening socket (one shard of a Bind()).
+class PosixEngineListenerImpl::AsyncAcceptor {
+ public:
+  AsyncAcceptor(grpc_core::RefCountedPtr<PosixEngineListenerImpl> listener,
+                EpollEventHandle* handle)
+      : listener_(std::move(listener)),
+        handle_(handle),
+        on_readable_(PosixEngineClosure::ToPermanentClosure(
+            [this](absl::Status status) { Accept(std::move(status)); })) {}
+  ~AsyncAcceptor() {
+    handle_->OrphanHandle(nullptr, "listener shutdown");
+    delete on_readable_;
+  }
+
+  void Start() { handle_->NotifyOnRead(on_readable_); }
+  // Fails the armed closure, which deletes the acceptor.
+  void Shutdown() {
+    handle_->ShutdownHandle(absl::CancelledError("Listener shutdown"));
+  }
+
+ private:
+  void Accept(absl::Status status);
+
+  grpc_core::RefCountedPtr<PosixEngineListenerImpl> listener_;
+  EpollEventHandle* handle_;
+  PosixEngineClosure* on_readable_;
+};
+
+void PosixEngineListenerImpl::AsyncAcceptor::Accept(absl::Status status) {
+  if (!status.ok()) {
+    delete this;
+    return;
+  }
+  // Drain the accept queue: the listening fd is edge triggered.
+  while (true) {
+    sockaddr_storage addr;
+    socklen_t len = sizeof(addr);
+    int fd = accept4(handle_->WrappedFd(), reinterpret_cast<sockaddr*>(&addr),
+                     &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        gpr_log(GPR_ERROR, "Failed accept4: %s", strerror(errno));
+      }
+      handle_->NotifyOnRead(on_readable_);
+      return;
+    }
+    PosixTcpOptions options = listener_->options_;
+    if (!PrepareConnectedSocket(fd, options)) {
+      options.tcp_tx_zero_copy_enabled = false;
+    }
+    std::string peer_name = absl::StrCat("tcp-server-connection:fd=", fd);
+    auto endpoint = absl::make_unique<PosixEndpoint>(
+        listener_->poller_->CreateHandle(fd, peer_name,
+                                         options.tcp_tx_zero_copy_enabled),
+        listener_->executor_,
+        listener_->memory_allocator_factory_->CreateMemoryAllocator(
+            absl::StrCat("endpoint-", peer_name)),
+        options);
+    listener_->on_accept_(
+        std::move(endpoint),
+        listener_->memory_allocator_factory_->CreateMemoryAllocator(
+            absl::StrCat("on-accept-", peer_name)));
+  }
+}
+
+absl::StatusOr<int> PosixEngineListenerImpl::CreateListeningSocket(
+    const EventEngine::ResolvedAddress& addr, bool reuse_port) {
+  int fd = socket(addr.address()->sa_family,
+                  SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) return ErrnoStatus("socket");
+  int one = 1;
+  int zero = 0;
+  absl::Status status;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0) {
+    status = ErrnoStatus("setsockopt(SO_REUSEADDR)");
+  } else if (reuse_port &&
+             setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) {
+    status = ErrnoStatus("setsockopt(SO_REUSEPORT)");
+  } else if (addr.address()->sa_family == AF_INET6 &&
+             setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero)) !=
+                 0) {
+    // Serve IPv4 clients on the same socket where the system allows it.
+    gpr_log(GPR_DEBUG, "setsockopt(IPV6_V6ONLY) failed: %s", strerror(errno));
+  }
+  if (status.ok() && bind(fd, addr.address(), addr.size()) != 0) {
+    status = ErrnoStatus("bind");
+  }
+  if (status.ok() && listen(fd, SOMAXCONN) != 0) {
+    status = ErrnoStatus("listen");
+  }
+  if (!status.ok()) {
+    close(fd);
+    return status;
+  }
+  return fd;
+}
+
+absl::StatusOr<int> PosixEngineListenerImpl::Bind(
+    const EventEngine::ResolvedAddress& addr) {
+  grpc_core::MutexLock lock(&mu_);
+  if (started_) {
+    return absl::FailedPreconditionError(
+        "Listener is already started, ports can no longer be bound");
+  }
+  int shards = options_.allow_reuse_port ? options_.listener_shards : 1;
+  auto first_fd = CreateListeningSocket(addr, shards > 1);
+  if (!first_fd.ok() && shards > 1) {
+    // SO_REUSEPORT may be unsupported: fall back to a single socket.
+    shards = 1;
+    first_fd = CreateListeningSocket(addr, false);
+  }
+  if (!first_fd.ok()) return first_fd.status();
+  // Resolve a wildcard port so every shard binds the same one.
+  sockaddr_storage bound;
+  socklen_t bound_len = sizeof(bound);
+  if (getsockname(*first_fd, reinterpret_cast<sockaddr*>(&bound),
+                  &bound_len) != 0) {
+    absl::Status status = ErrnoStatus("getsockname");
+    close(*first_fd);
+    return status;
+  }
+  EventEngine::ResolvedAddress bound_addr(reinterpret_cast<sockaddr*>(&bound),
+                                          bound_len);
+  std::vector<int> fds = {*first_fd};
+  for (int i = 1; i < shards; i++) {
+    auto fd = CreateListeningSocket(bound_addr, true);
+    if (!fd.ok()) {
+      gpr_log(GPR_ERROR, "Listener shard %d not created: %s", i,
+              fd.status().ToString().c_str());
+      break;
+    }
+    fds.push_back(*fd);
+  }
+  for (int fd : fds) {
+    acceptors_.push_back(new AsyncAcceptor(
+        Ref(), poller_->CreateHandle(fd, "tcp-server-listener", false)));
+  }
+  return SockaddrGetPort(bound_addr);
+}
+
+absl::Status PosixEngineListenerImpl::Start() {
+  grpc_core::MutexLock lock(&mu_);
+  if (started_) {
+    return absl::FailedPreconditionError("Listener is already started");
+  }
+  started_ = true;
+  for (AsyncAcceptor* acceptor : acceptors_) acceptor->Start();
+  return absl::OkStatus();
+}
+
+void PosixEngineListenerImpl::Shutdown() {
+  std::vector<AsyncAcceptor*> acceptors;
+  bool started;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    acceptors.swap(acceptors_);
+    started = started_;
+  }
+  for (AsyncAcceptor* acceptor : acceptors) {
+    if (started) {
+      acceptor->Shutdown();
+    } else {
+      delete acceptor;
+    }
+  }
+}
+
+PosixEngineListener::PosixEngineListener(
+    AcceptCallback on_accept,
+    absl::AnyInvocable<void(absl::Status)> on_shutdown,
+    const EndpointConfig& config,
+    std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory,
+    Epoll1Poller* poller, Executor* executor)
+    : impl_(grpc_core::MakeRefCounted<PosixEngineListenerImpl>(
+          std::move(on_accept), std::move(on_shutdown), config,
+          std::move(memory_allocator_factory), poller, executor)) {}
+
+PosixEngineListener::~PosixEngineListener() { impl_->Shutdown(); }
+
+absl::StatusOr<int> PosixEngineListener::Bind(
+    const EventEngine::ResolvedAddress& addr) {
+  return impl_->Bind(addr);
+}
+
+absl::Status PosixEngineListener::Start() { return impl_->Start(); }
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
@@ -0,0 +1,78 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_LISTENER_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_LISTENER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <memory>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+#include <grpc/event_engine/endpoint_config.h>
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+
+#include "src/core/lib/event_engine/executor/executor.h"
+#include "src/core/lib/event_engine/posix_engine/ev_epoll1_linux.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+class PosixEngineListenerImpl;
+
+// A TCP listener driven by an Epoll1Poller.
+//
+// When GRPC_ARG_TCP_LISTENER_SHARDS is greater than one and SO_REUSEPORT is
+// allowed, each Bind() opens that many listening sockets on the same port and
+// the kernel balances incoming connections across them; each shard is
+// accepted from independently, so a connection surge is drained by several
+// poller threads at once instead of serializing on one listening fd.
+class PosixEngineListener final
+    : public grpc_event_engine::experimental::EventEngine::Listener {
+ public:
+  PosixEngineListener(
+      AcceptCallback on_accept,
+      absl::AnyInvocable<void(absl::Status)> on_shutdown,
+      const grpc_event_engine::experimental::EndpointConfig& config,
+      std::unique_ptr<grpc_event_engine::experimental::MemoryAllocatorFactory>
+          memory_allocator_factory,
+      Epoll1Poller* poller,
+      grpc_event_engine::experimental::Executor* executor);
+  // Stops accepting. on_shutdown runs once every in-flight accept has
+  // finished.
+  ~PosixEngineListener() override;
+
+  absl::StatusOr<int> Bind(
+      const grpc_event_engine::experimental::EventEngine::ResolvedAddress& addr)
+      override;
+  absl::Status Start() override;
+
+ private:
+  grpc_core::RefCountedPtr<PosixEngineListenerImpl> impl_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_LISTENER_H
@@ -25,9 +25,12 @@
 #include <limits>
 #include <utility>
 
+#include "absl/memory/memory.h"
+
 #include <grpc/support/cpu.h>
 
 #include "src/core/lib/event_engine/posix_engine/timer_heap.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/time.h"
 
@@ -64,6 +67,13 @@ TimerList::TimerList(TimerListHost* host)
     shard.min_deadline = shard.ComputeMinDeadline();
     shard_queue_[i] = &shard;
   }
+  if (grpc_core::IsTimerWheelEnabled()) {
+    const int64_t now = host_->Now().milliseconds_after_process_epoch();
+    wheel_shards_.reserve(num_shards_);
+    for (size_t i = 0; i < num_shards_; i++) {
+      wheel_shards_.push_back(absl::make_unique<WheelShard>(now));
+    }
+  }
 }
 
 namespace {
@@ -116,6 +126,11 @@ void TimerList::TimerInit(Timer* timer, grpc_core::Timestamp deadline,
   timer->hash_table_next = nullptr;
 #endif
 
+  if (!wheel_shards_.empty()) {
+    WheelTimerInit(timer, deadline);
+    return;
+  }
+
   {
     grpc_core::MutexLock lock(&shard->mu);
     timer->pending = true;
@@ -161,6 +176,7 @@ void TimerList::TimerInit(Timer* timer, grpc_core::Timestamp deadline,
 }
 
 bool TimerList::TimerCancel(Timer* timer) {
+  if (!wheel_shards_.empty()) return WheelTimerCancel(timer);
   Shard* shard = &shards_[grpc_core::HashPointer(timer, num_shards_)];
   grpc_core::MutexLock lock(&shard->mu);
 
@@ -239,6 +255,7 @@ void TimerList::Shard::PopTimers(
 
 std::vector<experimental::EventEngine::Closure*> TimerList::FindExpiredTimers(
     grpc_core::Timestamp now, grpc_core::Timestamp* next) {
+  if (!wheel_shards_.empty()) return FindExpiredWheelTimers(now, next);
   grpc_core::Timestamp min_timer =
       grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
           min_timer_.load(std::memory_order_relaxed));
@@ -281,6 +298,90 @@ std::vector<experimental::EventEngine::Closure*> TimerList::FindExpiredTimers(
   return done;
 }
 
+int64_t TimerList::WheelShard::UpdateNextTick() {
+  int64_t tick = wheel.NextEventTick();
+  next_tick.store(tick);
+  return tick;
+}
+
+bool TimerList::LowerMinTimer(int64_t tick) {
+  uint64_t min_timer = min_timer_.load();
+  while (static_cast<uint64_t>(tick) < min_timer) {
+    if (min_timer_.compare_exchange_weak(min_timer, tick)) return true;
+  }
+  return false;
+}
+
+void TimerList::WheelTimerInit(Timer* timer, grpc_core::Timestamp deadline) {
+  WheelShard* shard =
+      wheel_shards_[grpc_core::HashPointer(timer, num_shards_)].get();
+  int64_t next_tick;
+  {
+    grpc_core::MutexLock lock(&shard->mu);
+    timer->pending = true;
+    grpc_core::Timestamp now = host_->Now();
+    if (deadline <= now) {
+      timer->deadline = now.milliseconds_after_process_epoch();
+    }
+    shard->wheel.Insert(timer);
+    next_tick = shard->UpdateNextTick();
+  }
+  /* The shard's next_tick is published before min_timer_ is lowered, and
+     FindExpiredWheelTimers re-reads every next_tick after storing its own
+     minimum, so a concurrent check cannot lose this timer. */
+  if (LowerMinTimer(next_tick)) host_->Kick();
+}
+
+bool TimerList::WheelTimerCancel(Timer* timer) {
+  WheelShard* shard =
+      wheel_shards_[grpc_core::HashPointer(timer, num_shards_)].get();
+  grpc_core::MutexLock lock(&shard->mu);
+  if (timer->pending) {
+    timer->pending = false;
+    shard->wheel.Remove(timer);
+    shard->UpdateNextTick();
+    return true;
+  }
+  return false;
+}
+
+std::vector<experimental::EventEngine::Closure*>
+TimerList::FindExpiredWheelTimers(grpc_core::Timestamp now,
+                                  grpc_core::Timestamp* next) {
+  std::vector<experimental::EventEngine::Closure*> done;
+  auto collect = [&done](Timer* timer) {
+    timer->pending = false;
+    done.push_back(timer->closure);
+  };
+  const int64_t now_ms = now.milliseconds_after_process_epoch();
+  int64_t new_min = std::numeric_limits<int64_t>::max();
+  for (const auto& shard : wheel_shards_) {
+    if (shard->next_tick.load() > now_ms) {
+      new_min = std::min(new_min, shard->next_tick.load());
+      continue;
+    }
+    grpc_core::MutexLock lock(&shard->mu);
+    if (now == grpc_core::Timestamp::InfFuture()) {
+      shard->wheel.Clear(collect);
+    } else {
+      shard->wheel.Advance(now_ms, collect);
+    }
+    new_min = std::min(new_min, shard->UpdateNextTick());
+  }
+  min_timer_.store(new_min);
+  /* Timers added while the shards were being scanned may have lowered
+     min_timer_ before the store above; pick them up again. */
+  for (const auto& shard : wheel_shards_) {
+    LowerMinTimer(shard->next_tick.load());
+  }
+  if (next != nullptr) {
+    *next = std::min(*next,
+                     grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                         min_timer_.load()));
+  }
+  return done;
+}
+
 absl::optional<std::vector<experimental::EventEngine::Closure*>>
 TimerList::TimerCheck(grpc_core::Timestamp* next) {
   // prelude
@@ -46,6 +46,9 @@ const char* const description_new_hpack_huffman_decoder =
     "implementation.";
 const char* const description_event_engine_client =
     "Use EventEngine clients instead of iomgr's grpc_tcp_client";
+const char* const description_timer_wheel =
+    "Keep pending timers in per-shard hierarchical timing wheels, with O(1) "
+    "insertion and cancellation, instead of heaps.";
 #ifdef NDEBUG
 const bool kDefaultForDebugOnly = false;
 #else
@@ -70,6 +73,7 @@ const ExperimentMetadata g_experiment_metadata[] = {
     {"new_hpack_huffman_decoder", description_new_hpack_huffman_decoder,
      kDefaultForDebugOnly},
     {"event_engine_client", description_event_engine_client, false},
+    {"timer_wheel", description_timer_wheel, false},
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,1228 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+/* This polling engine is only relevant on linux kernels whose io_uring
+   supports IORING_ENTER_EXT_ARG (5.11+). Older kernels are rejected at runtime
+   in init_io_uring_linux(). */
+#if defined(GRPC_LINUX_IO_URING) && defined(IORING_FEAT_EXT_ARG)
+#include <endian.h>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/fork.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/iomgr/block_annotate.h"
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/iomgr/lockfree_event.h"
+
+/*******************************************************************************
+ * Singleton ring related fields
+ */
+
+#define IO_URING_ENTRIES 1024
+#define MAX_CQES_HANDLED_PER_ITERATION 128
+
+/* Registered buffers lent out for grpc_io_uring_read_fixed() */
+#define REGISTERED_BUFFER_COUNT 32
+#define REGISTERED_BUFFER_SIZE (64 * 1024)
+
+/* Completion tags. Poll requests carry the grpc_fd pointer in user_data with
+ * the low bits selecting the direction being watched, and socket operations
+ * carry their grpc_io_uring_op pointer; kicks and cancellations carry a bare
+ * tag. Both structs are at least 8-byte aligned, so the three low bits of
+ * their addresses are free. */
+#define KICK_TAG 0
+#define POLL_READ_TAG 1
+#define POLL_WRITE_TAG 2
+#define CANCEL_TAG 3
+#define OP_TAG 4
+#define TAG_MASK 7
+
+/* NOTE ON SYNCHRONIZATION:
+ * - The submission queue is filled under sq_mu. The kernel only consumes
+ *   entries between its head and the tail we publish, so sq_mu is never held
+ *   across a blocking io_uring_enter() and any thread may flush submissions.
+ * - The completion queue is only reaped by the designated poller, but cq_mu
+ *   is taken anyway so that reaping never depends on poller hand-off order.
+ */
+typedef struct uring {
+  int ring_fd;
+  void* ring_ptr;
+  size_t ring_size;
+  io_uring_sqe* sqes;
+  size_t sqes_size;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned sq_mask;
+  unsigned sq_entries;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned cq_mask;
+  io_uring_cqe* cqes;
+
+  gpr_mu sq_mu;
+  gpr_mu cq_mu;
+
+  /* Number of threads blocked in io_uring_enter(). Submissions queued while
+   * nobody waits are left for the next poller, which flushes them in the same
+   * syscall it uses to wait for completions. */
+  std::atomic<int> waiters{0};
+} uring;
+
+/* The global singleton ring */
+static uring g_ring;
+
+static int sys_io_uring_setup(unsigned entries, io_uring_params* p) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, void* arg,
+                                 unsigned nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags, void* arg, size_t argsz) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, arg, argsz));
+}
+
+/* Must be called *only* once */
+static bool uring_init() {
+  io_uring_params p;
+  memset(&p, 0, sizeof(p));
+  g_ring.ring_fd = sys_io_uring_setup(IO_URING_ENTRIES, &p);
+  if (g_ring.ring_fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return false;
+  }
+  const uint32_t required_features =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+  if ((p.features & required_features) != required_features) {
+    gpr_log(GPR_ERROR, "io_uring is missing required features (have 0x%x)",
+            p.features);
+    close(g_ring.ring_fd);
+    g_ring.ring_fd = -1;
+    return false;
+  }
+
+  g_ring.ring_size =
+      std::max(p.sq_off.array + p.sq_entries * sizeof(unsigned),
+               p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe));
+  g_ring.ring_ptr =
+      mmap(nullptr, g_ring.ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, g_ring.ring_fd, IORING_OFF_SQ_RING);
+  if (g_ring.ring_ptr == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring ring mmap failed: %s", strerror(errno));
+    close(g_ring.ring_fd);
+    g_ring.ring_fd = -1;
+    return false;
+  }
+  g_ring.sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr, g_ring.sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, g_ring.ring_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring sqes mmap failed: %s", strerror(errno));
+    munmap(g_ring.ring_ptr, g_ring.ring_size);
+    close(g_ring.ring_fd);
+    g_ring.ring_fd = -1;
+    return false;
+  }
+  g_ring.sqes = static_cast<io_uring_sqe*>(sqes);
+
+  char* base = static_cast<char*>(g_ring.ring_ptr);
+  g_ring.sq_head = reinterpret_cast<unsigned*>(base + p.sq_off.head);
+  g_ring.sq_tail = reinterpret_cast<unsigned*>(base + p.sq_off.tail);
+  g_ring.sq_mask = *reinterpret_cast<unsigned*>(base + p.sq_off.ring_mask);
+  g_ring.sq_entries = p.sq_entries;
+  g_ring.cq_head = reinterpret_cast<unsigned*>(base + p.cq_off.head);
+  g_ring.cq_tail = reinterpret_cast<unsigned*>(base + p.cq_off.tail);
+  g_ring.cq_mask = *reinterpret_cast<unsigned*>(base + p.cq_off.ring_mask);
+  g_ring.cqes = reinterpret_cast<io_uring_cqe*>(base + p.cq_off.cqes);
+  /* Submission slots map 1:1 onto sqes, so the indirection array is filled
+   * once and never touched again. */
+  unsigned* sq_array = reinterpret_cast<unsigned*>(base + p.sq_off.array);
+  for (unsigned i = 0; i < p.sq_entries; i++) {
+    sq_array[i] = i;
+  }
+
+  gpr_mu_init(&g_ring.sq_mu);
+  gpr_mu_init(&g_ring.cq_mu);
+  g_ring.waiters.store(0, std::memory_order_relaxed);
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d", g_ring.ring_fd);
+  return true;
+}
+
+/* Submits everything between the kernel's sq head and our tail. The kernel
+   clamps to_submit to the number of queued entries, so concurrent flushes from
+   several threads are harmless. */
+static void uring_flush() {
+  int r;
+  do {
+    r = sys_io_uring_enter(g_ring.ring_fd, g_ring.sq_entries, 0, 0, nullptr,
+                           0);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0 && errno != EBUSY && errno != EAGAIN) {
+    gpr_log(GPR_ERROR, "io_uring_enter failed: %s", strerror(errno));
+  }
+}
+
+/* poll32_events is word-reversed on big-endian machines */
+static uint32_t poll_mask(uint32_t events) {
+#if __BYTE_ORDER == __BIG_ENDIAN
+  events = (events << 16) | (events >> 16);
+#endif
+  return events;
+}
+
+/* Queue one submission. If a poller is currently blocked in the kernel, or
+   if \a flush is set, the submission is handed to the kernel right away;
+   otherwise it rides along with the next poller's wait. */
+static void uring_queue_sqe(const io_uring_sqe& prepared, bool flush) {
+  gpr_mu_lock(&g_ring.sq_mu);
+  unsigned tail = *g_ring.sq_tail;
+  while (tail - __atomic_load_n(g_ring.sq_head, __ATOMIC_ACQUIRE) ==
+         g_ring.sq_entries) {
+    /* The submission queue is full: hand what we have to the kernel before
+       reusing a slot. */
+    uring_flush();
+  }
+  g_ring.sqes[tail & g_ring.sq_mask] = prepared;
+  /* Pairs with the increment of waiters in uring_wait(): either that poller
+     observes the new tail when it enters the kernel, or we observe it waiting
+     and flush on its behalf. */
+  __atomic_store_n(g_ring.sq_tail, tail + 1, __ATOMIC_SEQ_CST);
+  gpr_mu_unlock(&g_ring.sq_mu);
+  if (flush || g_ring.waiters.load(std::memory_order_seq_cst) > 0) {
+    uring_flush();
+  }
+}
+
+static void uring_queue(uint8_t opcode, int fd, uint64_t addr,
+                        uint32_t poll_events, uint64_t user_data, bool flush) {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = opcode;
+  sqe.fd = fd;
+  sqe.addr = addr;
+  sqe.poll32_events = poll_mask(poll_events);
+  sqe.user_data = user_data;
+  uring_queue_sqe(sqe, flush);
+}
+
+/*******************************************************************************
+ * Registered buffers
+ */
+
+/* A fixed pool registered once at init. Registration pins the pages and counts
+ * against RLIMIT_MEMLOCK, so a failure only means reads go without fixed
+ * buffers. */
+static void* g_buffers_base;
+static gpr_mu g_buffers_mu;
+static int g_free_buffers[REGISTERED_BUFFER_COUNT];
+static int g_free_buffer_count;
+
+static void buffers_init() {
+  gpr_mu_init(&g_buffers_mu);
+  g_free_buffer_count = 0;
+  const size_t total = REGISTERED_BUFFER_COUNT * REGISTERED_BUFFER_SIZE;
+  void* base = mmap(nullptr, total, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    gpr_log(GPR_INFO, "io_uring buffer mmap failed: %s", strerror(errno));
+    return;
+  }
+  iovec iovs[REGISTERED_BUFFER_COUNT];
+  for (int i = 0; i < REGISTERED_BUFFER_COUNT; i++) {
+    iovs[i].iov_base = static_cast<char*>(base) + i * REGISTERED_BUFFER_SIZE;
+    iovs[i].iov_len = REGISTERED_BUFFER_SIZE;
+  }
+  if (sys_io_uring_register(g_ring.ring_fd, IORING_REGISTER_BUFFERS, iovs,
+                            REGISTERED_BUFFER_COUNT) < 0) {
+    gpr_log(GPR_INFO, "io_uring buffer registration failed: %s",
+            strerror(errno));
+    munmap(base, total);
+    return;
+  }
+  g_buffers_base = base;
+  for (int i = 0; i < REGISTERED_BUFFER_COUNT; i++) {
+    g_free_buffers[g_free_buffer_count++] = i;
+  }
+}
+
+/*******************************************************************************
+ * Fd Declarations
+ */
+
+struct grpc_fd {
+  int fd;
+
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> read_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> write_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> error_closure;
+
+  /* Non-zero while a one-shot poll request for the direction is in flight.
+     Only cleared by the poll's completion, under ops_mu. */
+  gpr_atm read_armed;
+  gpr_atm write_armed;
+
+  /* Socket operations in flight, cancelled when the fd is shut down. An
+     orphaned fd is only recycled, and orphan_done only run, once they and
+     its poll requests have all completed; orphan_done is non-null until
+     then. */
+  gpr_mu ops_mu;
+  grpc_io_uring_op* ops;
+  bool ops_shutdown;
+  grpc_closure* orphan_done;
+
+  struct grpc_fd* freelist_next;
+
+  grpc_iomgr_object iomgr_object;
+};
+
+/*******************************************************************************
+ * Pollset Declarations
+ */
+
+struct grpc_pollset_worker {
+  /* Guarded by the owning pollset's mu */
+  bool kicked;
+  grpc_pollset_worker* next;
+  grpc_pollset_worker* prev;
+
+  /* Guarded by g_poller_mu */
+  bool idle;
+  grpc_pollset_worker* idle_next;
+  grpc_pollset_worker* idle_prev;
+
+  /* A worker that is not the designated poller sleeps on its own cv, so that
+     it can be woken both by kicks (which hold the pollset mu) and by poller
+     hand-off (which holds g_poller_mu) */
+  gpr_mu mu;
+  gpr_cv cv;
+  bool woken;
+};
+
+struct grpc_pollset {
+  gpr_mu mu;
+  grpc_pollset_worker* root_worker;
+  bool kicked_without_poller;
+
+  bool shutting_down;             /* Is the pollset shutting down ? */
+  grpc_closure* shutdown_closure; /* Called after shutdown is complete */
+};
+
+/*******************************************************************************
+ * Pollset-set Declarations
+ */
+
+struct grpc_pollset_set {
+  char unused;
+};
+
+/*******************************************************************************
+ * Common helpers
+ */
+
+static bool append_error(grpc_error_handle* composite, grpc_error_handle error,
+                         const char* desc) {
+  if (GRPC_ERROR_IS_NONE(error)) return true;
+  if (GRPC_ERROR_IS_NONE(*composite)) {
+    *composite = GRPC_ERROR_CREATE_FROM_COPIED_STRING(desc);
+  }
+  *composite = grpc_error_add_child(*composite, error);
+  return false;
+}
+
+/*******************************************************************************
+ * Fd Definitions
+ */
+
+/* As in the epoll1 engine, grpc_fd structs are freelisted rather than freed.
+ * Completions carry the grpc_fd pointer, so an orphaned fd only goes back on
+ * the freelist once every poll and operation submitted for it has completed
+ * (see fd_busy_locked()); a late completion never sees a recycled fd. */
+static grpc_fd* fd_freelist = nullptr;
+static gpr_mu fd_freelist_mu;
+
+static void fd_global_init(void) { gpr_mu_init(&fd_freelist_mu); }
+
+static grpc_fd* fd_create(int fd, const char* name, bool /*track_err*/) {
+  grpc_fd* new_fd = nullptr;
+
+  gpr_mu_lock(&fd_freelist_mu);
+  if (fd_freelist != nullptr) {
+    new_fd = fd_freelist;
+    fd_freelist = fd_freelist->freelist_next;
+  }
+  gpr_mu_unlock(&fd_freelist_mu);
+
+  if (new_fd == nullptr) {
+    new_fd = static_cast<grpc_fd*>(gpr_malloc(sizeof(grpc_fd)));
+    new_fd->read_closure.Init();
+    new_fd->write_closure.Init();
+    new_fd->error_closure.Init();
+    gpr_mu_init(&new_fd->ops_mu);
+  }
+  new_fd->fd = fd;
+  new_fd->read_closure->InitEvent();
+  new_fd->write_closure->InitEvent();
+  new_fd->error_closure->InitEvent();
+  gpr_atm_no_barrier_store(&new_fd->read_armed, 0);
+  gpr_atm_no_barrier_store(&new_fd->write_armed, 0);
+  new_fd->ops = nullptr;
+  new_fd->ops_shutdown = false;
+  new_fd->orphan_done = nullptr;
+
+  new_fd->freelist_next = nullptr;
+
+  std::string fd_name = absl::StrCat(name, " fd=", fd);
+  grpc_iomgr_register_object(&new_fd->iomgr_object, fd_name.c_str());
+#ifndef NDEBUG
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_fd_refcount)) {
+    gpr_log(GPR_DEBUG, "FD %d %p create %s", fd, new_fd, fd_name.c_str());
+  }
+#endif
+  return new_fd;
+}
+
+static int fd_wrapped_fd(grpc_fd* fd) { return fd->fd; }
+
+/* Arm a one-shot poll for one direction unless one is already in flight */
+static void fd_arm_poll(grpc_fd* fd, gpr_atm* armed, uint32_t events,
+                        uint64_t tag) {
+  if (gpr_atm_full_cas(armed, 0, 1)) {
+    uring_queue(IORING_OP_POLL_ADD, fd->fd, 0, events,
+                reinterpret_cast<uint64_t>(fd) | tag, false);
+  }
+}
+
+/* In-flight poll requests hold a reference to the file in the kernel, so they
+   must be removed before close() can actually close a socket, and before a
+   released fd stops being watched. */
+static void fd_cancel_poll(grpc_fd* fd, gpr_atm* armed, uint64_t tag) {
+  if (gpr_atm_acq_load(armed) != 0) {
+    uring_queue(IORING_OP_POLL_REMOVE, -1, reinterpret_cast<uint64_t>(fd) | tag,
+                0, CANCEL_TAG, true);
+  }
+}
+
+/* Cancels the socket operations in flight and fails any started later. They
+   complete with -ECANCELED, unless they finished first. */
+static void fd_cancel_ops(grpc_fd* fd) {
+  gpr_mu_lock(&fd->ops_mu);
+  if (!fd->ops_shutdown) {
+    fd->ops_shutdown = true;
+    for (grpc_io_uring_op* op = fd->ops; op != nullptr; op = op->next) {
+      uring_queue(IORING_OP_ASYNC_CANCEL, -1,
+                  reinterpret_cast<uint64_t>(op) | OP_TAG, 0, CANCEL_TAG,
+                  true);
+    }
+  }
+  gpr_mu_unlock(&fd->ops_mu);
+}
+
+/* if 'releasing_fd' is true, it means that we are going to detach the internal
+ * fd from grpc_fd structure (i.e which means we should not be calling
+ * shutdown() syscall on that fd) */
+static void fd_shutdown_internal(grpc_fd* fd, grpc_error_handle why,
+                                 bool releasing_fd) {
+  if (fd->read_closure->SetShutdown(GRPC_ERROR_REF(why))) {
+    if (!releasing_fd) {
+      shutdown(fd->fd, SHUT_RDWR);
+    }
+    fd->write_closure->SetShutdown(GRPC_ERROR_REF(why));
+    fd->error_closure->SetShutdown(GRPC_ERROR_REF(why));
+  }
+  fd_cancel_ops(fd);
+  GRPC_ERROR_UNREF(why);
+}
+
+/* Might be called multiple times */
+static void fd_shutdown(grpc_fd* fd, grpc_error_handle why) {
+  fd_shutdown_internal(fd, why, false);
+}
+
+static void fd_release(grpc_fd* fd, grpc_closure* on_done);
+
+/* Whether completions are still due for \a fd. fd->ops_mu must be held. */
+static bool fd_busy_locked(grpc_fd* fd) {
+  return fd->ops != nullptr || gpr_atm_acq_load(&fd->read_armed) != 0 ||
+         gpr_atm_acq_load(&fd->write_armed) != 0;
+}
+
+static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
+                      const char* reason) {
+  bool is_release_fd = (release_fd != nullptr);
+
+  if (!fd->read_closure->IsShutdown()) {
+    fd_shutdown_internal(fd, GRPC_ERROR_CREATE_FROM_COPIED_STRING(reason),
+                         is_release_fd);
+  }
+  fd_cancel_poll(fd, &fd->read_armed, POLL_READ_TAG);
+  fd_cancel_poll(fd, &fd->write_armed, POLL_WRITE_TAG);
+  fd_cancel_ops(fd);
+
+  /* If release_fd is not NULL, we should be relinquishing control of the file
+     descriptor fd->fd (but we still own the grpc_fd structure). */
+  if (is_release_fd) {
+    *release_fd = fd->fd;
+  } else {
+    close(fd->fd);
+  }
+
+  grpc_iomgr_unregister_object(&fd->iomgr_object);
+
+  gpr_mu_lock(&fd->ops_mu);
+  bool busy = fd_busy_locked(fd);
+  if (busy) fd->orphan_done = on_done;
+  gpr_mu_unlock(&fd->ops_mu);
+  if (!busy) fd_release(fd, on_done);
+}
+
+/* Runs \a on_done for an orphaned fd and recycles it */
+static void fd_release(grpc_fd* fd, grpc_closure* on_done) {
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_done, GRPC_ERROR_NONE);
+
+  fd->read_closure->DestroyEvent();
+  fd->write_closure->DestroyEvent();
+  fd->error_closure->DestroyEvent();
+
+  gpr_mu_lock(&fd_freelist_mu);
+  fd->freelist_next = fd_freelist;
+  fd_freelist = fd;
+  gpr_mu_unlock(&fd_freelist_mu);
+}
+
+static bool fd_is_shutdown(grpc_fd* fd) {
+  return fd->read_closure->IsShutdown();
+}
+
+static void fd_notify_on_read(grpc_fd* fd, grpc_closure* closure) {
+  fd->read_closure->NotifyOn(closure);
+  if (!fd->read_closure->IsShutdown()) {
+    fd_arm_poll(fd, &fd->read_armed, POLLIN | POLLPRI, POLL_READ_TAG);
+  }
+}
+
+static void fd_notify_on_write(grpc_fd* fd, grpc_closure* closure) {
+  fd->write_closure->NotifyOn(closure);
+  if (!fd->write_closure->IsShutdown()) {
+    fd_arm_poll(fd, &fd->write_armed, POLLOUT, POLL_WRITE_TAG);
+  }
+}
+
+/* Errors are never tracked separately by this engine (can_track_err is false),
+   so error closures only ever observe shutdown. */
+static void fd_notify_on_error(grpc_fd* fd, grpc_closure* closure) {
+  fd->error_closure->NotifyOn(closure);
+}
+
+static void fd_become_readable(grpc_fd* fd) { fd->read_closure->SetReady(); }
+
+static void fd_become_writable(grpc_fd* fd) { fd->write_closure->SetReady(); }
+
+static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
+
+/*******************************************************************************
+ * Socket operations
+ */
+
+static bool g_ops_available = false;
+
+/* Submits \a sqe on behalf of \a op, or fails \a op right away if its fd is
+   already shut down. The submission is queued under ops_mu so that a
+   concurrent fd_cancel_ops() either sees the op or runs first. */
+static void fd_start_op(grpc_fd* fd, grpc_io_uring_op* op, io_uring_sqe* sqe) {
+  op->fd = fd;
+  gpr_mu_lock(&fd->ops_mu);
+  if (fd->ops_shutdown) {
+    gpr_mu_unlock(&fd->ops_mu);
+    op->result = -ECANCELED;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, op->on_done, GRPC_ERROR_NONE);
+    return;
+  }
+  op->prev = nullptr;
+  op->next = fd->ops;
+  if (fd->ops != nullptr) fd->ops->prev = op;
+  fd->ops = op;
+  sqe->fd = fd->fd;
+  sqe->user_data = reinterpret_cast<uint64_t>(op) | OP_TAG;
+  uring_queue_sqe(*sqe, false);
+  gpr_mu_unlock(&fd->ops_mu);
+}
+
+/* Called from process_completions() */
+static void fd_finish_op(grpc_io_uring_op* op, int32_t res) {
+  grpc_fd* fd = op->fd;
+  op->result = res;
+  gpr_mu_lock(&fd->ops_mu);
+  if (op->prev != nullptr) {
+    op->prev->next = op->next;
+  } else {
+    fd->ops = op->next;
+  }
+  if (op->next != nullptr) op->next->prev = op->prev;
+  grpc_closure* orphan_done = nullptr;
+  if (!fd_busy_locked(fd)) std::swap(orphan_done, fd->orphan_done);
+  gpr_mu_unlock(&fd->ops_mu);
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, op->on_done, GRPC_ERROR_NONE);
+  if (orphan_done != nullptr) fd_release(fd, orphan_done);
+}
+
+/* Called from process_completions() when the poll request armed in \a armed
+   completes. A poll of an orphaned fd (normally cancelled by fd_orphan())
+   reports nothing, and may be the last completion the fd was waiting for.
+   Readiness is set under ops_mu, so that the fd cannot be orphaned and
+   released in between. Any result other than a cancellation, including
+   errors and POLLHUP/POLLERR, means the next syscall on the fd will not
+   block. */
+static void fd_finish_poll(grpc_fd* fd, gpr_atm* armed, int32_t res,
+                           void (*become_ready)(grpc_fd*)) {
+  gpr_mu_lock(&fd->ops_mu);
+  gpr_atm_rel_store(armed, 0);
+  grpc_closure* orphan_done = nullptr;
+  if (fd->orphan_done != nullptr) {
+    if (!fd_busy_locked(fd)) std::swap(orphan_done, fd->orphan_done);
+  } else if (res != -ECANCELED) {
+    become_ready(fd);
+  }
+  gpr_mu_unlock(&fd->ops_mu);
+  if (orphan_done != nullptr) fd_release(fd, orphan_done);
+}
+
+bool grpc_io_uring_ops_available() { return g_ops_available; }
+
+void grpc_io_uring_recv(grpc_fd* fd, void* buf, size_t len,
+                        grpc_io_uring_op* op) {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_RECV;
+  sqe.addr = reinterpret_cast<uint64_t>(buf);
+  sqe.len = static_cast<uint32_t>(len);
+  fd_start_op(fd, op, &sqe);
+}
+
+void grpc_io_uring_read_fixed(grpc_fd* fd, void* buf, size_t len,
+                              int buf_index, grpc_io_uring_op* op) {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_READ_FIXED;
+  sqe.addr = reinterpret_cast<uint64_t>(buf);
+  sqe.len = static_cast<uint32_t>(len);
+  sqe.buf_index = static_cast<uint16_t>(buf_index);
+  fd_start_op(fd, op, &sqe);
+}
+
+void grpc_io_uring_sendmsg(grpc_fd* fd, const struct msghdr* msg, int flags,
+                           grpc_io_uring_op* op) {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_SENDMSG;
+  sqe.addr = reinterpret_cast<uint64_t>(msg);
+  sqe.len = 1;
+  sqe.msg_flags = static_cast<uint32_t>(flags);
+  fd_start_op(fd, op, &sqe);
+}
+
+void grpc_io_uring_accept(grpc_fd* fd, struct sockaddr* addr,
+                          socklen_t* addrlen, grpc_io_uring_op* op) {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_ACCEPT;
+  sqe.addr = reinterpret_cast<uint64_t>(addr);
+  sqe.addr2 = reinterpret_cast<uint64_t>(addrlen);
+  sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+  fd_start_op(fd, op, &sqe);
+}
+
+int grpc_io_uring_acquire_buffer(void** buf, size_t* len) {
+  int index = -1;
+  gpr_mu_lock(&g_buffers_mu);
+  if (g_free_buffer_count > 0) index = g_free_buffers[--g_free_buffer_count];
+  gpr_mu_unlock(&g_buffers_mu);
+  if (index >= 0) {
+    *buf = static_cast<char*>(g_buffers_base) + index * REGISTERED_BUFFER_SIZE;
+    *len = REGISTERED_BUFFER_SIZE;
+  }
+  return index;
+}
+
+void grpc_io_uring_release_buffer(int index) {
+  gpr_mu_lock(&g_buffers_mu);
+  g_free_buffers[g_free_buffer_count++] = index;
+  gpr_mu_unlock(&g_buffers_mu);
+}
+
+/*******************************************************************************
+ * Pollset Definitions
+ */
+
+static GPR_THREAD_LOCAL(grpc_pollset*) g_current_thread_pollset;
+static GPR_THREAD_LOCAL(grpc_pollset_worker*) g_current_thread_worker;
+
+/* Guards g_active_poller and the idle worker list */
+static gpr_mu g_poller_mu;
+/* The designated poller: the only thread that waits on the ring */
+static grpc_pollset_worker* g_active_poller;
+/* Workers (from any pollset) waiting to become the designated poller */
+static grpc_pollset_worker* g_idle_root;
+
+static void worker_insert(grpc_pollset* pollset, grpc_pollset_worker* worker) {
+  if (pollset->root_worker == nullptr) {
+    pollset->root_worker = worker;
+    worker->next = worker->prev = worker;
+  } else {
+    worker->next = pollset->root_worker;
+    worker->prev = worker->next->prev;
+    worker->next->prev = worker;
+    worker->prev->next = worker;
+  }
+}
+
+/* Return true if the pollset has no workers left */
+static bool worker_remove(grpc_pollset* pollset, grpc_pollset_worker* worker) {
+  if (worker == pollset->root_worker) {
+    if (worker == worker->next) {
+      pollset->root_worker = nullptr;
+      return true;
+    }
+    pollset->root_worker = worker->next;
+  }
+  worker->prev->next = worker->next;
+  worker->next->prev = worker->prev;
+  return false;
+}
+
+/* g_poller_mu must be held */
+static void idle_push(grpc_pollset_worker* worker) {
+  worker->idle = true;
+  if (g_idle_root == nullptr) {
+    g_idle_root = worker;
+    worker->idle_next = worker->idle_prev = worker;
+  } else {
+    worker->idle_next = g_idle_root;
+    worker->idle_prev = g_idle_root->idle_prev;
+    worker->idle_next->idle_prev = worker;
+    worker->idle_prev->idle_next = worker;
+  }
+}
+
+/* g_poller_mu must be held */
+static void idle_remove(grpc_pollset_worker* worker) {
+  if (!worker->idle) return;
+  worker->idle = false;
+  if (worker == g_idle_root) {
+    g_idle_root = worker->idle_next == worker ? nullptr : worker->idle_next;
+  }
+  worker->idle_prev->idle_next = worker->idle_next;
+  worker->idle_next->idle_prev = worker->idle_prev;
+}
+
+static void worker_wake(grpc_pollset_worker* worker) {
+  gpr_mu_lock(&worker->mu);
+  worker->woken = true;
+  gpr_cv_signal(&worker->cv);
+  gpr_mu_unlock(&worker->mu);
+}
+
+/* g_poller_mu must be held. Offers the poller role to the oldest idle worker
+   when nobody is polling, so that completions keep being reaped. */
+static void maybe_hand_off_poller_locked() {
+  if (g_active_poller == nullptr && g_idle_root != nullptr) {
+    grpc_pollset_worker* next = g_idle_root;
+    idle_remove(next);
+    worker_wake(next);
+  }
+}
+
+static grpc_error_handle pollset_global_init(void) {
+  gpr_mu_init(&g_poller_mu);
+  g_active_poller = nullptr;
+  g_idle_root = nullptr;
+  return GRPC_ERROR_NONE;
+}
+
+static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
+  gpr_mu_init(&pollset->mu);
+  *mu = &pollset->mu;
+  pollset->root_worker = nullptr;
+  pollset->kicked_without_poller = false;
+  pollset->shutting_down = false;
+  pollset->shutdown_closure = nullptr;
+}
+
+static void pollset_destroy(grpc_pollset* pollset) {
+  gpr_mu_destroy(&pollset->mu);
+}
+
+/* pollset->mu must be held */
+static void kick_worker(grpc_pollset_worker* worker) {
+  worker->kicked = true;
+  if (worker == g_current_thread_worker) return;
+  gpr_mu_lock(&g_poller_mu);
+  bool is_poller = g_active_poller == worker;
+  gpr_mu_unlock(&g_poller_mu);
+  if (is_poller) {
+    /* A worker only becomes the poller while holding its pollset mu, which
+       the caller holds, so the poller cannot change underneath us. A NOP
+       completion wakes it up without a wakeup fd. */
+    uring_queue(IORING_OP_NOP, -1, 0, 0, KICK_TAG, true);
+  } else {
+    worker_wake(worker);
+  }
+}
+
+static void pollset_kick_all(grpc_pollset* pollset) {
+  if (pollset->root_worker != nullptr) {
+    grpc_pollset_worker* worker = pollset->root_worker;
+    do {
+      if (!worker->kicked) kick_worker(worker);
+      worker = worker->next;
+    } while (worker != pollset->root_worker);
+  }
+}
+
+static void pollset_maybe_finish_shutdown(grpc_pollset* pollset) {
+  if (pollset->shutdown_closure != nullptr && pollset->root_worker == nullptr) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, pollset->shutdown_closure,
+                            GRPC_ERROR_NONE);
+    pollset->shutdown_closure = nullptr;
+  }
+}
+
+static void pollset_shutdown(grpc_pollset* pollset, grpc_closure* closure) {
+  GPR_ASSERT(pollset->shutdown_closure == nullptr);
+  GPR_ASSERT(!pollset->shutting_down);
+  pollset->shutdown_closure = closure;
+  pollset->shutting_down = true;
+  pollset_kick_all(pollset);
+  pollset_maybe_finish_shutdown(pollset);
+}
+
+/* Block in io_uring_enter() until at least one completion is available or the
+   deadline passes. Pending submissions are flushed by the same syscall. */
+static grpc_error_handle uring_wait(grpc_core::Timestamp deadline) {
+  __kernel_timespec ts;
+  io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  bool blocking = true;
+  if (deadline != grpc_core::Timestamp::InfFuture()) {
+    int64_t delta = std::max<int64_t>(
+        0, (deadline - grpc_core::Timestamp::Now()).millis());
+    blocking = delta != 0;
+    ts.tv_sec = delta / GPR_MS_PER_SEC;
+    ts.tv_nsec = (delta % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+  }
+  g_ring.waiters.fetch_add(1, std::memory_order_seq_cst);
+  if (blocking) {
+    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  }
+  int r = sys_io_uring_enter(g_ring.ring_fd, g_ring.sq_entries, 1,
+                             IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                             &arg, sizeof(arg));
+  int err = errno;
+  if (blocking) {
+    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  }
+  g_ring.waiters.fetch_sub(1, std::memory_order_relaxed);
+  if (r < 0 && err != ETIME && err != EINTR && err != EBUSY && err != EAGAIN) {
+    return GRPC_OS_ERROR(err, "io_uring_enter");
+  }
+  return GRPC_ERROR_NONE;
+}
+
+/* Reap completions and turn them into readiness notifications. This only
+   queues closures on the ExecCtx; they run once the pollset lock is
+   released. */
+static void process_completions() {
+  io_uring_cqe cqes[MAX_CQES_HANDLED_PER_ITERATION];
+  size_t n = 0;
+  gpr_mu_lock(&g_ring.cq_mu);
+  unsigned head = *g_ring.cq_head;
+  unsigned tail = __atomic_load_n(g_ring.cq_tail, __ATOMIC_ACQUIRE);
+  while (head != tail && n < MAX_CQES_HANDLED_PER_ITERATION) {
+    cqes[n++] = g_ring.cqes[head & g_ring.cq_mask];
+    head++;
+  }
+  __atomic_store_n(g_ring.cq_head, head, __ATOMIC_RELEASE);
+  gpr_mu_unlock(&g_ring.cq_mu);
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "io_uring poll got %" PRIuPTR " completions", n);
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    uint64_t data = cqes[i].user_data;
+    if ((data & TAG_MASK) == OP_TAG) {
+      fd_finish_op(reinterpret_cast<grpc_io_uring_op*>(
+                       data & ~static_cast<uint64_t>(TAG_MASK)),
+                   cqes[i].res);
+      continue;
+    }
+    grpc_fd* fd =
+        reinterpret_cast<grpc_fd*>(data & ~static_cast<uint64_t>(TAG_MASK));
+    switch (data & TAG_MASK) {
+      case POLL_READ_TAG:
+        fd_finish_poll(fd, &fd->read_armed, cqes[i].res, fd_become_readable);
+        break;
+      case POLL_WRITE_TAG:
+        fd_finish_poll(fd, &fd->write_armed, cqes[i].res, fd_become_writable);
+        break;
+      default:
+        /* kicks and cancellations only exist to wake the poller */
+        break;
+    }
+  }
+}
+
+/* pollset->mu lock must be held by the caller before calling this.
+   The function pollset_work() may temporarily release the lock (pollset->mu)
+   during the course of its execution but it will always re-acquire the lock and
+   ensure that it is held by the time the function returns */
+static grpc_error_handle pollset_work(grpc_pollset* ps,
+                                      grpc_pollset_worker** worker_hdl,
+                                      grpc_core::Timestamp deadline) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  static const char* err_desc = "pollset_work";
+  if (ps->kicked_without_poller) {
+    ps->kicked_without_poller = false;
+    return GRPC_ERROR_NONE;
+  }
+  if (ps->shutting_down) return GRPC_ERROR_NONE;
+
+  grpc_pollset_worker worker;
+  worker.kicked = false;
+  worker.idle = false;
+  worker.woken = false;
+  gpr_mu_init(&worker.mu);
+  gpr_cv_init(&worker.cv);
+  if (worker_hdl != nullptr) *worker_hdl = &worker;
+  worker_insert(ps, &worker);
+  g_current_thread_pollset = ps;
+
+  bool is_poller = false;
+  while (!worker.kicked && !ps->shutting_down) {
+    gpr_mu_lock(&g_poller_mu);
+    if (g_active_poller == nullptr) {
+      g_active_poller = &worker;
+      is_poller = true;
+      gpr_mu_unlock(&g_poller_mu);
+      break;
+    }
+    idle_push(&worker);
+    gpr_mu_unlock(&g_poller_mu);
+
+    gpr_mu_unlock(&ps->mu);
+    bool timed_out = false;
+    gpr_mu_lock(&worker.mu);
+    while (!worker.woken && !timed_out) {
+      timed_out = gpr_cv_wait(&worker.cv, &worker.mu,
+                              deadline.as_timespec(GPR_CLOCK_MONOTONIC));
+    }
+    worker.woken = false;
+    gpr_mu_unlock(&worker.mu);
+    gpr_mu_lock(&ps->mu);
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+
+    gpr_mu_lock(&g_poller_mu);
+    idle_remove(&worker);
+    gpr_mu_unlock(&g_poller_mu);
+    if (timed_out) break;
+  }
+
+  if (is_poller) {
+    g_current_thread_worker = &worker;
+    gpr_mu_unlock(&ps->mu);
+    append_error(&error, uring_wait(deadline), err_desc);
+    process_completions();
+    g_current_thread_worker = nullptr;
+    gpr_mu_lock(&g_poller_mu);
+    g_active_poller = nullptr;
+    maybe_hand_off_poller_locked();
+    gpr_mu_unlock(&g_poller_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(&ps->mu);
+  } else {
+    /* We may have been offered the poller role and then kicked or timed out
+       before taking it: pass it on instead of leaving the ring unattended. */
+    gpr_mu_lock(&g_poller_mu);
+    maybe_hand_off_poller_locked();
+    gpr_mu_unlock(&g_poller_mu);
+    if (grpc_core::ExecCtx::Get()->HasWork()) {
+      gpr_mu_unlock(&ps->mu);
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_mu_lock(&ps->mu);
+    }
+  }
+
+  if (worker_hdl != nullptr) *worker_hdl = nullptr;
+  g_current_thread_pollset = nullptr;
+  if (worker_remove(ps, &worker)) {
+    pollset_maybe_finish_shutdown(ps);
+  }
+  gpr_cv_destroy(&worker.cv);
+  gpr_mu_destroy(&worker.mu);
+  return error;
+}
+
+static grpc_error_handle pollset_kick(grpc_pollset* pollset,
+                                      grpc_pollset_worker* specific_worker) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "PS:%p KICK:%p curps=%p curworker=%p root=%p", pollset,
+            specific_worker, static_cast<void*>(g_current_thread_pollset),
+            static_cast<void*>(g_current_thread_worker), pollset->root_worker);
+  }
+  if (specific_worker == nullptr) {
+    if (g_current_thread_pollset == pollset) {
+      /* kicked while waking up: the current worker is about to return */
+      return GRPC_ERROR_NONE;
+    }
+    if (pollset->root_worker == nullptr) {
+      pollset->kicked_without_poller = true;
+      return GRPC_ERROR_NONE;
+    }
+    grpc_pollset_worker* worker = pollset->root_worker;
+    do {
+      if (!worker->kicked) {
+        kick_worker(worker);
+        break;
+      }
+      worker = worker->next;
+    } while (worker != pollset->root_worker);
+    return GRPC_ERROR_NONE;
+  }
+  if (!specific_worker->kicked) {
+    kick_worker(specific_worker);
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static void pollset_add_fd(grpc_pollset* /*pollset*/, grpc_fd* /*fd*/) {}
+
+/*******************************************************************************
+ * Pollset-set Definitions
+ */
+
+static grpc_pollset_set* pollset_set_create(void) {
+  return reinterpret_cast<grpc_pollset_set*>(static_cast<intptr_t>(0xdeafbeef));
+}
+
+static void pollset_set_destroy(grpc_pollset_set* /*pss*/) {}
+
+static void pollset_set_add_fd(grpc_pollset_set* /*pss*/, grpc_fd* /*fd*/) {}
+
+static void pollset_set_del_fd(grpc_pollset_set* /*pss*/, grpc_fd* /*fd*/) {}
+
+static void pollset_set_add_pollset(grpc_pollset_set* /*pss*/,
+                                    grpc_pollset* /*ps*/) {}
+
+static void pollset_set_del_pollset(grpc_pollset_set* /*pss*/,
+                                    grpc_pollset* /*ps*/) {}
+
+static void pollset_set_add_pollset_set(grpc_pollset_set* /*bag*/,
+                                        grpc_pollset_set* /*item*/) {}
+
+static void pollset_set_del_pollset_set(grpc_pollset_set* /*bag*/,
+                                        grpc_pollset_set* /*item*/) {}
+
+/*******************************************************************************
+ * Event engine binding
+ */
+
+static bool is_any_background_poller_thread(void) { return false; }
+
+static void shutdown_background_closure(void) {}
+
+static bool add_closure_to_background_poller(grpc_closure* /*closure*/,
+                                             grpc_error_handle /*error*/) {
+  return false;
+}
+
+static bool init_io_uring_linux(bool explicit_request);
+
+const grpc_event_engine_vtable grpc_ev_io_uring_posix = {
+    sizeof(grpc_pollset),
+    false,
+    false,
+
+    fd_create,
+    fd_wrapped_fd,
+    fd_orphan,
+    fd_shutdown,
+    fd_notify_on_read,
+    fd_notify_on_write,
+    fd_notify_on_error,
+    fd_become_readable,
+    fd_become_writable,
+    fd_has_errors,
+    fd_is_shutdown,
+
+    pollset_init,
+    pollset_shutdown,
+    pollset_destroy,
+    pollset_work,
+    pollset_kick,
+    pollset_add_fd,
+
+    pollset_set_create,
+    pollset_set_destroy,
+    pollset_set_add_pollset,
+    pollset_set_del_pollset,
+    pollset_set_add_pollset_set,
+    pollset_set_del_pollset_set,
+    pollset_set_add_fd,
+    pollset_set_del_fd,
+
+    is_any_background_poller_thread,
+    /* name = */ "io_uring",
+    /* check_engine_available = */ init_io_uring_linux,
+    /* init_engine = */ []() {},
+    shutdown_background_closure,
+    /* shutdown_engine = */ []() {},
+    add_closure_to_background_poller,
+};
+
+/* The engine is opt-in: it is only considered when named explicitly in
+ * GRPC_POLL_STRATEGY, never as part of "all". The kernel may also lack
+ * io_uring (or have it disabled by seccomp), which uring_init() detects. */
+static bool init_io_uring_linux(bool explicit_request) {
+  if (!explicit_request) {
+    return false;
+  }
+  if (grpc_core::Fork::Enabled()) {
+    gpr_log(GPR_ERROR, "Skipping io_uring because fork support is enabled.");
+    return false;
+  }
+  if (!uring_init()) {
+    return false;
+  }
+  fd_global_init();
+  if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
+    return false;
+  }
+  buffers_init();
+  g_ops_available = true;
+  return true;
+}
+
+#else /* defined(GRPC_LINUX_IO_URING) && defined(IORING_FEAT_EXT_ARG) */
+#if defined(GRPC_POSIX_SOCKET_EV)
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+const grpc_event_engine_vtable grpc_ev_io_uring_posix = {
+    1,
+    false,
+    false,
+
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+
+    nullptr,
+    /* name = */ "io_uring",
+    /* check_engine_available = */ [](bool) { return false; },
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
+
+bool grpc_io_uring_ops_available() { return false; }
+
+void grpc_io_uring_recv(grpc_fd* /*fd*/, void* /*buf*/, size_t /*len*/,
+                        grpc_io_uring_op* /*op*/) {
+  GPR_ASSERT(false);
+}
+
+void grpc_io_uring_read_fixed(grpc_fd* /*fd*/, void* /*buf*/, size_t /*len*/,
+                              int /*buf_index*/, grpc_io_uring_op* /*op*/) {
+  GPR_ASSERT(false);
+}
+
+void grpc_io_uring_sendmsg(grpc_fd* /*fd*/, const struct msghdr* /*msg*/,
+                           int /*flags*/, grpc_io_uring_op* /*op*/) {
+  GPR_ASSERT(false);
+}
+
+void grpc_io_uring_accept(grpc_fd* /*fd*/, struct sockaddr* /*addr*/,
+                          socklen_t* /*addrlen*/, grpc_io_uring_op* /*op*/) {
+  GPR_ASSERT(false);
+}
+
+int grpc_io_uring_acquire_buffer(void** /*buf*/, size_t* /*len*/) {
+  return -1;
+}
+
+void grpc_io_uring_release_buffer(int /*index*/) { GPR_ASSERT(false); }
+#endif /* defined(GRPC_POSIX_SOCKET_EV) */
+#endif /* !(defined(GRPC_LINUX_IO_URING) && defined(IORING_FEAT_EXT_ARG)) */
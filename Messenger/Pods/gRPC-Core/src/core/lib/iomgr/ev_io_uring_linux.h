@@ -0,0 +1,78 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H
+#define GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <sys/socket.h>
+
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/port.h"
+
+// a polling engine that drives fd readiness through a singleton io_uring
+// instance: poll requests are queued as submissions and flushed in the same
+// io_uring_enter() call that waits for completions, and kicks are delivered as
+// NOP completions instead of through a wakeup fd. Only selected when
+// explicitly requested with GRPC_POLL_STRATEGY=io_uring.
+
+extern const grpc_event_engine_vtable grpc_ev_io_uring_posix;
+
+// A socket operation submitted to the engine's ring, which completes it
+// instead of reporting readiness. The memory an operation reads or writes
+// must stay valid until on_done runs. Shutting down or orphaning the fd
+// cancels the operations in flight; an orphaned fd is only released once
+// they have all completed.
+struct alignas(8) grpc_io_uring_op {
+  // Scheduled on the ExecCtx when the operation completes.
+  grpc_closure* on_done;
+  // Set before on_done runs: the byte count or accepted fd, or a negated
+  // errno. -ECANCELED once the fd has been shut down, and -EAGAIN if the
+  // socket is non-blocking and the kernel did not wait for it.
+  int result;
+
+  // Owned by the engine while the operation is in flight.
+  grpc_fd* fd;
+  grpc_io_uring_op* next;
+  grpc_io_uring_op* prev;
+};
+
+// Whether the io_uring engine is active, so that the functions below may be
+// called.
+bool grpc_io_uring_ops_available();
+
+void grpc_io_uring_recv(grpc_fd* fd, void* buf, size_t len,
+                        grpc_io_uring_op* op);
+// Reads into \a buf, which must lie within the registered buffer
+// \a buf_index.
+void grpc_io_uring_read_fixed(grpc_fd* fd, void* buf, size_t len,
+                              int buf_index, grpc_io_uring_op* op);
+void grpc_io_uring_sendmsg(grpc_fd* fd, const struct msghdr* msg, int flags,
+                           grpc_io_uring_op* op);
+// The accepted fd is non-blocking and close-on-exec.
+void grpc_io_uring_accept(grpc_fd* fd, struct sockaddr* addr,
+                          socklen_t* addrlen, grpc_io_uring_op* op);
+
+// Lends out one of the buffers registered with the ring. Returns its index,
+// or -1 if none is free or registration failed.
+int grpc_io_uring_acquire_buffer(void** buf, size_t* len);
+void grpc_io_uring_release_buffer(int index);
+
+#endif /* GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H */
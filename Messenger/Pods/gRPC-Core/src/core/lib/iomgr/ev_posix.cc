@@ -34,6 +34,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
 #include "src/core/lib/iomgr/ev_poll_posix.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/internal_errqueue.h"
@@ -97,6 +98,7 @@ static const grpc_event_engine_vtable* g_vtables[] = {
     &grpc_ev_epoll1_posix,
     &grpc_ev_poll_posix,
     &grpc_ev_none_posix,
+    &grpc_ev_io_uring_posix,
     nullptr,
     nullptr,
     nullptr,
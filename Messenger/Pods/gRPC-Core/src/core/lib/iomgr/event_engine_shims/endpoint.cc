@@ -0,0 +1,261 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/event_engine_shims/endpoint.h"
+
+#include <string.h>
+
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/event_engine/slice_buffer.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/resolved_address.h"
+#include "src/core/lib/transport/error_utils.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+std::string ResolvedAddressToUri(const EventEngine::ResolvedAddress& address) {
+  grpc_resolved_address addr;
+  GPR_ASSERT(address.size() <= sizeof(addr.addr));
+  memcpy(addr.addr, address.address(), address.size());
+  addr.len = address.size();
+  return grpc_sockaddr_to_uri(&addr).value_or("");
+}
+
+struct EventEngineEndpoint {
+  explicit EventEngineEndpoint(std::unique_ptr<EventEngine::Endpoint> ee)
+      : peer_address(ResolvedAddressToUri(ee->GetPeerAddress())),
+        local_address(ResolvedAddressToUri(ee->GetLocalAddress())),
+        endpoint(std::move(ee)) {}
+  ~EventEngineEndpoint() { GRPC_ERROR_UNREF(shutdown_error); }
+
+  void Ref() { refs.Ref(); }
+  void Unref() {
+    if (refs.Unref()) delete this;
+  }
+
+  // Returns the wrapped endpoint for one Read() or Write() call, which must
+  // be followed by EndCall(). Once shut down, returns nullptr and sets
+  // *error instead. The call holds a ref, since its callback may run and
+  // drop the last other one before the call returns.
+  EventEngine::Endpoint* BeginCall(grpc_error_handle* error) {
+    grpc_core::MutexLock lock(&mu);
+    if (shutdown) {
+      *error = GRPC_ERROR_REF(shutdown_error);
+      return nullptr;
+    }
+    ++calls_in_progress;
+    Ref();
+    return endpoint.get();
+  }
+
+  void EndCall() {
+    {
+      std::unique_ptr<EventEngine::Endpoint> to_destroy;
+      grpc_core::MutexLock lock(&mu);
+      if (--calls_in_progress == 0 && shutdown) {
+        to_destroy = std::move(endpoint);
+      }
+    }
+    Unref();
+  }
+
+  // The error to report for a read or write that failed with \a status: the
+  // shutdown error if the failure came from our own shutdown.
+  grpc_error_handle CompletionError(absl::Status status) {
+    if (status.ok()) return GRPC_ERROR_NONE;
+    grpc_core::MutexLock lock(&mu);
+    if (shutdown) return GRPC_ERROR_REF(shutdown_error);
+    return absl_status_to_grpc_error(status);
+  }
+
+  void FinishRead(absl::Status status) {
+    {
+      grpc_core::ApplicationCallbackExecCtx app_exec_ctx;
+      grpc_core::ExecCtx exec_ctx;
+      grpc_closure* cb = read_cb;
+      read_cb = nullptr;
+      grpc_slice_buffer_move_into(read_buffer.c_slice_buffer(), read_slices);
+      read_slices = nullptr;
+      grpc_core::ExecCtx::Run(DEBUG_LOCATION, cb,
+                              CompletionError(std::move(status)));
+    }
+    Unref();
+  }
+
+  void FinishWrite(absl::Status status) {
+    {
+      grpc_core::ApplicationCallbackExecCtx app_exec_ctx;
+      grpc_core::ExecCtx exec_ctx;
+      grpc_closure* cb = write_cb;
+      write_cb = nullptr;
+      write_buffer.Clear();
+      grpc_core::ExecCtx::Run(DEBUG_LOCATION, cb,
+                              CompletionError(std::move(status)));
+    }
+    Unref();
+  }
+
+  // Must be first, see FromBase().
+  grpc_endpoint base;
+  grpc_core::RefCount refs;
+  const std::string peer_address;
+  const std::string local_address;
+
+  grpc_core::Mutex mu;
+  std::unique_ptr<EventEngine::Endpoint> endpoint ABSL_GUARDED_BY(mu);
+  // Read() and Write() calls currently inside the wrapped endpoint. A
+  // shutdown leaves the endpoint to the last of them to destroy.
+  int calls_in_progress ABSL_GUARDED_BY(mu) = 0;
+  bool shutdown ABSL_GUARDED_BY(mu) = false;
+  grpc_error_handle shutdown_error ABSL_GUARDED_BY(mu) = GRPC_ERROR_NONE;
+
+  // Owned by the pending read.
+  SliceBuffer read_buffer;
+  grpc_slice_buffer* read_slices = nullptr;
+  grpc_closure* read_cb = nullptr;
+  // Owned by the pending write.
+  SliceBuffer write_buffer;
+  grpc_closure* write_cb = nullptr;
+};
+
+EventEngineEndpoint* FromBase(grpc_endpoint* ep) {
+  return reinterpret_cast<EventEngineEndpoint*>(ep);
+}
+
+void EndpointRead(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                  grpc_closure* cb, bool /*urgent*/, int min_progress_size) {
+  EventEngineEndpoint* eeep = FromBase(ep);
+  grpc_error_handle error;
+  EventEngine::Endpoint* endpoint = eeep->BeginCall(&error);
+  if (endpoint == nullptr) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, cb, error);
+    return;
+  }
+  GPR_ASSERT(eeep->read_cb == nullptr);
+  eeep->read_cb = cb;
+  eeep->read_slices = slices;
+  eeep->Ref();
+  EventEngine::Endpoint::ReadArgs args = {min_progress_size};
+  endpoint->Read(
+      [eeep](absl::Status status) { eeep->FinishRead(std::move(status)); },
+      &eeep->read_buffer, &args);
+  eeep->EndCall();
+}
+
+void EndpointWrite(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                   grpc_closure* cb, void* arg, int max_frame_size) {
+  EventEngineEndpoint* eeep = FromBase(ep);
+  grpc_error_handle error;
+  EventEngine::Endpoint* endpoint = eeep->BeginCall(&error);
+  if (endpoint == nullptr) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, cb, error);
+    return;
+  }
+  GPR_ASSERT(eeep->write_cb == nullptr);
+  eeep->write_cb = cb;
+  grpc_slice_buffer_swap(slices, eeep->write_buffer.c_slice_buffer());
+  eeep->Ref();
+  EventEngine::Endpoint::WriteArgs args;
+  args.google_specific = arg;
+  args.max_frame_size = max_frame_size;
+  endpoint->Write(
+      [eeep](absl::Status status) { eeep->FinishWrite(std::move(status)); },
+      &eeep->write_buffer, &args);
+  eeep->EndCall();
+}
+
+// The EventEngine does its own polling.
+void EndpointAddToPollset(grpc_endpoint* /*ep*/, grpc_pollset* /*pollset*/) {}
+void EndpointAddToPollsetSet(grpc_endpoint* /*ep*/,
+                             grpc_pollset_set* /*pollset_set*/) {}
+void EndpointDeleteFromPollsetSet(grpc_endpoint* /*ep*/,
+                                  grpc_pollset_set* /*pollset_set*/) {}
+
+void EndpointShutdown(grpc_endpoint* ep, grpc_error_handle why) {
+  EventEngineEndpoint* eeep = FromBase(ep);
+  // Destroying the wrapped endpoint fails its pending read and write.
+  std::unique_ptr<EventEngine::Endpoint> to_destroy;
+  {
+    grpc_core::MutexLock lock(&eeep->mu);
+    if (!eeep->shutdown) {
+      eeep->shutdown = true;
+      eeep->shutdown_error = GRPC_ERROR_REF(why);
+      if (eeep->calls_in_progress == 0) to_destroy = std::move(eeep->endpoint);
+    }
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+void EndpointDestroy(grpc_endpoint* ep) {
+  EndpointShutdown(ep,
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint destroyed"));
+  FromBase(ep)->Unref();
+}
+
+absl::string_view EndpointGetPeer(grpc_endpoint* ep) {
+  return FromBase(ep)->peer_address;
+}
+
+absl::string_view EndpointGetLocalAddress(grpc_endpoint* ep) {
+  return FromBase(ep)->local_address;
+}
+
+int EndpointGetFd(grpc_endpoint* /*ep*/) { return -1; }
+
+bool EndpointCanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+const grpc_endpoint_vtable kEventEngineEndpointVtable = {
+    EndpointRead,
+    EndpointWrite,
+    EndpointAddToPollset,
+    EndpointAddToPollsetSet,
+    EndpointDeleteFromPollsetSet,
+    EndpointShutdown,
+    EndpointDestroy,
+    EndpointGetPeer,
+    EndpointGetLocalAddress,
+    EndpointGetFd,
+    EndpointCanTrackErr};
+
+}  // namespace
+
+grpc_endpoint* grpc_event_engine_endpoint_create(
+    std::unique_ptr<EventEngine::Endpoint> ee_endpoint) {
+  GPR_ASSERT(ee_endpoint != nullptr);
+  auto* eeep = new EventEngineEndpoint(std::move(ee_endpoint));
+  eeep->base.vtable = &kEventEngineEndpointVtable;
+  return &eeep->base;
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
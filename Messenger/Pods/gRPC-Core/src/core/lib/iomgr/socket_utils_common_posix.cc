@@ -141,6 +141,13 @@ grpc_error_handle grpc_set_socket_sndbuf(int fd, int buffer_size_bytes) {
              : GRPC_OS_ERROR(errno, "setsockopt(SO_SNDBUF)");
 }
 
+grpc_error_handle grpc_get_socket_sndbuf(int fd, int* buffer_size_bytes) {
+  socklen_t len = sizeof(*buffer_size_bytes);
+  return 0 == getsockopt(fd, SOL_SOCKET, SO_SNDBUF, buffer_size_bytes, &len)
+             ? GRPC_ERROR_NONE
+             : GRPC_OS_ERROR(errno, "getsockopt(SO_SNDBUF)");
+}
+
 grpc_error_handle grpc_set_socket_rcvbuf(int fd, int buffer_size_bytes) {
   return 0 == setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size_bytes,
                          sizeof(buffer_size_bytes))
@@ -209,6 +216,20 @@ grpc_error_handle grpc_set_socket_reuse_port(int fd, int reuse) {
 #endif
 }
 
+grpc_error_handle grpc_set_socket_incoming_cpu(int fd, int cpu) {
+#ifndef SO_INCOMING_CPU
+  (void)fd;
+  (void)cpu;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_INCOMING_CPU unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_INCOMING_CPU)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
 static gpr_once g_probe_so_reuesport_once = GPR_ONCE_INIT;
 static int g_support_so_reuseport = false;
 
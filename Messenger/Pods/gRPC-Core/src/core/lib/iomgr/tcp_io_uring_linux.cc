@@ -0,0 +1,535 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET_TCP
+
+#include "src/core/lib/iomgr/tcp_io_uring_linux.h"
+
+#ifdef GRPC_LINUX_IO_URING
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+#define MAX_WRITE_IOVEC 260
+
+namespace {
+
+// Reads that fill less than this much of a registered buffer are copied out,
+// so that a few bytes do not keep a whole buffer out of the pool.
+constexpr size_t kMinFixedReadToKeep = 16 * 1024;
+
+// A registered buffer handed up in the slices of a read. It is charged to the
+// endpoint's memory quota, and goes back to the engine once the last of the
+// slices is released.
+struct FixedBuffer : public grpc_slice_refcount {
+  FixedBuffer(int index, grpc_core::MemoryAllocator::Reservation reservation)
+      : grpc_slice_refcount(Destroy),
+        index(index),
+        reservation(std::move(reservation)) {}
+
+  static void Destroy(grpc_slice_refcount* refcount) {
+    FixedBuffer* buffer = static_cast<FixedBuffer*>(refcount);
+    grpc_io_uring_release_buffer(buffer->index);
+    delete buffer;
+  }
+
+  const int index;
+  grpc_core::MemoryAllocator::Reservation reservation;
+};
+
+struct grpc_tcp_uring {
+  explicit grpc_tcp_uring(const grpc_core::PosixTcpOptions& options)
+      : read_chunk_size(options.tcp_read_chunk_size),
+        min_read_chunk_size(options.tcp_min_read_chunk_size),
+        max_read_chunk_size(options.tcp_max_read_chunk_size) {}
+
+  grpc_endpoint base;
+  grpc_fd* em_fd;
+  int fd;
+  grpc_core::RefCount refcount;
+
+  int read_chunk_size;
+  int min_read_chunk_size;
+  int max_read_chunk_size;
+
+  std::string peer_string;
+  std::string local_address;
+
+  grpc_core::MemoryOwner memory_owner;
+  grpc_core::MemoryAllocator::Reservation self_reservation;
+
+  grpc_slice_buffer* incoming_buffer = nullptr;
+  grpc_closure* read_cb = nullptr;
+  size_t min_progress_size = 1;
+  grpc_io_uring_op read_op;
+  grpc_closure read_done_closure;
+  grpc_closure read_ready_closure;
+  /* What read_op reads into: the registered buffer read_buffer_index, or
+   * read_slice if that is -1. */
+  int read_buffer_index = -1;
+  void* read_buffer = nullptr;
+  grpc_slice read_slice;
+
+  grpc_slice_buffer* outgoing_buffer = nullptr;
+  /* byte within outgoing_buffer->slices[0] to write next */
+  size_t outgoing_byte_idx = 0;
+  grpc_closure* write_cb = nullptr;
+  grpc_io_uring_op write_op;
+  grpc_closure write_done_closure;
+  grpc_closure write_ready_closure;
+  struct iovec iov[MAX_WRITE_IOVEC];
+  struct msghdr msg;
+
+  grpc_closure* release_fd_cb = nullptr;
+  int* release_fd = nullptr;
+};
+
+}  // namespace
+
+static grpc_error_handle tcp_annotate_error(grpc_error_handle src_error,
+                                            grpc_tcp_uring* tcp) {
+  return grpc_error_set_str(
+      grpc_error_set_int(
+          grpc_error_set_int(src_error, GRPC_ERROR_INT_FD, tcp->fd),
+          /* All tcp errors are marked with UNAVAILABLE so that application may
+           * choose to retry. */
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE),
+      GRPC_ERROR_STR_TARGET_ADDRESS, tcp->peer_string);
+}
+
+/* The error for an operation that failed with \a res */
+static grpc_error_handle tcp_op_error(int res, const char* call_name,
+                                      grpc_tcp_uring* tcp) {
+  if (res == -ECANCELED) {
+    return tcp_annotate_error(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint shutdown"), tcp);
+  }
+  return tcp_annotate_error(GRPC_OS_ERROR(-res, call_name), tcp);
+}
+
+static void tcp_unref(grpc_tcp_uring* tcp) {
+  if (GPR_UNLIKELY(tcp->refcount.Unref())) {
+    /* No operation is in flight anymore: each one holds a ref. */
+    grpc_fd_orphan(tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
+                   "tcp_unref_orphan");
+    delete tcp;
+  }
+}
+
+/*******************************************************************************
+ * Reads
+ */
+
+static void tcp_start_read(grpc_tcp_uring* tcp) {
+  size_t len;
+  tcp->read_buffer_index =
+      grpc_io_uring_acquire_buffer(&tcp->read_buffer, &len);
+  if (tcp->read_buffer_index >= 0) {
+    grpc_io_uring_read_fixed(tcp->em_fd, tcp->read_buffer, len,
+                             tcp->read_buffer_index, &tcp->read_op);
+    return;
+  }
+  /* No registered buffer is free: read into memory from the quota. */
+  const size_t remaining =
+      tcp->min_progress_size > tcp->incoming_buffer->length
+          ? tcp->min_progress_size - tcp->incoming_buffer->length
+          : 0;
+  const size_t target = grpc_core::Clamp(
+      std::max(static_cast<size_t>(tcp->read_chunk_size), remaining),
+      static_cast<size_t>(tcp->min_read_chunk_size),
+      static_cast<size_t>(tcp->max_read_chunk_size));
+  tcp->read_slice = tcp->memory_owner.MakeSlice(grpc_core::MemoryRequest(
+      static_cast<size_t>(tcp->min_read_chunk_size), target));
+  grpc_io_uring_recv(tcp->em_fd, GRPC_SLICE_START_PTR(tcp->read_slice),
+                     GRPC_SLICE_LENGTH(tcp->read_slice), &tcp->read_op);
+}
+
+/* Hands the first \a n bytes read to incoming_buffer, and releases the rest of
+ * the buffer that was read into. */
+static void tcp_take_read_buffer(grpc_tcp_uring* tcp, size_t n) {
+  if (tcp->read_buffer_index < 0) {
+    if (n > 0) {
+      grpc_slice_buffer_add(tcp->incoming_buffer,
+                            grpc_slice_sub_no_ref(tcp->read_slice, 0, n));
+    } else {
+      grpc_slice_unref_internal(tcp->read_slice);
+    }
+    return;
+  }
+  if (n < kMinFixedReadToKeep) {
+    if (n > 0) {
+      grpc_slice slice = tcp->memory_owner.MakeSlice(n);
+      memcpy(GRPC_SLICE_START_PTR(slice), tcp->read_buffer, n);
+      grpc_slice_buffer_add(tcp->incoming_buffer, slice);
+    }
+    grpc_io_uring_release_buffer(tcp->read_buffer_index);
+  } else {
+    FixedBuffer* buffer =
+        new FixedBuffer(tcp->read_buffer_index,
+                        tcp->memory_owner.MakeReservation(n));
+    grpc_slice slice;
+    slice.refcount = buffer;
+    slice.data.refcounted.bytes = static_cast<uint8_t*>(tcp->read_buffer);
+    slice.data.refcounted.length = n;
+    grpc_slice_buffer_add(tcp->incoming_buffer, slice);
+  }
+  tcp->read_buffer_index = -1;
+}
+
+static void tcp_finish_read(grpc_tcp_uring* tcp, grpc_error_handle error) {
+  if (!GRPC_ERROR_IS_NONE(error)) {
+    grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+  }
+  grpc_closure* cb = tcp->read_cb;
+  tcp->read_cb = nullptr;
+  tcp->incoming_buffer = nullptr;
+  grpc_core::Closure::Run(DEBUG_LOCATION, cb, error);
+  tcp_unref(tcp);
+}
+
+static void tcp_handle_read(void* arg, grpc_error_handle /*error*/) {
+  grpc_tcp_uring* tcp = static_cast<grpc_tcp_uring*>(arg);
+  const int res = tcp->read_op.result;
+  if (res == -EAGAIN || res == -EINTR) {
+    /* The kernel did not wait on the non-blocking socket: wait for it to
+     * become readable before trying again. */
+    tcp_take_read_buffer(tcp, 0);
+    grpc_fd_notify_on_read(tcp->em_fd, &tcp->read_ready_closure);
+    return;
+  }
+  if (res < 0) {
+    tcp_take_read_buffer(tcp, 0);
+    tcp_finish_read(tcp, tcp_op_error(res, "recv", tcp));
+    return;
+  }
+  if (res == 0) {
+    /* 0 read size ==> end of stream */
+    tcp_take_read_buffer(tcp, 0);
+    tcp_finish_read(
+        tcp, tcp_annotate_error(
+                 GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed"), tcp));
+    return;
+  }
+  GRPC_STATS_INC_TCP_READ_SIZE(res);
+  tcp_take_read_buffer(tcp, static_cast<size_t>(res));
+  if (tcp->incoming_buffer->length < tcp->min_progress_size) {
+    tcp_start_read(tcp);
+    return;
+  }
+  tcp_finish_read(tcp, GRPC_ERROR_NONE);
+}
+
+static void tcp_handle_read_ready(void* arg, grpc_error_handle error) {
+  grpc_tcp_uring* tcp = static_cast<grpc_tcp_uring*>(arg);
+  if (!GRPC_ERROR_IS_NONE(error)) {
+    tcp_finish_read(tcp, GRPC_ERROR_REF(error));
+    return;
+  }
+  tcp_start_read(tcp);
+}
+
+static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
+                     grpc_closure* cb, bool /*urgent*/,
+                     int min_progress_size) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  GPR_ASSERT(tcp->read_cb == nullptr);
+  tcp->read_cb = cb;
+  tcp->incoming_buffer = incoming_buffer;
+  tcp->min_progress_size =
+      static_cast<size_t>(std::max(min_progress_size, 1));
+  grpc_slice_buffer_reset_and_unref_internal(incoming_buffer);
+  tcp->refcount.Ref();
+  tcp_start_read(tcp);
+}
+
+/*******************************************************************************
+ * Writes
+ */
+
+static void tcp_start_write(grpc_tcp_uring* tcp) {
+  size_t iov_size = 0;
+  size_t sending_length = 0;
+  for (size_t i = 0;
+       i < tcp->outgoing_buffer->count && iov_size < MAX_WRITE_IOVEC; i++) {
+    grpc_slice& slice = tcp->outgoing_buffer->slices[i];
+    const size_t skip = i == 0 ? tcp->outgoing_byte_idx : 0;
+    tcp->iov[iov_size].iov_base = GRPC_SLICE_START_PTR(slice) + skip;
+    tcp->iov[iov_size].iov_len = GRPC_SLICE_LENGTH(slice) - skip;
+    sending_length += tcp->iov[iov_size].iov_len;
+    iov_size++;
+  }
+  memset(&tcp->msg, 0, sizeof(tcp->msg));
+  tcp->msg.msg_iov = tcp->iov;
+  tcp->msg.msg_iovlen = iov_size;
+  GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
+  GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
+  grpc_io_uring_sendmsg(tcp->em_fd, &tcp->msg, MSG_NOSIGNAL, &tcp->write_op);
+}
+
+static void tcp_finish_write(grpc_tcp_uring* tcp, grpc_error_handle error) {
+  grpc_closure* cb = tcp->write_cb;
+  tcp->write_cb = nullptr;
+  tcp->outgoing_buffer = nullptr;
+  grpc_core::Closure::Run(DEBUG_LOCATION, cb, error);
+  tcp_unref(tcp);
+}
+
+static void tcp_handle_write(void* arg, grpc_error_handle /*error*/) {
+  grpc_tcp_uring* tcp = static_cast<grpc_tcp_uring*>(arg);
+  const int res = tcp->write_op.result;
+  if (res == -EAGAIN || res == -EINTR) {
+    /* As for reads: wait for the socket to become writable. */
+    grpc_fd_notify_on_write(tcp->em_fd, &tcp->write_ready_closure);
+    return;
+  }
+  if (res < 0) {
+    tcp_finish_write(tcp, tcp_op_error(res, "sendmsg", tcp));
+    return;
+  }
+  /* Drop what was sent, which may end partway through a slice. */
+  size_t sent = static_cast<size_t>(res);
+  while (sent > 0) {
+    const size_t slice_remaining =
+        GRPC_SLICE_LENGTH(tcp->outgoing_buffer->slices[0]) -
+        tcp->outgoing_byte_idx;
+    if (sent < slice_remaining) {
+      tcp->outgoing_byte_idx += sent;
+      break;
+    }
+    sent -= slice_remaining;
+    grpc_slice_buffer_remove_first(tcp->outgoing_buffer);
+    tcp->outgoing_byte_idx = 0;
+  }
+  if (tcp->outgoing_buffer->count == 0) {
+    tcp_finish_write(tcp, GRPC_ERROR_NONE);
+    return;
+  }
+  tcp_start_write(tcp);
+}
+
+static void tcp_handle_write_ready(void* arg, grpc_error_handle error) {
+  grpc_tcp_uring* tcp = static_cast<grpc_tcp_uring*>(arg);
+  if (!GRPC_ERROR_IS_NONE(error)) {
+    tcp_finish_write(tcp, GRPC_ERROR_REF(error));
+    return;
+  }
+  tcp_start_write(tcp);
+}
+
+/* Write timestamps need the error queue, which this endpoint does not track
+ * (tcp_can_track_err() is false, so chttp2 never asks for them). Should a
+ * caller pass a timestamps \a arg anyway, it is handed straight back to the
+ * timestamps callback with an error, as tcp_posix does when it shuts down its
+ * traced buffer list, so that whatever the arg holds is released. */
+static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
+                      grpc_closure* cb, void* arg, int /*max_frame_size*/) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  GPR_ASSERT(tcp->write_cb == nullptr);
+  if (arg != nullptr) {
+    grpc_core::TracedBuffer* tb_head = nullptr;
+    grpc_core::TracedBuffer::Shutdown(
+        &tb_head, arg,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Write timestamps are not supported by the io_uring endpoint"));
+  }
+  if (buf->length == 0) {
+    grpc_core::Closure::Run(
+        DEBUG_LOCATION, cb,
+        grpc_fd_is_shutdown(tcp->em_fd)
+            ? tcp_annotate_error(GRPC_ERROR_CREATE_FROM_STATIC_STRING("EOF"),
+                                 tcp)
+            : GRPC_ERROR_NONE);
+    return;
+  }
+  tcp->write_cb = cb;
+  tcp->outgoing_buffer = buf;
+  tcp->outgoing_byte_idx = 0;
+  tcp->refcount.Ref();
+  tcp_start_write(tcp);
+}
+
+/*******************************************************************************
+ * Endpoint
+ */
+
+static void tcp_add_to_pollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  grpc_pollset_add_fd(pollset, tcp->em_fd);
+}
+
+static void tcp_add_to_pollset_set(grpc_endpoint* ep,
+                                   grpc_pollset_set* pollset_set) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  grpc_pollset_set_add_fd(pollset_set, tcp->em_fd);
+}
+
+static void tcp_delete_from_pollset_set(grpc_endpoint* ep,
+                                        grpc_pollset_set* pollset_set) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  grpc_pollset_set_del_fd(pollset_set, tcp->em_fd);
+}
+
+/* Also cancels the operations in flight. */
+static void tcp_shutdown(grpc_endpoint* ep, grpc_error_handle why) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  grpc_fd_shutdown(tcp->em_fd, why);
+}
+
+static void tcp_destroy(grpc_endpoint* ep) {
+  tcp_unref(reinterpret_cast<grpc_tcp_uring*>(ep));
+}
+
+static absl::string_view tcp_get_peer(grpc_endpoint* ep) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  return tcp->peer_string;
+}
+
+static absl::string_view tcp_get_local_address(grpc_endpoint* ep) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  return tcp->local_address;
+}
+
+static int tcp_get_fd(grpc_endpoint* ep) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  return tcp->fd;
+}
+
+static bool tcp_can_track_err(grpc_endpoint* /*ep*/) { return false; }
+
+static const grpc_endpoint_vtable vtable = {tcp_read,
+                                            tcp_write,
+                                            tcp_add_to_pollset,
+                                            tcp_add_to_pollset_set,
+                                            tcp_delete_from_pollset_set,
+                                            tcp_shutdown,
+                                            tcp_destroy,
+                                            tcp_get_peer,
+                                            tcp_get_local_address,
+                                            tcp_get_fd,
+                                            tcp_can_track_err};
+
+bool grpc_tcp_io_uring_enabled() { return grpc_io_uring_ops_available(); }
+
+grpc_endpoint* grpc_tcp_io_uring_create(
+    grpc_fd* em_fd, const grpc_core::PosixTcpOptions& options,
+    absl::string_view peer_string) {
+  grpc_tcp_uring* tcp = new grpc_tcp_uring(options);
+  tcp->base.vtable = &vtable;
+  tcp->em_fd = em_fd;
+  tcp->fd = grpc_fd_wrapped_fd(em_fd);
+  tcp->peer_string = std::string(peer_string);
+  GPR_ASSERT(options.resource_quota != nullptr);
+  tcp->memory_owner =
+      options.resource_quota->memory_quota()->CreateMemoryOwner(peer_string);
+  tcp->self_reservation =
+      tcp->memory_owner.MakeReservation(sizeof(grpc_tcp_uring));
+  grpc_resolved_address resolved_local_addr;
+  memset(&resolved_local_addr, 0, sizeof(resolved_local_addr));
+  resolved_local_addr.len = sizeof(resolved_local_addr.addr);
+  absl::StatusOr<std::string> addr_uri;
+  if (getsockname(tcp->fd,
+                  reinterpret_cast<sockaddr*>(resolved_local_addr.addr),
+                  &resolved_local_addr.len) < 0 ||
+      !(addr_uri = grpc_sockaddr_to_uri(&resolved_local_addr)).ok()) {
+    tcp->local_address = "";
+  } else {
+    tcp->local_address = addr_uri.value();
+  }
+  tcp->read_op.on_done = &tcp->read_done_closure;
+  tcp->write_op.on_done = &tcp->write_done_closure;
+  GRPC_CLOSURE_INIT(&tcp->read_done_closure, tcp_handle_read, tcp,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&tcp->read_ready_closure, tcp_handle_read_ready, tcp,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&tcp->write_done_closure, tcp_handle_write, tcp,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&tcp->write_ready_closure, tcp_handle_write_ready, tcp,
+                    grpc_schedule_on_exec_ctx);
+  return &tcp->base;
+}
+
+bool grpc_is_tcp_io_uring_endpoint(grpc_endpoint* ep) {
+  return ep->vtable == &vtable;
+}
+
+int grpc_tcp_io_uring_fd(grpc_endpoint* ep) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  GPR_ASSERT(ep->vtable == &vtable);
+  return grpc_fd_wrapped_fd(tcp->em_fd);
+}
+
+void grpc_tcp_io_uring_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
+                                              grpc_closure* done) {
+  grpc_tcp_uring* tcp = reinterpret_cast<grpc_tcp_uring*>(ep);
+  GPR_ASSERT(ep->vtable == &vtable);
+  tcp->release_fd = fd;
+  tcp->release_fd_cb = done;
+  tcp_unref(tcp);
+}
+
+#else /* GRPC_LINUX_IO_URING */
+
+bool grpc_tcp_io_uring_enabled() { return false; }
+
+grpc_endpoint* grpc_tcp_io_uring_create(
+    grpc_fd* /*fd*/, const grpc_core::PosixTcpOptions& /*options*/,
+    absl::string_view /*peer_string*/) {
+  GPR_ASSERT(false);
+  return nullptr;
+}
+
+bool grpc_is_tcp_io_uring_endpoint(grpc_endpoint* /*ep*/) { return false; }
+
+int grpc_tcp_io_uring_fd(grpc_endpoint* /*ep*/) {
+  GPR_ASSERT(false);
+  return -1;
+}
+
+void grpc_tcp_io_uring_destroy_and_release_fd(grpc_endpoint* /*ep*/,
+                                              int* /*fd*/,
+                                              grpc_closure* /*done*/) {
+  GPR_ASSERT(false);
+}
+
+#endif /* GRPC_LINUX_IO_URING */
+
+#endif /* GRPC_POSIX_SOCKET_TCP */
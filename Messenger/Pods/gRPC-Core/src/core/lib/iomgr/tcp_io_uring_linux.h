@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_TCP_IO_URING_LINUX_H
+#define GRPC_CORE_LIB_IOMGR_TCP_IO_URING_LINUX_H
+
+/*
+   A tcp endpoint whose reads and writes are submitted to the io_uring
+   polling engine and completed by the kernel, instead of being issued as
+   syscalls once the fd is readable or writable. Reads go into the buffers
+   registered with the ring when one is free. grpc_tcp_create() returns one
+   of these whenever the io_uring engine is active.
+*/
+
+#include <grpc/support/port_platform.h>
+
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+
+/// Whether grpc_tcp_io_uring_create() may be called.
+bool grpc_tcp_io_uring_enabled();
+
+/// Create an io_uring tcp endpoint. Takes ownership of \a fd.
+grpc_endpoint* grpc_tcp_io_uring_create(
+    grpc_fd* fd, const grpc_core::PosixTcpOptions& options,
+    absl::string_view peer_string);
+
+/// Whether \a ep was created by grpc_tcp_io_uring_create().
+bool grpc_is_tcp_io_uring_endpoint(grpc_endpoint* ep);
+
+/// As grpc_tcp_fd().
+int grpc_tcp_io_uring_fd(grpc_endpoint* ep);
+
+/// As grpc_tcp_destroy_and_release_fd().
+void grpc_tcp_io_uring_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
+                                              grpc_closure* done);
+
+#endif /* GRPC_CORE_LIB_IOMGR_TCP_IO_URING_LINUX_H */
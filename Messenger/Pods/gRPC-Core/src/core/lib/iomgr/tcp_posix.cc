@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
@@ -53,11 +54,14 @@
 #include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/tcp_io_uring_linux.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
@@ -457,8 +461,102 @@ class TcpZerocopySendCtx {
   OMemState zcopy_enobuf_state_;
 };
 
+// A per-connection pool of large, page-aligned receive buffers, enabled with
+// GRPC_ARG_TCP_RX_BUFFER_POOL_SIZE. Reads land in a pooled buffer, and what
+// they return are sub-slices sharing the buffer's refcount: the part a read
+// leaves unused goes to last_read_buffer and is filled by the next read, so a
+// bulk transfer streams through a few large buffers with no per-read
+// allocation and no copy on the way up. A buffer goes back to the pool once
+// every slice of it has been released. Each buffer holds a reservation
+// against the connection's memory quota for as long as it exists.
+class TcpReceiveBufferPool : public RefCounted<TcpReceiveBufferPool> {
+ public:
+  static constexpr size_t kBufferSize = 256 * 1024;
+
+  explicit TcpReceiveBufferPool(size_t max_buffers)
+      : max_buffers_(max_buffers) {}
+
+  ~TcpReceiveBufferPool() override {
+    for (Buffer* buffer : free_buffers_) delete buffer;
+  }
+
+  // Returns a slice covering a whole buffer, or an empty slice if every
+  // buffer is still referenced by data handed up earlier.
+  grpc_slice Allocate(MemoryOwner* memory_owner) {
+    Buffer* buffer = nullptr;
+    {
+      MutexLock lock(&mu_);
+      if (!free_buffers_.empty()) {
+        buffer = free_buffers_.back();
+        free_buffers_.pop_back();
+      } else if (num_buffers_ < max_buffers_) {
+        ++num_buffers_;
+      } else {
+        return grpc_empty_slice();
+      }
+    }
+    if (buffer == nullptr) {
+      buffer = new Buffer(memory_owner->MakeReservation(kBufferSize));
+    }
+    // The pool stays alive while any of its buffers are out.
+    buffer->pool = Ref();
+    grpc_slice slice;
+    slice.refcount = buffer;
+    slice.data.refcounted.bytes = buffer->data;
+    slice.data.refcounted.length = kBufferSize;
+    return slice;
+  }
+
+  // Frees the buffers that are not in use, releasing their memory.
+  void Trim() {
+    std::vector<Buffer*> free_buffers;
+    {
+      MutexLock lock(&mu_);
+      free_buffers.swap(free_buffers_);
+      num_buffers_ -= free_buffers.size();
+    }
+    for (Buffer* buffer : free_buffers) delete buffer;
+  }
+
+ private:
+  struct Buffer : public grpc_slice_refcount {
+    explicit Buffer(MemoryAllocator::Reservation reservation)
+        : grpc_slice_refcount(Destroy),
+          reservation(std::move(reservation)),
+          data(static_cast<uint8_t*>(
+              gpr_malloc_aligned(kBufferSize, sysconf(_SC_PAGESIZE)))) {}
+    ~Buffer() { gpr_free_aligned(data); }
+
+    // Called when the last slice referencing the buffer is released.
+    static void Destroy(grpc_slice_refcount* refcount) {
+      Buffer* buffer = static_cast<Buffer*>(refcount);
+      RefCountedPtr<TcpReceiveBufferPool> pool = std::move(buffer->pool);
+      pool->Recycle(buffer);
+    }
+
+    RefCountedPtr<TcpReceiveBufferPool> pool;
+    MemoryAllocator::Reservation reservation;
+    uint8_t* const data;
+  };
+
+  void Recycle(Buffer* buffer) {
+    // Back to the single ref that the next Allocate() hands out.
+    buffer->Ref();
+    MutexLock lock(&mu_);
+    free_buffers_.push_back(buffer);
+  }
+
+  const size_t max_buffers_;
+  Mutex mu_;
+  size_t num_buffers_ ABSL_GUARDED_BY(mu_) = 0;
+  std::vector<Buffer*> free_buffers_ ABSL_GUARDED_BY(mu_);
+};
+
+constexpr size_t TcpReceiveBufferPool::kBufferSize;
+
 }  // namespace grpc_core
 
+using grpc_core::TcpReceiveBufferPool;
 using grpc_core::TcpZerocopySendCtx;
 using grpc_core::TcpZerocopySendRecord;
 
@@ -538,6 +636,8 @@ struct grpc_tcp {
                                       on errors anymore */
   TcpZerocopySendCtx tcp_zerocopy_send_ctx;
   TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+  /* Pool of receive buffers, if enabled. */
+  grpc_core::RefCountedPtr<TcpReceiveBufferPool> rx_buffer_pool;
 
   bool frame_size_tuning_enabled;
   int min_progress_size; /* A hint from upper layers specifying the minimum
@@ -788,6 +888,7 @@ static void perform_reclamation(grpc_tcp* tcp)
   if (tcp->incoming_buffer != nullptr) {
     grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
   }
+  if (tcp->rx_buffer_pool != nullptr) tcp->rx_buffer_pool->Trim();
   tcp->has_posted_reclaimer = false;
   tcp->read_mu.Unlock();
 }
@@ -1047,6 +1148,28 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
 
 static void maybe_make_read_slices(grpc_tcp* tcp)
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
+  if (tcp->rx_buffer_pool != nullptr) {
+    // Read into whole pooled buffers; unused space carries over to the next
+    // read through last_read_buffer. Once the pool is exhausted, fall back
+    // to regular slices below.
+    const size_t wanted =
+        std::max(static_cast<size_t>(tcp->min_progress_size),
+                 std::min(static_cast<size_t>(tcp->target_length),
+                          TcpReceiveBufferPool::kBufferSize));
+    bool allocated = false;
+    while (tcp->incoming_buffer->length < wanted &&
+           tcp->incoming_buffer->count < MAX_READ_IOVEC) {
+      grpc_slice slice = tcp->rx_buffer_pool->Allocate(&tcp->memory_owner);
+      if (GRPC_SLICE_IS_EMPTY(slice)) break;
+      grpc_slice_buffer_add_indexed(tcp->incoming_buffer, slice);
+      allocated = true;
+    }
+    if (allocated) maybe_post_reclaimer(tcp);
+    if (tcp->incoming_buffer->length >=
+        static_cast<size_t>(tcp->min_progress_size)) {
+      return;
+    }
+  }
   if (grpc_core::IsTcpReadChunksEnabled()) {
     static const int kBigAlloc = 64 * 1024;
     static const int kSmallAlloc = 8 * 1024;
@@ -1947,6 +2070,9 @@ static const grpc_endpoint_vtable vtable = {tcp_read,
 grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                                const grpc_core::PosixTcpOptions& options,
                                absl::string_view peer_string) {
+  if (grpc_tcp_io_uring_enabled()) {
+    return grpc_tcp_io_uring_create(em_fd, options, peer_string);
+  }
   grpc_tcp* tcp = new grpc_tcp(options);
   tcp->base.vtable = &vtable;
   tcp->peer_string = std::string(peer_string);
@@ -1982,6 +2108,10 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->outgoing_buffer_arg = nullptr;
   tcp->frame_size_tuning_enabled = grpc_core::IsTcpFrameSizeTuningEnabled();
   tcp->min_progress_size = 1;
+  if (options.tcp_rx_buffer_pool_size > 0) {
+    tcp->rx_buffer_pool = grpc_core::MakeRefCounted<TcpReceiveBufferPool>(
+        options.tcp_rx_buffer_pool_size);
+  }
   if (options.tcp_tx_zero_copy_enabled &&
       !tcp->tcp_zerocopy_send_ctx.memory_limited()) {
 #ifdef GRPC_LINUX_ERRQUEUE
@@ -2044,6 +2174,7 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
 }
 
 int grpc_tcp_fd(grpc_endpoint* ep) {
+  if (grpc_is_tcp_io_uring_endpoint(ep)) return grpc_tcp_io_uring_fd(ep);
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
   GPR_ASSERT(ep->vtable == &vtable);
   return grpc_fd_wrapped_fd(tcp->em_fd);
@@ -2051,6 +2182,10 @@ int grpc_tcp_fd(grpc_endpoint* ep) {
 
 void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
                                      grpc_closure* done) {
+  if (grpc_is_tcp_io_uring_endpoint(ep)) {
+    grpc_tcp_io_uring_destroy_and_release_fd(ep, fd, done);
+    return;
+  }
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
   GPR_ASSERT(ep->vtable == &vtable);
   tcp->release_fd = fd;
@@ -56,6 +56,13 @@ int grpc_tcp_server_port_fd(grpc_tcp_server* s, unsigned port_index,
   return grpc_tcp_server_impl->port_fd(s, port_index, fd_index);
 }
 
+uint64_t grpc_tcp_server_port_fd_accepted_connections(grpc_tcp_server* s,
+                                                      unsigned port_index,
+                                                      unsigned fd_index) {
+  return grpc_tcp_server_impl->port_fd_accepted_connections(s, port_index,
+                                                            fd_index);
+}
+
 grpc_tcp_server* grpc_tcp_server_ref(grpc_tcp_server* s) {
   return grpc_tcp_server_impl->ref(s);
 }
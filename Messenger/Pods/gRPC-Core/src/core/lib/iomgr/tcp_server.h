@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <vector>
 
 #include <grpc/event_engine/endpoint_config.h>
@@ -77,6 +79,9 @@ typedef struct grpc_tcp_server_vtable {
   grpc_core::TcpServerFdHandler* (*create_fd_handler)(grpc_tcp_server* s);
   unsigned (*port_fd_count)(grpc_tcp_server* s, unsigned port_index);
   int (*port_fd)(grpc_tcp_server* s, unsigned port_index, unsigned fd_index);
+  uint64_t (*port_fd_accepted_connections)(grpc_tcp_server* s,
+                                           unsigned port_index,
+                                           unsigned fd_index);
   grpc_tcp_server* (*ref)(grpc_tcp_server* s);
   void (*shutdown_starting_add)(grpc_tcp_server* s,
                                 grpc_closure* shutdown_starting);
@@ -127,6 +132,14 @@ unsigned grpc_tcp_server_port_fd_count(grpc_tcp_server* s, unsigned port_index);
 int grpc_tcp_server_port_fd(grpc_tcp_server* s, unsigned port_index,
                             unsigned fd_index);
 
+/* Returns the number of connections accepted so far on the listening socket
+   identified as in grpc_tcp_server_port_fd(), or 0 if the indices are out of
+   bounds or the platform does not count them. With several SO_REUSEPORT
+   shards per port, this shows how evenly the kernel spreads connections. */
+uint64_t grpc_tcp_server_port_fd_accepted_connections(grpc_tcp_server* s,
+                                                      unsigned port_index,
+                                                      unsigned fd_index);
+
 /* Ref s and return s. */
 grpc_tcp_server* grpc_tcp_server_ref(grpc_tcp_server* s);
 
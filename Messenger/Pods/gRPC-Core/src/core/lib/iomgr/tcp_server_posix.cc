@@ -45,13 +45,16 @@
 
 #include <grpc/event_engine/endpoint_config.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/sockaddr.h"
@@ -80,6 +83,14 @@ static grpc_error_handle tcp_server_create(grpc_closure* shutdown_complete,
   if (value.has_value()) {
     s->expand_wildcard_addrs = (*value != 0);
   }
+  value = config.GetInt(GRPC_ARG_TCP_LISTENER_SHARDS);
+  if (value.has_value()) {
+    s->listener_shards = grpc_core::Clamp(*value, 1, 64);
+  }
+  value = config.GetInt(GRPC_ARG_TCP_LISTENER_SHARD_CPU_AFFINITY);
+  if (value.has_value()) {
+    s->listener_cpu_affinity = (*value != 0);
+  }
   gpr_ref_init(&s->refs, 1);
   gpr_mu_init(&s->mu);
   s->active_ports = 0;
@@ -145,6 +156,13 @@ static void deactivated_all_ports(grpc_tcp_server* s) {
   if (s->head) {
     grpc_tcp_listener* sp;
     for (sp = s->head; sp; sp = sp->next) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+        gpr_log(GPR_INFO,
+                "SERVER_SHUTDOWN: listener port_index=%u fd_index=%u accepted "
+                "%" PRIdPTR " connections",
+                sp->port_index, sp->fd_index,
+                gpr_atm_no_barrier_load(&sp->accepted_connections));
+      }
       grpc_unlink_if_unix_domain_socket(&sp->addr);
       GRPC_CLOSURE_INIT(&sp->destroyed_closure, destroyed_port, s,
                         grpc_schedule_on_exec_ctx);
@@ -176,10 +194,27 @@ static void tcp_server_destroy(grpc_tcp_server* s) {
   }
 }
 
+/* Calls on_read once a connection is waiting. With the io_uring engine the
+   accept itself is submitted to the ring, and on_read takes its result from
+   sp->accept_op. */
+static void notify_on_accept(grpc_tcp_listener* sp) {
+  if (!grpc_io_uring_ops_available()) {
+    grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
+    return;
+  }
+  memset(&sp->accept_addr, 0, sizeof(sp->accept_addr));
+  sp->accept_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
+  sp->accept_op.on_done = &sp->read_closure;
+  grpc_io_uring_accept(sp->emfd,
+                       reinterpret_cast<struct sockaddr*>(sp->accept_addr.addr),
+                       &sp->accept_addr.len, &sp->accept_op);
+}
+
 /* event manager callback when reads are ready */
 static void on_read(void* arg, grpc_error_handle err) {
   grpc_tcp_listener* sp = static_cast<grpc_tcp_listener*>(arg);
   grpc_pollset* read_notifier_pollset;
+  bool accepted = grpc_io_uring_ops_available();
   if (!GRPC_ERROR_IS_NONE(err)) {
     goto error;
   }
@@ -187,18 +222,29 @@ static void on_read(void* arg, grpc_error_handle err) {
   /* loop until accept4 returns EAGAIN, and then re-arm notification */
   for (;;) {
     grpc_resolved_address addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
-    /* Note: If we ever decide to return this address to the user, remember to
-       strip off the ::ffff:0.0.0.0/96 prefix first. */
-    int fd = grpc_accept4(sp->fd, &addr, 1, 1);
+    int fd;
+    if (accepted) {
+      accepted = false;
+      addr = sp->accept_addr;
+      fd = sp->accept_op.result;
+      if (fd < 0) errno = -fd;
+    } else {
+      memset(&addr, 0, sizeof(addr));
+      addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
+      /* Note: If we ever decide to return this address to the user, remember
+         to strip off the ::ffff:0.0.0.0/96 prefix first. */
+      fd = grpc_accept4(sp->fd, &addr, 1, 1);
+    }
     if (fd < 0) {
       if (errno == EINTR) {
         continue;
       } else if (errno == EAGAIN || errno == ECONNABORTED ||
                  errno == EWOULDBLOCK) {
-        grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
+        notify_on_accept(sp);
         return;
+      } else if (errno == ECANCELED) {
+        /* The io_uring accept was cancelled by the listener's shutdown. */
+        goto error;
       } else {
         gpr_mu_lock(&sp->server->mu);
         if (!sp->server->shutdown_listeners) {
@@ -260,12 +306,19 @@ static void on_read(void* arg, grpc_error_handle err) {
     std::string name = absl::StrCat("tcp-server-connection:", addr_uri.value());
     grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
 
-    read_notifier_pollset = (*(sp->server->pollsets))
-        [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-             &sp->server->next_pollset_to_assign, 1)) %
-         sp->server->pollsets->size()];
+    /* A listener polled by a single pollset keeps its connections there, so
+       the handshake runs on the poller that accepted it. */
+    if (sp->pollset != nullptr) {
+      read_notifier_pollset = sp->pollset;
+    } else {
+      read_notifier_pollset = (*(sp->server->pollsets))
+          [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+               &sp->server->next_pollset_to_assign, 1)) %
+           sp->server->pollsets->size()];
+    }
 
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
+    gpr_atm_no_barrier_fetch_add(&sp->accepted_connections, 1);
 
     // Create acceptor.
     grpc_tcp_server_acceptor* acceptor =
@@ -402,6 +455,8 @@ static grpc_error_handle clone_port(grpc_tcp_listener* listener,
     sp->port = port;
     sp->port_index = listener->port_index;
     sp->fd_index = listener->fd_index + count - i;
+    sp->pollset = nullptr;
+    gpr_atm_no_barrier_store(&sp->accepted_connections, 0);
     GPR_ASSERT(sp->emfd);
     while (listener->server->tail->next != nullptr) {
       listener->server->tail = listener->server->tail->next;
@@ -504,12 +559,30 @@ static int tcp_server_port_fd(grpc_tcp_server* s, unsigned port_index,
   return -1;
 }
 
+static uint64_t tcp_server_port_fd_accepted_connections(grpc_tcp_server* s,
+                                                        unsigned port_index,
+                                                        unsigned fd_index) {
+  gpr_mu_lock(&s->mu);
+  grpc_tcp_listener* sp = get_port_index(s, port_index);
+  for (; sp; sp = sp->sibling, --fd_index) {
+    if (fd_index == 0) {
+      gpr_mu_unlock(&s->mu);
+      return static_cast<uint64_t>(
+          gpr_atm_no_barrier_load(&sp->accepted_connections));
+    }
+  }
+  gpr_mu_unlock(&s->mu);
+  return 0;
+}
+
 static void tcp_server_start(grpc_tcp_server* s,
                              const std::vector<grpc_pollset*>* pollsets,
                              grpc_tcp_server_cb on_accept_cb,
                              void* on_accept_cb_arg) {
   size_t i;
+  size_t j;
   grpc_tcp_listener* sp;
+  const size_t num_cpus = gpr_cpu_num_cores();
   GPR_ASSERT(on_accept_cb);
   gpr_mu_lock(&s->mu);
   GPR_ASSERT(!s->on_accept_cb);
@@ -519,25 +592,42 @@ static void tcp_server_start(grpc_tcp_server* s,
   s->pollsets = pollsets;
   sp = s->head;
   while (sp != nullptr) {
-    if (s->so_reuseport && !grpc_is_unix_socket(&sp->addr) &&
-        pollsets->size() > 1) {
-      GPR_ASSERT(GRPC_LOG_IF_ERROR(
-          "clone_port", clone_port(sp, (unsigned)(pollsets->size() - 1))));
-      for (i = 0; i < pollsets->size(); i++) {
-        grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
-        GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
-                          grpc_schedule_on_exec_ctx);
-        grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
-        s->active_ports++;
-        sp = sp->next;
+    /* With SO_REUSEPORT, open several listening sockets (shards) on the port
+       and let the kernel spread incoming connections across them. */
+    size_t shards = 1;
+    if (s->so_reuseport && !grpc_is_unix_socket(&sp->addr)) {
+      shards = s->listener_shards > 0
+                   ? static_cast<size_t>(s->listener_shards)
+                   : pollsets->size();
+    }
+    if (shards > 1) {
+      GPR_ASSERT(GRPC_LOG_IF_ERROR("clone_port",
+                                   clone_port(sp, (unsigned)(shards - 1))));
+    }
+    /* Shard i is polled by pollsets i, i + shards, ..., so that every pollset
+       polls exactly one shard of the port. When there are at least as many
+       shards as pollsets, each shard has a single pollset and its
+       connections stay on it. */
+    for (i = 0; i < shards; i++) {
+      for (j = i % pollsets->size(); j < pollsets->size(); j += shards) {
+        grpc_pollset_add_fd((*pollsets)[j], sp->emfd);
       }
-    } else {
-      for (i = 0; i < pollsets->size(); i++) {
-        grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
+      if (shards >= pollsets->size()) {
+        sp->pollset = (*pollsets)[i % pollsets->size()];
+      }
+      if (s->listener_cpu_affinity && shards > 1) {
+        grpc_error_handle err = grpc_set_socket_incoming_cpu(
+            sp->fd, static_cast<int>(i % num_cpus));
+        if (!GRPC_ERROR_IS_NONE(err)) {
+          /* Not fatal: the kernel still balances across the shards. */
+          gpr_log(GPR_DEBUG, "Listener shard %" PRIuPTR " has no CPU: %s", i,
+                  grpc_error_std_string(err).c_str());
+          GRPC_ERROR_UNREF(err);
+        }
       }
       GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                         grpc_schedule_on_exec_ctx);
-      grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
+      notify_on_accept(sp);
       s->active_ports++;
       sp = sp->next;
     }
@@ -644,10 +734,16 @@ static grpc_core::TcpServerFdHandler* tcp_server_create_fd_handler(
 }
 
 grpc_tcp_server_vtable grpc_posix_tcp_server_vtable = {
-    tcp_server_create,        tcp_server_start,
-    tcp_server_add_port,      tcp_server_create_fd_handler,
-    tcp_server_port_fd_count, tcp_server_port_fd,
-    tcp_server_ref,           tcp_server_shutdown_starting_add,
-    tcp_server_unref,         tcp_server_shutdown_listeners};
+    tcp_server_create,
+    tcp_server_start,
+    tcp_server_add_port,
+    tcp_server_create_fd_handler,
+    tcp_server_port_fd_count,
+    tcp_server_port_fd,
+    tcp_server_port_fd_accepted_connections,
+    tcp_server_ref,
+    tcp_server_shutdown_starting_add,
+    tcp_server_unref,
+    tcp_server_shutdown_listeners};
 
 #endif /* GRPC_POSIX_SOCKET_TCP_SERVER */
@@ -0,0 +1,281 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/gprpp/timing_wheel.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+// Defined in timer_generic.cc, which is always built alongside this file.
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+namespace {
+
+using TimerWheel = grpc_core::TimingWheel<grpc_timer>;
+
+// Timers are spread over the shards by address, as in timer_generic.cc, so
+// that cancellation finds a timer's shard without any extra state. Each shard
+// publishes the next tick at which its wheel has work, so the checker only
+// takes the locks of shards that are actually due.
+struct WheelShard {
+  gpr_mu mu;
+  grpc_core::ManualConstructor<TimerWheel> wheel;
+  std::atomic<int64_t> next_tick;
+};
+
+size_t g_num_shards;
+WheelShard* g_shards;
+bool g_initialized = false;
+gpr_spinlock g_checker_mu = GPR_SPINLOCK_STATIC_INITIALIZER;
+// The smallest next_tick across all shards. Lowered without locks by
+// timer_init and recomputed by the checker.
+std::atomic<int64_t> g_min_timer{0};
+
+GPR_THREAD_LOCAL(int64_t) g_last_seen_min_timer;
+
+int64_t NextTickLocked(WheelShard* shard) {
+  int64_t next = shard->wheel->NextEventTick();
+  shard->next_tick.store(next, std::memory_order_seq_cst);
+  return next;
+}
+
+// Returns true if this call lowered the global minimum.
+bool LowerMinTimer(int64_t tick) {
+  int64_t min_timer = g_min_timer.load(std::memory_order_seq_cst);
+  while (tick < min_timer) {
+    if (g_min_timer.compare_exchange_weak(min_timer, tick,
+                                          std::memory_order_seq_cst)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void timer_list_init() {
+  g_num_shards = grpc_core::Clamp(2 * gpr_cpu_num_cores(), 1u, 32u);
+  g_shards = static_cast<WheelShard*>(
+      gpr_zalloc(g_num_shards * sizeof(*g_shards)));
+  const int64_t now =
+      grpc_core::Timestamp::Now().milliseconds_after_process_epoch();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    WheelShard* shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    shard->wheel.Init(now);
+    new (&shard->next_tick)
+        std::atomic<int64_t>(std::numeric_limits<int64_t>::max());
+  }
+  g_min_timer.store(std::numeric_limits<int64_t>::max());
+  g_last_seen_min_timer = 0;
+  g_checker_mu = GPR_SPINLOCK_INITIALIZER;
+  g_initialized = true;
+}
+
+void timer_list_shutdown() {
+  grpc_error_handle error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown");
+  for (size_t i = 0; i < g_num_shards; i++) {
+    WheelShard* shard = &g_shards[i];
+    gpr_mu_lock(&shard->mu);
+    shard->wheel->Clear([error](grpc_timer* timer) {
+      timer->pending = false;
+      grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                              GRPC_ERROR_REF(error));
+    });
+    gpr_mu_unlock(&shard->mu);
+  }
+  GRPC_ERROR_UNREF(error);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    WheelShard* shard = &g_shards[i];
+    shard->wheel.Destroy();
+    gpr_mu_destroy(&shard->mu);
+  }
+  gpr_free(g_shards);
+  g_initialized = false;
+}
+
+void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
+                grpc_closure* closure) {
+  timer->closure = closure;
+  timer->deadline = deadline.milliseconds_after_process_epoch();
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  grpc_core::Timestamp now = grpc_core::Timestamp::Now();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline.milliseconds_after_process_epoch(),
+            now.milliseconds_after_process_epoch(), closure, closure->cb);
+  }
+
+  if (!g_initialized) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  if (deadline <= now) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    return;
+  }
+
+  WheelShard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  timer->pending = true;
+  shard->wheel->Insert(timer);
+  int64_t next_tick = NextTickLocked(shard);
+  gpr_mu_unlock(&shard->mu);
+
+  // The checker republishes the minimum after it finishes, and re-reads every
+  // shard's next_tick when it does; publishing next_tick before lowering the
+  // minimum means that at least one of the two sees this timer.
+  if (LowerMinTimer(next_tick)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "  .. lowered min timer to %" PRId64, next_tick);
+    }
+    grpc_kick_poller();
+  }
+}
+
+void timer_consume_kick(void) {
+  // Force re-evaluation of last seen min
+  g_last_seen_min_timer = 0;
+}
+
+void timer_cancel(grpc_timer* timer) {
+  if (!g_initialized) {
+    // must have already been cancelled, also the shard mutex is invalid
+    return;
+  }
+
+  WheelShard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+  if (timer->pending) {
+    timer->pending = false;
+    shard->wheel->Remove(timer);
+    NextTickLocked(shard);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+grpc_timer_check_result timer_check(grpc_core::Timestamp* next) {
+  grpc_core::Timestamp now = grpc_core::Timestamp::Now();
+  const int64_t now_ms = now.milliseconds_after_process_epoch();
+
+  // fetch from a thread-local first: this avoids contention on a globally
+  // mutable cacheline in the common case
+  if (now_ms < g_last_seen_min_timer) {
+    if (next != nullptr) {
+      *next = std::min(*next,
+                       grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                           g_last_seen_min_timer));
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  int64_t min_timer = g_min_timer.load(std::memory_order_seq_cst);
+  g_last_seen_min_timer = min_timer;
+  if (now_ms < min_timer) {
+    if (next != nullptr) {
+      *next = std::min(
+          *next, grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                     min_timer));
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (!gpr_spinlock_trylock(&g_checker_mu)) return GRPC_TIMERS_NOT_CHECKED;
+
+  grpc_timer_check_result result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+  size_t fired = 0;
+  int64_t new_min = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    WheelShard* shard = &g_shards[i];
+    if (shard->next_tick.load(std::memory_order_seq_cst) <= now_ms) {
+      gpr_mu_lock(&shard->mu);
+      shard->wheel->Advance(now_ms, [&fired](grpc_timer* timer) {
+        timer->pending = false;
+        grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                                GRPC_ERROR_NONE);
+        ++fired;
+      });
+      new_min = std::min(new_min, NextTickLocked(shard));
+      gpr_mu_unlock(&shard->mu);
+    } else {
+      new_min =
+          std::min(new_min, shard->next_tick.load(std::memory_order_seq_cst));
+    }
+  }
+  if (fired > 0) result = GRPC_TIMERS_FIRED;
+
+  g_min_timer.store(new_min, std::memory_order_seq_cst);
+  // Pick up timers that were added while the minimum was being recomputed:
+  // their LowerMinTimer() may have run before the store above.
+  for (size_t i = 0; i < g_num_shards; i++) {
+    LowerMinTimer(g_shards[i].next_tick.load(std::memory_order_seq_cst));
+  }
+  min_timer = g_min_timer.load(std::memory_order_seq_cst);
+  g_last_seen_min_timer = min_timer;
+  gpr_spinlock_unlock(&g_checker_mu);
+
+  if (next != nullptr) {
+    *next = std::min(
+        *next, grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                   min_timer));
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO,
+            "TIMER CHECK: now=%" PRId64 " fired=%" PRIuPTR
+            " min_timer=%" PRId64,
+            now_ms, fired, min_timer);
+  }
+  return result;
+}
+
+}  // namespace
+
+// Timer list based on hierarchical timing wheels. Selected over
+// grpc_generic_timer_vtable by the "timer_wheel" experiment.
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
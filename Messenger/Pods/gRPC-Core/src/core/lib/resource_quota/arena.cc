@@ -24,27 +24,33 @@
 #include <new>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
 
 namespace {
 
-void* ArenaStorage(size_t initial_size) {
+size_t ArenaStorageSize(size_t initial_size) {
   static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
-  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
+  return base_size + GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
+}
+
+}  // namespace
+
+void* Arena::AllocStorage(size_t initial_size) {
   static constexpr size_t alignment =
       (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
        GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
           ? GPR_CACHELINE_SIZE
           : GPR_MAX_ALIGNMENT;
-  return gpr_malloc_aligned(alloc_size, alignment);
+  return gpr_malloc_aligned(ArenaStorageSize(initial_size), alignment);
 }
 
-}  // namespace
-
-namespace grpc_core {
+void Arena::FreeStorage(void* storage) { gpr_free_aligned(storage); }
 
 Arena::~Arena() {
   Zone* z = last_zone_;
@@ -57,7 +63,7 @@ Arena::~Arena() {
 }
 
 Arena* Arena::Create(size_t initial_size, MemoryAllocator* memory_allocator) {
-  return new (ArenaStorage(initial_size))
+  return new (AllocStorage(initial_size))
       Arena(initial_size, 0, memory_allocator);
 }
 
@@ -65,13 +71,19 @@ std::pair<Arena*, void*> Arena::CreateWithAlloc(
     size_t initial_size, size_t alloc_size, MemoryAllocator* memory_allocator) {
   static constexpr size_t base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-  auto* new_arena = new (ArenaStorage(initial_size))
+  auto* new_arena = new (AllocStorage(initial_size))
       Arena(initial_size, alloc_size, memory_allocator);
   void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
   return std::make_pair(new_arena, first_alloc);
 }
 
 size_t Arena::Destroy() {
+  size_t size = DestroyKeepingStorage();
+  FreeStorage(this);
+  return size;
+}
+
+size_t Arena::DestroyKeepingStorage() {
   ManagedNewObject* p;
   // Outer loop: clear the managed new object list.
   // We do this repeatedly in case a destructor ends up allocating something.
@@ -85,7 +97,6 @@ size_t Arena::Destroy() {
   size_t size = total_used_.load(std::memory_order_relaxed);
   memory_allocator_->Release(total_allocated_.load(std::memory_order_relaxed));
   this->~Arena();
-  gpr_free_aligned(this);
   return size;
 }
 
@@ -116,4 +127,121 @@ void Arena::ManagedNewObject::Link(std::atomic<ManagedNewObject*>* head) {
   }
 }
 
+ArenaPool::ArenaPool(size_t initial_size_estimate,
+                     MemoryAllocator* memory_allocator)
+    : memory_allocator_(memory_allocator),
+      num_shards_(Clamp(gpr_cpu_num_cores(), 1u, 32u)),
+      shards_(new Shard[num_shards_]),
+      initial_size_estimate_(initial_size_estimate) {}
+
+ArenaPool::~ArenaPool() {
+  for (size_t i = 0; i < num_shards_; i++) {
+    Shard& shard = shards_[i];
+    MutexLock lock(&shard.mu);
+    while (shard.free_list != nullptr) {
+      FreeParkedArena(std::exchange(shard.free_list, shard.free_list->next));
+    }
+  }
+}
+
+ArenaPool::Shard& ArenaPool::ShardForCurrentCpu() {
+  return shards_[gpr_cpu_current_cpu() % num_shards_];
+}
+
+void ArenaPool::FreeParkedArena(FreeArena* arena) {
+  memory_allocator_->Release(ArenaStorageSize(arena->initial_zone_size));
+  Arena::FreeStorage(arena);
+}
+
+std::pair<Arena*, void*> ArenaPool::CreateWithAlloc(size_t alloc_size) {
+  static constexpr size_t base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
+  const size_t initial_size = InitialSizeEstimate();
+  FreeArena* parked;
+  {
+    Shard& shard = ShardForCurrentCpu();
+    MutexLock lock(&shard.mu);
+    parked = shard.free_list;
+    if (parked != nullptr) {
+      shard.free_list = parked->next;
+      --shard.free_count;
+    }
+  }
+  if (parked != nullptr) {
+    const size_t initial_zone_size = parked->initial_zone_size;
+    if (initial_zone_size >= initial_size) {
+      memory_allocator_->Release(ArenaStorageSize(initial_zone_size));
+      auto* arena = new (parked)
+          Arena(initial_zone_size, alloc_size, memory_allocator_);
+      return std::make_pair(arena,
+                            reinterpret_cast<char*>(arena) + base_size);
+    }
+    // The estimate has grown past this arena since it was parked.
+    FreeParkedArena(parked);
+  }
+  return Arena::CreateWithAlloc(initial_size, alloc_size, memory_allocator_);
+}
+
+size_t ArenaPool::Recycle(Arena* arena) {
+  const size_t initial_zone_size = arena->initial_zone_size_;
+  const size_t size = arena->DestroyKeepingStorage();
+  RecordSize(size);
+  // Arenas that overflowed into extra zones, and ones much larger than
+  // calls currently need, go back to the system (and the memory quota).
+  const size_t estimate = InitialSizeEstimate();
+  if (size > initial_zone_size || initial_zone_size < estimate ||
+      initial_zone_size > 2 * estimate ||
+      initial_zone_size > kMaxPooledArenaSize) {
+    Arena::FreeStorage(arena);
+    return size;
+  }
+  memory_allocator_->Reserve(ArenaStorageSize(initial_zone_size));
+  auto* parked = new (arena) FreeArena{nullptr, initial_zone_size};
+  {
+    Shard& shard = ShardForCurrentCpu();
+    MutexLock lock(&shard.mu);
+    if (shard.free_count < kMaxArenasPerShard) {
+      parked->next = shard.free_list;
+      shard.free_list = parked;
+      ++shard.free_count;
+      parked = nullptr;
+    }
+  }
+  if (parked != nullptr) FreeParkedArena(parked);
+  return size;
+}
+
+void ArenaPool::RecordSize(size_t size) {
+  size_t bucket = 0;
+  while (bucket + 1 < kNumBuckets && (kMinBucketSize << bucket) < size) {
+    ++bucket;
+  }
+  histogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+  if (samples_.fetch_add(1, std::memory_order_relaxed) % kSamplesPerEstimate ==
+      kSamplesPerEstimate - 1) {
+    UpdateEstimate();
+  }
+}
+
+void ArenaPool::UpdateEstimate() {
+  uint32_t counts[kNumBuckets];
+  uint64_t total = 0;
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    // Halve the counts as we go, so that older calls count for less.
+    counts[i] = histogram_[i].load(std::memory_order_relaxed);
+    histogram_[i].fetch_sub(counts[i] / 2, std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) return;
+  const uint64_t target = (total * kEstimatePercentile + 99) / 100;
+  uint64_t seen = 0;
+  size_t bucket = 0;
+  for (; bucket + 1 < kNumBuckets; bucket++) {
+    seen += counts[bucket];
+    if (seen >= target) break;
+  }
+  initial_size_estimate_.store(kMinBucketSize << bucket,
+                               std::memory_order_relaxed);
+}
+
 }  // namespace grpc_core
@@ -28,15 +28,19 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <atomic>
 #include <memory>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
+
 #include <grpc/event_engine/memory_allocator.h>
 
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/gprpp/construct_destruct.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/promise/context.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 
@@ -89,6 +93,8 @@ class Arena {
   }
 
  private:
+  friend class ArenaPool;
+
   struct Zone {
     Zone* prev;
   };
@@ -126,6 +132,14 @@ class Arena {
 
   ~Arena();
 
+  // Allocate and free the block that holds the arena and its initial zone.
+  static void* AllocStorage(size_t initial_size);
+  static void FreeStorage(void* storage);
+
+  // Run the managed destructors and tear down the arena, leaving its storage
+  // allocated. Returns the total number of bytes used.
+  size_t DestroyKeepingStorage();
+
   void* AllocZone(size_t size);
 
   // Keep track of the total used size. We use this in our call sizing
@@ -154,6 +168,70 @@ inline ScopedArenaPtr MakeScopedArena(size_t initial_size,
   return ScopedArenaPtr(Arena::Create(initial_size, memory_allocator));
 }
 
+// Recycles call arenas for a channel, so that steady-state calls reuse the
+// storage of earlier ones instead of going back to malloc, and sizes new
+// arenas from a histogram of how much recent calls actually used.
+// Idle storage is kept on per-CPU free lists, and stays reserved against the
+// memory quota while it is parked there.
+class ArenaPool {
+ public:
+  ArenaPool(size_t initial_size_estimate, MemoryAllocator* memory_allocator);
+  ~ArenaPool();
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  // Initial zone size that should hold most calls without growing.
+  size_t InitialSizeEstimate() const {
+    return initial_size_estimate_.load(std::memory_order_relaxed);
+  }
+
+  // Like Arena::CreateWithAlloc(), but reuses pooled storage when there is
+  // some of the right size.
+  std::pair<Arena*, void*> CreateWithAlloc(size_t alloc_size);
+
+  // Destroy an arena created by this pool, returning the total number of
+  // bytes it used. Its storage is kept for a later call if it was not
+  // outgrown and still fits the current size estimate, and freed otherwise.
+  size_t Recycle(Arena* arena);
+
+ private:
+  // Histogram buckets are powers of two, from kMinBucketSize upwards.
+  static constexpr size_t kMinBucketSize = 256;
+  static constexpr size_t kNumBuckets = 16;
+  // Recompute the size estimate every this many recycled arenas.
+  static constexpr uint32_t kSamplesPerEstimate = 256;
+  // Size the initial zone to hold this percentage of calls.
+  static constexpr uint64_t kEstimatePercentile = 95;
+  // Storage is not pooled beyond these limits.
+  static constexpr size_t kMaxArenasPerShard = 8;
+  static constexpr size_t kMaxPooledArenaSize = 64 * 1024;
+
+  // Header written over the storage of a parked arena.
+  struct FreeArena {
+    FreeArena* next;
+    size_t initial_zone_size;
+  };
+
+  struct Shard {
+    Mutex mu;
+    FreeArena* free_list ABSL_GUARDED_BY(mu) = nullptr;
+    size_t free_count ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  Shard& ShardForCurrentCpu();
+  void RecordSize(size_t size);
+  void UpdateEstimate();
+  void FreeParkedArena(FreeArena* arena);
+
+  MemoryAllocator* const memory_allocator_;
+  const size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
+  std::atomic<size_t> initial_size_estimate_;
+  std::atomic<uint32_t> samples_{0};
+  std::atomic<uint32_t> histogram_[kNumBuckets] = {};
+};
+
 // Arenas form a context for activities
 template <>
 struct ContextType<Arena> {};
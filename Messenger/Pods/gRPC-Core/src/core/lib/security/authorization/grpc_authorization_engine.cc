@@ -16,24 +16,13 @@
 
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
-#include <algorithm>
-#include <map>
+#include <string>
 #include <utility>
 
-#include "absl/memory/memory.h"
-
 namespace grpc_core {
 
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
-    : action_(policy.action) {
-  for (auto& sub_policy : policy.policies) {
-    Policy policy;
-    policy.name = sub_policy.first;
-    policy.matcher = absl::make_unique<PolicyAuthorizationMatcher>(
-        std::move(sub_policy.second));
-    policies_.push_back(std::move(policy));
-  }
-}
+    : action_(policy.action), policies_(std::move(policy.policies)) {}
 
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(
     GrpcAuthorizationEngine&& other) noexcept
@@ -49,14 +38,9 @@ GrpcAuthorizationEngine& GrpcAuthorizationEngine::operator=(
 AuthorizationEngine::Decision GrpcAuthorizationEngine::Evaluate(
     const EvaluateArgs& args) const {
   Decision decision;
-  bool matches = false;
-  for (const auto& policy : policies_) {
-    if (policy.matcher->Matches(args)) {
-      matches = true;
-      decision.matching_policy_name = policy.name;
-      break;
-    }
-  }
+  const std::string* matching_policy = policies_.FindMatchingPolicy(args);
+  const bool matches = matching_policy != nullptr;
+  if (matches) decision.matching_policy_name = *matching_policy;
   decision.type = (matches == (action_ == Rbac::Action::kAllow))
                       ? Decision::Type::kAllow
                       : Decision::Type::kDeny;
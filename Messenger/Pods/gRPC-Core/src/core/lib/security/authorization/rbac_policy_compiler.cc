@@ -0,0 +1,508 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/authorization/rbac_policy_compiler.h"
+
+#include <string.h>
+
+#include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/iomgr/sockaddr.h"
+
+namespace grpc_core {
+
+namespace {
+
+// The address bytes of an IPv4 or IPv6 address, or an empty string for any
+// other family.
+std::string AddressBytes(const grpc_resolved_address& address) {
+  auto* addr = reinterpret_cast<const grpc_sockaddr*>(address.addr);
+  if (addr->sa_family == GRPC_AF_INET) {
+    auto* addr4 = reinterpret_cast<const grpc_sockaddr_in*>(addr);
+    return std::string(reinterpret_cast<const char*>(&addr4->sin_addr),
+                       sizeof(addr4->sin_addr));
+  }
+  if (addr->sa_family == GRPC_AF_INET6) {
+    auto* addr6 = reinterpret_cast<const grpc_sockaddr_in6*>(addr);
+    return std::string(reinterpret_cast<const char*>(&addr6->sin6_addr),
+                       sizeof(addr6->sin6_addr));
+  }
+  return "";
+}
+
+int AddressFamily(const grpc_resolved_address& address) {
+  return reinterpret_cast<const grpc_sockaddr*>(address.addr)->sa_family;
+}
+
+// A key naming what \a matcher matches. The value or pattern comes last, after
+// fields of fixed format, so no two different matchers share a key.
+std::string StringMatcherKey(const StringMatcher& matcher) {
+  return absl::StrCat(
+      static_cast<int>(matcher.type()), ":", matcher.case_sensitive(), ":",
+      matcher.type() == StringMatcher::Type::kSafeRegex
+          ? matcher.regex_matcher()->pattern()
+          : matcher.string_matcher());
+}
+
+}  // namespace
+
+//
+// CompiledRbacPolicies::PrefixTrie
+//
+
+void CompiledRbacPolicies::PrefixTrie::Insert(absl::string_view key,
+                                              size_t predicate) {
+  Node* node = &root_;
+  for (char c : key) {
+    std::unique_ptr<Node>& child = node->children[c];
+    if (child == nullptr) child = absl::make_unique<Node>();
+    node = child.get();
+  }
+  node->predicates.push_back(predicate);
+}
+
+void CompiledRbacPolicies::PrefixTrie::FindPrefixesOf(
+    absl::string_view s, std::vector<size_t>* predicates) const {
+  const Node* node = &root_;
+  for (size_t depth = 0;; ++depth) {
+    predicates->insert(predicates->end(), node->predicates.begin(),
+                       node->predicates.end());
+    if (depth == s.size()) return;
+    auto it = node->children.find(s[depth]);
+    if (it == node->children.end()) return;
+    node = it->second.get();
+  }
+}
+
+//
+// CompiledRbacPolicies::Compiler
+//
+
+// Turns permission and principal trees into nodes, sharing predicates by key.
+class CompiledRbacPolicies::Compiler {
+ public:
+  explicit Compiler(CompiledRbacPolicies* program) : program_(program) {}
+
+  size_t Compile(Rbac::Permission permission) {
+    switch (permission.type) {
+      case Rbac::Permission::RuleType::kAnd:
+      case Rbac::Permission::RuleType::kOr:
+      case Rbac::Permission::RuleType::kNot: {
+        std::vector<size_t> children;
+        for (auto& rule : permission.permissions) {
+          children.push_back(Compile(std::move(*rule)));
+        }
+        return AddNode(permission.type == Rbac::Permission::RuleType::kAnd
+                           ? Node::Type::kAnd
+                       : permission.type == Rbac::Permission::RuleType::kOr
+                           ? Node::Type::kOr
+                           : Node::Type::kNot,
+                       std::move(children));
+      }
+      case Rbac::Permission::RuleType::kAny:
+        return AddNode(Node::Type::kAny, {});
+      case Rbac::Permission::RuleType::kHeader:
+        return AddPredicateNode(
+            AddHeaderPredicate(std::move(permission.header_matcher)));
+      case Rbac::Permission::RuleType::kPath:
+        return AddPredicateNode(
+            AddPathPredicate(std::move(permission.string_matcher)));
+      case Rbac::Permission::RuleType::kDestIp:
+        return AddPredicateNode(
+            AddIpPredicate(kLocalAddress, std::move(permission.ip)));
+      default: {
+        absl::optional<std::string> key;
+        switch (permission.type) {
+          case Rbac::Permission::RuleType::kDestPort:
+            key = absl::StrCat("permission:dest_port:", permission.port);
+            break;
+          case Rbac::Permission::RuleType::kMetadata:
+            key = absl::StrCat("permission:metadata:", permission.invert);
+            break;
+          case Rbac::Permission::RuleType::kReqServerName:
+            key = absl::StrCat("permission:req_server_name:",
+                               StringMatcherKey(permission.string_matcher));
+            break;
+          default:
+            break;
+        }
+        return AddPredicateNode(AddMatcherPredicate(
+            std::move(key), [&permission] {
+              return AuthorizationMatcher::Create(std::move(permission));
+            }));
+      }
+    }
+  }
+
+  size_t Compile(Rbac::Principal principal) {
+    switch (principal.type) {
+      case Rbac::Principal::RuleType::kAnd:
+      case Rbac::Principal::RuleType::kOr:
+      case Rbac::Principal::RuleType::kNot: {
+        std::vector<size_t> children;
+        for (auto& id : principal.principals) {
+          children.push_back(Compile(std::move(*id)));
+        }
+        return AddNode(principal.type == Rbac::Principal::RuleType::kAnd
+                           ? Node::Type::kAnd
+                       : principal.type == Rbac::Principal::RuleType::kOr
+                           ? Node::Type::kOr
+                           : Node::Type::kNot,
+                       std::move(children));
+      }
+      case Rbac::Principal::RuleType::kAny:
+        return AddNode(Node::Type::kAny, {});
+      case Rbac::Principal::RuleType::kHeader:
+        return AddPredicateNode(
+            AddHeaderPredicate(std::move(principal.header_matcher)));
+      case Rbac::Principal::RuleType::kPath:
+        return AddPredicateNode(
+            AddPathPredicate(std::move(principal.string_matcher.value())));
+      case Rbac::Principal::RuleType::kSourceIp:
+      case Rbac::Principal::RuleType::kDirectRemoteIp:
+      case Rbac::Principal::RuleType::kRemoteIp:
+        return AddPredicateNode(
+            AddIpPredicate(kPeerAddress, std::move(principal.ip)));
+      default: {
+        absl::optional<std::string> key;
+        switch (principal.type) {
+          case Rbac::Principal::RuleType::kPrincipalName:
+            // Without a matcher, any authenticated peer matches.
+            key = principal.string_matcher.has_value()
+                      ? absl::StrCat(
+                            "principal:principal_name:",
+                            StringMatcherKey(*principal.string_matcher))
+                      : "principal:authenticated";
+            break;
+          case Rbac::Principal::RuleType::kMetadata:
+            key = absl::StrCat("principal:metadata:", principal.invert);
+            break;
+          default:
+            break;
+        }
+        return AddPredicateNode(AddMatcherPredicate(
+            std::move(key), [&principal] {
+              return AuthorizationMatcher::Create(std::move(principal));
+            }));
+      }
+    }
+  }
+
+ private:
+  size_t AddNode(Node::Type type, std::vector<size_t> children) {
+    Node node;
+    node.type = type;
+    node.children = std::move(children);
+    program_->nodes_.push_back(std::move(node));
+    return program_->nodes_.size() - 1;
+  }
+
+  size_t AddPredicateNode(size_t predicate) {
+    Node node;
+    node.type = Node::Type::kPredicate;
+    node.predicate = predicate;
+    program_->nodes_.push_back(std::move(node));
+    return program_->nodes_.size() - 1;
+  }
+
+  size_t AddPredicate(Predicate::Type type) {
+    program_->predicates_.emplace_back();
+    program_->predicates_.back().type = type;
+    return program_->predicates_.size() - 1;
+  }
+
+  // Returns the predicate already registered under key, if any; otherwise
+  // registers a new one of the given type.
+  size_t GetOrAddPredicate(std::string key, Predicate::Type type,
+                           bool* added) {
+    auto it = predicate_ids_.emplace(std::move(key),
+                                     program_->predicates_.size());
+    *added = it.second;
+    if (*added) AddPredicate(type);
+    return it.first->second;
+  }
+
+  size_t AddHeaderPredicate(HeaderMatcher header_matcher) {
+    auto it = header_ids_.emplace(header_matcher.name(),
+                                  program_->header_names_.size());
+    if (it.second) {
+      program_->header_names_.push_back(header_matcher.name());
+      header_predicates_.emplace_back();
+    }
+    const size_t header = it.first->second;
+    // Matchers on the same header are few, so they are compared directly.
+    for (size_t id : header_predicates_[header]) {
+      if (program_->predicates_[id].header_matcher == header_matcher) {
+        return id;
+      }
+    }
+    size_t id = AddPredicate(Predicate::Type::kHeader);
+    header_predicates_[header].push_back(id);
+    Predicate& predicate = program_->predicates_[id];
+    predicate.header = header;
+    predicate.header_matcher = std::move(header_matcher);
+    return id;
+  }
+
+  size_t AddPathPredicate(StringMatcher path_matcher) {
+    const bool indexed =
+        path_matcher.type() == StringMatcher::Type::kExact ||
+        path_matcher.type() == StringMatcher::Type::kPrefix;
+    bool added;
+    size_t id = GetOrAddPredicate(
+        absl::StrCat("path:", StringMatcherKey(path_matcher)),
+        indexed ? Predicate::Type::kIndexedPath : Predicate::Type::kPath,
+        &added);
+    if (!added) return id;
+    if (!indexed) {
+      program_->predicates_[id].path_matcher = std::move(path_matcher);
+      return id;
+    }
+    PathTable& table = program_->path_table_;
+    table.predicates.push_back(id);
+    const bool exact = path_matcher.type() == StringMatcher::Type::kExact;
+    if (path_matcher.case_sensitive()) {
+      const std::string& value = path_matcher.string_matcher();
+      if (exact) {
+        table.exact[value].push_back(id);
+      } else {
+        table.prefixes.Insert(value, id);
+      }
+    } else {
+      const std::string value =
+          absl::AsciiStrToLower(path_matcher.string_matcher());
+      if (exact) {
+        table.exact_ignore_case[value].push_back(id);
+      } else {
+        table.prefixes_ignore_case.Insert(value, id);
+      }
+    }
+    return id;
+  }
+
+  size_t AddIpPredicate(AddressSource source, Rbac::CidrRange range) {
+    bool added;
+    size_t id = GetOrAddPredicate(
+        absl::StrCat("ip:", source, ":", range.prefix_len, ":",
+                     range.address_prefix),
+        Predicate::Type::kIp, &added);
+    if (!added) return id;
+    program_->predicates_[id].address_source = source;
+    CidrTable& table = program_->cidr_tables_[source];
+    table.predicates.push_back(id);
+    auto address =
+        StringToSockaddr(range.address_prefix, 0);  // Port does not matter.
+    if (!address.ok()) {
+      // As in IpAuthorizationMatcher, such a range never matches.
+      gpr_log(GPR_DEBUG,
+              "CidrRange address \"%s\" is not IPv4/IPv6. Error: %s",
+              range.address_prefix.c_str(),
+              address.status().ToString().c_str());
+      return id;
+    }
+    grpc_sockaddr_mask_bits(&*address, range.prefix_len);
+    table.ranges[{AddressFamily(*address), range.prefix_len}]
+                [AddressBytes(*address)]
+                    .push_back(id);
+    return id;
+  }
+
+  // Rules without a key get a predicate of their own.
+  template <typename F>
+  size_t AddMatcherPredicate(absl::optional<std::string> key,
+                             F create_matcher) {
+    bool added = true;
+    size_t id =
+        key.has_value()
+            ? GetOrAddPredicate(std::move(*key), Predicate::Type::kMatcher,
+                                &added)
+            : AddPredicate(Predicate::Type::kMatcher);
+    if (added) program_->predicates_[id].matcher = create_matcher();
+    return id;
+  }
+
+  CompiledRbacPolicies* program_;
+  std::map<std::string, size_t> predicate_ids_;
+  std::map<std::string, size_t> header_ids_;
+  // The header predicates of each entry of header_names_.
+  std::vector<std::vector<size_t>> header_predicates_;
+};
+
+CompiledRbacPolicies::CompiledRbacPolicies(
+    std::map<std::string, Rbac::Policy> policies) {
+  Compiler compiler(this);
+  for (auto& p : policies) {
+    Policy policy;
+    policy.name = p.first;
+    policy.permissions = compiler.Compile(std::move(p.second.permissions));
+    policy.principals = compiler.Compile(std::move(p.second.principals));
+    policies_.push_back(std::move(policy));
+  }
+}
+
+//
+// CompiledRbacPolicies::Evaluation
+//
+
+// The state of evaluating the program for one request: what has been read
+// from the request and which predicates have been decided.
+class CompiledRbacPolicies::Evaluation {
+ public:
+  Evaluation(const CompiledRbacPolicies* program, const EvaluateArgs& args)
+      : program_(program),
+        args_(args),
+        results_(program->predicates_.size(), kUnknown),
+        headers_(program->header_names_.size()) {}
+
+  bool Matches(size_t node_index) {
+    const Node& node = program_->nodes_[node_index];
+    switch (node.type) {
+      case Node::Type::kAnd:
+        for (size_t child : node.children) {
+          if (!Matches(child)) return false;
+        }
+        return true;
+      case Node::Type::kOr:
+        for (size_t child : node.children) {
+          if (Matches(child)) return true;
+        }
+        return false;
+      case Node::Type::kNot:
+        return !Matches(node.children[0]);
+      case Node::Type::kAny:
+        return true;
+      case Node::Type::kPredicate:
+        return PredicateMatches(node.predicate);
+    }
+    return false;
+  }
+
+ private:
+  enum Result : uint8_t { kUnknown, kFalse, kTrue };
+
+  struct HeaderValue {
+    bool fetched = false;
+    std::string concatenated_value;
+    absl::optional<absl::string_view> value;
+  };
+
+  bool PredicateMatches(size_t id) {
+    if (results_[id] == kUnknown) {
+      const Predicate& predicate = program_->predicates_[id];
+      switch (predicate.type) {
+        case Predicate::Type::kHeader:
+          Set(id, predicate.header_matcher.Match(GetHeader(predicate.header)));
+          break;
+        case Predicate::Type::kIndexedPath:
+          DecidePathPredicates();
+          break;
+        case Predicate::Type::kPath: {
+          absl::string_view path = args_.GetPath();
+          Set(id, !path.empty() && predicate.path_matcher.Match(path));
+          break;
+        }
+        case Predicate::Type::kIp:
+          DecideIpPredicates(predicate.address_source);
+          break;
+        case Predicate::Type::kMatcher:
+          Set(id, predicate.matcher->Matches(args_));
+          break;
+      }
+    }
+    return results_[id] == kTrue;
+  }
+
+  void Set(size_t id, bool matches) { results_[id] = matches ? kTrue : kFalse; }
+
+  absl::optional<absl::string_view> GetHeader(size_t header) {
+    // headers_ is never resized, so value may point into concatenated_value.
+    HeaderValue& h = headers_[header];
+    if (!h.fetched) {
+      h.value = args_.GetHeaderValue(program_->header_names_[header],
+                                     &h.concatenated_value);
+      h.fetched = true;
+    }
+    return h.value;
+  }
+
+  void DecidePathPredicates() {
+    const PathTable& table = program_->path_table_;
+    for (size_t id : table.predicates) results_[id] = kFalse;
+    absl::string_view path = args_.GetPath();
+    // As in PathAuthorizationMatcher, nothing matches a missing path.
+    if (path.empty()) return;
+    std::vector<size_t> matches;
+    auto it = table.exact.find(path);
+    if (it != table.exact.end()) matches = it->second;
+    table.prefixes.FindPrefixesOf(path, &matches);
+    if (!table.exact_ignore_case.empty() ||
+        !table.prefixes_ignore_case.empty()) {
+      const std::string lower_path = absl::AsciiStrToLower(path);
+      it = table.exact_ignore_case.find(lower_path);
+      if (it != table.exact_ignore_case.end()) {
+        matches.insert(matches.end(), it->second.begin(), it->second.end());
+      }
+      table.prefixes_ignore_case.FindPrefixesOf(lower_path, &matches);
+    }
+    for (size_t id : matches) results_[id] = kTrue;
+  }
+
+  void DecideIpPredicates(AddressSource source) {
+    const CidrTable& table = program_->cidr_tables_[source];
+    for (size_t id : table.predicates) results_[id] = kFalse;
+    const grpc_resolved_address address = source == kLocalAddress
+                                              ? args_.GetLocalAddress()
+                                              : args_.GetPeerAddress();
+    const int family = AddressFamily(address);
+    // One lookup per distinct prefix length, however many ranges share it.
+    for (const auto& p : table.ranges) {
+      if (p.first.first != family) continue;
+      grpc_resolved_address masked = address;
+      grpc_sockaddr_mask_bits(&masked, p.first.second);
+      auto it = p.second.find(AddressBytes(masked));
+      if (it == p.second.end()) continue;
+      for (size_t id : it->second) results_[id] = kTrue;
+    }
+  }
+
+  const CompiledRbacPolicies* program_;
+  const EvaluateArgs& args_;
+  std::vector<Result> results_;
+  std::vector<HeaderValue> headers_;
+};
+
+const std::string* CompiledRbacPolicies::FindMatchingPolicy(
+    const EvaluateArgs& args) const {
+  if (policies_.empty()) return nullptr;
+  Evaluation evaluation(this, args);
+  for (const Policy& policy : policies_) {
+    if (evaluation.Matches(policy.permissions) &&
+        evaluation.Matches(policy.principals)) {
+      return &policy.name;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace grpc_core
@@ -518,6 +518,13 @@ grpc_ssl_session_cache* grpc_ssl_session_cache_create_lru(size_t capacity) {
   return reinterpret_cast<grpc_ssl_session_cache*>(cache);
 }
 
+grpc_ssl_session_cache* grpc_ssl_session_cache_create_sharded_lru(
+    size_t capacity, size_t sessions_per_host) {
+  tsi_ssl_session_cache* cache =
+      tsi_ssl_session_cache_create_sharded_lru(capacity, sessions_per_host);
+  return reinterpret_cast<grpc_ssl_session_cache*>(cache);
+}
+
 void grpc_ssl_session_cache_destroy(grpc_ssl_session_cache* cache) {
   tsi_ssl_session_cache* tsi_cache =
       reinterpret_cast<tsi_ssl_session_cache*>(cache);
@@ -131,6 +131,7 @@ class SecurityHandshaker : public Handshaker {
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  bool kernel_offload_;
   std::string tsi_handshake_error_;
 };
 
@@ -143,7 +144,9 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
       handshake_buffer_(
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(
-          std::max(0, args.GetInt(GRPC_ARG_TSI_MAX_FRAME_SIZE).value_or(0))) {
+          std::max(0, args.GetInt(GRPC_ARG_TSI_MAX_FRAME_SIZE).value_or(0))),
+      kernel_offload_(
+          args.GetBool(GRPC_ARG_TSI_KERNEL_OFFLOAD).value_or(false)) {
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -264,6 +267,12 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
         result));
     return;
   }
+  // Let the TSI implementation move record protection into the kernel if it
+  // can. If it does not, the connection is protected as usual.
+  if (kernel_offload_) {
+    const int fd = grpc_endpoint_get_fd(args_->endpoint);
+    if (fd >= 0) tsi_handshaker_result_offload_to_fd(handshaker_result_, fd);
+  }
   // Check whether we need to wrap the endpoint.
   tsi_frame_protector_type frame_protector_type;
   result = tsi_handshaker_result_get_frame_protector_type(
@@ -530,14 +530,14 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   FilterStackCall* call;
   grpc_error_handle error = GRPC_ERROR_NONE;
   grpc_channel_stack* channel_stack = channel->channel_stack();
-  size_t initial_size = channel->CallSizeEstimate();
-  GRPC_STATS_INC_CALL_INITIAL_SIZE(initial_size);
+  GRPC_STATS_INC_CALL_INITIAL_SIZE(
+      channel->arena_pool()->InitialSizeEstimate());
   size_t call_alloc_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(FilterStackCall)) +
       channel_stack->call_stack_size;
 
-  std::pair<Arena*, void*> arena_with_call = Arena::CreateWithAlloc(
-      initial_size, call_alloc_size, channel->allocator());
+  std::pair<Arena*, void*> arena_with_call =
+      channel->arena_pool()->CreateWithAlloc(call_alloc_size);
   arena = arena_with_call.first;
   call = new (arena_with_call.second) FilterStackCall(arena, *args);
   GPR_DEBUG_ASSERT(FromC(call->c_ptr()) == call);
@@ -636,7 +636,7 @@ void FilterStackCall::ReleaseCall(void* call, grpc_error_handle /*error*/) {
   RefCountedPtr<Channel> channel = std::move(c->channel_);
   Arena* arena = c->arena();
   c->~FilterStackCall();
-  channel->UpdateCallSizeEstimate(arena->Destroy());
+  channel->UpdateCallSizeEstimate(channel->arena_pool()->Recycle(arena));
 }
 
 void FilterStackCall::DestroyCall(void* call, grpc_error_handle /*error*/) {
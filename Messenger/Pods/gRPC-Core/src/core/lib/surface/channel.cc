@@ -75,6 +75,8 @@ Channel::Channel(bool is_client, std::string target,
       allocator_(channel_args.GetObject<ResourceQuota>()
                      ->memory_quota()
                      ->CreateMemoryOwner(target)),
+      arena_pool_(call_size_estimate_.load(std::memory_order_relaxed),
+                  &allocator_),
       target_(std::move(target)),
       channel_stack_(std::move(channel_stack)) {
   // We need to make sure that grpc_shutdown() does not shut things down
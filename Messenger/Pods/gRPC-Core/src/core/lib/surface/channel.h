@@ -51,6 +51,7 @@
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/surface/channel_stack_type.h"
@@ -140,6 +141,7 @@ class Channel : public RefCounted<Channel>,
   void UpdateCallSizeEstimate(size_t size);
   absl::string_view target() const { return target_; }
   MemoryAllocator* allocator() { return &allocator_; }
+  ArenaPool* arena_pool() { return &arena_pool_; }
   bool is_client() const { return is_client_; }
   RegisteredCall* RegisterCall(const char* method, const char* host);
 
@@ -164,6 +166,8 @@ class Channel : public RefCounted<Channel>,
   CallRegistrationTable registration_table_;
   RefCountedPtr<channelz::ChannelNode> channelz_node_;
   MemoryAllocator allocator_;
+  // Must be destroyed before allocator_, which it releases parked arenas to.
+  ArenaPool arena_pool_;
   std::string target_;
   const RefCountedPtr<grpc_channel_stack> channel_stack_;
 };
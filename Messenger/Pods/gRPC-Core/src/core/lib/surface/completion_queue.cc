@@ -236,6 +236,10 @@ class CqEventQueue {
 
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
+  /* Pops up to max completions into completions under a single acquisition
+     of queue_lock_, returning how many were popped. Like Pop(), may come back
+     short even if the queue is not empty. */
+  size_t PopBatch(grpc_cq_completion** completions, size_t max);
 
  private:
   /* Spinlock to serialize consumers i.e pop() operations */
@@ -488,9 +492,17 @@ grpc_cq_completion* CqEventQueue::Pop() {
   grpc_cq_completion* c = nullptr;
 
   if (gpr_spinlock_trylock(&queue_lock_)) {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
+
     bool is_empty = false;
     c = reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
     gpr_spinlock_unlock(&queue_lock_);
+
+    if (c == nullptr && !is_empty) {
+      GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
+    }
+  } else {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
   }
 
   if (c) {
@@ -500,6 +512,36 @@ grpc_cq_completion* CqEventQueue::Pop() {
   return c;
 }
 
+size_t CqEventQueue::PopBatch(grpc_cq_completion** completions, size_t max) {
+  size_t n = 0;
+
+  if (gpr_spinlock_trylock(&queue_lock_)) {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
+
+    while (n < max) {
+      bool is_empty = false;
+      grpc_cq_completion* c = reinterpret_cast<grpc_cq_completion*>(
+          queue_.PopAndCheckEnd(&is_empty));
+      if (c == nullptr) {
+        if (!is_empty) {
+          GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
+        }
+        break;
+      }
+      completions[n++] = c;
+    }
+    gpr_spinlock_unlock(&queue_lock_);
+  } else {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
+  }
+
+  if (n > 0) {
+    num_queue_items_.fetch_sub(n, std::memory_order_relaxed);
+  }
+
+  return n;
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback) {
@@ -952,21 +994,26 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
-static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
-                          void* reserved) {
-  grpc_event ret;
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+/* Most completions popped from the queue per acquisition of its lock when
+   draining a batch */
+static constexpr size_t kMaxCqBatchPop = 16;
+
+/* Converts a popped completion into the event returned to the application,
+   and releases its storage */
+static void cq_completion_to_event(grpc_cq_completion* c, grpc_event* ev) {
+  ev->type = GRPC_OP_COMPLETE;
+  ev->success = c->next & 1u;
+  ev->tag = c->tag;
+  c->done(c->done_arg, c);
+}
 
-  GRPC_API_TRACE(
-      "grpc_completion_queue_next("
-      "cq=%p, "
-      "deadline=gpr_timespec { tv_sec: %" PRId64
-      ", tv_nsec: %d, clock_type: %d }, "
-      "reserved=%p)",
-      5,
-      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
-       reserved));
-  GPR_ASSERT(!reserved);
+/* Shared by grpc_completion_queue_next and grpc_completion_queue_next_batch:
+   blocks until at least one event is ready, then returns up to max_events of
+   them without polling again. Returns the number of events stored. */
+static size_t cq_next_events(grpc_completion_queue* cq, grpc_event* events,
+                             size_t max_events, gpr_timespec deadline) {
+  size_t num_events = 0;
+  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
 
   dump_pending_tags(cq);
 
@@ -988,27 +1035,28 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     if (is_finished_arg.stolen_completion != nullptr) {
       grpc_cq_completion* c = is_finished_arg.stolen_completion;
       is_finished_arg.stolen_completion = nullptr;
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
-      break;
+      cq_completion_to_event(c, &events[num_events++]);
     }
 
-    grpc_cq_completion* c = cqd->queue.Pop();
+    /* Take whatever else is ready in one go */
+    grpc_cq_completion* popped[kMaxCqBatchPop];
+    while (num_events < max_events) {
+      size_t n = cqd->queue.PopBatch(
+          popped, std::min(max_events - num_events, kMaxCqBatchPop));
+      for (size_t i = 0; i < n; i++) {
+        cq_completion_to_event(popped[i], &events[num_events++]);
+      }
+      if (n < kMaxCqBatchPop) break;
+    }
 
-    if (c != nullptr) {
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+    if (num_events > 0) {
       break;
     } else {
-      /* If c == NULL it means either the queue is empty OR in an transient
-         inconsistent state. If it is the latter, we shold do a 0-timeout poll
-         so that the thread comes back quickly from poll to make a second
-         attempt at popping. Not doing this can potentially deadlock this
-         thread forever (if the deadline is infinity) */
+      /* If nothing was popped it means either the queue is empty OR in an
+         transient inconsistent state. If it is the latter, we shold do a
+         0-timeout poll so that the thread comes back quickly from poll to make
+         a second attempt at popping. Not doing this can potentially deadlock
+         this thread forever (if the deadline is infinity) */
       if (cqd->queue.num_items() > 0) {
         iteration_deadline = grpc_core::Timestamp::ProcessEpoch();
       }
@@ -1027,15 +1075,15 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
         continue;
       }
 
-      ret.type = GRPC_QUEUE_SHUTDOWN;
-      ret.success = 0;
+      events[num_events].type = GRPC_QUEUE_SHUTDOWN;
+      events[num_events++].success = 0;
       break;
     }
 
     if (!is_finished_arg.first_loop &&
         grpc_core::Timestamp::Now() >= deadline_millis) {
-      ret.type = GRPC_QUEUE_TIMEOUT;
-      ret.success = 0;
+      events[num_events].type = GRPC_QUEUE_TIMEOUT;
+      events[num_events++].success = 0;
       dump_pending_tags(cq);
       break;
     }
@@ -1052,11 +1100,11 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
               grpc_error_std_string(err).c_str());
       GRPC_ERROR_UNREF(err);
       if (err == GRPC_ERROR_CANCELLED) {
-        ret.type = GRPC_QUEUE_SHUTDOWN;
+        events[num_events].type = GRPC_QUEUE_SHUTDOWN;
       } else {
-        ret.type = GRPC_QUEUE_TIMEOUT;
+        events[num_events].type = GRPC_QUEUE_TIMEOUT;
       }
-      ret.success = 0;
+      events[num_events++].success = 0;
       dump_pending_tags(cq);
       break;
     }
@@ -1070,11 +1118,32 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  for (size_t i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
+  return num_events;
+}
+
+static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
+                          void* reserved) {
+  grpc_event ret;
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  cq_next_events(cq, &ret, 1, deadline);
   return ret;
 }
 
@@ -1125,6 +1194,27 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+int grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                     grpc_event* events, int max_events,
+                                     gpr_timespec deadline, void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, "
+      "events=%p, "
+      "max_events=%d, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_NEXT);
+  if (max_events <= 0) return 0;
+  return static_cast<int>(
+      cq_next_events(cq, events, static_cast<size_t>(max_events), deadline));
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
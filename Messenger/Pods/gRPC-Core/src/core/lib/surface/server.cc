@@ -319,8 +319,9 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
 // advance or queue up any incoming RPC for later match. Instead, MatchOrQueue
 // will call out to an allocation function passed in at the construction of the
 // object. These request matchers are designed for the C++ callback API, so they
-// only support 1 completion queue (passed in at the constructor). They are also
-// used for the sync API.
+// are registered with 1 completion queue (passed in at the constructor). They
+// are also used for the sync API, whose allocator may pick another server
+// completion queue per call so that one method can feed several of them.
 class Server::AllocatingRequestMatcherBase : public RequestMatcherInterface {
  public:
   AllocatingRequestMatcherBase(Server* server, grpc_completion_queue* cq)
@@ -356,6 +357,18 @@ class Server::AllocatingRequestMatcherBase : public RequestMatcherInterface {
   // Supply the completion queue's index relative to the server.
   size_t cq_idx() const { return cq_idx_; }
 
+  // Supply the index of the completion queue an allocation asked to be
+  // notified on, defaulting to this matcher's own.
+  size_t notify_cq_idx(grpc_completion_queue* notify_cq) const {
+    if (notify_cq == nullptr || notify_cq == cq_) return cq_idx_;
+    size_t idx;
+    for (idx = 0; idx < server_->cqs_.size(); idx++) {
+      if (server_->cqs_[idx] == notify_cq) break;
+    }
+    GPR_ASSERT(idx < server_->cqs_.size());
+    return idx;
+  }
+
  private:
   Server* const server_;
   grpc_completion_queue* const cq_;
@@ -376,14 +389,16 @@ class Server::AllocatingRequestMatcherBatch
                     CallData* calld) override {
     if (server()->ShutdownRefOnRequest()) {
       BatchCallAllocation call_info = allocator_();
+      const size_t notify_idx = notify_cq_idx(call_info.notify_cq);
       GPR_ASSERT(server()->ValidateServerRequest(
-                     cq(), static_cast<void*>(call_info.tag), nullptr,
+                     server()->cqs_[notify_idx],
+                     static_cast<void*>(call_info.tag), nullptr,
                      nullptr) == GRPC_CALL_OK);
       RequestedCall* rc = new RequestedCall(
           static_cast<void*>(call_info.tag), call_info.cq, call_info.call,
           call_info.initial_metadata, call_info.details);
       calld->SetState(CallData::CallState::ACTIVATED);
-      calld->Publish(cq_idx(), rc);
+      calld->Publish(notify_idx, rc);
     } else {
       calld->FailCallCreation();
     }
@@ -409,15 +424,17 @@ class Server::AllocatingRequestMatcherRegistered
                     CallData* calld) override {
     if (server()->ShutdownRefOnRequest()) {
       RegisteredCallAllocation call_info = allocator_();
+      const size_t notify_idx = notify_cq_idx(call_info.notify_cq);
       GPR_ASSERT(server()->ValidateServerRequest(
-                     cq(), call_info.tag, call_info.optional_payload,
+                     server()->cqs_[notify_idx], call_info.tag,
+                     call_info.optional_payload,
                      registered_method_) == GRPC_CALL_OK);
       RequestedCall* rc =
           new RequestedCall(call_info.tag, call_info.cq, call_info.call,
                             call_info.initial_metadata, registered_method_,
                             call_info.deadline, call_info.optional_payload);
       calld->SetState(CallData::CallState::ACTIVATED);
-      calld->Publish(cq_idx(), rc);
+      calld->Publish(notify_idx, rc);
     } else {
       calld->FailCallCreation();
     }
@@ -20,6 +20,9 @@
 
 #include "src/core/lib/surface/validate_metadata.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "absl/strings/string_view.h"
 
 #include <grpc/grpc.h>
@@ -29,11 +32,96 @@
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/error.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GRPC_VALIDATE_METADATA_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define GRPC_VALIDATE_METADATA_NEON
+#endif
+
+namespace {
+
+// Vectorized scans used to skip over the (usually entire) legal prefix of a
+// key or value sixteen bytes at a time. Each returns the length of a prefix of
+// [p, p + n) known to be legal, always a multiple of 16; the byte-wise BitSet
+// check picks up from there, so it alone decides what is reported as illegal.
+#if defined(GRPC_VALIDATE_METADATA_SSE2)
+
+// Bytes in [lo, hi]. SSE2 only has signed compares: bias so lo maps to -128.
+inline __m128i InRange(__m128i v, uint8_t lo, uint8_t hi) {
+  const __m128i biased =
+      _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+  return _mm_cmplt_epi8(biased,
+                        _mm_set1_epi8(static_cast<char>(0x80 + hi - lo + 1)));
+}
+
+size_t LegalKeyPrefix(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    __m128i ok = _mm_or_si128(InRange(v, 'a', 'z'), InRange(v, '0', '9'));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, _mm_set1_epi8('-')));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, _mm_set1_epi8('.')));
+    if (_mm_movemask_epi8(ok) != 0xffff) break;
+  }
+  return i;
+}
+
+size_t LegalNonBinValuePrefix(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    if (_mm_movemask_epi8(InRange(v, 32, 126)) != 0xffff) break;
+  }
+  return i;
+}
+
+#elif defined(GRPC_VALIDATE_METADATA_NEON)
+
+inline uint8x16_t InRange(uint8x16_t v, uint8_t lo, uint8_t hi) {
+  return vcleq_u8(vsubq_u8(v, vdupq_n_u8(lo)), vdupq_n_u8(hi - lo));
+}
+
+size_t LegalKeyPrefix(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const uint8x16_t v = vld1q_u8(p + i);
+    uint8x16_t ok = vorrq_u8(InRange(v, 'a', 'z'), InRange(v, '0', '9'));
+    ok = vorrq_u8(ok, vceqq_u8(v, vdupq_n_u8('-')));
+    ok = vorrq_u8(ok, vceqq_u8(v, vdupq_n_u8('_')));
+    ok = vorrq_u8(ok, vceqq_u8(v, vdupq_n_u8('.')));
+    if (vminvq_u8(ok) != 0xff) break;
+  }
+  return i;
+}
+
+size_t LegalNonBinValuePrefix(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    if (vminvq_u8(InRange(vld1q_u8(p + i), 32, 126)) != 0xff) break;
+  }
+  return i;
+}
+
+#else
+
+size_t LegalKeyPrefix(const uint8_t*, size_t) { return 0; }
+size_t LegalNonBinValuePrefix(const uint8_t*, size_t) { return 0; }
+
+#endif
+
+}  // namespace
+
 static grpc_error_handle conforms_to(const grpc_slice& slice,
                                      const grpc_core::BitSet<256>& legal_bits,
+                                     size_t (*legal_prefix)(const uint8_t*,
+                                                            size_t),
                                      const char* err_desc) {
   const uint8_t* p = GRPC_SLICE_START_PTR(slice);
   const uint8_t* e = GRPC_SLICE_END_PTR(slice);
+  p += legal_prefix(p, static_cast<size_t>(e - p));
   for (; p != e; p++) {
     if (!legal_bits.is_set(*p)) {
       size_t len;
@@ -84,7 +172,8 @@ grpc_error_handle grpc_validate_header_key_is_legal(const grpc_slice& slice) {
     return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "Metadata keys cannot start with :");
   }
-  return conforms_to(slice, g_legal_header_key_bits, "Illegal header key");
+  return conforms_to(slice, g_legal_header_key_bits, LegalKeyPrefix,
+                     "Illegal header key");
 }
 
 int grpc_header_key_is_legal(grpc_slice slice) {
@@ -106,7 +195,7 @@ constexpr LegalHeaderNonBinValueBits g_legal_header_non_bin_value_bits;
 grpc_error_handle grpc_validate_header_nonbin_value_is_legal(
     const grpc_slice& slice) {
   return conforms_to(slice, g_legal_header_non_bin_value_bits,
-                     "Illegal header value");
+                     LegalNonBinValuePrefix, "Illegal header value");
 }
 
 int grpc_header_nonbin_value_is_legal(grpc_slice slice) {
@@ -24,10 +24,12 @@
 
 #include "absl/base/thread_annotations.h"
 #include "absl/memory/memory.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -36,20 +38,27 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/event_engine/channel_args_endpoint_config.h"
+#include "src/core/lib/event_engine/default_event_engine.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/event_engine_shims/endpoint.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/resolved_address.h"
 #include "src/core/lib/iomgr/tcp_client.h"
 #include "src/core/lib/iomgr/tcp_server.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/error_utils.h"
 #include "src/core/lib/transport/handshaker.h"
 #include "src/core/lib/transport/handshaker_factory.h"
 #include "src/core/lib/transport/handshaker_registry.h"
@@ -59,6 +68,8 @@ namespace grpc_core {
 
 namespace {
 
+using ::grpc_event_engine::experimental::EventEngine;
+
 class TCPConnectHandshaker : public Handshaker {
  public:
   explicit TCPConnectHandshaker(grpc_pollset_set* pollset_set);
@@ -73,9 +84,15 @@ class TCPConnectHandshaker : public Handshaker {
   void CleanupArgsForFailureLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void FinishLocked(grpc_error_handle error) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   static void Connected(void* arg, grpc_error_handle error);
+  // Connects through the default EventEngine and wraps the result in a
+  // grpc_endpoint shim, for the event_engine_client experiment.
+  void ConnectWithEventEngine(const ChannelArgs& args, Timestamp deadline);
 
   Mutex mu_;
   bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  // Set while an EventEngine connection attempt may still be cancelled.
+  absl::optional<EventEngine::ConnectionHandle> connection_handle_
+      ABSL_GUARDED_BY(mu_);
   // Endpoint and read buffer to destroy after a shutdown.
   grpc_endpoint* endpoint_to_destroy_ ABSL_GUARDED_BY(mu_) = nullptr;
   grpc_slice_buffer* read_buffer_to_destroy_ ABSL_GUARDED_BY(mu_) = nullptr;
@@ -103,10 +120,19 @@ TCPConnectHandshaker::TCPConnectHandshaker(grpc_pollset_set* pollset_set)
 void TCPConnectHandshaker::Shutdown(grpc_error_handle why) {
   // TODO(anramach): After migration to EventEngine, cancel the in-progress
   // TCP connection attempt.
+  bool connect_cancelled = false;
   {
     MutexLock lock(&mu_);
     if (!shutdown_) {
       shutdown_ = true;
+      // A cancelled EventEngine connect never calls back, so drop the ref
+      // its callback held.
+      if (connection_handle_.has_value()) {
+        connect_cancelled =
+            grpc_event_engine::experimental::GetDefaultEventEngine()
+                ->CancelConnect(*connection_handle_);
+        connection_handle_.reset();
+      }
       // If we are shutting down while connecting, respond back with
       // handshake done.
       // The callback from grpc_tcp_client_connect will perform
@@ -118,6 +144,7 @@ void TCPConnectHandshaker::Shutdown(grpc_error_handle why) {
       }
     }
   }
+  if (connect_cancelled) Unref();
   GRPC_ERROR_UNREF(why);
 }
 
@@ -155,7 +182,13 @@ void TCPConnectHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
   // we don't want to pass args->endpoint directly.
   // Instead pass endpoint_ and swap this endpoint to
   // args endpoint on success.
-  // TODO(hork): use EventEngine::Connect if(IsEventEngineClientEnabled())
+#ifdef GRPC_LINUX_EPOLL
+  // Only the Linux PosixEventEngine implements Connect() so far.
+  if (IsEventEngineClientEnabled()) {
+    ConnectWithEventEngine(args->args, args->deadline);
+    return;
+  }
+#endif
   grpc_tcp_client_connect(
       &connected_, &endpoint_to_destroy_, interested_parties_,
       grpc_event_engine::experimental::ChannelArgsEndpointConfig(args->args),
@@ -200,6 +233,42 @@ void TCPConnectHandshaker::Connected(void* arg, grpc_error_handle error) {
   }
 }
 
+void TCPConnectHandshaker::ConnectWithEventEngine(const ChannelArgs& args,
+                                                  Timestamp deadline) {
+  EventEngine* engine =
+      grpc_event_engine::experimental::GetDefaultEventEngine();
+  grpc_event_engine::experimental::MemoryAllocator allocator =
+      args.GetObject<ResourceQuota>()->memory_quota()->CreateMemoryAllocator(
+          "tcp_connect");
+  // Hold mu_ so that the callback cannot see connection_handle_ before it
+  // is set; EventEngine never runs on_connect inline.
+  MutexLock lock(&mu_);
+  connection_handle_ = engine->Connect(
+      [this](absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>> endpoint) {
+        ApplicationCallbackExecCtx callback_exec_ctx;
+        ExecCtx exec_ctx;
+        grpc_error_handle error = GRPC_ERROR_NONE;
+        {
+          MutexLock lock(&mu_);
+          connection_handle_.reset();
+          if (endpoint.ok()) {
+            endpoint_to_destroy_ =
+                grpc_event_engine::experimental::
+                    grpc_event_engine_endpoint_create(std::move(*endpoint));
+          } else {
+            error = absl_status_to_grpc_error(endpoint.status());
+          }
+        }
+        // Takes over the ref held by this callback.
+        Connected(this, error);
+        GRPC_ERROR_UNREF(error);
+      },
+      EventEngine::ResolvedAddress(
+          reinterpret_cast<const sockaddr*>(addr_.addr), addr_.len),
+      grpc_event_engine::experimental::ChannelArgsEndpointConfig(args),
+      std::move(allocator), deadline - Timestamp::Now());
+}
+
 TCPConnectHandshaker::~TCPConnectHandshaker() {
   if (endpoint_to_destroy_ != nullptr) {
     grpc_endpoint_destroy(endpoint_to_destroy_);
@@ -20,21 +20,28 @@
 
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session.h"
 
 namespace tsi {
 
-/// Node for single cached session.
+constexpr size_t SslSessionLRUCache::kMinKeysPerShard;
+constexpr size_t SslSessionLRUCache::kMaxShards;
+
+/// Node for the sessions cached under one key.
 class SslSessionLRUCache::Node {
  public:
-  Node(const std::string& key, SslSessionPtr session) : key_(key) {
-    SetSession(std::move(session));
-  }
+  explicit Node(const std::string& key) : key_(key) {}
 
   // Not copyable nor movable.
   Node(const Node&) = delete;
@@ -42,29 +49,96 @@ class SslSessionLRUCache::Node {
 
   const std::string& key() const { return key_; }
 
-  /// Returns a copy of the node's cache session.
-  SslSessionPtr CopySession() const { return session_->CopySession(); }
+  bool empty() const { return sessions_.empty(); }
+
+  /// Adds \a session (which is moved) as the newest one, dropping the oldest
+  /// if there are more than \a max_sessions.
+  void AddSession(SslSessionPtr session, int64_t expiry, size_t max_sessions) {
+    sessions_.push_front(
+        {SslCachedSession::Create(std::move(session)), expiry});
+    while (sessions_.size() > max_sessions) sessions_.pop_back();
+  }
 
-  /// Set the \a session (which is moved) for the node.
-  void SetSession(SslSessionPtr session) {
-    session_ = SslCachedSession::Create(std::move(session));
+  /// Drops the sessions that expired by \a now and returns a copy of the next
+  /// remaining one in turn, or null if none is left.
+  SslSessionPtr CopyNextSession(int64_t now) {
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+      if (it->expiry <= now) {
+        it = sessions_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (sessions_.empty()) return nullptr;
+    return sessions_[next_session_++ % sessions_.size()]
+        .session->CopySession();
   }
 
  private:
   friend class SslSessionLRUCache;
 
+  struct Entry {
+    std::unique_ptr<SslCachedSession> session;
+    // Wall-clock seconds after which the server will not resume it.
+    int64_t expiry;
+  };
+
   std::string key_;
-  std::unique_ptr<SslCachedSession> session_;
+  // Newest first.
+  std::deque<Entry> sessions_;
+  size_t next_session_ = 0;
 
   Node* next_ = nullptr;
   Node* prev_ = nullptr;
 };
 
-SslSessionLRUCache::SslSessionLRUCache(size_t capacity) : capacity_(capacity) {
+SslSessionLRUCache::SslSessionLRUCache(size_t capacity, size_t sessions_per_key)
+    : num_shards_(grpc_core::Clamp(capacity / kMinKeysPerShard, size_t(1),
+                                   kMaxShards)),
+      shard_capacity_((capacity + num_shards_ - 1) / num_shards_),
+      sessions_per_key_(std::max(sessions_per_key, size_t(1))),
+      shards_(new Shard[num_shards_]) {
   GPR_ASSERT(capacity > 0);
 }
 
-SslSessionLRUCache::~SslSessionLRUCache() {
+SslSessionLRUCache::~SslSessionLRUCache() {}
+
+size_t SslSessionLRUCache::Size() {
+  size_t size = 0;
+  for (size_t i = 0; i < num_shards_; ++i) size += shards_[i].Size();
+  return size;
+}
+
+SslSessionLRUCache::Shard& SslSessionLRUCache::ShardFor(
+    const std::string& key) {
+  if (num_shards_ == 1) return shards_[0];
+  return shards_[std::hash<std::string>()(key) % num_shards_];
+}
+
+void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
+  int64_t expiry = std::numeric_limits<int64_t>::max();
+  const int64_t timeout =
+      static_cast<int64_t>(SSL_SESSION_get_timeout(session.get()));
+  if (timeout > 0) {
+    expiry =
+        static_cast<int64_t>(SSL_SESSION_get_time(session.get())) + timeout;
+  }
+  std::string key_str(key);
+  ShardFor(key_str).Put(key_str, std::move(session), expiry, shard_capacity_,
+                        sessions_per_key_);
+}
+
+SslSessionPtr SslSessionLRUCache::Get(const char* key) {
+  // Key is only used for lookups.
+  std::string key_str(key);
+  return ShardFor(key_str).Get(key_str, gpr_now(GPR_CLOCK_REALTIME).tv_sec);
+}
+
+//
+// SslSessionLRUCache::Shard
+//
+
+SslSessionLRUCache::Shard::~Shard() {
   Node* node = use_order_list_head_;
   while (node) {
     Node* next = node->next_;
@@ -73,12 +147,12 @@ SslSessionLRUCache::~SslSessionLRUCache() {
   }
 }
 
-size_t SslSessionLRUCache::Size() {
+size_t SslSessionLRUCache::Shard::Size() {
   grpc_core::MutexLock lock(&lock_);
   return use_order_list_size_;
 }
 
-SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
+SslSessionLRUCache::Node* SslSessionLRUCache::Shard::FindLocked(
     const std::string& key) {
   auto it = entry_by_key_.find(key);
   if (it == entry_by_key_.end()) {
@@ -92,18 +166,21 @@ SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
   return node;
 }
 
-void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
+void SslSessionLRUCache::Shard::Put(const std::string& key,
+                                    SslSessionPtr session, int64_t expiry,
+                                    size_t capacity, size_t sessions_per_key) {
   grpc_core::MutexLock lock(&lock_);
   Node* node = FindLocked(key);
   if (node != nullptr) {
-    node->SetSession(std::move(session));
+    node->AddSession(std::move(session), expiry, sessions_per_key);
     return;
   }
-  node = new Node(key, std::move(session));
+  node = new Node(key);
+  node->AddSession(std::move(session), expiry, sessions_per_key);
   PushFront(node);
   entry_by_key_.emplace(key, node);
   AssertInvariants();
-  if (use_order_list_size_ > capacity_) {
+  if (use_order_list_size_ > capacity) {
     GPR_ASSERT(use_order_list_tail_);
     node = use_order_list_tail_;
     Remove(node);
@@ -114,17 +191,25 @@ void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
   }
 }
 
-SslSessionPtr SslSessionLRUCache::Get(const char* key) {
+SslSessionPtr SslSessionLRUCache::Shard::Get(const std::string& key,
+                                             int64_t now) {
   grpc_core::MutexLock lock(&lock_);
-  // Key is only used for lookups.
   Node* node = FindLocked(key);
   if (node == nullptr) {
     return nullptr;
   }
-  return node->CopySession();
+  SslSessionPtr session = node->CopyNextSession(now);
+  if (node->empty()) {
+    // Everything under this key expired; a full handshake will refill it.
+    Remove(node);
+    entry_by_key_.erase(node->key());
+    delete node;
+    AssertInvariants();
+  }
+  return session;
 }
 
-void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::Remove(SslSessionLRUCache::Node* node) {
   if (node->prev_ == nullptr) {
     use_order_list_head_ = node->next_;
   } else {
@@ -139,7 +224,7 @@ void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
   use_order_list_size_--;
 }
 
-void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::PushFront(SslSessionLRUCache::Node* node) {
   if (use_order_list_head_ == nullptr) {
     use_order_list_head_ = node;
     use_order_list_tail_ = node;
@@ -155,7 +240,7 @@ void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
 }
 
 #ifndef NDEBUG
-void SslSessionLRUCache::AssertInvariants() {
+void SslSessionLRUCache::Shard::AssertInvariants() {
   size_t size = 0;
   Node* prev = nullptr;
   Node* current = use_order_list_head_;
@@ -173,7 +258,7 @@ void SslSessionLRUCache::AssertInvariants() {
   GPR_ASSERT(entry_by_key_.size() == use_order_list_size_);
 }
 #else
-void SslSessionLRUCache::AssertInvariants() {}
+void SslSessionLRUCache::Shard::AssertInvariants() {}
 #endif
 
 }  // namespace tsi
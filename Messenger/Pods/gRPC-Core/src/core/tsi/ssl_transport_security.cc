@@ -32,6 +32,14 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #endif
+#if defined(GPR_LINUX) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+#endif
 
 #include <string>
 
@@ -76,11 +84,30 @@
   #include <openssl/x509v3.h>
 #endif
 
+/* Kernel TLS offload needs the kernel's TLS ULP and access to the negotiated
+   traffic secrets, which only BoringSSL provides. */
+#if defined(OPENSSL_IS_BORINGSSL) && defined(TLS_TX) && defined(TLS_1_3_VERSION)
+#define TSI_SSL_KTLS_SUPPORTED 1
+#if COCOAPODS==1
+  #include <openssl_grpc/hkdf.h>
+#else
+  #include <openssl/hkdf.h>
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 
 #include <grpc/grpc_security.h>
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
@@ -92,6 +119,7 @@
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -160,6 +188,8 @@ struct tsi_ssl_handshaker_result {
   BIO* network_io;
   unsigned char* unused_bytes;
   size_t unused_bytes_size;
+  /* Set once outgoing records are encrypted by the kernel. */
+  bool kernel_tx_offloaded;
 };
 struct tsi_ssl_frame_protector {
   tsi_frame_protector base;
@@ -169,6 +199,14 @@ struct tsi_ssl_frame_protector {
   size_t buffer_size;
   size_t buffer_offset;
 };
+/* Protector used once the kernel encrypts outgoing records: data to send
+   passes through unchanged, received records are decrypted by SSL. */
+struct tsi_ssl_zero_copy_grpc_protector {
+  tsi_zero_copy_grpc_protector base;
+  SSL* ssl;
+  BIO* network_io;
+  size_t max_frame_size;
+};
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
@@ -1072,6 +1110,14 @@ tsi_ssl_session_cache* tsi_ssl_session_cache_create_lru(size_t capacity) {
   return tsi::SslSessionLRUCache::Create(capacity).release()->c_ptr();
 }
 
+tsi_ssl_session_cache* tsi_ssl_session_cache_create_sharded_lru(
+    size_t capacity, size_t sessions_per_key) {
+  /* Pointer will be dereferenced by unref call. */
+  return tsi::SslSessionLRUCache::Create(capacity, sessions_per_key)
+      .release()
+      ->c_ptr();
+}
+
 void tsi_ssl_session_cache_ref(tsi_ssl_session_cache* cache) {
   /* Pointer will be dereferenced by unref call. */
   tsi::SslSessionLRUCache::FromC(cache)->Ref().release();
@@ -1232,6 +1278,269 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector* /*self*/,
+    grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  /* The kernel builds the records as the data is written to the socket. */
+  grpc_slice_buffer_move_into(unprotected_slices, protected_slices);
+  return TSI_OK;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices, int* min_progress_size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  while (true) {
+    /* Read everything SSL can decrypt from the records it has so far. */
+    while (true) {
+      grpc_slice unprotected =
+          GRPC_SLICE_MALLOC(TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND);
+      size_t unprotected_size = GRPC_SLICE_LENGTH(unprotected);
+      tsi_result result = do_ssl_read(
+          impl->ssl, GRPC_SLICE_START_PTR(unprotected), &unprotected_size);
+      if (result != TSI_OK || unprotected_size == 0) {
+        grpc_slice_unref(unprotected);
+        if (result != TSI_OK) return result;
+        break;
+      }
+      unprotected.data.refcounted.length = unprotected_size;
+      grpc_slice_buffer_add(unprotected_slices, unprotected);
+    }
+    /* Outgoing records are sequenced by the kernel now, so SSL must never
+       produce one itself. It would do so in reply to a key update that the
+       peer requested. */
+    if (BIO_pending(impl->network_io) > 0) {
+      gpr_log(GPR_ERROR,
+              "SSL has records to send after kernel TLS offload, most likely "
+              "for a key update requested by the peer. This is unsupported.");
+      return TSI_UNIMPLEMENTED;
+    }
+    if (protected_slices->length == 0) break;
+    grpc_slice protected_slice = grpc_slice_buffer_take_first(protected_slices);
+    const size_t protected_size = GRPC_SLICE_LENGTH(protected_slice);
+    if (protected_size == 0) {
+      grpc_slice_unref(protected_slice);
+      continue;
+    }
+    GPR_ASSERT(protected_size <= INT_MAX);
+    int written_into_ssl =
+        BIO_write(impl->network_io, GRPC_SLICE_START_PTR(protected_slice),
+                  static_cast<int>(protected_size));
+    if (written_into_ssl <= 0) {
+      grpc_slice_buffer_undo_take_first(protected_slices, protected_slice);
+      gpr_log(GPR_ERROR, "Sending protected frame to ssl failed with %d",
+              written_into_ssl);
+      return TSI_INTERNAL_ERROR;
+    }
+    if (static_cast<size_t>(written_into_ssl) < protected_size) {
+      grpc_slice_buffer_undo_take_first(
+          protected_slices,
+          grpc_slice_sub_no_ref(protected_slice,
+                                static_cast<size_t>(written_into_ssl),
+                                protected_size));
+    } else {
+      grpc_slice_unref(protected_slice);
+    }
+  }
+  if (min_progress_size != nullptr) *min_progress_size = 1;
+  return TSI_OK;
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  if (impl->ssl != nullptr) SSL_free(impl->ssl);
+  if (impl->network_io != nullptr) BIO_free(impl->network_io);
+  gpr_free(self);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t* max_frame_size) {
+  *max_frame_size =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self)->max_frame_size;
+  return TSI_OK;
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+        ssl_zero_copy_grpc_protector_max_frame_size,
+};
+
+/* --- Kernel TLS offload. ---*/
+
+#ifdef TSI_SSL_KTLS_SUPPORTED
+
+/* HKDF-Expand-Label from RFC 8446, section 7.1, with an empty context. */
+static bool ssl_hkdf_expand_label(const EVP_MD* digest,
+                                  bssl::Span<const uint8_t> secret,
+                                  const char* label, uint8_t* out,
+                                  size_t out_len) {
+  static const char kLabelPrefix[] = "tls13 ";
+  const size_t label_len = strlen(label);
+  uint8_t info[2 + 1 + sizeof(kLabelPrefix) - 1 + 16 + 1];
+  if (label_len > 16) return false;
+  size_t info_len = 0;
+  info[info_len++] = static_cast<uint8_t>(out_len >> 8);
+  info[info_len++] = static_cast<uint8_t>(out_len);
+  info[info_len++] = static_cast<uint8_t>(sizeof(kLabelPrefix) - 1 + label_len);
+  memcpy(info + info_len, kLabelPrefix, sizeof(kLabelPrefix) - 1);
+  info_len += sizeof(kLabelPrefix) - 1;
+  memcpy(info + info_len, label, label_len);
+  info_len += label_len;
+  info[info_len++] = 0;
+  return HKDF_expand(out, out_len, digest, secret.data(), secret.size(), info,
+                     info_len) == 1;
+}
+
+/* Fills in the kernel's description of the write state. The nonce of each
+   record is derived from |fixed_iv| and the sequence number the same way
+   SSL does: for TLS 1.2 AES-GCM, the kernel's salt is the implicit part and
+   its IV the explicit part, which SSL sets to the sequence number. */
+template <typename CryptoInfo>
+static size_t ssl_fill_crypto_info(CryptoInfo* info, uint16_t version,
+                                   uint16_t cipher_type, const uint8_t* key,
+                                   const uint8_t* fixed_iv,
+                                   const uint8_t* rec_seq) {
+  info->info.version = version;
+  info->info.cipher_type = cipher_type;
+  memcpy(info->key, key, sizeof(info->key));
+  memcpy(info->salt, fixed_iv, sizeof(info->salt));
+  if (version == TLS_1_3_VERSION || sizeof(info->salt) == 0) {
+    memcpy(info->iv, fixed_iv + sizeof(info->salt), sizeof(info->iv));
+  } else {
+    memcpy(info->iv, rec_seq, sizeof(info->iv));
+  }
+  memcpy(info->rec_seq, rec_seq, sizeof(info->rec_seq));
+  return sizeof(*info);
+}
+
+/* Hands encryption of the records |ssl| sends on |fd| to the kernel, starting
+   at the current write sequence number. */
+static tsi_result ssl_offload_tx_to_kernel(SSL* ssl, int fd) {
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  const int version = SSL_version(ssl);
+  if (cipher == nullptr ||
+      (version != TLS1_2_VERSION && version != TLS1_3_VERSION)) {
+    return TSI_UNIMPLEMENTED;
+  }
+  const bool tls13 = version == TLS1_3_VERSION;
+  uint16_t cipher_type;
+  size_t key_len;
+  size_t fixed_iv_len = 12;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      cipher_type = TLS_CIPHER_AES_GCM_128;
+      key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      if (!tls13) fixed_iv_len = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+      break;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case NID_aes_256_gcm:
+      cipher_type = TLS_CIPHER_AES_GCM_256;
+      key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      if (!tls13) fixed_iv_len = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+      break;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case NID_chacha20_poly1305:
+      cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+      key_len = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+      break;
+#endif
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+  uint8_t key[32];
+  uint8_t fixed_iv[12];
+  if (tls13) {
+    bssl::Span<const uint8_t> read_secret;
+    bssl::Span<const uint8_t> write_secret;
+    const EVP_MD* digest = SSL_CIPHER_get_prf_nid(cipher) == NID_sha384
+                               ? EVP_sha384()
+                               : EVP_sha256();
+    if (!bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret) ||
+        !ssl_hkdf_expand_label(digest, write_secret, "key", key, key_len) ||
+        !ssl_hkdf_expand_label(digest, write_secret, "iv", fixed_iv,
+                               fixed_iv_len)) {
+      OPENSSL_cleanse(key, sizeof(key));
+      return TSI_UNIMPLEMENTED;
+    }
+  } else {
+    /* An AEAD key block holds the client and server keys, followed by the
+       client and server fixed IVs. */
+    uint8_t key_block[2 * (sizeof(key) + sizeof(fixed_iv))];
+    const size_t key_block_len = SSL_get_key_block_len(ssl);
+    if (key_block_len != 2 * (key_len + fixed_iv_len) ||
+        !SSL_generate_key_block(ssl, key_block, key_block_len)) {
+      return TSI_UNIMPLEMENTED;
+    }
+    const size_t side = SSL_is_server(ssl) ? 1 : 0;
+    memcpy(key, key_block + side * key_len, key_len);
+    memcpy(fixed_iv, key_block + 2 * key_len + side * fixed_iv_len,
+           fixed_iv_len);
+    OPENSSL_cleanse(key_block, sizeof(key_block));
+  }
+  const uint64_t sequence = SSL_get_write_sequence(ssl);
+  uint8_t rec_seq[8];
+  for (size_t i = 0; i < sizeof(rec_seq); i++) {
+    rec_seq[i] = static_cast<uint8_t>(sequence >> (56 - 8 * i));
+  }
+  union {
+    tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+#ifdef TLS_CIPHER_AES_GCM_256
+    tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+#endif
+  } crypto_info;
+  memset(&crypto_info, 0, sizeof(crypto_info));
+  const uint16_t kernel_version = tls13 ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+  size_t crypto_info_len = 0;
+  switch (cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+      crypto_info_len =
+          ssl_fill_crypto_info(&crypto_info.aes_gcm_128, kernel_version,
+                               cipher_type, key, fixed_iv, rec_seq);
+      break;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case TLS_CIPHER_AES_GCM_256:
+      crypto_info_len =
+          ssl_fill_crypto_info(&crypto_info.aes_gcm_256, kernel_version,
+                               cipher_type, key, fixed_iv, rec_seq);
+      break;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+      crypto_info_len =
+          ssl_fill_crypto_info(&crypto_info.chacha20_poly1305, kernel_version,
+                               cipher_type, key, fixed_iv, rec_seq);
+      break;
+#endif
+  }
+  OPENSSL_cleanse(key, sizeof(key));
+  OPENSSL_cleanse(fixed_iv, sizeof(fixed_iv));
+  /* A socket with the TLS ULP but no TLS_TX state behaves like a plain TCP
+     socket, so failing after the first call still leaves |fd| usable. */
+  tsi_result result = TSI_OK;
+  if (setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 ||
+      setsockopt(fd, SOL_TLS, TLS_TX, &crypto_info, crypto_info_len) != 0) {
+    gpr_log(GPR_DEBUG, "Kernel TLS offload unavailable: %s", strerror(errno));
+    result = TSI_UNIMPLEMENTED;
+  }
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  return result;
+}
+
+#endif /* TSI_SSL_KTLS_SUPPORTED */
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1367,9 +1676,43 @@ static tsi_result ssl_handshaker_result_extract_peer(
 }
 
 static tsi_result ssl_handshaker_result_get_frame_protector_type(
-    const tsi_handshaker_result* /*self*/,
+    const tsi_handshaker_result* self,
     tsi_frame_protector_type* frame_protector_type) {
-  *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL;
+  const tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<const tsi_ssl_handshaker_result*>(self);
+  *frame_protector_type = impl->kernel_tx_offloaded
+                              ? TSI_FRAME_PROTECTOR_ZERO_COPY
+                              : TSI_FRAME_PROTECTOR_NORMAL;
+  return TSI_OK;
+}
+
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  /* Without the kernel encrypting records, protect() cannot pass data
+     through. */
+  if (!impl->kernel_tx_offloaded) return TSI_FAILED_PRECONDITION;
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  protector_impl->max_frame_size = TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  if (max_output_protected_frame_size != nullptr) {
+    *max_output_protected_frame_size = grpc_core::Clamp(
+        *max_output_protected_frame_size,
+        static_cast<size_t>(TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND),
+        static_cast<size_t>(TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND));
+    protector_impl->max_frame_size = *max_output_protected_frame_size;
+  }
+  /* Transfer ownership of ssl and network_io to the frame protector. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  protector_impl->network_io = impl->network_io;
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
   return TSI_OK;
 }
 
@@ -1437,13 +1780,36 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
   gpr_free(impl);
 }
 
+static tsi_result ssl_handshaker_result_offload_to_fd(
+    const tsi_handshaker_result* self, int fd) {
+#ifdef TSI_SSL_KTLS_SUPPORTED
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  if (impl->ssl == nullptr || impl->kernel_tx_offloaded) {
+    return TSI_FAILED_PRECONDITION;
+  }
+  /* The kernel continues from the current write sequence number, so every
+     record SSL has produced must already have been sent. */
+  if (BIO_pending(impl->network_io) > 0) return TSI_UNIMPLEMENTED;
+  tsi_result result = ssl_offload_tx_to_kernel(impl->ssl, fd);
+  if (result == TSI_OK) impl->kernel_tx_offloaded = true;
+  return result;
+#else
+  (void)self;
+  (void)fd;
+  return TSI_UNIMPLEMENTED;
+#endif
+}
+
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
     ssl_handshaker_result_get_frame_protector_type,
-    nullptr, /* create_zero_copy_grpc_protector */
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
+    ssl_handshaker_result_offload_to_fd,
 };
 
 static tsi_result ssl_handshaker_result_create(
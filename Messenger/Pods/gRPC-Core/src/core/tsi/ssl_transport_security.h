@@ -74,6 +74,11 @@ typedef struct tsi_ssl_session_cache tsi_ssl_session_cache;
 /* Create LRU cache for SSL sessions with \a capacity.  */
 tsi_ssl_session_cache* tsi_ssl_session_cache_create_lru(size_t capacity);
 
+/* Create LRU cache for SSL sessions with \a capacity keys, each holding up to
+   \a sessions_per_key sessions.  */
+tsi_ssl_session_cache* tsi_ssl_session_cache_create_sharded_lru(
+    size_t capacity, size_t sessions_per_key);
+
 /* Increment reference counter of \a cache.  */
 void tsi_ssl_session_cache_ref(tsi_ssl_session_cache* cache);
 
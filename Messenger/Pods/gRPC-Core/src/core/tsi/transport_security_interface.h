@@ -279,6 +279,16 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result* self, const unsigned char** bytes,
     size_t* bytes_size);
 
+/* This method offers the file descriptor of the connection being secured to
+   the handshaker result, so that it may hand record protection of outgoing
+   data to the kernel. It must be called before any frame protector is
+   created. It returns TSI_OK if protection was offloaded, in which case
+   get_frame_protector_type and the protectors created afterwards reflect the
+   offload, or TSI_UNIMPLEMENTED (leaving the result unchanged) if the
+   implementation or platform cannot offload.  */
+tsi_result tsi_handshaker_result_offload_to_fd(
+    const tsi_handshaker_result* self, int fd);
+
 /* This method releases the tsi_handshaker_handshaker object. After this method
    is called, no other method can be called on the object.  */
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self);